@@ -9,6 +9,7 @@
 #include "widgets/WidgetSubsystem.hpp"
 #include "window/Window.hpp"
 #include <vulkan/vulkan.hpp>
+#include <atomic>
 #include <queue>
 
 namespace aerox::io {
@@ -89,10 +90,13 @@ private:
 
   EInputMode _inputMode = GameAndUi;
   
-  bool bExitRequested = false;
+  // Read by the render thread
+  std::atomic<bool> bExitRequested = false;
 
   bool bIsRunning = false;
 
+  bool bHeadless = false;
+
   bool bIsMinimized = false;
 
   bool bIsFocused = false;
@@ -139,6 +143,28 @@ public:
   static Engine * Get();
   void Run();
 
+  /**
+   * \brief Initializes without running the loop, frames are then advanced with Step and drawn on the calling thread
+   */
+  void Start();
+
+  /**
+   * \brief Ticks once by deltaSeconds and draws the result before returning, the same steps always give the same frames
+   */
+  void Step(float deltaSeconds);
+
+  /**
+   * \brief Shuts down an engine started with Start
+   */
+  void Stop();
+
+  /**
+   * \brief Runs without a window or swapchain, frames are drawn offscreen and can be read back. Set before the engine starts.
+   */
+  void SetHeadless(bool headless);
+
+  bool IsHeadless() const;
+
   void RunGame();
 
   void RunDraw() const;
@@ -153,6 +179,11 @@ public:
 
   vk::Extent2D GetMainWindowSize() const;
 
+  /**
+   * \brief Also the size of offscreen frames when headless. Set before the engine starts.
+   */
+  void SetMainWindowSize(const vk::Extent2D &size);
+
   std::weak_ptr<drawing::DrawingSubsystem> GetDrawingSubsystem() const;
 
   std::weak_ptr<input::InputSubsystem> GetInputSubsystem() const;
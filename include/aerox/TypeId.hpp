@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace aerox {
+
+/**
+ * \brief Compile time identifier of a type, a hash of the type's name so it is the same in every shared library and needs no RTTI.
+ * Types in anonymous namespaces of different translation units share a name and therefore an id
+ */
+using TypeId = uint64_t;
+
+/**
+ * \brief 64 bit FNV-1a
+ */
+constexpr uint64_t hashString(const std::string_view str) {
+  uint64_t hash = 14695981039346656037ull;
+  for (const auto c : str) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+/**
+ * \brief Compiler specific signature of this function, it spells out T
+ */
+template <typename T>
+constexpr std::string_view typeSignature() {
+#ifdef _MSC_VER
+  return __FUNCSIG__;
+#else
+  return __PRETTY_FUNCTION__;
+#endif
+}
+
+template <typename T>
+constexpr TypeId typeIdOf() {
+  constexpr auto id = hashString(typeSignature<std::remove_cvref_t<T>>());
+  return id;
+}
+}
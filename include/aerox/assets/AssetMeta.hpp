@@ -1,4 +1,5 @@
 ﻿#pragma once
+#include "constants.hpp"
 #include "types.hpp"
 #include "aerox/containers/Serializable.hpp"
 #include "aerox/meta/Macro.hpp"
@@ -7,7 +8,7 @@ namespace aerox::assets {
 
 struct AssetMeta : Serializable {
 
-  uint32_t version;
+  uint32_t version = ASSET_VERSION;
 
   std::string type;
 
@@ -6,6 +6,8 @@
 #include "aerox/EngineSubsystem.hpp"
 #include "aerox/Object.hpp"
 #include "aerox/meta/Macro.hpp"
+#include <list>
+#include <mutex>
 #include "gen/assets/AssetSubsystem.gen.hpp"
 
 namespace msdfgen {
@@ -13,6 +15,7 @@ class Shape;
 }
 
 namespace aerox::drawing {
+struct GpuHeapBudget;
 class Font;
 class Texture;
 class Mesh;
@@ -41,7 +44,9 @@ class AssetSubsystem : public EngineSubsystem {
 
 private:
   std::unordered_map<std::string, std::shared_ptr<AssetInfo>> _assets;
-  std::unordered_map<std::string, std::weak_ptr<LiveAsset>> _liveAssets;
+  // Least recently loaded first
+  std::list<std::shared_ptr<LiveAsset>> _retainedAssets;
+  std::mutex _retainedMutex;
 
   std::shared_ptr<FT_Library> _library;
 
@@ -75,8 +80,25 @@ public:
                                          const std::function<std::shared_ptr<LiveAsset>(
                                              const fs::path &)> &importFn);
 
+  /**
+   * \brief Returns the live instance of the asset if there is one, otherwise reads it and caches it
+   */
   virtual std::shared_ptr<LiveAsset> LoadAsset(const std::string &assetId);
 
+  /**
+   * \brief Keeps asset alive as the most recently used one, the least recently used is let go once more than NUM_RETAINED_ASSETS are
+   * kept
+   */
+  void Retain(const std::shared_ptr<LiveAsset> &asset);
+
+  /**
+   * \brief Lets go of retained assets, only those nothing else holds unless bOnlyUnused is false
+   * \return Number of assets let go
+   */
+  size_t ReleaseRetained(bool bOnlyUnused = true);
+
+  size_t GetNumRetained();
+
   virtual std::shared_ptr<drawing::Mesh> ImportMesh(
       const fs::path &path);
 
@@ -104,6 +126,11 @@ public:
 
   virtual std::shared_ptr<audio::AudioBuffer> ImportAudioAsset(const fs::path &path);
 
+  /**
+   * \brief A gpu heap is close to its budget, releases retained assets nothing else uses so their gpu memory is freed
+   */
+  virtual void OnGpuMemoryPressure(const drawing::GpuHeapBudget &heap);
+
   String GetName() const override;
 };
 }
@@ -1,6 +1,8 @@
 #pragma once
 #include "aerox/typedefs.hpp"
+#include "aerox/assets/constants.hpp"
 #include "aerox/containers/Serializable.hpp"
+#include <mutex>
 #include <string>
 #include "gen/assets/LiveAsset.gen.hpp"
 
@@ -20,10 +22,13 @@ namespace aerox::assets {
 META_TYPE()
 class LiveAsset : public Serializable, public meta::IMetadata {
   std::string _assetId;
+  uint32_t _assetVersion = ASSET_VERSION;
 
 protected:
   friend class AssetSubsystem;
+  // Every loaded asset that is still alive, by id
   static std::unordered_map<std::string,std::weak_ptr<LiveAsset>> _liveAssetCache;
+  static std::mutex _liveAssetCacheMutex;
   virtual void SetAssetId(const std::string& id);
 public:
 
@@ -31,6 +36,11 @@ public:
 
   virtual std::string GetAssetId() const;
 
+  /**
+   * \brief Layout version of the data this asset was read from, ASSET_VERSION for assets created in this run
+   */
+  uint32_t GetAssetVersion() const;
+
   static bool IsCached(const std::string& assetId);
   
   static std::shared_ptr<LiveAsset> Resolve(const std::string& assetId);
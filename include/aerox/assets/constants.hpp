@@ -0,0 +1,14 @@
+#pragma once
+#include <cstdint>
+
+namespace aerox::assets {
+// Layout versions written into asset metas, add one whenever an asset's data changes and branch on it when reading
+constexpr uint32_t ASSET_VERSION_INITIAL = 0;
+// Meshes carry collision data cooked at import
+constexpr uint32_t ASSET_VERSION_MESH_COLLISION = 1;
+// Given to every asset created now
+constexpr uint32_t ASSET_VERSION = ASSET_VERSION_MESH_COLLISION;
+
+// Loaded assets the asset cache keeps alive after their last user lets go, loading one of them again reuses it
+constexpr uint32_t NUM_RETAINED_ASSETS = 32;
+}
@@ -19,6 +19,7 @@ public:
 protected:
   std::list<std::thread> _pool;
   std::queue<std::shared_ptr<Task>> _tasks;
+  std::queue<std::function<void()>> _jobs;
   std::condition_variable _taskCond;
   std::mutex _taskMutex;
 
@@ -32,6 +33,19 @@ public:
   void RunOneThread();
 
   void EnqueueTask(const std::shared_ptr<Task>& task);
+
+  /**
+   * \brief Queues a lightweight job, unlike tasks jobs are not objects and run before any pending task
+   */
+  void EnqueueJob(std::function<void()> job);
+
+  /**
+   * \brief Runs one queued job on the calling thread
+   * \return False if there was no job to run
+   */
+  bool TryRunJob();
+
+  size_t GetNumThreads() const;
   
   void OnDestroy() override;
 
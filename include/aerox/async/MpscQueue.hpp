@@ -0,0 +1,84 @@
+#pragma once
+#include <atomic>
+#include <utility>
+
+namespace aerox::async {
+
+/**
+ * \brief Lock free queue for many producers and one consumer. Producers push onto an atomic list head, the consumer takes the whole list
+ * in one exchange and walks it oldest first.
+ */
+template <typename T>
+class MpscQueue {
+  struct Node {
+    T value;
+    Node *next = nullptr;
+  };
+
+  std::atomic<Node *> _head = nullptr;
+
+public:
+  MpscQueue() = default;
+  MpscQueue(const MpscQueue &) = delete;
+  MpscQueue &operator=(const MpscQueue &) = delete;
+
+  ~MpscQueue();
+
+  /**
+   * \brief Safe to call from any thread
+   */
+  void Push(T value);
+
+  /**
+   * \brief Calls fn with every value pushed so far in push order, only one thread may drain at a time
+   * \return Number of values drained
+   */
+  template <typename Fn>
+  size_t Drain(Fn &&fn);
+
+  bool IsEmpty() const;
+};
+
+template <typename T>
+MpscQueue<T>::~MpscQueue() {
+  Drain([](T &) {
+  });
+}
+
+template <typename T>
+void MpscQueue<T>::Push(T value) {
+  const auto node = new Node{std::move(value), _head.load(std::memory_order_relaxed)};
+  while (!_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+  }
+}
+
+template <typename T>
+template <typename Fn>
+size_t MpscQueue<T>::Drain(Fn &&fn) {
+  auto node = _head.exchange(nullptr, std::memory_order_acquire);
+
+  // The list is newest first, reverse it so values come out in push order
+  Node *ordered = nullptr;
+  while (node) {
+    const auto next = node->next;
+    node->next = ordered;
+    ordered = node;
+    node = next;
+  }
+
+  size_t count = 0;
+  while (ordered) {
+    const auto next = ordered->next;
+    fn(ordered->value);
+    delete ordered;
+    ordered = next;
+    count++;
+  }
+  return count;
+}
+
+template <typename T>
+bool MpscQueue<T>::IsEmpty() const {
+  return _head.load(std::memory_order_relaxed) == nullptr;
+}
+}
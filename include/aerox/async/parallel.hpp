@@ -0,0 +1,35 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace aerox::async {
+class AsyncSubsystem;
+
+/**
+ * \brief Number of threads parallelFor can spread work over, the async subsystem's threads plus the calling thread
+ */
+size_t getNumWorkers();
+
+/**
+ * \brief Splits [0,count) into at most maxBatches contiguous [begin,end) batches of at least minBatchSize items, except the last. The
+ * split only depends on the arguments so work recorded per batch can be merged in a deterministic order.
+ */
+std::vector<std::pair<size_t, size_t>> partition(size_t count, size_t maxBatches, size_t minBatchSize);
+
+/**
+ * \brief Splits [0,count) into batches and runs them on the async subsystem's threads, the calling thread works on the first batch and
+ * helps with queued jobs until every batch is done. Runs inline when the async subsystem is not running or count is below minBatchSize.
+ * \param count Number of items
+ * \param fn Called with [begin,end) of each batch, must be safe to call from multiple threads at once
+ * \param minBatchSize Smallest number of items worth handing to another thread
+ */
+void parallelFor(size_t count, const std::function<void(size_t begin, size_t end)> &fn, size_t minBatchSize = 64);
+
+/**
+ * \brief parallelFor on the threads of runner instead of the engine's async subsystem, runs inline when runner is null or not running
+ */
+void parallelFor(const std::shared_ptr<AsyncSubsystem> &runner, size_t count, const std::function<void(size_t begin, size_t end)> &fn,
+                 size_t minBatchSize = 64);
+}
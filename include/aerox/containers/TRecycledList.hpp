@@ -0,0 +1,46 @@
+#pragma once
+#include "Array.hpp"
+#include <cstdint>
+
+namespace aerox {
+
+/**
+ * \brief Items kept across resets and handed out again in the same order, a new item is only created once every kept one is in use.
+ * Holds no resources itself, whoever creates the items frees them.
+ */
+template <typename T>
+class TRecycledList {
+  Array<T> _items;
+  uint32_t _numUsed = 0;
+
+public:
+  /**
+   * \brief Returns the next unused item, calling create for a new one if all are in use
+   */
+  template <typename Create>
+  T Acquire(Create &&create) {
+    if (_numUsed == _items.size()) {
+      _items.push(create());
+    }
+    return _items[_numUsed++];
+  }
+
+  /**
+   * \brief Marks every item unused
+   * \return False if nothing was in use, so the owner can skip resetting the items
+   */
+  bool Reset() {
+    const auto bWasUsed = _numUsed > 0;
+    _numUsed = 0;
+    return bWasUsed;
+  }
+
+  uint32_t GetNumUsed() const {
+    return _numUsed;
+  }
+
+  const Array<T> &GetItems() const {
+    return _items;
+  }
+};
+}
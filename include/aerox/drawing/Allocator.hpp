@@ -5,6 +5,10 @@
 #include "aerox/meta/Macro.hpp"
 #include "aerox/TObjectWithInit.hpp"
 #include "aerox/TOwnedBy.hpp"
+#include "aerox/containers/Array.hpp"
+#include "aerox/containers/TDelegate.hpp"
+#include <array>
+#include <atomic>
 #include "gen/drawing/Allocator.gen.hpp"
 
 namespace aerox::drawing {
@@ -12,6 +16,49 @@ struct AllocatedBuffer;
 struct AllocatedImage;
 class DrawingSubsystem;
 
+/**
+ * \brief What an allocation is used for, totals are kept per category
+ */
+enum class EGpuMemoryCategory : uint8_t {
+  Texture,
+  Mesh,
+  RenderTarget,
+  Uniform,
+  Staging,
+  Other,
+  Count
+};
+
+const char *getGpuMemoryCategoryName(EGpuMemoryCategory category);
+
+// A heap whose usage reaches this much of its budget raises onBudgetWarning
+constexpr float GPU_BUDGET_WARNING_RATIO = 0.9f;
+
+struct GpuHeapBudget {
+  uint32_t heap = 0;
+  bool bDeviceLocal = false;
+  // What the process may use of the heap and what it uses, including memory from outside VMA
+  vk::DeviceSize budget = 0;
+  vk::DeviceSize usage = 0;
+  // Memory blocks VMA took from the heap and how much of them allocations use
+  vk::DeviceSize blockBytes = 0;
+  vk::DeviceSize allocationBytes = 0;
+  uint32_t blockCount = 0;
+  uint32_t allocationCount = 0;
+};
+
+struct GpuCategoryStats {
+  vk::DeviceSize bytes = 0;
+  uint64_t count = 0;
+};
+
+struct GpuMemoryStats {
+  Array<GpuHeapBudget> heaps;
+  std::array<GpuCategoryStats, static_cast<size_t>(EGpuMemoryCategory::Count)> categories{};
+  uint64_t liveBuffers = 0;
+  uint64_t liveImages = 0;
+};
+
 struct VmaAllocated : meta::IMetadata {
 private:
     VmaAllocator _allocator;
@@ -19,6 +66,9 @@ private:
 public:
 
     VmaAllocation alloc;
+    EGpuMemoryCategory category = EGpuMemoryCategory::Other;
+    // Size VMA allocated, 0 for memory that is not tracked
+    vk::DeviceSize allocatedSize = 0;
 
     VmaAllocated(VmaAllocator allocator){
         _allocator = allocator;
@@ -32,6 +82,11 @@ public:
     }
 
     void Read(void * dst, size_t offset = 0) const;
+
+    /**
+     * \brief Pointer to persistently mapped memory, null unless created with VMA_ALLOCATION_CREATE_MAPPED_BIT
+     */
+    void * GetMappedData() const;
 };
 
 META_TYPE()
@@ -65,10 +120,25 @@ META_TYPE()
 class Allocator : public TOwnedBy<DrawingSubsystem> {
   
   VmaAllocator _allocator = nullptr;
-  uint64_t _images = 0;
-  uint64_t _buffers = 0;
+  // Allocations are made through const methods, only the totals change
+  mutable std::atomic<uint64_t> _images = 0;
+  mutable std::atomic<uint64_t> _buffers = 0;
+  mutable std::array<std::atomic<uint64_t>, static_cast<size_t>(EGpuMemoryCategory::Count)> _categoryBytes{};
+  mutable std::array<std::atomic<uint64_t>, static_cast<size_t>(EGpuMemoryCategory::Count)> _categoryCounts{};
+  // Heaps that have warned and not gone back under the warning ratio since
+  uint32_t _warnedHeaps = 0;
+
+  void Track(VmaAllocated &allocation, EGpuMemoryCategory category) const;
+
+  void Untrack(const VmaAllocated &allocation) const;
+
 public:
   META_BODY()
+
+  /**
+   * \brief Raised from CheckBudget when a heap's usage reaches GPU_BUDGET_WARNING_RATIO of its budget
+   */
+  DECLARE_DELEGATE(onBudgetWarning, const GpuHeapBudget &)
   
   void OnInit(DrawingSubsystem * subsystem) override;
 
@@ -80,7 +150,8 @@ public:
                                                 vk::MemoryPropertyFlags
                                                 requiredFlags = {},
                                                 VmaAllocationCreateFlags
-                                                flags = {},const std::string& name = "Buffer") const;
+                                                flags = {},const std::string& name = "Buffer",
+                                                EGpuMemoryCategory category = EGpuMemoryCategory::Other) const;
 
   std::shared_ptr<AllocatedBuffer> CreateTransferCpuGpuBuffer(
       size_t size, bool randomAccess,const std::string& name = "Transfer Buffer") const;
@@ -94,7 +165,8 @@ public:
                                                 vk::MemoryPropertyFlags
                                                 requiredFlags = {},
                                                 VmaAllocationCreateFlags
-                                                flags = {},const std::string& name = "Buffer") const;
+                                                flags = {},const std::string& name = "Buffer",
+                                                EGpuMemoryCategory category = EGpuMemoryCategory::Other) const;
 
   template<typename T>
   std::shared_ptr<AllocatedBuffer> CreateTransferCpuGpuBuffer(bool randomAccess,const std::string& name = "Transfer Buffer") const;
@@ -104,17 +176,49 @@ public:
   
   void DestroyBuffer(const AllocatedBuffer &buffer) const;
 
+  /**
+   * \brief Images used as attachments count as render targets, the rest as textures
+   */
   std::shared_ptr<AllocatedImage> AllocateImage(vk::ImageCreateInfo &createInfo,
                                                 const VmaMemoryUsage memoryUsage = {},
                                                 const vk::MemoryPropertyFlags requiredFlags = {},const std::string& name = "Image") const;
   void DestroyImage(const AllocatedImage &image) const;
+
+  /**
+   * \brief Allocates device memory that images are bound into with AllocateAliasedImage
+   */
+  std::shared_ptr<VmaAllocated> AllocateMemory(const vk::MemoryRequirements &requirements,
+                                               const vk::MemoryPropertyFlags requiredFlags = {},const std::string& name = "Memory",
+                                               EGpuMemoryCategory category = EGpuMemoryCategory::RenderTarget) const;
+
+  /**
+   * \brief Creates an image bound into memory at offset. Images whose uses never overlap may share the same range, the image keeps memory alive.
+   */
+  std::shared_ptr<AllocatedImage> AllocateAliasedImage(vk::ImageCreateInfo &createInfo,
+                                                       const std::shared_ptr<VmaAllocated> &memory,
+                                                       vk::DeviceSize offset) const;
+
+  Array<GpuHeapBudget> GetHeapBudgets() const;
+
+  GpuMemoryStats GetMemoryStats() const;
+
+  /**
+   * \brief VMA's json stats with the category totals and live counts next to them
+   * \param detailed Lists every allocation
+   */
+  std::string DumpStatsJson(bool detailed = false) const;
+
+  /**
+   * \brief Refreshes the budgets for a new frame and warns about heaps close to theirs, call once a frame
+   */
+  void CheckBudget(uint32_t frameIndex);
 };
 
 template <typename T> std::shared_ptr<AllocatedBuffer> Allocator::CreateBuffer(
     vk::BufferUsageFlags usage, VmaMemoryUsage memoryUsage,
     vk::MemoryPropertyFlags requiredFlags,
-    VmaAllocationCreateFlags flags,const std::string& name) const {
-  return CreateBuffer(sizeof(T),usage,memoryUsage,requiredFlags,flags,name);
+    VmaAllocationCreateFlags flags,const std::string& name, EGpuMemoryCategory category) const {
+  return CreateBuffer(sizeof(T),usage,memoryUsage,requiredFlags,flags,name,category);
 }
 
 template <typename T> std::shared_ptr<AllocatedBuffer> Allocator::CreateTransferCpuGpuBuffer(bool randomAccess,const std::string& name) const {
@@ -0,0 +1,106 @@
+#pragma once
+#include "aerox/containers/Array.hpp"
+#include <functional>
+#include <mutex>
+#include <vulkan/vulkan.hpp>
+
+namespace aerox::drawing {
+struct RawFrameData;
+
+constexpr uint32_t MAX_BINDLESS_TEXTURES = 4096;
+constexpr uint32_t INVALID_BINDLESS_INDEX = ~0u;
+
+/**
+ * \brief Hands out indices below a capacity, freed indices are reused before new ones
+ */
+class IndexAllocator {
+  Array<uint32_t> _free;
+  // Indexed by every index handed out so far, catches frees of indices that are not in use
+  std::vector<bool> _allocated;
+  uint32_t _next = 0;
+  uint32_t _capacity = 0;
+
+public:
+  explicit IndexAllocator(uint32_t capacity);
+
+  /**
+   * \return INVALID_BINDLESS_INDEX when every index is in use
+   */
+  uint32_t Allocate();
+
+  /**
+   * \brief Throws if index was never allocated or is already free
+   */
+  void Free(uint32_t index);
+
+  uint32_t GetNumAllocated() const;
+
+  uint32_t GetCapacity() const;
+};
+
+/**
+ * \brief One descriptor set holding every texture, shaders index it with Textures[] from bindless.glsl. Textures keep their index
+ * for as long as they are uploaded so it is written once instead of every time a material uses the texture. A written index is never
+ * rewritten while frames may read it, changing a texture moves it to a new index and the old one is retired. The material buffer is
+ * bound next to them.
+ */
+class BindlessTextures {
+  struct Retired {
+    uint32_t index;
+    std::function<void()> release;
+  };
+
+  vk::Device _device;
+  vk::DescriptorSetLayout _layout;
+  vk::DescriptorPool _pool;
+  vk::DescriptorSet _set;
+  IndexAllocator _indices{MAX_BINDLESS_TEXTURES};
+  Array<Retired> _retired;
+  bool _bMaterialBufferSet = false;
+  std::mutex _mutex;
+
+  void Write(uint32_t index, vk::ImageView view, vk::Sampler sampler) const;
+
+public:
+  void Init(vk::Device device);
+
+  void Destroy();
+
+  /**
+   * \return Index of the texture in the set, stays valid until removed
+   */
+  uint32_t Add(vk::ImageView view, vk::Sampler sampler);
+
+  /**
+   * \brief Writes view and sampler to a new index and retires oldIndex, frames already recorded keep reading the old one
+   * \param release Runs once oldIndex is freed, for whatever the old descriptor pointed at
+   * \return The new index
+   */
+  uint32_t Replace(uint32_t oldIndex, vk::ImageView view, vk::Sampler sampler, std::function<void()> release = {});
+
+  /**
+   * \brief Frees index and runs release once every frame recorded before the next Flush is done with it
+   */
+  void Retire(uint32_t index, std::function<void()> release = {});
+
+  /**
+   * \brief Hands everything retired so far to frame's cleaner, which runs when the frame is drawn again FRAME_OVERLAP frames later.
+   * Called once per recorded frame.
+   */
+  void Flush(RawFrameData *frame);
+
+  /**
+   * \brief The index may be handed out again right away, the gpu must be done with it
+   */
+  void Remove(uint32_t index);
+
+  vk::DescriptorSetLayout GetLayout() const;
+
+  vk::DescriptorSet GetSet() const;
+
+  /**
+   * \brief Binds the buffer shaders read material parameters from, only once before any frame is recorded
+   */
+  void SetMaterialBuffer(vk::Buffer buffer);
+};
+}
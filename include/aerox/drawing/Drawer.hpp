@@ -1,13 +1,17 @@
 ﻿#pragma once
-#include "types.hpp"
+#include "FrameSnapshot.hpp"
 
 namespace aerox::drawing {
 class DrawingSubsystem;
 
 class Drawer {
 public:
-  
-  virtual void Draw(RawFrameData * frameData) = 0;
+
+  /**
+   * \brief Copies what will be drawn from game state, runs on the game thread. The returned function records it on the render thread and
+   * may be empty when there is nothing to draw.
+   */
+  virtual recordFn Collect() = 0;
 };
 }
 
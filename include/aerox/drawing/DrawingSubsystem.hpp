@@ -1,6 +1,10 @@
 ﻿#pragma once
+#include "BindlessTextures.hpp"
+#include "MaterialBuffer.hpp"
+#include "FrameSnapshot.hpp"
 #include "Shader.hpp"
 #include "ShaderManager.hpp"
+#include "StagingUploader.hpp"
 #include "descriptors.hpp"
 #include "types.hpp"
 #include "aerox/EngineSubsystem.hpp"
@@ -28,6 +32,7 @@ namespace aerox::drawing {
 
 class Viewport;
 class WindowDrawer;
+class OffscreenDrawer;
 class Texture;
 class Allocator;
 class MaterialInstance;
@@ -36,6 +41,12 @@ class Mesh;
 
 constexpr unsigned int FRAME_OVERLAP = 2;
 
+// Most frames the game thread may simulate ahead of the render thread
+constexpr unsigned int MAX_FRAME_LATENCY = FRAME_OVERLAP;
+
+// Key of the offscreen drawer among the window drawers, window ids count up from 0
+constexpr uint64_t OFFSCREEN_DRAWER_ID = ~0ull;
+
 struct GraphicsQueueOp {
   std::function<void(const vk::Queue &)> func;
   std::promise<std::optional<std::exception_ptr>> *pending;
@@ -61,6 +72,10 @@ class DrawingSubsystem : public EngineSubsystem {
   vk::SurfaceKHR _surface = nullptr;
   vk::Queue _graphicsQueue = nullptr;
   uint32_t _graphicsQueueFamily = -1;
+  // Null when the device has no transfer only queue family
+  vk::Queue _transferQueue = nullptr;
+  uint32_t _transferQueueFamily = -1;
+  bool _bMemoryBudgetExtension = false;
 
   // Default Images
   std::shared_ptr<Texture> _whiteTexture;
@@ -73,6 +88,9 @@ class DrawingSubsystem : public EngineSubsystem {
   vk::Sampler _defaultSamplerNearest;
 
   DescriptorAllocatorGrowable _globalAllocator{};
+  BindlessTextures _bindlessTextures;
+  MaterialBuffer _materialBuffer;
+  StagingUploader _uploader;
 
   vk::Fence _immediateFence;
   vk::CommandBuffer _immediateCommandBuffer;
@@ -84,6 +102,12 @@ class DrawingSubsystem : public EngineSubsystem {
   Array<std::function<void()>> _resizeCallbacks;
 
   std::unordered_map<uint64_t, std::shared_ptr<WindowDrawer>> _windowDrawers;
+  // Stands in for the main window's drawer when the engine runs headless
+  std::weak_ptr<OffscreenDrawer> _offscreenDrawer;
+  FrameSnapshotQueue _frameQueue;
+  uint64_t _numCollected = 0;
+  // Frames started by any window, ids are handed out in submission order
+  std::atomic<uint64_t> _numRecorded = 0;
   std::queue<GraphicsQueueOp> _submitQueue{};
   std::thread _submitThread;
   std::condition_variable _submitCond;
@@ -99,6 +123,8 @@ protected:
 
   std::weak_ptr<WindowDrawer> CreateWindowDrawer(const std::weak_ptr<window::Window> &window);
 
+  std::weak_ptr<WindowDrawer> CreateOffscreenDrawer(const vk::Extent2D &extent);
+
 public:
   static std::shared_ptr<meta::Metadata> Meta;
   std::shared_ptr<meta::Metadata> GetMeta() const override;
@@ -117,23 +143,6 @@ public:
   static void GenerateMipMaps(vk::CommandBuffer cmd, vk::Image image,
                               vk::Extent2D size, const vk::Filter &filter);
 
-  static void TransitionImage(vk::CommandBuffer cmd, vk::Image image,
-                              vk::ImageLayout from,
-                              vk::ImageLayout to,
-                              const std::variant<
-                                vk::ImageSubresourceRange, vk::ImageAspectFlags>
-                              &resourceOrAspect =
-                                  vk::ImageAspectFlagBits::eColor,
-                              vk::PipelineStageFlags2 srcStageFlags =
-                                  vk::PipelineStageFlagBits2::eAllCommands,
-                              vk::PipelineStageFlags2 dstStageFlags =
-                                  vk::PipelineStageFlagBits2::eAllCommands,
-                              vk::AccessFlags2 srcAccessFlags =
-                                  vk::AccessFlagBits2::eMemoryWrite,
-                              vk::AccessFlags2 dstAccessFlags =
-                                  vk::AccessFlagBits2::eMemoryWrite |
-                                  vk::AccessFlagBits2::eMemoryRead
-      );
   static vk::ImageSubresourceRange ImageSubResourceRange(
       vk::ImageAspectFlags aspectMask);
   static void CopyImageToImage(vk::CommandBuffer cmd, vk::Image src,
@@ -153,7 +162,15 @@ public:
 
   static uint32_t CalcMipLevels(const vk::Extent2D &extent);
 
+  /**
+   * \brief The offscreen drawer when headless
+   */
   std::weak_ptr<WindowDrawer> GetMainWindowDrawer();
+
+  /**
+   * \brief Empty unless the engine runs headless
+   */
+  std::weak_ptr<OffscreenDrawer> GetOffscreenDrawer() const;
   String GetName() const override;
 
   float renderScale = 1.f;
@@ -166,6 +183,8 @@ public:
   vk::PhysicalDevice GetPhysicalDevice() const;
   uint32_t GetQueueFamily() const;
   vk::Instance GetVulkanInstance() const;
+  // VK_EXT_memory_budget is enabled, VMA reports budgets from the driver instead of estimating them
+  bool HasMemoryBudgetExtension() const;
   std::weak_ptr<Allocator> GetAllocator() const;
 
 
@@ -182,10 +201,24 @@ public:
 
   DescriptorAllocatorGrowable *GetGlobalDescriptorAllocator();
 
+  BindlessTextures *GetBindlessTextures();
+
+  MaterialBuffer *GetMaterialBuffer();
+
+  StagingUploader *GetUploader();
+
+  /**
+   * \brief Id of a frame about to be recorded, larger than every earlier frame's of any window
+   */
+  uint64_t NextFrameId();
+
   std::shared_ptr<AllocatedImage> CreateImage(vk::Extent3D size,
                                       vk::Format format,
                                       vk::ImageUsageFlags usage,
                                       bool mipMapped = false,const std::string& name = "Image") const;
+  /**
+   * \brief The copy is queued on the uploader, frames submitted after the next flush wait for it
+   */
   std::shared_ptr<AllocatedImage> CreateImage(const void *data,
                                       vk::Extent3D size,
                                       vk::Format format,
@@ -204,8 +237,39 @@ public:
 
   //void drawImGui(vk::CommandBuffer cmd, vk::ImageView view);
 
+  /**
+   * \brief Snapshots what every window will draw, runs on the game thread. With a latency of 0 the snapshot is drawn right away,
+   * otherwise it is queued for the render thread.
+   */
+  virtual void Collect();
+
+  /**
+   * \brief Draws the oldest queued snapshot, runs on the render thread and blocks until one is queued
+   */
   virtual void Draw();
 
+  virtual void DrawSnapshot(const FrameSnapshot &snapshot);
+
+  /**
+   * \brief How many snapshots may wait for the render thread, 0 draws on the game thread
+   */
+  void SetFrameLatency(uint32_t latency);
+
+  uint32_t GetFrameLatency();
+
+  /**
+   * \brief Blocks until the render thread has drawn every queued snapshot, call before changing anything queued snapshots use
+   */
+  void WaitForRenderThread();
+
+  /**
+   * \brief Wakes the render thread and drops queued snapshots
+   */
+  void StopRendering();
+
+  /**
+   * \brief The copies are queued on the uploader, frames submitted after the next flush wait for them
+   */
   std::shared_ptr<GpuGeometryBuffers> CreateGeometryBuffers(const Mesh *mesh);
 
   template <typename T>
@@ -227,38 +291,21 @@ DrawingSubsystem::CreateGeometryBuffers(const Array<T> &vertices,
       | vk::BufferUsageFlagBits::eTransferDst
       | vk::BufferUsageFlagBits::eShaderDeviceAddress,
       VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
-      vk::MemoryPropertyFlagBits::eDeviceLocal);
+      vk::MemoryPropertyFlagBits::eDeviceLocal, {}, "Vertex Buffer", EGpuMemoryCategory::Mesh);
 
   const vk::BufferDeviceAddressInfo deviceAddressInfo{
       newBuffers->vertexBuffer->buffer};
   newBuffers->vertexBufferAddress = _device.getBufferAddress(deviceAddressInfo);
 
   newBuffers->indexBuffer = GetAllocator().lock()->CreateBuffer(
-      vertexBufferSize,
+      indexBufferSize,
       vk::BufferUsageFlagBits::eIndexBuffer
       | vk::BufferUsageFlagBits::eTransferDst,
       VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
-      vk::MemoryPropertyFlagBits::eDeviceLocal);
-
-  const auto stagingBuffer = GetAllocator().lock()->
-                                            CreateTransferCpuGpuBuffer(
-                                                vertexBufferSize +
-                                                indexBufferSize, false);
-
-  stagingBuffer->Write(vertices.data(), vertexBufferSize);
-  stagingBuffer->Write(indices.data(), indexBufferSize, vertexBufferSize);
-
-  ImmediateSubmit([&](const vk::CommandBuffer cmd) {
-    const vk::BufferCopy vertexCopy{0, 0, vertexBufferSize};
-
-    cmd.copyBuffer(stagingBuffer->buffer, newBuffers->vertexBuffer->buffer, 1,
-                   &vertexCopy);
-
-    const vk::BufferCopy indicesCopy{vertexBufferSize, 0, indexBufferSize};
+      vk::MemoryPropertyFlagBits::eDeviceLocal, {}, "Index Buffer", EGpuMemoryCategory::Mesh);
 
-    cmd.copyBuffer(stagingBuffer->buffer, newBuffers->indexBuffer->buffer, 1,
-                   &indicesCopy);
-  });
+  _uploader.UploadBuffer(newBuffers->vertexBuffer, vertices.data(), vertexBufferSize);
+  _uploader.UploadBuffer(newBuffers->indexBuffer, indices.data(), indexBufferSize);
 
   return newBuffers;
 }
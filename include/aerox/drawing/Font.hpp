@@ -2,27 +2,24 @@
 
 #include "types.hpp"
 #include "aerox/drawing/Texture.hpp"
+#include "aerox/drawing/MaterialBuffer.hpp"
 #include "gen/drawing/Font.gen.hpp"
 
 namespace aerox::drawing {
 class MaterialInstance;
 
-constexpr int FONT_CHARACTERS_MAX = 256;
-
+// info.x = glyph index, info.y = font size, info.z = glyph table index, info.w = text material block index
 struct FontPushConstants {
   glm::vec4 extent{0};
   glm::vec4  info{0};
+  // Address of this frame's UiGlobalBuffer
+  vk::DeviceAddress globals = 0;
 };
 
 struct PackedGlyph {
   glm::vec4 info;
 };
 
-struct PackedGpuGlyphs {
-  PackedGlyph glyphs[FONT_CHARACTERS_MAX] = {};
-  int numChars = 0;
-};
-
 struct Glyph {
   // Normalized x,y,x + width,y + height
   int id;
@@ -50,7 +47,8 @@ class Font : public Object, public assets::LiveAsset,public GpuNative {
   float _descender = 0.0f;
   Array<std::shared_ptr<Texture>> _textures;
   Array<Glyph> _glyphs{};
-  std::shared_ptr<AllocatedBuffer> _gpuGlyphs;
+  // One PackedGlyph per glyph in the material buffer
+  MaterialBlock _glyphBlock;
   std::unordered_map<int,int> _glyphMapping;
 
 public:
@@ -80,7 +78,10 @@ public:
 
   std::optional<int> GetGlyphIndex(int id) const;
 
-  std::weak_ptr<AllocatedBuffer> GetPackedGlyphs() const;
+  /**
+   * \brief Index of the first packed glyph in the material buffer
+   */
+  uint32_t GetGlyphsIndex() const;
 
   void OnDestroy() override;
 
@@ -0,0 +1,78 @@
+#pragma once
+#include "types.hpp"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace aerox::drawing {
+class WindowDrawer;
+
+/**
+ * \brief Records collected work into a frame, runs on the render thread
+ */
+typedef std::function<void(RawFrameData *)> recordFn;
+
+/**
+ * \brief Everything one window records in a frame. Built on the game thread from copies of game state and only read by the render thread.
+ */
+struct WindowSnapshot {
+  std::shared_ptr<WindowDrawer> drawer;
+  // Taken with the snapshot so a resize on the game thread never changes what a queued frame records
+  vk::Viewport viewport;
+  Array<recordFn> scenes;
+  Array<recordFn> ui;
+  // Copied to the swapchain once everything is recorded
+  std::shared_ptr<AllocatedImage> output;
+};
+
+struct FrameSnapshot {
+  uint64_t frame = 0;
+  Array<WindowSnapshot> windows;
+};
+
+/**
+ * \brief Hands frame snapshots from the game thread to the render thread. The latency is how many snapshots may wait to be drawn, the
+ * game thread blocks once that many are queued.
+ */
+class FrameSnapshotQueue {
+  std::deque<std::shared_ptr<FrameSnapshot>> _pending;
+  std::mutex _mutex;
+  std::condition_variable _cond;
+  std::thread::id _renderThread;
+  uint32_t _latency = 1;
+  bool _bDrawing = false;
+  bool _bClosed = false;
+
+public:
+  void SetLatency(uint32_t latency);
+
+  uint32_t GetLatency();
+
+  /**
+   * \brief Called by the game thread, blocks while the queue is full
+   */
+  void Push(std::shared_ptr<FrameSnapshot> snapshot);
+
+  /**
+   * \brief Called by the render thread, blocks until a snapshot is queued. Returns nothing once closed.
+   */
+  std::shared_ptr<FrameSnapshot> Pop();
+
+  /**
+   * \brief Called by the render thread once it no longer uses the snapshot it popped
+   */
+  void Release();
+
+  /**
+   * \brief Blocks until every queued snapshot is drawn and the render thread is waiting for more. Returns immediately on the render thread.
+   */
+  void WaitIdle();
+
+  /**
+   * \brief Drops queued snapshots and wakes every waiting thread
+   */
+  void Close();
+};
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vulkan/vulkan.hpp>
+
+namespace aerox::drawing {
+struct AllocatedBuffer;
+class DrawingSubsystem;
+
+constexpr vk::DeviceSize FRAME_UPLOAD_BUFFER_SIZE = 8 * 1024 * 1024;
+
+/**
+ * \brief Bump allocates offsets in [0, capacity), everything is freed at once with Reset. Only deals in offsets so it does not care
+ * what memory is behind them.
+ */
+class LinearAllocator {
+  uint64_t _capacity = 0;
+  uint64_t _head = 0;
+
+public:
+  explicit LinearAllocator(uint64_t capacity = 0);
+
+  /**
+   * \param alignment Must be a power of two
+   * \return Offset of the allocation, empty when it does not fit
+   */
+  std::optional<uint64_t> Allocate(uint64_t size, uint64_t alignment);
+
+  void Reset();
+
+  uint64_t GetUsed() const;
+
+  uint64_t GetCapacity() const;
+};
+
+/**
+ * \brief Memory handed out by FrameUploadBuffer, valid until the frame it was allocated for is drawn again
+ */
+struct FrameUpload {
+  vk::Buffer buffer = nullptr;
+  vk::DeviceSize offset = 0;
+  vk::DeviceSize size = 0;
+  // Mapped pointer to offset
+  void *data = nullptr;
+  // Device address of offset, for buffer_reference reads
+  vk::DeviceAddress address = 0;
+};
+
+/**
+ * \brief A persistently mapped buffer for data that only lives for one frame in flight, uniforms, instance data or dynamic vertices.
+ * Allocations are never freed one by one, the whole buffer is reset once the frame's fence signals.
+ */
+class FrameUploadBuffer {
+  std::shared_ptr<AllocatedBuffer> _buffer;
+  std::byte *_mapped = nullptr;
+  vk::DeviceAddress _address = 0;
+  // Every allocation can be bound as a uniform or storage buffer
+  vk::DeviceSize _minAlignment = 16;
+  LinearAllocator _allocator;
+  std::mutex _mutex;
+
+public:
+  void Init(DrawingSubsystem *drawer, vk::DeviceSize size = FRAME_UPLOAD_BUFFER_SIZE);
+
+  void Destroy();
+
+  /**
+   * \param alignment Raised to the device's uniform and storage buffer offset alignment
+   */
+  FrameUpload Allocate(vk::DeviceSize size, vk::DeviceSize alignment = 0);
+
+  FrameUpload Upload(const void *src, vk::DeviceSize size, vk::DeviceSize alignment = 0);
+
+  template <typename T>
+  FrameUpload Upload(const T &src, vk::DeviceSize alignment = 0);
+
+  /**
+   * \brief Only call once the frame's previous submission has finished
+   */
+  void Reset();
+
+  vk::DeviceSize GetUsed() const;
+};
+
+template <typename T> FrameUpload FrameUploadBuffer::Upload(const T &src, const vk::DeviceSize alignment) {
+  return Upload(&src, sizeof(T), alignment);
+}
+}
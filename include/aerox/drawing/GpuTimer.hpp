@@ -0,0 +1,53 @@
+#pragma once
+#include "aerox/containers/Array.hpp"
+#include "aerox/containers/String.hpp"
+#include <vulkan/vulkan.hpp>
+
+namespace aerox::drawing {
+class DrawingSubsystem;
+
+constexpr uint32_t GPU_TIMER_MAX_SCOPES = 64;
+
+struct GpuTiming {
+  String name;
+  double milliseconds = 0;
+};
+
+/**
+ * \brief Measures named scopes of a frame's command buffer with timestamp queries. Results are only read once the frame's fence has
+ * signalled, scopes are dropped when the device has no timestamp support or a frame opens more than GPU_TIMER_MAX_SCOPES.
+ */
+class GpuTimer {
+  vk::Device _device = nullptr;
+  vk::QueryPool _pool = nullptr;
+  // Nanoseconds per timestamp tick
+  double _period = 0;
+  Array<String> _scopes;
+
+public:
+  static constexpr uint32_t INVALID_SCOPE = ~0u;
+
+  void Init(DrawingSubsystem *drawer);
+
+  void Destroy();
+
+  /**
+   * \brief Drops the scopes of the last submission, call at the start of the frame's command buffer outside of rendering
+   */
+  void Reset(vk::CommandBuffer cmd);
+
+  /**
+   * \return Scope to pass to End, INVALID_SCOPE when it is not measured
+   */
+  uint32_t Begin(vk::CommandBuffer cmd, const String &name);
+
+  void End(vk::CommandBuffer cmd, uint32_t scope) const;
+
+  /**
+   * \brief Durations of every scope recorded since the last reset, in the order they began
+   */
+  Array<GpuTiming> Resolve() const;
+
+  bool IsSupported() const;
+};
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "aerox/containers/Array.hpp"
+#include <mutex>
+#include <vulkan/vulkan.hpp>
+
+namespace aerox::drawing {
+struct AllocatedBuffer;
+class DrawingSubsystem;
+
+// Blocks are made of 16 byte vec4 slots
+constexpr uint32_t MATERIAL_SLOT_SIZE = 16;
+constexpr uint32_t MATERIAL_BUFFER_SIZE = 4 * 1024 * 1024;
+
+/**
+ * \brief Part of the material buffer, shaders read it at materials.data[GetIndex()]
+ */
+struct MaterialBlock {
+  uint32_t offset = 0;
+  uint32_t size = 0;
+
+  bool IsValid() const;
+
+  uint32_t GetIndex() const;
+};
+
+/**
+ * \brief Where a named parameter lives in a material's block, in slots
+ */
+struct MaterialParamInfo {
+  uint32_t slot = 0;
+  uint32_t numSlots = 1;
+};
+
+/**
+ * \brief One storage buffer holding the parameters of every material, bound with the bindless textures. Writes go to a cpu copy and
+ * only the ranges that changed are copied to the gpu when a frame starts.
+ */
+class MaterialBuffer {
+  std::shared_ptr<AllocatedBuffer> _buffer;
+  Array<std::byte> _data;
+  // Free ranges sorted by offset, neighbours are merged
+  Array<MaterialBlock> _free;
+  Array<MaterialBlock> _dirty;
+  std::mutex _mutex;
+
+  void RecordBarrier(vk::CommandBuffer cmd, vk::PipelineStageFlags2 srcStages, vk::AccessFlags2 srcAccess,
+                     vk::PipelineStageFlags2 dstStages, vk::AccessFlags2 dstAccess) const;
+
+public:
+  void Init(DrawingSubsystem *drawer);
+
+  void Destroy();
+
+  /**
+   * \brief size is rounded up to whole slots
+   */
+  MaterialBlock Allocate(uint32_t size);
+
+  /**
+   * \brief The block may be handed out again right away, Flush orders new writes after earlier frames are done reading
+   */
+  void Free(MaterialBlock &block);
+
+  void Write(const MaterialBlock &block, const void *src, uint32_t size, uint32_t offset = 0);
+
+  template <typename T>
+  void Write(const MaterialBlock &block, const T &src, uint32_t offset = 0);
+
+  /**
+   * \brief Records copies of every range written since the last flush, before anything reads the buffer this frame
+   */
+  void Flush(vk::CommandBuffer cmd);
+
+  std::shared_ptr<AllocatedBuffer> GetBuffer() const;
+};
+
+template <typename T> void MaterialBuffer::Write(const MaterialBlock &block, const T &src, const uint32_t offset) {
+  Write(block, &src, sizeof(T), offset);
+}
+}
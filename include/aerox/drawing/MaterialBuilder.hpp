@@ -1,4 +1,5 @@
 #pragma once
+#include "MaterialBuffer.hpp"
 #include "PipelineBuilder.hpp"
 #include "types.hpp"
 
@@ -10,6 +11,8 @@ class MaterialBuilder {
   PipelineBuilder _pipelineBuilder;
   DescriptorLayoutBuilder _layoutBuilder;
   Array<std::shared_ptr<Shader>> _shaders;
+  std::unordered_map<std::string, MaterialParamInfo> _params;
+  uint32_t _numParamSlots = 0;
   friend class MaterialInstance;
   
 protected:
@@ -23,6 +26,11 @@ public:
   virtual MaterialBuilder& AddAttachmentFormats(const Array<vk::Format> &formats);
   
   virtual MaterialBuilder& SetType(EMaterialType type);
+
+  /**
+   * \brief Reserves numSlots 16 byte slots for param in each instance's material block, params are laid out in the order they are added
+   */
+  virtual MaterialBuilder& AddParam(const std::string &param, uint32_t numSlots = 1);
   
   virtual std::shared_ptr<MaterialInstance> Create();
 
@@ -19,12 +19,28 @@ class MaterialInstance : public Object {
   vk::Pipeline _pipeline;
   vk::PipelineLayout _pipelineLayout;
   std::unordered_map<RawFrameData *,std::weak_ptr<DescriptorSet>> _dynamicSets;
+  // Draws may be recorded on several threads
+  std::mutex _dynamicSetsMutex;
   std::unordered_map<uint64_t,RawFrameData> _pendingCleanups;
   std::unordered_map<EMaterialSetType,std::weak_ptr<DescriptorSet>> _sets;
   std::unordered_map<EMaterialSetType,vk::DescriptorSetLayout> _layouts;
+  // Bound at EMaterialSetType::Bindless when the shaders index Textures[]
+  vk::DescriptorSet _bindlessSet;
   // vk::DescriptorSetLayout _materialSetLayout;
   EMaterialType _materialType{};
   ShaderResources _shaderResources;
+  bool _bUsesDynamicSet = false;
+  // Parameters in the shared material buffer, shaders read them at materials.data[GetBlockIndex() + slot]
+  MaterialBlock _block;
+  std::unordered_map<std::string,MaterialParamInfo> _params;
+  // Texture params follow their texture to a new bindless index
+  std::unordered_map<std::string,std::pair<std::shared_ptr<Texture>,std::shared_ptr<TDelegateHandle<uint32_t>>>> _textureParams;
+  std::mutex _paramsMutex;
+
+  void WriteParam(const std::string &param, const void *data, uint32_t size);
+
+  // Stops param following a texture, then writes data to it
+  void SetParamData(const std::string &param, const void *data, uint32_t size);
 
   
 public:
@@ -47,6 +63,13 @@ public:
                layouts);
   void SetType(EMaterialType pass);
   void SetResources(const ShaderResources &resources);
+  void SetBindlessSet(vk::DescriptorSet set);
+  void SetUsesDynamicSet(bool bUsesDynamicSet);
+
+  /**
+   * \brief Takes ownership of block, every param lies inside it. The block is cleared.
+   */
+  void SetParams(const std::unordered_map<std::string,MaterialParamInfo> &params, const MaterialBlock &block);
   
   vk::Pipeline GetPipeline() const;
   vk::PipelineLayout GetLayout() const;
@@ -63,16 +86,48 @@ public:
 
   void SetDynamicTexture(RawFrameData *frame, const std::string &param, const std::shared_ptr<Texture> &texture);
 
+  /**
+   * \brief Points a uniform buffer in the dynamic set at memory from the frame's upload buffer, both are reset with the frame
+   */
+  void SetDynamicBuffer(RawFrameData *frame, const std::string &param, const FrameUpload &upload);
+
   void SetTextureArray(const std::string &param, const Array<std::shared_ptr<Texture>> &textures);
   
   void SetBuffer(const std::string &param, const std::shared_ptr<AllocatedBuffer> &buffer, uint32_t
                  offset = 0);
 
+  /**
+   * \brief Writes value to a param declared with MaterialBuilder::AddParam, no descriptor is touched
+   */
+  template <typename T>
+  void SetParam(const std::string &param, const T &value);
+
+  /**
+   * \brief Writes vec4(bindless index, 1, 0, 0) to param, a param never set reads as zeros. The index is rewritten whenever the
+   * texture moves to a new one.
+   */
+  void SetParam(const std::string &param, const std::shared_ptr<Texture> &texture);
+
+  /**
+   * \brief Index of the material's first slot in materials.data, pushed with each draw
+   */
+  uint32_t GetBlockIndex() const;
+
   void BindPipeline(RawFrameData *frame) const;
+  /**
+   * \brief Binds to the frame data's command buffer, which may be a secondary buffer being recorded on another thread
+   */
+  void BindPipeline(const SimpleFrameData *frame) const;
   //void BindCustomSet(RawFrameData *frame, const vk::DescriptorSet set, const uint32_t idx) const;
   void BindSets(RawFrameData *frame);
+  void BindSets(const SimpleFrameData *frame);
 
   void AllocateDynamicSet(RawFrameData *frame);
+
+  /**
+   * \brief This frame's dynamic set, allocated on first use
+   */
+  std::shared_ptr<DescriptorSet> GetDynamicSet(RawFrameData *frame);
   //void Bind(const SceneFrameData * frame) const;
 
   //void Bind(RawFrameData *frame, uint32_t materialSetIndex = 0) const;
@@ -84,6 +139,11 @@ public:
 };
 
 
+template <typename T> void MaterialInstance::SetParam(const std::string &param, const T &value) {
+  static_assert(std::is_trivially_copyable_v<T>, "Params are copied into the material buffer as bytes");
+  SetParamData(param, &value, sizeof(T));
+}
+
 template <typename T> void MaterialInstance::Push(
     const vk::CommandBuffer *cmd, const std::string &param,
     const T &data) {
@@ -5,6 +5,7 @@
 #include "aerox/assets/AssetMeta.hpp"
 #include "aerox/containers/Array.hpp"
 #include "aerox/assets/LiveAsset.hpp"
+#include "aerox/math/Bounds.hpp"
 #include "gen/drawing/Mesh.gen.hpp"
 
 namespace aerox::drawing {
@@ -31,6 +32,18 @@ struct MeshSurface {
 
 VENGINE_SIMPLE_ARRAY_SERIALIZER(Buffer, MeshSurface);
 
+/**
+ * \brief Collision geometry cooked from a mesh when it is imported so physics never has to build it at runtime
+ */
+struct MeshCollisionData {
+  // Triangles with duplicate vertex locations welded, xyz per vertex
+  Array<float> triangleVertices;
+  Array<uint32_t> triangleIndices;
+  // Convex hull, xyz per vertex then per face its vertex count followed by its vertex indices
+  Array<float> hullVertices;
+  Array<uint32_t> hullFaces;
+};
+
 META_TYPE()
 class Mesh : public Object, public assets::LiveAsset, public GpuNative {
 
@@ -40,6 +53,10 @@ protected:
   Array<MeshSurface> _surfaces;
   Array<std::shared_ptr<MaterialInstance>> _materials;
   std::shared_ptr<GpuGeometryBuffers> _gpuData;
+  math::Bounds _bounds;
+  MeshCollisionData _collision;
+
+  void ComputeBounds();
 
 public:
 
@@ -50,12 +67,16 @@ public:
   Array<uint32_t> GetIndices() const;
   Array<MeshSurface> GetSurfaces() const;
   Array<std::weak_ptr<MaterialInstance>> GetMaterials() const;
+  math::Bounds GetBounds() const;
+  const MeshCollisionData &GetCollisionData() const;
+  bool HasCollisionData() const;
 
 
   void SetVertices(const Array<Vertex> &vertices);
   void SetIndices(const Array<uint32_t> &indices);
   void SetSurfaces(const Array<MeshSurface> &surfaces);
   void SetMaterial(uint32_t index, const std::shared_ptr<MaterialInstance> &material);
+  void SetCollisionData(MeshCollisionData collision);
 
   void Upload() override;
   bool IsUploaded() const override;
@@ -0,0 +1,53 @@
+#pragma once
+#include "WindowDrawer.hpp"
+
+namespace aerox::drawing {
+
+constexpr vk::Format OFFSCREEN_FORMAT = vk::Format::eR8G8B8A8Unorm;
+
+/**
+ * \brief A drawn frame copied back to the cpu
+ */
+struct FrameCapture {
+  uint64_t frame = 0;
+  vk::Extent2D extent;
+  // Rows of OFFSCREEN_FORMAT pixels with no padding
+  Array<uint8_t> pixels;
+  Array<GpuTiming> timings;
+};
+
+/**
+ * \brief Draws into images instead of a swapchain, used when the engine runs headless. Every frame's output is copied into a host
+ * visible buffer so it can be read back once the frame has finished.
+ */
+class OffscreenDrawer : public WindowDrawer {
+  vk::Extent2D _extent;
+  std::shared_ptr<AllocatedImage> _targets[FRAME_OVERLAP];
+  std::shared_ptr<AllocatedBuffer> _readbacks[FRAME_OVERLAP];
+
+public:
+  explicit OffscreenDrawer(const vk::Extent2D &extent);
+
+  /**
+   * \param window Unused, there is no window to present to
+   */
+  void OnInit(const std::weak_ptr<window::Window> &window, DrawingSubsystem *drawer) override;
+
+  void CreateResources() override;
+
+  void CreateSwapchain() override;
+
+  void DestroySwapchain() override;
+
+  vk::Extent2D GetSwapchainExtent() const override;
+
+  void Draw(const WindowSnapshot &snapshot) override;
+
+  /**
+   * \brief Waits for the last drawn frame and copies its pixels and pass timings, call on the thread that draws
+   */
+  FrameCapture ReadFrame();
+
+  void OnDestroy() override;
+};
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "types.hpp"
+#include <functional>
+
+namespace aerox::drawing {
+
+// Fewer draws than this are not worth a secondary command buffer
+constexpr size_t MIN_DRAWS_PER_RECORDER = 64;
+
+/**
+ * \brief Splits the draws of one rendering pass over the frame's recording workers. Each batch is recorded into its own secondary command
+ * buffer and they are executed in batch order, so the result does not depend on which worker finished first.
+ */
+class ParallelRecorder {
+  RawFrameData *_frame = nullptr;
+  std::vector<std::pair<size_t, size_t>> _batches;
+
+public:
+  ParallelRecorder(RawFrameData *frame, size_t count, size_t minBatchSize = MIN_DRAWS_PER_RECORDER);
+
+  bool IsParallel() const;
+
+  /**
+   * \brief Flags the pass has to begin rendering with
+   */
+  vk::RenderingFlags GetRenderingFlags() const;
+
+  /**
+   * \brief Records every batch, call between beginning and ending a pass begun with GetRenderingFlags. Records inline into the frame's
+   * command buffer when there is only one batch.
+   * \param colorFormats Color attachment formats of the pass, in order
+   * \param depthFormat Depth attachment format of the pass, undefined if it has none
+   * \param fn Called with the command buffer to record into and [begin,end) of the draws to record, must be safe to call from multiple
+   * threads at once
+   */
+  void Record(const Array<vk::Format> &colorFormats, vk::Format depthFormat,
+              const std::function<void(vk::CommandBuffer *cmd, size_t begin, size_t end)> &fn) const;
+};
+}
@@ -0,0 +1,149 @@
+#pragma once
+#include "Allocator.hpp"
+#include "barriers.hpp"
+#include "aerox/containers/Array.hpp"
+#include "aerox/containers/String.hpp"
+#include <functional>
+#include <vulkan/vulkan.hpp>
+
+namespace aerox::drawing {
+struct RawFrameData;
+class RenderGraphExecutor;
+
+typedef uint32_t graphImageId;
+
+/**
+ * \brief State of an image owned outside the graph
+ */
+struct RenderGraphImport {
+  // Last access before the graph runs, the first barrier waits on it
+  EImageUsage before = EImageUsage::TransferSrc;
+  // The image is left ready for this once the graph has run
+  EImageUsage after = EImageUsage::TransferSrc;
+  // Contents from before the graph are not needed so the first barrier transitions from undefined
+  bool bDiscard = false;
+};
+
+struct RenderGraphImage {
+  String name;
+  vk::Format format = vk::Format::eUndefined;
+  vk::Extent2D extent;
+  vk::ImageAspectFlags aspect;
+  bool bImported = false;
+  RenderGraphImport import;
+  std::shared_ptr<AllocatedImage> image;
+};
+
+struct RenderGraphUse {
+  graphImageId image = 0;
+  EImageUsage usage = EImageUsage::FragmentSampled;
+  bool bRead = false;
+  bool bWrite = false;
+};
+
+typedef std::function<void(RawFrameData *frame, const RenderGraphExecutor &executor)> graphPassFn;
+
+struct RenderGraphPass {
+  String name;
+  Array<RenderGraphUse> uses;
+  graphPassFn fn;
+
+  /**
+   * \brief The pass needs what earlier passes wrote to image
+   */
+  RenderGraphPass &Read(graphImageId image, EImageUsage usage);
+
+  /**
+   * \brief The pass produces image, without a matching Read earlier contents are discarded
+   */
+  RenderGraphPass &Write(graphImageId image, EImageUsage usage);
+
+private:
+  RenderGraphPass &Use(graphImageId image, EImageUsage usage, bool bRead, bool bWrite);
+};
+
+struct RenderGraphBarrier {
+  graphImageId image = 0;
+  vk::PipelineStageFlags2 srcStages;
+  vk::AccessFlags2 srcAccess;
+  vk::PipelineStageFlags2 dstStages;
+  vk::AccessFlags2 dstAccess;
+  vk::ImageLayout oldLayout = vk::ImageLayout::eUndefined;
+  vk::ImageLayout newLayout = vk::ImageLayout::eUndefined;
+};
+
+struct CompiledRenderGraphPass {
+  // Index of the pass in the graph
+  uint32_t pass = 0;
+  // Issued together before the pass runs
+  Array<RenderGraphBarrier> barriers;
+};
+
+struct CompiledRenderGraphImage {
+  bool bUsed = false;
+  // Every access the surviving passes make, transient images are created with it
+  vk::ImageUsageFlags usage;
+  // Compiled pass indices of the first and last use
+  uint32_t firstUse = 0;
+  uint32_t lastUse = 0;
+  // Transient images only, where the image lives in the shared heap
+  vk::MemoryRequirements requirements;
+  vk::DeviceSize offset = 0;
+};
+
+struct CompiledRenderGraph {
+  // Surviving passes in the order they run
+  Array<CompiledRenderGraphPass> passes;
+  // Leave imported images in the state they were imported with
+  Array<RenderGraphBarrier> finalBarriers;
+  // Indexed by graphImageId
+  Array<CompiledRenderGraphImage> images;
+  vk::DeviceSize heapSize = 0;
+  vk::DeviceSize heapAlignment = 1;
+  uint32_t heapMemoryTypes = ~0u;
+  uint32_t numCulled = 0;
+};
+
+/**
+ * \brief Returns the memory an image needs when created with usage
+ */
+typedef std::function<vk::MemoryRequirements(const RenderGraphImage &image, vk::ImageUsageFlags usage)> graphRequirementsFn;
+
+/**
+ * \brief Passes of one frame along with the images they read and write. Compiling culls passes nothing uses, places the barriers between
+ * passes and packs transient images whose lifetimes do not overlap into the same memory. Compiling makes no device calls.
+ */
+class RenderGraph {
+  Array<RenderGraphImage> _images;
+  Array<RenderGraphPass> _passes;
+
+public:
+  /**
+   * \brief An image that only lives while the graph runs, its memory may be shared with other transient images
+   */
+  graphImageId CreateImage(const String &name, vk::Format format, vk::Extent2D extent,
+                           vk::ImageAspectFlags aspect = vk::ImageAspectFlagBits::eColor);
+
+  /**
+   * \brief An image owned outside the graph, passes writing it are never culled
+   */
+  graphImageId ImportImage(const String &name, const std::shared_ptr<AllocatedImage> &image, const RenderGraphImport &import,
+                           vk::ImageAspectFlags aspect = vk::ImageAspectFlagBits::eColor);
+
+  /**
+   * \brief Passes run in the order they are added, the returned pass is only valid until the next one is added
+   */
+  RenderGraphPass &AddPass(const String &name, graphPassFn fn);
+
+  const Array<RenderGraphImage> &GetImages() const;
+
+  const Array<RenderGraphPass> &GetPasses() const;
+
+  CompiledRenderGraph Compile(const graphRequirementsFn &getRequirements) const;
+
+  /**
+   * \brief Replays compiled through a BarrierValidator, returns every hazard it finds. Transient images are checked within the frame only.
+   */
+  Array<String> Validate(const CompiledRenderGraph &compiled) const;
+};
+}
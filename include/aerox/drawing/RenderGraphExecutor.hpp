@@ -0,0 +1,63 @@
+#pragma once
+#include "RenderGraph.hpp"
+
+namespace aerox::drawing {
+class DrawingSubsystem;
+
+/**
+ * \brief Runs compiled render graphs and owns the memory their transient images share. Images are only recreated when the graph's
+ * transient images or their placement change, which waits for the device first.
+ */
+class RenderGraphExecutor {
+  struct TransientKey {
+    vk::Format format = vk::Format::eUndefined;
+    vk::Extent2D extent;
+    vk::ImageAspectFlags aspect;
+    vk::ImageUsageFlags usage;
+    vk::DeviceSize offset = 0;
+    bool bUsed = false;
+
+    bool operator==(const TransientKey &other) const;
+  };
+
+  struct CachedRequirements {
+    vk::Format format = vk::Format::eUndefined;
+    vk::Extent2D extent;
+    vk::ImageUsageFlags usage;
+    vk::MemoryRequirements requirements;
+  };
+
+  DrawingSubsystem *_drawer = nullptr;
+  std::shared_ptr<VmaAllocated> _heap;
+  Array<TransientKey> _keys;
+  Array<std::shared_ptr<AllocatedImage>> _images;
+  Array<CachedRequirements> _requirements;
+  uint64_t _generation = 0;
+
+  vk::MemoryRequirements GetRequirements(const RenderGraphImage &image, vk::ImageUsageFlags usage);
+
+  void CreateTransients(const RenderGraph &graph, const CompiledRenderGraph &compiled);
+
+  void IssueBarriers(vk::CommandBuffer cmd, const RenderGraph &graph, const Array<RenderGraphBarrier> &barriers) const;
+
+public:
+  void Init(DrawingSubsystem *drawer);
+
+  void Destroy();
+
+  /**
+   * \brief Compiles graph then records its surviving passes into the frame's command buffer
+   */
+  void Execute(RawFrameData *frame, const RenderGraph &graph);
+
+  /**
+   * \brief The image behind id for the graph being executed, empty for images no surviving pass uses
+   */
+  std::shared_ptr<AllocatedImage> GetImage(graphImageId id) const;
+
+  /**
+   * \brief Changes whenever transient images are recreated, descriptors written with them have to be written again
+   */
+  uint64_t GetGeneration() const;
+};
+}
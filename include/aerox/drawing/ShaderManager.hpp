@@ -20,6 +20,8 @@ class GlslShaderIncluder : public glslang::TShader::Includer {
   Set<IncludeResult *> _results;
   ShaderManager * _manager = nullptr;
   bool _bDebug = false;
+
+  IncludeResult *MakeResult(const std::string &name,const std::string &content);
 public:
   GlslShaderIncluder(ShaderManager * manager,const fs::path &inPath);
 
@@ -37,6 +39,8 @@ META_TYPE()
 class ShaderManager : public TOwnedBy<DrawingSubsystem>, public WithLogger {
 
   std::map<fs::path,std::shared_ptr<Shader>> _shaders;
+  // Includes built in code instead of read from disk, by name
+  std::map<std::string,std::string> _generatedIncludes;
   
 public:
   META_BODY()
@@ -48,6 +52,18 @@ public:
   std::shared_ptr<Shader> GetLoadedShader(
       const fs::path &shaderPath) const;
   
+  /**
+   * \brief Serves content to any shader including name, compiled shaders are invalidated when it changes
+   */
+  void SetGeneratedInclude(const std::string &name,const std::string &content);
+
+  const std::string * GetGeneratedInclude(const std::string &name) const;
+
+  /**
+   * \brief Hash of the source and every generated include, compiled shaders are reused while it stays the same
+   */
+  std::string HashSource(const fs::path &shaderPath) const;
+  
   Array<unsigned int> Compile(const fs::path &shaderPath);
 
   Array<unsigned int> CompileAndSave(const fs::path &shaderPath);
@@ -0,0 +1,120 @@
+#pragma once
+#include "aerox/containers/Array.hpp"
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vulkan/vulkan.hpp>
+
+namespace aerox::drawing {
+struct AllocatedBuffer;
+struct AllocatedImage;
+class DrawingSubsystem;
+
+constexpr vk::DeviceSize STAGING_RING_SIZE = 64 * 1024 * 1024;
+
+/**
+ * \brief Copies cpu data into device local buffers and images without waiting for the copies. Uploads are staged in a ring buffer and
+ * recorded into a batch that is submitted on Flush, on a dedicated transfer queue when the device has one. Each batch signals a timeline
+ * value once its resources may be used on the graphics queue, frames wait on the last value submitted before they were.
+ */
+class StagingUploader {
+  struct Batch {
+    uint64_t value = 0;
+    vk::CommandBuffer transferCmd = nullptr;
+    // Acquires ownership and generates mips, only used with a dedicated transfer queue
+    vk::CommandBuffer graphicsCmd = nullptr;
+    // Ring position after the batch's last allocation, everything before it is free once the batch completes
+    vk::DeviceSize ringEnd = 0;
+    // Destinations and oversized staging buffers live until the batch completes
+    Array<std::shared_ptr<void>> keepAlive;
+    uint32_t numUploads = 0;
+  };
+
+  DrawingSubsystem *_drawer = nullptr;
+  vk::Device _device = nullptr;
+  vk::Queue _transferQueue = nullptr;
+  uint32_t _transferFamily = 0;
+  uint32_t _graphicsFamily = 0;
+  bool _bDedicatedTransfer = false;
+
+  vk::CommandPool _transferPool = nullptr;
+  vk::CommandPool _graphicsPool = nullptr;
+  Array<vk::CommandBuffer> _freeTransferCmds;
+  Array<vk::CommandBuffer> _freeGraphicsCmds;
+
+  // Signalled with a batch's value once it is usable on the graphics queue
+  vk::Semaphore _timeline = nullptr;
+  // Signalled by the transfer queue, the graphics queue waits on it before acquiring
+  vk::Semaphore _transferTimeline = nullptr;
+
+  std::shared_ptr<AllocatedBuffer> _ring;
+  std::byte *_ringData = nullptr;
+  vk::DeviceSize _ringAlignment = 16;
+  // Positions only ever grow, the ring offset is position % STAGING_RING_SIZE
+  vk::DeviceSize _ringHead = 0;
+  vk::DeviceSize _ringTail = 0;
+
+  Batch _recording;
+  std::deque<Batch> _inFlight;
+  uint64_t _nextValue = 1;
+  std::atomic<uint64_t> _submittedValue = 0;
+  std::mutex _mutex;
+
+  vk::CommandBuffer TakeCmd(vk::CommandPool pool, Array<vk::CommandBuffer> &free) const;
+
+  void BeginBatch();
+
+  vk::CommandBuffer GetGraphicsCmd() const;
+
+  /**
+   * \brief Reserves staging memory in the ring, submitting and waiting on earlier batches when it is full
+   * \return Buffer and offset to copy from
+   */
+  std::pair<vk::Buffer, vk::DeviceSize> Stage(const void *data, vk::DeviceSize size);
+
+  void SubmitLocked();
+
+  void ReclaimLocked();
+
+public:
+  /**
+   * \param transferQueue Dedicated transfer queue, null uploads on the graphics queue
+   */
+  void Init(DrawingSubsystem *drawer, vk::Queue transferQueue, uint32_t transferFamily);
+
+  void Destroy();
+
+  /**
+   * \return Timeline value the copy completes with
+   */
+  uint64_t UploadBuffer(const std::shared_ptr<AllocatedBuffer> &dst, const void *data, vk::DeviceSize size,
+                        vk::DeviceSize dstOffset = 0);
+
+  /**
+   * \brief Uploads mip 0 and generates the rest on the graphics queue, the image ends up ready to be sampled
+   * \return Timeline value the copy completes with
+   */
+  uint64_t UploadImage(const std::shared_ptr<AllocatedImage> &dst, const void *data, vk::DeviceSize size, bool mipMapped,
+                       vk::Filter mipMapFilter = vk::Filter::eLinear);
+
+  /**
+   * \brief Submits everything uploaded since the last flush
+   * \return The last submitted timeline value
+   */
+  uint64_t Flush();
+
+  bool IsComplete(uint64_t value) const;
+
+  /**
+   * \brief Blocks until value completes, flushing first if it has not been submitted
+   */
+  void Wait(uint64_t value);
+
+  vk::Semaphore GetSemaphore() const;
+
+  uint64_t GetSubmittedValue() const;
+
+  bool HasDedicatedTransferQueue() const;
+};
+}
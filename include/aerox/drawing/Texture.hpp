@@ -1,4 +1,5 @@
 #pragma once
+#include "BindlessTextures.hpp"
 #include "GpuNative.hpp"
 #include "aerox/Object.hpp"
 #include "aerox/assets/AssetMeta.hpp"
@@ -32,17 +33,30 @@ class Texture : public TOwnedBy<DrawingSubsystem>, public assets::LiveAsset, pub
   bool _mipMapped = true;
   
   std::vector<unsigned char> _data;
+
+  uint32_t _bindlessIndex = INVALID_BINDLESS_INDEX;
   
   void MakeSampler();
 
+  // Moves the texture to a bindless slot for the current image and sampler, the old slot, image and sampler are retired together
+  void UpdateBindless(std::shared_ptr<AllocatedImage> oldImage, vk::Sampler oldSampler);
+
 public:
 
   META_BODY()
+
+  // Called with the new index whenever the texture moves to another bindless slot
+  DECLARE_DELEGATE(onBindlessIndexChanged, uint32_t)
   
   vk::Extent3D GetSize() const;
   
   std::weak_ptr<AllocatedImage> GetGpuData() const;
   vk::Sampler GetSampler() const;
+
+  /**
+   * \brief Index of the texture in Textures[], uploads the texture if it is not yet
+   */
+  uint32_t GetBindlessIndex();
   void SetMipMapped(bool newMipMapped);
 
   bool IsMipMapped() const;
@@ -28,6 +28,18 @@ protected:
   bool _isReady = false;
 
   vk::Viewport _viewport;
+  // Scopes measured in the last frame whose fence was waited on
+  Array<GpuTiming> _passTimings;
+
+  /**
+   * \brief Waits for the frame's last submission then resets everything it used
+   */
+  virtual void BeginFrame(RawFrameData *frame);
+
+  /**
+   * \brief Records the snapshot's scenes and ui into the frame's begun command buffer
+   */
+  virtual void RecordSnapshot(RawFrameData *frame, const WindowSnapshot &snapshot);
   
 public:
 
@@ -49,20 +61,37 @@ public:
   
   vk::SurfaceKHR GetSurface() const;
 
-  vk::Extent2D GetSwapchainExtent() const;
+  virtual vk::Extent2D GetSwapchainExtent() const;
 
   vk::Extent2D GetSwapchainExtentScaled() const;
 
   vk::Format GetSwapchainFormat() const;
 
+  /**
+   * \brief Current viewport on the game thread, recording reads the copy taken with its snapshot instead
+   */
   vk::Viewport GetViewport() const;
 
+  /**
+   * \brief Gpu time of every render graph pass in a recent frame, read on the render thread or with a frame latency of 0
+   */
+  Array<GpuTiming> GetPassTimings() const;
+
   DECLARE_DELEGATE(onResizeScenes)
   DECLARE_DELEGATE(onResizeUi)
-  DECLARE_DELEGATE(onDrawScenes,RawFrameData *)
-  DECLARE_DELEGATE(onDrawUi,RawFrameData *)
-
-  virtual void Draw();
+  // Called on the game thread to add to this window's snapshot
+  DECLARE_DELEGATE(onCollectScenes,WindowSnapshot *)
+  DECLARE_DELEGATE(onCollectUi,WindowSnapshot *)
+
+  /**
+   * \brief Lets scenes and ui add what they will draw to snapshot, runs on the game thread
+   */
+  virtual void Collect(WindowSnapshot &snapshot);
+
+  /**
+   * \brief Records and presents snapshot, runs on the render thread
+   */
+  virtual void Draw(const WindowSnapshot &snapshot);
 
   void OnDestroy() override;
 };
@@ -0,0 +1,38 @@
+#pragma once
+#include "aerox/containers/Array.hpp"
+#include "aerox/containers/TRecycledList.hpp"
+#include <vulkan/vulkan.hpp>
+
+namespace aerox::drawing {
+
+/**
+ * \brief One command pool per recording worker for a frame in flight, so workers allocate secondary command buffers without locking.
+ * Buffers are kept and handed out again after the frame's pools are reset.
+ */
+class WorkerCommandPools {
+  struct Pool {
+    vk::CommandPool pool;
+    TRecycledList<vk::CommandBuffer> buffers;
+  };
+
+  vk::Device _device = nullptr;
+  Array<Pool> _pools;
+
+public:
+  void Init(vk::Device device, uint32_t queueFamily, uint32_t numWorkers);
+
+  void Destroy();
+
+  /**
+   * \brief Resets every pool that was used, only call once the frame's previous submission has finished
+   */
+  void Reset();
+
+  /**
+   * \brief Returns an unused secondary buffer from worker's pool, allocating one if all are in use. Only one thread may use a worker at a time.
+   */
+  vk::CommandBuffer Allocate(uint32_t worker);
+
+  uint32_t GetNumWorkers() const;
+};
+}
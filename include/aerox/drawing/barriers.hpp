@@ -0,0 +1,124 @@
+#pragma once
+#include "aerox/containers/Array.hpp"
+#include "aerox/containers/String.hpp"
+#include <unordered_map>
+#include <variant>
+#include <vulkan/vulkan.hpp>
+
+namespace aerox::drawing {
+
+/**
+ * \brief How an image is used, barriers between two usages take their stages, access and layouts from here
+ */
+enum class EImageUsage : uint8_t {
+  // Contents are not needed, only valid as the usage an image comes from
+  Undefined,
+  ColorAttachmentWrite,
+  DepthAttachmentWrite,
+  DepthAttachmentRead,
+  FragmentSampled,
+  ComputeSampled,
+  TransferSrc,
+  TransferDst,
+  Present
+};
+
+struct ImageUsageInfo {
+  vk::PipelineStageFlags2 stages;
+  vk::AccessFlags2 access;
+  vk::ImageLayout layout;
+  vk::ImageUsageFlags usage;
+  bool bWrite = false;
+};
+
+const ImageUsageInfo &getUsageInfo(EImageUsage usage);
+
+/**
+ * \brief Only the parts of access that write
+ */
+vk::AccessFlags2 getWriteAccess(vk::AccessFlags2 access);
+
+/**
+ * \brief Barrier making an image that was used as from ready to be used as to
+ * \param waitStages Extra stages to wait on, like the stage a semaphore the submission waits on was waited at
+ * \param bDiscard The contents are not needed, transitions from undefined while still waiting on from
+ */
+vk::ImageMemoryBarrier2 makeImageBarrier(vk::Image image, EImageUsage from, EImageUsage to,
+                                         const std::variant<vk::ImageSubresourceRange, vk::ImageAspectFlags> &resourceOrAspect =
+                                             vk::ImageAspectFlagBits::eColor,
+                                         vk::PipelineStageFlags2 waitStages = {}, bool bDiscard = false);
+
+/**
+ * \brief Collects image barriers and records them with a single pipelineBarrier2
+ */
+class ImageBarriers {
+  Array<vk::ImageMemoryBarrier2> _barriers;
+
+public:
+  ImageBarriers &Add(vk::Image image, EImageUsage from, EImageUsage to,
+                     const std::variant<vk::ImageSubresourceRange, vk::ImageAspectFlags> &resourceOrAspect =
+                         vk::ImageAspectFlagBits::eColor,
+                     vk::PipelineStageFlags2 waitStages = {});
+
+  /**
+   * \brief Like Add but the contents are thrown away, for images that are overwritten every frame
+   */
+  ImageBarriers &Discard(vk::Image image, EImageUsage from, EImageUsage to,
+                         const std::variant<vk::ImageSubresourceRange, vk::ImageAspectFlags> &resourceOrAspect =
+                             vk::ImageAspectFlagBits::eColor,
+                         vk::PipelineStageFlags2 waitStages = {});
+
+  ImageBarriers &Add(const vk::ImageMemoryBarrier2 &barrier);
+
+  const Array<vk::ImageMemoryBarrier2> &GetBarriers() const;
+
+  bool IsEmpty() const;
+
+  /**
+   * \brief Records every barrier added so far then clears them
+   */
+  void Record(vk::CommandBuffer cmd);
+};
+
+/**
+ * \brief Records a single barrier
+ */
+void transitionImage(vk::CommandBuffer cmd, vk::Image image, EImageUsage from, EImageUsage to,
+                     const std::variant<vk::ImageSubresourceRange, vk::ImageAspectFlags> &resourceOrAspect =
+                         vk::ImageAspectFlagBits::eColor);
+
+/**
+ * \brief Replays barriers and accesses on the CPU and reports every access that is not synchronized with the ones before it. Images are
+ * identified by any number that is unique to them.
+ */
+class BarrierValidator {
+  struct ImageState {
+    vk::ImageLayout layout = vk::ImageLayout::eUndefined;
+    // The last write or layout transition
+    vk::PipelineStageFlags2 writeStages;
+    vk::AccessFlags2 writeAccess;
+    bool bAvailable = true;
+    // Stages and access the last write is visible to
+    vk::PipelineStageFlags2 visibleStages;
+    vk::AccessFlags2 visibleAccess;
+    // Reads since the last write and the stages that wait on all of them
+    vk::PipelineStageFlags2 readStages;
+    vk::PipelineStageFlags2 readsWaitedBy;
+  };
+
+  std::unordered_map<uint64_t, ImageState> _images;
+  Array<String> _hazards;
+
+public:
+  /**
+   * \brief The image starts out already used as usage
+   */
+  void Assume(uint64_t image, EImageUsage usage);
+
+  void Barrier(uint64_t image, const vk::ImageMemoryBarrier2 &barrier);
+
+  void Access(uint64_t image, EImageUsage usage, const String &what = "");
+
+  const Array<String> &GetHazards() const;
+};
+}
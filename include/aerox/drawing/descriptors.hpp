@@ -14,29 +14,117 @@ struct AllocatedImage;
 
 namespace aerox::drawing {
 struct AllocatedBuffer;
+struct FrameUpload;
 class DrawingSubsystem;
 class Texture;
 
 
 typedef std::variant<std::monostate,std::shared_ptr<AllocatedBuffer>,std::shared_ptr<AllocatedImage>,std::shared_ptr<Texture>,Array<std::shared_ptr<Texture>>> descriptorResource;
+
+/**
+ * \brief Totals across every descriptor set
+ */
+struct DescriptorWriteStats {
+  // Bindings written to the device
+  uint64_t issued = 0;
+  // Writes dropped because the binding already held the same descriptors or was written again before a flush
+  uint64_t skipped = 0;
+  // updateDescriptorSets calls
+  uint64_t flushes = 0;
+};
+
+/**
+ * \brief Descriptors of one binding along with the resources they keep alive
+ */
+struct DescriptorWrite {
+  vk::DescriptorType type{};
+  Array<vk::DescriptorImageInfo> images;
+  Array<vk::DescriptorBufferInfo> buffers;
+  descriptorResource resource;
+
+  bool HasSameDescriptors(const DescriptorWrite &other) const;
+};
+
+/**
+ * \brief Writes are queued and combined, Flush sends every changed binding to the device in one call. Writes matching what the binding
+ * already holds never reach the device. Sets with queued writes are flushed together when a frame starts recording, sets that are not
+ * update-after-bind only once every frame that bound them is done.
+ */
 META_TYPE()
 class DescriptorSet : meta::IMetadata {
   vk::Device _device;
   vk::DescriptorSet _set;
   std::mutex _mutex;
-  std::unordered_map<uint32_t,descriptorResource> _resources;
+  std::unordered_map<uint32_t,DescriptorWrite> _bound;
+  std::unordered_map<uint32_t,DescriptorWrite> _pending;
+  // Set while writes are queued, lets binds skip the lock when there is nothing to flush
+  std::atomic<bool> _bPending = false;
+  bool _bUpdateAfterBind = true;
+  // Id of the last frame that bound the set, 0 if none did
+  std::atomic<uint64_t> _lastUse = 0;
+
+  // Every frame up to this id has finished on the gpu
+  static std::atomic<uint64_t> _completedFrame;
+
+  // Sets that queued writes since the last FlushAll
+  static std::mutex _queuedSetsMutex;
+  static std::vector<DescriptorSet *> _queuedSets;
+
+  static std::atomic<uint64_t> _writesIssued;
+  static std::atomic<uint64_t> _writesSkipped;
+  static std::atomic<uint64_t> _flushes;
+
+  void Queue(uint32_t binding,DescriptorWrite &&write);
 
 public:
 
   META_BODY()
   
-  DescriptorSet(const vk::Device &device,const vk::DescriptorSet &set);
+  DescriptorSet(const vk::Device &device,const vk::DescriptorSet &set,bool bUpdateAfterBind = true);
   ~DescriptorSet();
   operator vk::DescriptorSet() const;
 
+  /**
+   * \brief Writes every queued binding, called before the set is bound. Check CanFlush first.
+   */
+  void Flush();
+
+  /**
+   * \brief Writes may reach the device now. Update-after-bind sets always may, others once no frame in flight bound them.
+   */
+  bool CanFlush() const;
+
+  /**
+   * \brief Called whenever the set is bound while recording frameId
+   */
+  void MarkUsed(uint64_t frameId);
+
+  /**
+   * \brief frameId and every frame before it finished on the gpu, called once its fence has signalled
+   */
+  static void CompleteFrame(uint64_t frameId);
+
+  /**
+   * \brief Writes were queued since the last flush, safe to call without holding the set
+   */
+  bool HasPendingWrites() const;
+
+  /**
+   * \brief Flushes every set with queued writes that CanFlush, called once when a frame starts recording on the render thread. The rest
+   * stay queued for a later frame.
+   */
+  static void FlushAll();
+
+  static DescriptorWriteStats GetWriteStats();
+
   void WriteBuffer(uint32_t binding, const std::shared_ptr<AllocatedBuffer> &buffer, size_t
                    offset, vk::DescriptorType type);
 
+  /**
+   * \brief The upload's memory belongs to its frame, only write it to sets that are reset with that frame
+   */
+  void WriteBuffer(uint32_t binding, const FrameUpload &upload, vk::DescriptorType type);
+
   void WriteImage(uint32_t binding, const std::shared_ptr<AllocatedImage> &image, vk::Sampler
                   sampler, vk::ImageLayout layout, vk::DescriptorType type);
   
@@ -46,6 +134,9 @@ public:
   void WriteTextureArray(uint32_t binding, const Array<std::shared_ptr<Texture>> &textures, vk::ImageLayout
                          layout, const vk::DescriptorType type);
 
+  /**
+   * \brief The binding was written, even if the write is still queued
+   */
   bool IsBound(uint32_t binding) const;
 };
 
@@ -54,7 +145,10 @@ struct DescriptorLayoutBuilder {
 
   DescriptorLayoutBuilder& AddBinding(uint32_t binding,vk::DescriptorType type,vk::ShaderStageFlags stages,uint32_t count = 1);
   DescriptorLayoutBuilder& Clear();
-  vk::DescriptorSetLayout Build();
+  /**
+   * \param bUpdateAfterBind Bindings may be written while a recording command buffer has the set bound
+   */
+  vk::DescriptorSetLayout Build(bool bUpdateAfterBind = true);
 };
 
 
@@ -98,14 +192,17 @@ public:
   void Init(vk::Device device,uint32_t maxSets, std::span<PoolSizeRatio> poolRatios);
   void ClearPools();
   void DestroyPools();
-  std::weak_ptr<DescriptorSet> Allocate(vk::DescriptorSetLayout layout);
+  /**
+   * \param bUpdateAfterBind Whether layout was built update-after-bind
+   */
+  std::weak_ptr<DescriptorSet> Allocate(vk::DescriptorSetLayout layout, bool bUpdateAfterBind = true);
 private:
   std::atomic<uint64_t> _lastPoolId = 0;
   
   void ClearDescriptorsFromPool(DescriptorPoolWithId pool);
   DescriptorPoolWithId GetPool();
   DescriptorPoolWithId CreatePool(uint32_t setCount, std::span<PoolSizeRatio> poolRatios);
-  std::shared_ptr<DescriptorSet> DescriptorSetToPtr(const vk::DescriptorSet &set) const;
+  std::shared_ptr<DescriptorSet> DescriptorSetToPtr(const vk::DescriptorSet &set, bool bUpdateAfterBind) const;
   vk::Device _device;
   Array<PoolSizeRatio> _ratios;
   Array<DescriptorPoolWithId> _fullPools;
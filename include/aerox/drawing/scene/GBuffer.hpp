@@ -0,0 +1,69 @@
+#pragma once
+#include "aerox/containers/Array.hpp"
+#include "aerox/drawing/RenderGraph.hpp"
+#include <string>
+#include <vulkan/vulkan.hpp>
+
+namespace aerox::drawing {
+
+/**
+ * \brief Color targets of the G-buffer, the value is the attachment location and the lighting pass binding
+ */
+enum class EGBufferTarget : uint8_t {
+  // rgb base color, stored as srgb
+  Albedo,
+  // Octahedral encoded world normal
+  Normal,
+  // roughness, metallic, specular and emissive intensity
+  Material,
+  Count
+};
+
+struct GBufferTargetInfo {
+  const char *name;
+  vk::Format format;
+  // Glsl type of the fragment output
+  const char *outputType;
+  // Fragment output written by the base pass
+  const char *output;
+  // Sampler read by the lighting pass
+  const char *sampler;
+};
+
+constexpr vk::Format GBUFFER_DEPTH_FORMAT = vk::Format::eD32Sfloat;
+
+// Sampler the lighting pass reconstructs positions from, bound after the color targets
+constexpr auto GBUFFER_DEPTH_SAMPLER = "TDepth";
+
+// Emissive color is the albedo scaled by the stored intensity times this
+constexpr float GBUFFER_EMISSIVE_RANGE = 16.0f;
+
+/**
+ * \brief Layout of every color target, indexed by EGBufferTarget
+ */
+const GBufferTargetInfo &getGBufferTarget(EGBufferTarget target);
+
+Array<vk::Format> getGBufferFormats();
+
+/**
+ * \brief Glsl declaring the G-buffer outputs, or the lighting samplers when GBUFFER_OUTPUTS is not defined. Shaders include it as
+ * "gbuffer_layout.glsl" so they always match the formats above.
+ */
+std::string makeGBufferGlsl();
+
+/**
+ * \brief Transient G-buffer images of one frame's render graph
+ */
+struct GBuffer {
+  // Indexed by EGBufferTarget, which is also attachment order
+  Array<graphImageId> targets;
+  graphImageId depth = 0;
+
+  /**
+   * \brief Adds every target and depth to graph as transient images
+   */
+  static GBuffer Create(RenderGraph &graph, vk::Extent2D extent);
+
+  graphImageId Get(EGBufferTarget target) const;
+};
+}
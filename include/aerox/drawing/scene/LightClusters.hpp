@@ -0,0 +1,86 @@
+#pragma once
+#include "aerox/containers/Array.hpp"
+#include "aerox/math/Bounds.hpp"
+#include <glm/glm.hpp>
+
+namespace aerox::drawing {
+
+constexpr uint32_t LIGHT_CLUSTERS_X = 16;
+constexpr uint32_t LIGHT_CLUSTERS_Y = 9;
+constexpr uint32_t LIGHT_CLUSTERS_Z = 24;
+// Lights past this count in a single cluster are dropped
+constexpr uint32_t MAX_LIGHTS_PER_CLUSTER = 128;
+
+/**
+ * \brief Froxel grid for clustered shading. Screen tiles are split into depth slices that grow exponentially from the near plane and lights
+ * are binned into them on the cpu. The result is laid out as an [offset,count] pair for every cluster, one more pair for lights that reach
+ * everywhere and then the light indices the pairs point into.
+ */
+class LightClusters {
+  struct LightRange {
+    uint32_t minX = 0;
+    uint32_t maxX = 0;
+    uint32_t minY = 0;
+    uint32_t maxY = 0;
+    uint32_t minZ = 0;
+    uint32_t maxZ = 0;
+    bool bVisible = false;
+  };
+
+  uint32_t _sizeX;
+  uint32_t _sizeY;
+  uint32_t _sizeZ;
+  float _near = 0.0f;
+  float _far = 0.0f;
+  glm::mat4 _projection{0.0f};
+  glm::vec3 _forward{0.0f, 0.0f, 1.0f};
+  Array<math::Bounds> _bounds;
+  std::vector<LightRange> _ranges;
+  Array<uint32_t> _counts;
+  Array<uint32_t> _indices;
+  Array<uint32_t> _data;
+
+  LightRange ComputeRange(const math::Sphere &light) const;
+
+public:
+  LightClusters(uint32_t sizeX = LIGHT_CLUSTERS_X, uint32_t sizeY = LIGHT_CLUSTERS_Y, uint32_t sizeZ = LIGHT_CLUSTERS_Z);
+
+  /**
+   * \brief Recomputes the view space bounds of every cluster, does nothing if the projection and depth range did not change
+   */
+  void Build(const glm::mat4 &projection, float near, float far);
+
+  /**
+   * \brief Bins lights into clusters, work is split across the async subsystem by depth slice
+   * \param lights View space spheres, lights with a radius <= 0 reach everywhere and are put in the global list
+   * \param ids Value written to the lists for each light, the light's index is used when empty
+   */
+  void Assign(const Array<math::Sphere> &lights, const Array<uint32_t> &ids = {});
+
+  uint32_t GetNumClusters() const;
+
+  glm::uvec3 GetGridSize() const;
+
+  /**
+   * \brief View space direction depth is measured along
+   */
+  glm::vec3 GetForward() const;
+
+  /**
+   * \brief near, far, scale and bias where slice = log(depth) * scale + bias
+   */
+  glm::vec4 GetDepthParams() const;
+
+  uint32_t GetSlice(float depth) const;
+
+  uint32_t GetClusterIndex(uint32_t x, uint32_t y, uint32_t z) const;
+
+  const math::Bounds &GetClusterBounds(uint32_t cluster) const;
+
+  const Array<uint32_t> &GetData() const;
+
+  Array<uint32_t> GetLights(uint32_t cluster) const;
+
+  Array<uint32_t> GetGlobalLights() const;
+};
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include "types.hpp"
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace aerox::scene {
+class LightComponent;
+}
+
+namespace aerox::drawing {
+
+/**
+ * \brief Dirty lights copied out of a LightStore so they can be written to the gpu later, from another thread
+ */
+struct LightUpload {
+  // First slot and slot count of each contiguous run, the lights of every run are packed in order
+  Array<std::pair<uint32_t, uint32_t>> runs;
+  Array<GpuLight> lights;
+
+  /**
+   * \brief Writes every run to its slots in buffer
+   * \return Number of bytes written
+   */
+  size_t Write(const AllocatedBuffer &buffer) const;
+};
+
+/**
+ * \brief Keeps every scene light in a stable slot of a gpu light array. Light info is only recomputed when a light's version changes and
+ * only the slots that changed are uploaded.
+ */
+class LightStore {
+  struct Slot {
+    std::weak_ptr<scene::LightComponent> light;
+    scene::LightComponent *key = nullptr;
+    uint64_t version = 0;
+    bool bDirty = false;
+  };
+
+  std::vector<Slot> _slots;
+  std::vector<GpuLight> _lights;
+  std::unordered_map<scene::LightComponent *, uint32_t> _slotMap;
+  Array<uint32_t> _freeSlots;
+  Array<uint32_t> _usedSlots;
+  uint32_t _numSlots = 0;
+  uint32_t _capacity;
+  bool _bLayoutChanged = true;
+  // Runs of uploads that were never written, any thread may add to them
+  std::mutex _restoreMutex;
+  Array<std::pair<uint32_t, uint32_t>> _restoredRuns;
+
+  void FreeSlot(uint32_t slot);
+
+  void ApplyRestored();
+
+public:
+  explicit LightStore(uint32_t capacity = MAX_SCENE_LIGHTS);
+
+  /**
+   * \brief Adds new lights, frees slots of destroyed lights and refreshes lights whose version changed
+   */
+  void Update(const std::list<std::weak_ptr<scene::LightComponent>> &lights);
+
+  /**
+   * \brief Copies all dirty slots into upload and clears them, contiguous slots become one run
+   */
+  void TakeDirty(LightUpload &upload);
+
+  /**
+   * \brief Marks the slots of an upload that was dropped before it was written dirty again, they are taken with their current info by
+   * the next Update. Safe to call from any thread.
+   */
+  void Restore(const LightUpload &upload);
+
+  /**
+   * \brief Writes all dirty slots to buffer, contiguous slots are written together
+   * \return Number of bytes written
+   */
+  size_t Upload(const AllocatedBuffer &buffer);
+
+  /**
+   * \brief Slots currently holding a light, in slot order
+   */
+  const Array<uint32_t> &GetUsedSlots() const;
+
+  const GpuLight &GetLight(uint32_t slot) const;
+
+  /**
+   * \brief One past the highest slot ever used
+   */
+  uint32_t GetNumSlots() const;
+
+  uint32_t GetCapacity() const;
+};
+}
@@ -1,41 +1,94 @@
 #pragma once
+#include "GBuffer.hpp"
+#include "LightClusters.hpp"
+#include "LightStore.hpp"
 #include "SceneDrawer.hpp"
+#include "aerox/drawing/RenderGraphExecutor.hpp"
+#include <array>
 
 namespace aerox::drawing {
-struct GBuffer {
-  std::shared_ptr<AllocatedImage> location;
-  std::shared_ptr<AllocatedImage> color;
-  std::shared_ptr<AllocatedImage> normals;
-  std::shared_ptr<AllocatedImage> roughnessMetallic;
-  std::shared_ptr<AllocatedImage> emissive;
-  std::shared_ptr<AllocatedImage> specular;
-
-  void Clear();
+
+// Texture params of every mesh material, in the slot order mesh_deferred.frag reads them
+constexpr std::array<const char *, 6> MESH_TEXTURE_PARAMS = {"ColorT", "NormalT", "RoughnessT", "MetallicT", "SpecularT", "EmissiveT"};
+
+/**
+ * \brief Copy of everything a scene needs to be drawn, made on the game thread. Material parameters and descriptor writes are not part of
+ * it, they are shared state that a queued snapshot sees as it is when recorded.
+ */
+struct SceneSnapshot {
+  vk::Extent2D extent;
+  glm::mat4 viewMatrix{1.0f};
+  glm::mat4 projectionMatrix{1.0f};
+  glm::vec4 cameraLocation{0.0f};
+  float nearClip = 0.0f;
+  float farClip = 0.0f;
+  LightUpload lights;
+  Array<uint32_t> lightSlots;
+  // View space bounds of the lights in lightSlots, in the same order
+  Array<math::Sphere> clusterLights;
+  Array<drawFn> lit;
+  Array<drawFn> translucent;
+  // Set once the lights were written, a snapshot dropped before that hands them back to the light store
+  bool bLightsUploaded = false;
 };
+
+/**
+ * \brief One frame in flight's copy of the light array
+ */
+struct LightBufferCopy {
+  std::shared_ptr<AllocatedBuffer> buffer;
+  vk::DeviceAddress address = 0;
+  // Runs written to the other copies since this one was last written, oldest first
+  Array<LightUpload> pending;
+};
+
 class SceneDeferredDrawer : public SceneDrawer {
   SceneGlobalBuffer _sceneData{};
-  std::shared_ptr<AllocatedBuffer> _sceneGlobalBuffer;
+  LightStore _lightStore;
+  // Only dirty slots are written, so each frame in flight keeps its own copy instead of rewriting one the gpu may be reading
+  std::array<LightBufferCopy, FRAME_OVERLAP> _lightBuffers;
+  std::unordered_map<RawFrameData *, uint32_t> _lightBufferIndices;
+  LightClusters _lightClusters;
   std::shared_ptr<MaterialInstance> _defaultCheckeredMaterial;
   
-  GBuffer _gBuffer{};
-  std::shared_ptr<AllocatedImage> _depth;
+  RenderGraphExecutor _graph;
+  // Graph generation the lighting material's G-buffer images were written for
+  uint64_t _gBufferGeneration = 0;
   std::shared_ptr<AllocatedImage> _result;
   std::shared_ptr<MaterialInstance> _shader;
   vk::Sampler _sampler;
 public:
 
   void OnInit(scene::Scene * owner) override;
-  void CreateBuffers();
 
-  std::shared_ptr<AllocatedImage> CreateBufferImage();
-  std::shared_ptr<AllocatedImage> CreateDepthImage();
   std::shared_ptr<AllocatedImage> CreateRenderTargetImage();
 
-  void Draw(RawFrameData *frameData) override;
+  /**
+   * \brief Uploads the cluster light lists to frame's upload buffer, they are rebuilt every frame
+   */
+  void UploadLightClusters(RawFrameData *frame);
+
+  /**
+   * \brief frame's copy of the light array, frames are given a copy the first time they record the scene
+   */
+  LightBufferCopy &GetLightBuffer(RawFrameData *frame);
+
+  /**
+   * \brief Refreshes changed lights and copies only their slots into snapshot, along with the view space bounds of every light
+   */
+  void CollectLights(SceneSnapshot &snapshot);
+
+  /**
+   * \brief Writes the lights copied into snapshot to frame's copy of the light array and queues them for the other copies, then assigns
+   * them to clusters
+   */
+  void UploadLights(RawFrameData *frame, const SceneSnapshot &snapshot);
+
+  recordFn Collect() override;
 
-  void TransitionGBuffer(vk::CommandBuffer cmd, vk::ImageLayout from, vk::ImageLayout to);
+  void Record(RawFrameData *frameData, const SceneSnapshot &snapshot);
 
-  Array<vk::RenderingAttachmentInfo> MakeAttachments();
+  Array<vk::RenderingAttachmentInfo> MakeAttachments(const RenderGraphExecutor &executor, const GBuffer &gBuffer);
 
   Array<vk::Format> GetColorAttachmentFormats() override;
 
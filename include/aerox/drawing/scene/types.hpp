@@ -4,7 +4,11 @@
 
 namespace aerox::drawing {
 class SceneDrawer;
+
+constexpr uint32_t MAX_SCENE_LIGHTS = 1024;
+
 struct GpuLight {
+  // w is the radius, lights with a radius <= 0 reach everywhere
   glm::vec4 location;
   glm::vec4 direction;
   glm::vec4 color;
@@ -16,7 +20,17 @@ struct SceneGlobalBuffer {
   glm::vec4 lightDirection{0.0f,-1.0f,0,0.0f};
   glm::vec4 cameraLocation{0.0f};
   glm::vec4 numLights{0.0f};
-  GpuLight lights[1024];
+  // x,y,z cluster counts
+  glm::uvec4 clusterGrid{0};
+  // near, far, scale and bias for the depth slice
+  glm::vec4 clusterDepth{0.0f};
+  glm::vec4 clusterForward{0.0f};
+  // Address of the per cluster light index lists
+  vk::DeviceAddress clusterBuffer = 0;
+  // Address of the GpuLight array, lights keep their slot so it is only partially rewritten
+  vk::DeviceAddress lightBuffer = 0;
+  // Lighting rebuilds world locations from depth with it
+  glm::mat4 inverseViewProjection{1.0f};
 };
 struct SceneFrameData;
 
@@ -24,11 +38,15 @@ typedef std::function<void(SceneFrameData *)> drawFn;
 
 struct SceneFrameData : SimpleFrameData {
   SceneDrawer * _sceneDrawer = nullptr;
+  // Address of this frame's SceneGlobalBuffer, 0 while collecting
+  vk::DeviceAddress _sceneGlobals = 0;
 public:
-  SceneFrameData(RawFrameData * frame,SceneDrawer * drawer);
+  SceneFrameData(RawFrameData * frame,SceneDrawer * drawer, vk::CommandBuffer * cmd = nullptr, vk::DeviceAddress sceneGlobals = 0);
 
   SceneDrawer * GetSceneDrawer() const;
 
+  vk::DeviceAddress GetSceneGlobals() const;
+
   Array<drawFn> lit;
   Array<drawFn> translucent;
 
@@ -1,12 +1,16 @@
 ﻿#pragma once
 
 #include "Allocator.hpp"
+#include "FrameUploadBuffer.hpp"
+#include "GpuTimer.hpp"
+#include "WorkerCommandPools.hpp"
 #include "descriptors.hpp"
 #include "aerox/types.hpp"
 #include "aerox/containers/Array.hpp"
 #include "aerox/containers/String.hpp"
 #include <glm/fwd.hpp>
 #include <glm/glm.hpp>
+#include <mutex>
 
 
 namespace aerox::drawing {
@@ -39,25 +43,44 @@ private:
   vk::Fence _renderFence;
   vk::CommandPool _cmdPool;
   vk::CommandBuffer _cmdBuffer;
+  WorkerCommandPools _workerPools;
+  FrameUploadBuffer _uploads;
+  GpuTimer _timer;
   DescriptorAllocatorGrowable _frameDescriptors{};
+  std::mutex _descriptorMutex;
   DrawingSubsystem * _drawer = nullptr;
   WindowDrawer * _windowDrawer = nullptr;
+  vk::Viewport _viewport;
+  uint64_t _id = 0;
 public:
   CleanupQueue cleaner;
   vk::CommandBuffer * GetCmd();
   vk::CommandPool * GetCmdPool();
+  WorkerCommandPools * GetWorkerPools();
+  // Transient uniforms, instance data and vertices, reset when the frame is drawn again
+  FrameUploadBuffer * GetUploads();
+  // Times scopes of the frame's command buffer, read once its fence signals
+  GpuTimer * GetTimer();
   DescriptorAllocatorGrowable * GetDescriptorAllocator();
+  // Held while allocating from the frame's descriptors when recording on several threads
+  std::mutex * GetDescriptorMutex();
   vk::Semaphore GetSwapchainSemaphore() const;
   vk::Semaphore GetRenderSemaphore() const;
   vk::Fence GetRenderFence() const;
   DrawingSubsystem * GetDrawer() const;
   WindowDrawer * GetWindowDrawer() const;
+  // Viewport of the snapshot being recorded, only read on the render thread
+  vk::Viewport GetViewport() const;
+  // Id of the frame last recorded with this data, from DrawingSubsystem::NextFrameId
+  uint64_t GetId() const;
+  void SetId(uint64_t id);
   void SetSemaphores(const vk::Semaphore &swapchain, const vk::Semaphore &render);
   void SetRenderFence(vk::Fence renderFence);
   void SetCommandPool(vk::CommandPool pool);
   void SetCommandBuffer(vk::CommandBuffer buffer);
   void SetDrawer(DrawingSubsystem * drawer);
   void SetWindowDrawer(WindowDrawer * windowDrawer);
+  void SetViewport(const vk::Viewport &viewport);
 };
 
 struct Vertex {
@@ -80,9 +103,12 @@ struct GpuGeometryBuffers {
   vk::DeviceAddress vertexBufferAddress;
 };
 
+// Matches pVertex in mesh.glsl
 struct MeshVertexPushConstant {
   glm::mat4 transformMatrix;
-  vk::DeviceAddress vertexBuffer;
+  uint32_t material = 0;
+  vk::DeviceAddress vertexBuffer = 0;
+  vk::DeviceAddress sceneGlobals = 0;
 };
 
 
@@ -107,7 +133,9 @@ struct ComputeEffect {
 enum EMaterialSetType {
   Global = 0,
   Static = 1,
-  Dynamic = 2
+  Dynamic = 2,
+  // Shared BindlessTextures set, never allocated per material
+  Bindless = 3
 };
 
 struct BasicShaderResourceInfo {
@@ -140,6 +168,8 @@ struct ShaderResources {
   std::unordered_map<std::string,BasicShaderResourceInfo> images;
   std::unordered_map<std::string,PushConstantInfo> pushConstants;
   std::unordered_map<std::string,BasicShaderResourceInfo> uniformBuffers;
+  // Reads the material buffer in the bindless set
+  bool bUsesMaterialBuffer = false;
 };
 
 enum EMaterialResourceType {
@@ -159,9 +189,11 @@ struct MaterialResourceInfo {
 struct SimpleFrameData {
 private:
   RawFrameData * _frame = nullptr;
+  // Recorded into instead of the frame's command buffer, set when recording a secondary buffer
+  vk::CommandBuffer * _cmd = nullptr;
 public:
   
-  SimpleFrameData(RawFrameData * frame);
+  SimpleFrameData(RawFrameData * frame, vk::CommandBuffer * cmd = nullptr);
 
   [[nodiscard]] vk::CommandBuffer * GetCmd() const;
 
@@ -0,0 +1,91 @@
+#pragma once
+#include <array>
+#include <limits>
+#include <glm/glm.hpp>
+
+namespace aerox::math {
+
+struct Sphere {
+  glm::vec3 center{0.0f};
+  float radius = 0.0f;
+
+  Sphere() = default;
+  Sphere(const glm::vec3 &inCenter, float inRadius);
+
+  bool operator==(const Sphere &other) const = default;
+};
+
+struct Ray {
+  glm::vec3 origin{0.0f};
+  glm::vec3 direction{0.0f, 0.0f, 1.0f};
+
+  Ray() = default;
+  /**
+   * \brief Creates a ray, the direction is normalized
+   */
+  Ray(const glm::vec3 &inOrigin, const glm::vec3 &inDirection);
+
+  [[nodiscard]] glm::vec3 At(float distance) const;
+};
+
+/**
+ * \brief Axis aligned bounding box, a default constructed box is empty and can be grown with Expand
+ */
+struct Bounds {
+  glm::vec3 min{std::numeric_limits<float>::max()};
+  glm::vec3 max{std::numeric_limits<float>::lowest()};
+
+  Bounds() = default;
+  Bounds(const glm::vec3 &inMin, const glm::vec3 &inMax);
+
+  bool operator==(const Bounds &other) const = default;
+
+  static Bounds FromPoint(const glm::vec3 &point);
+  static Bounds FromSphere(const Sphere &sphere);
+
+  [[nodiscard]] bool IsValid() const;
+  [[nodiscard]] glm::vec3 GetCenter() const;
+  [[nodiscard]] glm::vec3 GetExtent() const;
+  [[nodiscard]] float GetSurfaceArea() const;
+
+  [[nodiscard]] Bounds Union(const Bounds &other) const;
+  [[nodiscard]] Bounds Expand(float amount) const;
+  [[nodiscard]] Bounds Expand(const glm::vec3 &point) const;
+
+  [[nodiscard]] bool Contains(const glm::vec3 &point) const;
+  [[nodiscard]] bool Contains(const Bounds &other) const;
+  [[nodiscard]] bool Intersects(const Bounds &other) const;
+  [[nodiscard]] bool Intersects(const Sphere &sphere) const;
+
+  /**
+   * \brief Slab test against a ray
+   * \param ray The ray, must have a normalized direction
+   * \param maxDistance Hits past this distance are ignored
+   * \param outDistance Distance to the entry point, 0 if the ray starts inside
+   * \return True if the ray hits within maxDistance
+   */
+  bool Intersects(const Ray &ray, float maxDistance, float &outDistance) const;
+
+  /**
+   * \brief Returns the bounds of this box after transforming it by matrix
+   */
+  [[nodiscard]] Bounds TransformBy(const glm::mat4 &matrix) const;
+};
+
+/**
+ * \brief Six planes extracted from a view projection matrix, normals face inward
+ */
+struct Frustum {
+  std::array<glm::vec4, 6> planes{};
+
+  Frustum() = default;
+  explicit Frustum(const glm::mat4 &viewProjection);
+
+  /**
+   * \brief Conservative test, may report boxes near the corners as visible
+   */
+  [[nodiscard]] bool Intersects(const Bounds &bounds) const;
+  [[nodiscard]] bool Intersects(const Sphere &sphere) const;
+  [[nodiscard]] bool Contains(const Bounds &bounds) const;
+};
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include "Bounds.hpp"
+#include "aerox/containers/Array.hpp"
+#include <cstdint>
+#include <functional>
+
+namespace aerox::math {
+
+/**
+ * \brief Incrementally updated dynamic AABB tree. Leaves store a fattened copy of the bounds they were inserted with so small
+ * movements do not touch the tree, inserts pick siblings by surface area and the tree is kept balanced with rotations.
+ */
+class BoundsTree {
+public:
+  static constexpr int32_t NULL_NODE = -1;
+  static constexpr float DISPLACEMENT_MULTIPLIER = 4.0f;
+
+  /**
+   * \brief Return false to stop the query
+   */
+  using QueryCallback = std::function<bool(int32_t proxy)>;
+
+  /**
+   * \brief Return the new max distance for the ray, return 0 to stop the query or the current max distance to ignore the proxy
+   */
+  using RayCastCallback = std::function<float(int32_t proxy, float distance, float maxDistance)>;
+
+private:
+  struct Node {
+    Bounds bounds;
+    void *userData = nullptr;
+
+    // Doubles as the next free node when the node is in the free list
+    int32_t parent = NULL_NODE;
+    int32_t left = NULL_NODE;
+    int32_t right = NULL_NODE;
+
+    // Leaves have a height of 0, free nodes a height of -1
+    int32_t height = -1;
+
+    [[nodiscard]] bool IsLeaf() const { return left == NULL_NODE; }
+  };
+
+  std::vector<Node> _nodes;
+  int32_t _root = NULL_NODE;
+  int32_t _freeList = NULL_NODE;
+  size_t _proxyCount = 0;
+  float _margin = 0.1f;
+
+  int32_t AllocateNode();
+  void FreeNode(int32_t node);
+  void InsertLeaf(int32_t leaf);
+  void RemoveLeaf(int32_t leaf);
+  int32_t Balance(int32_t node);
+  void Refit(int32_t node);
+  int32_t BuildTopDown(int32_t *leaves, size_t count);
+
+public:
+  /**
+   * \param margin Amount leaf bounds are fattened by
+   */
+  explicit BoundsTree(float margin = 0.1f);
+
+  /**
+   * \brief Adds a proxy to the tree
+   * \return The proxy id, stays valid until the proxy is removed
+   */
+  int32_t Insert(const Bounds &bounds, void *userData);
+
+  void Remove(int32_t proxy);
+
+  /**
+   * \brief Updates the bounds of a proxy, only re-inserts if the bounds escaped the fat bounds
+   * \param displacement Movement since the last update, the fat bounds are stretched along it to predict future motion
+   * \return True if the proxy was re-inserted
+   */
+  bool Move(int32_t proxy, const Bounds &bounds, const glm::vec3 &displacement = glm::vec3{0.0f});
+
+  void *GetUserData(int32_t proxy) const;
+
+  const Bounds &GetFatBounds(int32_t proxy) const;
+
+  void Query(const Bounds &bounds, const QueryCallback &callback) const;
+
+  void Query(const Sphere &sphere, const QueryCallback &callback) const;
+
+  void Query(const Frustum &frustum, const QueryCallback &callback) const;
+
+  void RayCast(const Ray &ray, float maxDistance, const RayCastCallback &callback) const;
+
+  /**
+   * \brief Rebuilds the tree top down from its leaves, proxy ids are preserved
+   */
+  void Rebuild();
+
+  void Clear();
+
+  size_t GetProxyCount() const;
+
+  int32_t GetHeight() const;
+
+  /**
+   * \brief Sum of all node surface areas over the root's surface area, grows as the tree degrades
+   */
+  float GetAreaRatio() const;
+};
+}
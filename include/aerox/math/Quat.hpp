@@ -34,6 +34,8 @@ namespace aerox::math {
 
         Quat operator*(const Quat& other) const;
 
+        [[nodiscard]] Quat Inverse() const;
+
         [[nodiscard]] Vec3<> Forward() const;
 
         [[nodiscard]] Vec3<> Right() const;
@@ -22,8 +22,44 @@ public:
   }
 
 public:
+  /**
+   * \brief True when every axis is scaled by the same amount, transforms like this stay exact through inverses and relative transforms
+   */
+  [[nodiscard]] bool HasUniformScale() const;
+
+  /**
+   * \brief This transform expressed in the space of other. Computed on the components when other has a uniform scale, otherwise through
+   * the affine inverse of other's matrix
+   */
   [[nodiscard]] Transform RelativeTo(const Transform& other) const;
 
+  /**
+   * \brief This transform expressed in the space of an affine matrix, use when other can hold shear a Transform cannot represent
+   */
+  [[nodiscard]] Transform RelativeTo(const glm::mat4& other) const;
+
+  /**
+   * \brief Applies this transform on top of child, i.e. the world transform of child when this is its parent's world transform. Computed on
+   * the components when this has a uniform scale, otherwise decomposed from the matrix product. A rotated child of a non-uniformly scaled
+   * parent picks up shear a Transform cannot hold, use the matrices when that matters
+   */
+  [[nodiscard]] Transform operator*(const Transform& child) const;
+
+  /**
+   * \brief Inverse computed on the components when the scale is uniform, otherwise decomposed from InverseMatrix
+   */
+  [[nodiscard]] Transform Inverse() const;
+
+  /**
+   * \brief Inverse of Matrix() computed analytically from the components, exact for any scale
+   */
+  [[nodiscard]] glm::mat4 InverseMatrix() const;
+
+  /**
+   * \brief Blends location and scale linearly and rotation along the shortest arc, alpha 0 is this and 1 is to
+   */
+  [[nodiscard]] Transform Interpolate(const Transform& to, float alpha) const;
+
     [[nodiscard]] glm::mat4 GetLocationMatrix() const;
 
     [[nodiscard]] glm::mat4 GetRotationMatrix() const;
@@ -43,7 +43,7 @@ namespace aerox::math {
         }
 
         Vec2 operator*(const Vec2 &other) const {
-            return {x / other.x, y / other.y};
+            return {x * other.x, y * other.y};
         }
 
         Vec2 operator/(const Vec2 &other) const {
@@ -49,7 +49,7 @@ namespace aerox::math {
             return {x - other.x,y - other.y,z - other.z};
         }
         Vec3 operator*(const Vec3& other) const {
-            return {x / other.x,y / other.y,z / other.z};
+            return {x * other.x,y * other.y,z * other.z};
         }
         Vec3 operator/(const Vec3& other) const {
             return {x / other.x,y / other.y,z / other.z};
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AEROX_SIMD_SSE 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define AEROX_SIMD_NEON 1
+#endif
+
+/**
+ * \brief Vectorized versions of the matrix and quaternion operations used by transforms. SSE is used on x86, NEON on arm and plain
+ * scalar code everywhere else. Matrix products, point transforms, quaternion products and slerp add their terms in the same order as glm
+ * so results match glm bit for bit, compose and inverse follow glm's formulas but skip the work a TRS or affine matrix does not need.
+ */
+namespace aerox::math::simd {
+
+/**
+ * \brief "sse", "neon" or "scalar"
+ */
+const char *getBackendName();
+
+glm::mat4 multiply(const glm::mat4 &a, const glm::mat4 &b);
+
+/**
+ * \brief Same as glm::translate(location) * glm::mat4_cast(rotation) * glm::scale(scale) without the two matrix products
+ */
+glm::mat4 composeTrs(const glm::vec3 &location, const glm::quat &rotation, const glm::vec3 &scale);
+
+/**
+ * \brief Inverse of a matrix whose last row is (0,0,0,1), cheaper than glm::inverse
+ */
+glm::mat4 inverseAffine(const glm::mat4 &matrix);
+
+glm::quat multiply(const glm::quat &a, const glm::quat &b);
+
+glm::vec3 rotate(const glm::quat &rotation, const glm::vec3 &vector);
+
+/**
+ * \brief Shortest path interpolation, falls back to a linear blend when the quaternions are nearly equal like glm::slerp
+ */
+glm::quat slerp(const glm::quat &a, const glm::quat &b, float alpha);
+
+/**
+ * \brief Transforms count points by matrix, points and out may be the same array
+ */
+void transformPoints(const glm::mat4 &matrix, const glm::vec3 *points, glm::vec3 *out, size_t count);
+}
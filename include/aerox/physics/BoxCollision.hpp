@@ -0,0 +1,25 @@
+#pragma once
+#include "aerox/physics/CollisionComponent.hpp"
+
+namespace aerox::physics {
+/**
+ * \brief Box centered on the component and aligned with its rotation
+ */
+class BoxCollision : public CollisionComponent {
+  glm::vec3 _halfExtents{0.5f};
+
+protected:
+  rp3d::CollisionShape *CreateShape(RP3DScenePhysics *physics) override;
+  void DestroyShape(rp3d::CollisionShape *shape) override;
+
+public:
+  explicit BoxCollision(const glm::vec3 &halfExtents = glm::vec3{0.5f});
+
+  void SetHalfExtents(const glm::vec3 &halfExtents);
+  glm::vec3 GetHalfExtents() const;
+
+  static std::shared_ptr<BoxCollision> Construct() {
+    return newObject<BoxCollision>();
+  }
+};
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include "aerox/physics/CollisionComponent.hpp"
+
+namespace aerox::physics {
+/**
+ * \brief Capsule along the component's local up axis
+ */
+class CapsuleCollision : public CollisionComponent {
+  float _radius = 0.5f;
+  // Distance between the centers of the two end spheres
+  float _height = 1.0f;
+
+protected:
+  rp3d::CollisionShape *CreateShape(RP3DScenePhysics *physics) override;
+  void DestroyShape(rp3d::CollisionShape *shape) override;
+
+public:
+  CapsuleCollision(float radius = 0.5f, float height = 1.0f);
+
+  void SetRadius(float radius);
+  float GetRadius() const;
+
+  void SetHeight(float height);
+  float GetHeight() const;
+
+  static std::shared_ptr<CapsuleCollision> Construct() {
+    return newObject<CapsuleCollision>();
+  }
+};
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "aerox/scene/components/SceneComponent.hpp"
+#include <functional>
+#include <reactphysics3d/reactphysics3d.h>
+
+namespace aerox::physics {
+class RP3DScenePhysics;
+class RigidBodyComponent;
+
+/**
+ * \brief A collision shape in the scene's physics world. The shape becomes a collider of the object's rigid body, objects without one
+ * get a static body of their own.
+ */
+class CollisionComponent : public scene::SceneComponent {
+  rp3d::Collider *_collider = nullptr;
+  rp3d::RigidBody *_colliderBody = nullptr;
+  // Static body owned by this shape when the object has no rigid body
+  rp3d::RigidBody *_ownBody = nullptr;
+  bool _bTrigger = false;
+  std::weak_ptr<RigidBodyComponent> _rigidBody;
+
+  /**
+   * \brief Places the collider on its rigid body's body again after this component moved relative to the rigid body
+   */
+  void SyncColliderTransform();
+
+protected:
+  rp3d::CollisionShape *_shape = nullptr;
+  std::weak_ptr<RP3DScenePhysics> _physics;
+
+  virtual rp3d::CollisionShape *CreateShape(RP3DScenePhysics *physics) = 0;
+  virtual void DestroyShape(rp3d::CollisionShape *shape) = 0;
+
+  /**
+   * \brief Applies a change to the created shape on the stepping thread, does nothing before the shape exists as it is created
+   * from the current settings
+   */
+  void UpdateShape(std::function<void(rp3d::CollisionShape *)> fn);
+
+public:
+  void OnInit(scene::SceneObject *owner) override;
+  void OnDestroy() override;
+
+  using SceneComponent::SetRelativeTransform;
+  void SetRelativeTransform(const math::Transform &val) override;
+
+  /**
+   * \brief Triggers report overlaps through ScenePhysics::onTriggers instead of colliding
+   */
+  void SetTrigger(bool bTrigger);
+  bool IsTrigger() const;
+
+  /**
+   * \brief Adds this shape to body, called by the rigid body the shape is attached to
+   */
+  void CreateCollider(RP3DScenePhysics *physics, rp3d::RigidBody *body, const math::Transform &bodyTransform);
+
+  /**
+   * \brief Removes this shape from its body
+   * \param bBodyDestroyed The body is being destroyed and takes its colliders with it
+   */
+  void ReleaseCollider(bool bBodyDestroyed);
+
+  rp3d::Collider *GetCollider() const;
+};
+}
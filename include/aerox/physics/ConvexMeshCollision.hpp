@@ -0,0 +1,29 @@
+#pragma once
+#include "aerox/physics/CollisionComponent.hpp"
+#include "aerox/drawing/Mesh.hpp"
+
+namespace aerox::physics {
+/**
+ * \brief Convex hull of a mesh cooked when the mesh was imported, scaled by the component's world scale
+ */
+class ConvexMeshCollision : public CollisionComponent {
+  std::shared_ptr<drawing::Mesh> _mesh;
+
+protected:
+  rp3d::CollisionShape *CreateShape(RP3DScenePhysics *physics) override;
+  void DestroyShape(rp3d::CollisionShape *shape) override;
+
+public:
+  explicit ConvexMeshCollision(const std::shared_ptr<drawing::Mesh> &mesh = {});
+
+  /**
+   * \brief Takes effect when the component is initialized
+   */
+  void SetMesh(const std::shared_ptr<drawing::Mesh> &mesh);
+  std::weak_ptr<drawing::Mesh> GetMesh() const;
+
+  static std::shared_ptr<ConvexMeshCollision> Construct() {
+    return newObject<ConvexMeshCollision>();
+  }
+};
+}
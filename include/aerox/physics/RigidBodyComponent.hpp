@@ -0,0 +1,66 @@
+#pragma once
+#include "aerox/physics/types.hpp"
+#include "aerox/scene/components/SceneComponent.hpp"
+#include <reactphysics3d/reactphysics3d.h>
+
+namespace aerox::physics {
+class RP3DScenePhysics;
+class CollisionComponent;
+
+/**
+ * \brief Gives its object a body in the scene's physics world. Collision components on the same object become the body's colliders,
+ * dynamic bodies move this component and static or kinematic bodies follow it. Meant to be the object's root, return it from
+ * SceneObject::CreateRootComponent. A dynamic body anywhere else only moves this component and its children and leaves the rest of
+ * the object behind, a warning is logged when that happens.
+ */
+class RigidBodyComponent : public scene::SceneComponent {
+  EBodyType _bodyType = EBodyType::Dynamic;
+  float _mass = 1.0f;
+  bool _bGravity = true;
+  rp3d::RigidBody *_body = nullptr;
+  std::weak_ptr<RP3DScenePhysics> _physics;
+  std::vector<std::weak_ptr<CollisionComponent>> _shapes;
+
+  void UpdateMassProperties();
+
+  /**
+   * \brief Runs fn against the body on the stepping thread
+   */
+  void PushBodyCommand(std::function<void(rp3d::RigidBody *)> fn);
+
+public:
+  explicit RigidBodyComponent(EBodyType type = EBodyType::Dynamic);
+
+  void OnInit(scene::SceneObject *owner) override;
+  void OnDestroy() override;
+
+  /**
+   * \brief Makes shape one of this body's colliders, immediately if the body exists or once it is created
+   */
+  void AttachShape(const std::shared_ptr<CollisionComponent> &shape);
+
+  void DetachShape(const CollisionComponent *shape);
+
+  EBodyType GetBodyType() const;
+
+  void SetMass(float mass);
+  float GetMass() const;
+
+  void SetGravityEnabled(bool bEnabled);
+  bool IsGravityEnabled() const;
+
+  void ApplyForce(const glm::vec3 &force);
+  void ApplyTorque(const glm::vec3 &torque);
+  void SetLinearVelocity(const glm::vec3 &velocity);
+  void SetAngularVelocity(const glm::vec3 &velocity);
+
+  /**
+   * \brief The rp3d body, only safe to touch directly through ScenePhysics::PushCommand
+   */
+  rp3d::RigidBody *GetBody() const;
+
+  static std::shared_ptr<RigidBodyComponent> Construct() {
+    return newObject<RigidBodyComponent>();
+  }
+};
+}
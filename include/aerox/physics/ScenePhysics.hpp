@@ -2,21 +2,170 @@
 #include "aerox/Object.hpp"
 #include "aerox/TObjectWithInit.hpp"
 #include "aerox/TOwnedBy.hpp"
+#include "aerox/async/MpscQueue.hpp"
+#include "aerox/containers/Array.hpp"
+#include "aerox/containers/TDelegate.hpp"
+#include "aerox/math/Bounds.hpp"
+#include "aerox/math/Transform.hpp"
+#include "aerox/physics/constants.hpp"
+#include "aerox/physics/types.hpp"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
 
 namespace aerox {
 namespace scene {
 class Scene;
 }
 
+namespace async {
+class AsyncSubsystem;
+}
+
 namespace physics {
+/**
+ * \brief Steps the simulation at a fixed rate no matter the frame rate. Frame time is accumulated and consumed in whole steps, at most
+ * a fixed number per frame, and what is left over is used to interpolate between the last two steps so motion stays smooth.
+ * In async mode the steps of a frame run as a job on the async subsystem while the game and renderer carry on, the scene sees the
+ * results of the previous frame's steps and the next FixedUpdate is the sync point where they are exchanged.
+ */
 class ScenePhysics : public TOwnedBy<scene::Scene> {
+  /**
+   * \brief Steps handed to the async subsystem, shared with the job so a job that lost the race never touches the physics object
+   */
+  struct PendingStep {
+    std::atomic<bool> bClaimed = false;
+    std::vector<std::function<void()>> commands;
+    uint32_t count = 0;
+    float stepSize = 0.0f;
+
+    /**
+     * \return True for the one caller that gets to run the steps
+     */
+    bool Claim() {
+      return !bClaimed.exchange(true, std::memory_order_acq_rel);
+    }
+  };
+
   float _accum = 0.0f;
+  float _stepSize = PHYSICS_FIXED_UPDATE;
+  uint32_t _maxSubSteps = PHYSICS_MAX_SUBSTEPS;
+  float _interpolationAlpha = 0.0f;
+  uint64_t _droppedSteps = 0;
+  bool _bAsync = false;
+  bool _bResultsPending = false;
+  std::atomic<bool> _bStepping = false;
+  std::shared_ptr<PendingStep> _pendingStep;
+  async::MpscQueue<std::function<void()>> _commands;
+
+  void RunSteps(const std::vector<std::function<void()>> &commands, uint32_t count, float stepSize);
+
+  /**
+   * \brief Runs a claimed step and wakes the threads waiting for it
+   */
+  void RunPendingStep(const PendingStep &step);
+
+protected:
+  // Filled by ExchangeResults and handed out in one batch per frame
+  std::vector<ContactEvent> _contactEvents;
+  std::vector<TriggerEvent> _triggerEvents;
+
+  void DispatchEvents();
+
+  /**
+   * \brief Where async steps run, the engine's async subsystem unless overridden
+   */
+  virtual std::shared_ptr<async::AsyncSubsystem> GetStepRunner() const;
 
 public:
-  
+
+  /**
+   * \brief Called once per frame with every contact reported by the steps whose results were exchanged
+   */
+  DECLARE_DELEGATE(onContacts, const std::vector<ContactEvent>&)
+
+  /**
+   * \brief Called once per frame with every trigger overlap reported by the steps whose results were exchanged
+   */
+  DECLARE_DELEGATE(onTriggers, const std::vector<TriggerEvent>&)
+
+  void OnDestroy() override;
+
+  /**
+   * \brief Advances the simulation by deltaTime worth of fixed steps, call once per frame with the frame delta
+   */
   virtual void FixedUpdate(float deltaTime);
 
+  /**
+   * \brief Pushes scene transforms of bodies the scene drives into the simulation, called once per frame before the first step
+   */
+  virtual void SyncToPhysics();
+
+  /**
+   * \brief Pulls simulated transforms back into the scene, called every frame after stepping
+   * \param alpha How far the frame is between the last two steps, 0 is the previous step and 1 the latest
+   */
+  virtual void SyncFromPhysics(float alpha);
+
   virtual void InternalFixedUpdate(float deltaTime) = 0;
+
+  /**
+   * \brief Publishes the results of the finished steps to the scene side, called on the game thread at the sync point
+   */
+  virtual void ExchangeResults();
+
+  /**
+   * \brief Blocks until the steps in flight are done and exchanges their results, anything that changes the simulation's structure
+   * like adding or removing bodies must call this first. Steps no pool thread has picked up yet run on the calling thread, no other
+   * queued work does
+   */
+  void WaitForStep();
+
+  /**
+   * \brief Queues a change to the simulation such as applying a force, run on the stepping thread before the next frame's steps. Safe
+   * to call from any thread, the simulation must not be touched directly while async steps may be running. Commands pushed while a
+   * step is in flight wait for the next frame in async and inline mode alike.
+   */
+  void PushCommand(std::function<void()> command);
+
+  /**
+   * \brief Waits for the step in flight then runs queued commands on the calling thread, call before destroying anything a queued
+   * command may reference
+   */
+  void FlushCommands();
+
+  void SetAsync(bool bAsync);
+  bool IsAsync() const;
+
+  /**
+   * \brief Closest shape hit by the ray
+   */
+  virtual std::optional<PhysicsHit> RayCast(const math::Ray &ray, float maxDistance);
+
+  /**
+   * \brief Shapes overlapping a sphere
+   */
+  virtual Array<std::weak_ptr<scene::SceneComponent>> OverlapSphere(const glm::vec3 &center, float radius);
+
+  /**
+   * \brief Shapes overlapping a box, transform's scale is ignored
+   */
+  virtual Array<std::weak_ptr<scene::SceneComponent>> OverlapBox(const math::Transform &transform, const glm::vec3 &halfExtents);
+
+  void SetStepSize(float stepSize);
+  float GetStepSize() const;
+
+  void SetMaxSubSteps(uint32_t maxSubSteps);
+  uint32_t GetMaxSubSteps() const;
+
+  float GetInterpolationAlpha() const;
+
+  /**
+   * \brief Number of steps skipped because a frame needed more than the max sub steps
+   */
+  uint64_t GetDroppedSteps() const;
 };
 }
 }
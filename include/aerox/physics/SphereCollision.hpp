@@ -1,11 +1,25 @@
 #pragma once
-#include "aerox/scene/components/RenderedComponent.hpp"
+#include "aerox/physics/CollisionComponent.hpp"
 
 namespace aerox::physics {
-class SphereCollision : public scene::RenderedComponent  {
-  
+/**
+ * \brief Sphere centered on the component
+ */
+class SphereCollision : public CollisionComponent {
+  float _radius = 0.5f;
+
+protected:
+  rp3d::CollisionShape *CreateShape(RP3DScenePhysics *physics) override;
+  void DestroyShape(rp3d::CollisionShape *shape) override;
+
 public:
-  virtual void SetRadius(float val) = 0;
-  virtual float GetRadius() = 0;
+  explicit SphereCollision(float radius = 0.5f);
+
+  void SetRadius(float radius);
+  float GetRadius() const;
+
+  static std::shared_ptr<SphereCollision> Construct() {
+    return newObject<SphereCollision>();
+  }
 };
 }
@@ -0,0 +1,30 @@
+#pragma once
+#include "aerox/physics/CollisionComponent.hpp"
+#include "aerox/drawing/Mesh.hpp"
+
+namespace aerox::physics {
+/**
+ * \brief Triangles of a mesh cooked when the mesh was imported, scaled by the component's world scale. Only collides as part of static
+ * or kinematic bodies
+ */
+class TriangleMeshCollision : public CollisionComponent {
+  std::shared_ptr<drawing::Mesh> _mesh;
+
+protected:
+  rp3d::CollisionShape *CreateShape(RP3DScenePhysics *physics) override;
+  void DestroyShape(rp3d::CollisionShape *shape) override;
+
+public:
+  explicit TriangleMeshCollision(const std::shared_ptr<drawing::Mesh> &mesh = {});
+
+  /**
+   * \brief Takes effect when the component is initialized
+   */
+  void SetMesh(const std::shared_ptr<drawing::Mesh> &mesh);
+  std::weak_ptr<drawing::Mesh> GetMesh() const;
+
+  static std::shared_ptr<TriangleMeshCollision> Construct() {
+    return newObject<TriangleMeshCollision>();
+  }
+};
+}
@@ -1,5 +1,9 @@
 #pragma once
+#include <cstdint>
 
 namespace aerox::physics {
-constexpr float PHYSICS_FIXED_UPDATE = 0.2f;
+// Default length of a physics step in seconds
+constexpr float PHYSICS_FIXED_UPDATE = 1.0f / 60.0f;
+// Most steps taken in one frame, time past this is dropped so a slow frame cannot snowball into slower ones
+constexpr uint32_t PHYSICS_MAX_SUBSTEPS = 8;
 }
@@ -0,0 +1,10 @@
+#pragma once
+#include "aerox/drawing/Mesh.hpp"
+
+namespace aerox::physics {
+
+/**
+ * \brief Welds the mesh's triangles and computes its convex hull, meant to run when the mesh is imported
+ */
+drawing::MeshCollisionData cookMeshCollision(const Array<drawing::Vertex> &vertices, const Array<uint32_t> &indices);
+}
@@ -1,22 +1,136 @@
 ﻿#pragma once
+#include "aerox/math/Transform.hpp"
 #include "aerox/physics/ScenePhysics.hpp"
+#include <memory>
+#include <unordered_map>
+#include <vector>
 #include <reactphysics3d/reactphysics3d.h>
 
+namespace aerox::drawing {
+class Mesh;
+}
+
+namespace aerox::scene {
+class SceneComponent;
+}
 
 namespace aerox::physics {
 class RP3DScenePhysics : public ScenePhysics {
-  
+
+  /**
+   * \brief Records contacts and triggers while the world steps, they are turned into events at the sync point
+   */
+  class EventRecorder : public rp3d::EventListener {
+    RP3DScenePhysics *_physics = nullptr;
+  public:
+    explicit EventRecorder(RP3DScenePhysics *physics);
+    void onContact(const rp3d::CollisionCallback::CallbackData &callbackData) override;
+    void onTrigger(const rp3d::OverlapCallback::CallbackData &callbackData) override;
+  };
+
+  struct StepContact {
+    scene::SceneComponent *a = nullptr;
+    scene::SceneComponent *b = nullptr;
+    EContactType type = EContactType::Begin;
+    glm::vec3 point{0.0f};
+    glm::vec3 normal{0.0f};
+    float depth = 0.0f;
+  };
+
+  struct StepTrigger {
+    scene::SceneComponent *a = nullptr;
+    scene::SceneComponent *b = nullptr;
+    EContactType type = EContactType::Begin;
+  };
+
+  struct CookedMesh {
+    // Held so the address used as the key stays unique while the rp3d meshes exist
+    std::shared_ptr<drawing::Mesh> mesh;
+    rp3d::ConvexMesh *convex = nullptr;
+    rp3d::TriangleMesh *triangles = nullptr;
+  };
   
   rp3d::PhysicsWorld * _phys = nullptr;
+  EventRecorder _eventRecorder{this};
+
+  // Bodies and the components they drive or follow, kept as parallel arrays so syncing walks them in one pass
+  std::vector<rp3d::RigidBody *> _bodies;
+  // Types are fixed at creation, kept here so the game thread never asks a body that may be stepping
+  std::vector<rp3d::BodyType> _bodyTypes;
+  std::vector<std::weak_ptr<scene::SceneComponent>> _bodyComponents;
+  // Last two steps as seen by the scene, only touched on the game thread
+  std::vector<math::Transform> _previousTransforms;
+  std::vector<math::Transform> _currentTransforms;
+  // Last two steps as written by the stepping thread, copied to the scene side at the sync point
+  std::vector<math::Transform> _stepPreviousTransforms;
+  std::vector<math::Transform> _stepCurrentTransforms;
+  std::vector<rp3d::Transform> _transformBatch;
+  std::vector<StepContact> _stepContacts;
+  std::vector<StepTrigger> _stepTriggers;
+  std::unordered_map<const drawing::Mesh *, CookedMesh> _cookedMeshes;
+
+  void ReadBodyTransforms(std::vector<math::Transform> &out) const;
 
+  static std::weak_ptr<scene::SceneComponent> getColliderComponent(scene::SceneComponent *component);
   
 public:
 
   static rp3d::PhysicsCommon physicsCommon;
 
+  static rp3d::Transform toPhysics(const math::Transform &transform);
+  static math::Transform fromPhysics(const rp3d::Transform &transform, const math::Vec3<> &scale);
+  static rp3d::BodyType toPhysics(EBodyType type);
+
   void OnInit(scene::Scene * owner) override;
   void OnDestroy() override;
+
+  /**
+   * \brief Creates a body at component's world transform. Dynamic bodies move component, static and kinematic bodies follow it.
+   * Changes to the returned body must go through PushCommand.
+   */
+  rp3d::RigidBody *CreateBody(const std::shared_ptr<scene::SceneComponent> &component, rp3d::BodyType type);
+
+  void DestroyBody(rp3d::RigidBody *body);
+
+  /**
+   * \brief Adds shape to body, contacts with the collider are reported for component
+   */
+  rp3d::Collider *AddCollider(rp3d::RigidBody *body, rp3d::CollisionShape *shape, const math::Transform &localTransform,
+                              scene::SceneComponent *component);
+
+  void RemoveCollider(rp3d::RigidBody *body, rp3d::Collider *collider);
+
+  /**
+   * \brief Convex mesh built from mesh's cooked hull, shared by every shape using the mesh
+   * \return nullptr if the mesh has no cooked hull
+   */
+  rp3d::ConvexMesh *GetConvexMesh(const std::shared_ptr<drawing::Mesh> &mesh);
+
+  /**
+   * \brief Triangle mesh built from mesh's cooked triangles, shared by every shape using the mesh
+   * \return nullptr if the mesh has no cooked triangles
+   */
+  rp3d::TriangleMesh *GetTriangleMesh(const std::shared_ptr<drawing::Mesh> &mesh);
+
+  rp3d::PhysicsWorld *GetWorld() const;
+
+  void SyncToPhysics() override;
+
+  void SyncFromPhysics(float alpha) override;
+
+  void ExchangeResults() override;
   
   void InternalFixedUpdate(float deltaTime) override;
+
+  std::optional<PhysicsHit> RayCast(const math::Ray &ray, float maxDistance) override;
+
+  Array<std::weak_ptr<scene::SceneComponent>> OverlapSphere(const glm::vec3 &center, float radius) override;
+
+  Array<std::weak_ptr<scene::SceneComponent>> OverlapBox(const math::Transform &transform, const glm::vec3 &halfExtents) override;
+
+  /**
+   * \brief Every shape overlapping shape placed at transform
+   */
+  Array<std::weak_ptr<scene::SceneComponent>> Overlap(rp3d::CollisionShape *shape, const math::Transform &transform);
 };
 }
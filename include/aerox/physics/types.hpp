@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <glm/glm.hpp>
+
+namespace aerox::scene {
+class SceneComponent;
+}
+
+namespace aerox::physics {
+
+enum class EBodyType : uint8_t {
+  // Never moves
+  Static,
+  // Moved by its component, pushes dynamic bodies but is not pushed back
+  Kinematic,
+  // Moved by the simulation
+  Dynamic
+};
+
+enum class EContactType : uint8_t {
+  Begin,
+  Stay,
+  End
+};
+
+/**
+ * \brief Two colliding shapes, point and normal are in world space with the normal pointing from a to b
+ */
+struct ContactEvent {
+  std::weak_ptr<scene::SceneComponent> a;
+  std::weak_ptr<scene::SceneComponent> b;
+  EContactType type = EContactType::Begin;
+  glm::vec3 point{0.0f};
+  glm::vec3 normal{0.0f};
+  float depth = 0.0f;
+};
+
+/**
+ * \brief A shape overlapping a trigger, either may be the trigger
+ */
+struct TriggerEvent {
+  std::weak_ptr<scene::SceneComponent> a;
+  std::weak_ptr<scene::SceneComponent> b;
+  EContactType type = EContactType::Begin;
+};
+
+struct PhysicsHit {
+  std::weak_ptr<scene::SceneComponent> component;
+  glm::vec3 point{0.0f};
+  glm::vec3 normal{0.0f};
+  float distance = 0.0f;
+};
+}
@@ -0,0 +1,316 @@
+#pragma once
+#include "aerox/async/parallel.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aerox::scene {
+
+// Bytes per archetype chunk, chunks hold as many rows as fit
+constexpr size_t ENTITY_CHUNK_SIZE = 16 * 1024;
+constexpr size_t ENTITY_CHUNK_ALIGNMENT = 64;
+
+struct EntityId {
+  uint32_t index = std::numeric_limits<uint32_t>::max();
+  uint32_t generation = 0;
+
+  [[nodiscard]] bool IsValid() const;
+
+  bool operator==(const EntityId &other) const = default;
+};
+
+struct ComponentTypeInfo {
+  uint32_t id = 0;
+  size_t size = 0;
+  size_t alignment = 0;
+  void (*moveConstruct)(void *destination, void *source) = nullptr;
+  void (*destroy)(void *ptr) = nullptr;
+};
+
+uint32_t registerComponentType(ComponentTypeInfo info);
+
+const ComponentTypeInfo &getComponentTypeInfo(uint32_t id);
+
+/**
+ * \brief Id of a plain data component type, assigned the first time the type is used
+ */
+template <typename T>
+uint32_t getComponentTypeId() {
+  if constexpr (!std::is_same_v<T, std::remove_cv_t<T>>) {
+    return getComponentTypeId<std::remove_cv_t<T>>();
+  }
+  else {
+    static_assert(std::is_move_constructible_v<T>, "Components must be move constructible");
+    static const uint32_t id = registerComponentType({0, sizeof(T), alignof(T), [](void *destination, void *source) {
+      new(destination) T(std::move(*static_cast<T *>(source)));
+    }, [](void *ptr) {
+      static_cast<T *>(ptr)->~T();
+    }});
+    return id;
+  }
+}
+
+/**
+ * \brief Every entity with the same set of component types. Rows are packed into fixed size chunks where each component type has its own
+ * contiguous column, removing a row moves the last row into the hole so rows stay dense.
+ */
+class Archetype {
+  struct Chunk {
+    std::byte *data = nullptr;
+    uint32_t count = 0;
+  };
+
+  std::vector<uint32_t> _types;
+  std::vector<const ComponentTypeInfo *> _infos;
+  std::vector<size_t> _offsets;
+  std::vector<Chunk> _chunks;
+  size_t _chunkSize = ENTITY_CHUNK_SIZE;
+  uint32_t _capacity = 0;
+  size_t _count = 0;
+
+  size_t ComputeLayout(uint32_t capacity);
+
+public:
+  /**
+   * \param types Sorted component type ids
+   */
+  explicit Archetype(std::vector<uint32_t> types);
+  ~Archetype();
+
+  Archetype(const Archetype &) = delete;
+  Archetype &operator=(const Archetype &) = delete;
+
+  const std::vector<uint32_t> &GetTypes() const;
+
+  /**
+   * \return The column of type or -1
+   */
+  int32_t GetColumn(uint32_t type) const;
+
+  bool HasAll(std::span<const uint32_t> types) const;
+
+  size_t GetCount() const;
+
+  size_t GetChunkCount() const;
+
+  uint32_t GetChunkRowCount(size_t chunk) const;
+
+  uint32_t GetRowsPerChunk() const;
+
+  EntityId *GetEntities(size_t chunk) const;
+
+  void *GetColumnData(size_t chunk, uint32_t column) const;
+
+  void *GetComponent(size_t row, uint32_t column) const;
+
+  EntityId GetEntity(size_t row) const;
+
+  /**
+   * \brief Adds a row for entity, its components are left unconstructed
+   * \return The row
+   */
+  size_t Push(EntityId entity);
+
+  /**
+   * \brief Fills row with the last row
+   * \param bDestroy Destroy the components in row first, pass false if they were already moved out and destroyed
+   * \return The entity that moved into row, invalid if row was the last row
+   */
+  EntityId Remove(size_t row, bool bDestroy = true);
+};
+
+/**
+ * \brief Archetype based storage for plain data components. Entities with the same component types share an archetype so queries walk
+ * contiguous arrays, creating and destroying entities or adding and removing components is queued and applied together in Sync.
+ */
+class EntityStore {
+  struct Record {
+    Archetype *archetype = nullptr;
+    size_t row = 0;
+    uint32_t generation = 0;
+    bool bAlive = false;
+  };
+
+  struct Command {
+    enum class Type {
+      Create,
+      Destroy,
+      Add,
+      Remove
+    };
+
+    Type type;
+    EntityId entity;
+    uint32_t componentType = 0;
+    std::function<void(void *)> construct;
+  };
+
+  std::vector<Record> _records;
+  std::vector<uint32_t> _freeIndices;
+  std::vector<std::unique_ptr<Archetype>> _archetypes;
+  std::map<std::vector<uint32_t>, Archetype *> _archetypeMap;
+  std::vector<Command> _commands;
+  size_t _count = 0;
+
+  Archetype *GetOrCreateArchetype(const std::vector<uint32_t> &types);
+  void MoveEntity(EntityId entity, Archetype *target, uint32_t addedType, const std::function<void(void *)> &construct);
+  void *GetComponent(EntityId entity, uint32_t type) const;
+
+  template <typename... T>
+  std::vector<Archetype *> Match() const;
+
+  template <typename... T, typename Fn, size_t... I>
+  static void CallChunk(const Archetype *archetype, size_t chunk, Fn &fn, std::index_sequence<I...>);
+
+public:
+  EntityStore() = default;
+  EntityStore(const EntityStore &) = delete;
+  EntityStore &operator=(const EntityStore &) = delete;
+
+  /**
+   * \brief Reserves an entity id, the entity shows up in queries after the next sync
+   */
+  EntityId Create();
+
+  void Destroy(EntityId entity);
+
+  template <typename T>
+  void Add(EntityId entity, T value);
+
+  template <typename T>
+  void Remove(EntityId entity);
+
+  /**
+   * \brief Applies every queued structural change in the order it was made
+   */
+  void Sync();
+
+  bool IsAlive(EntityId entity) const;
+
+  /**
+   * \return The component or nullptr if the entity does not have one as of the last sync
+   */
+  template <typename T>
+  T *Get(EntityId entity) const;
+
+  template <typename T>
+  bool Has(EntityId entity) const;
+
+  /**
+   * \brief Calls fn(EntityId, T&...) for every entity that has all of T
+   */
+  template <typename... T, typename Fn>
+  void Each(Fn &&fn) const;
+
+  /**
+   * \brief Calls fn(std::span<const EntityId>, std::span<T>...) once per chunk holding entities with all of T
+   */
+  template <typename... T, typename Fn>
+  void EachChunk(Fn &&fn) const;
+
+  /**
+   * \brief Same as EachChunk with chunks spread across the async subsystem, fn must be safe to call from multiple threads
+   */
+  template <typename... T, typename Fn>
+  void ParallelEachChunk(Fn &&fn) const;
+
+  /**
+   * \brief Destroys every entity immediately and drops queued changes
+   */
+  void Clear();
+
+  size_t GetCount() const;
+
+  size_t GetArchetypeCount() const;
+};
+
+template <typename T>
+void EntityStore::Add(const EntityId entity, T value) {
+  auto shared = std::make_shared<T>(std::move(value));
+  _commands.push_back({Command::Type::Add, entity, getComponentTypeId<T>(), [shared](void *destination) {
+    new(destination) T(std::move(*shared));
+  }});
+}
+
+template <typename T>
+void EntityStore::Remove(const EntityId entity) {
+  _commands.push_back({Command::Type::Remove, entity, getComponentTypeId<T>(), {}});
+}
+
+template <typename T>
+T *EntityStore::Get(const EntityId entity) const {
+  return static_cast<T *>(GetComponent(entity, getComponentTypeId<T>()));
+}
+
+template <typename T>
+bool EntityStore::Has(const EntityId entity) const {
+  return GetComponent(entity, getComponentTypeId<T>()) != nullptr;
+}
+
+template <typename... T>
+std::vector<Archetype *> EntityStore::Match() const {
+  const uint32_t types[] = {getComponentTypeId<T>()..., 0};
+  std::vector<Archetype *> result;
+  for (const auto &archetype : _archetypes) {
+    if (archetype->GetCount() > 0 && archetype->HasAll({types, sizeof...(T)})) {
+      result.push_back(archetype.get());
+    }
+  }
+  return result;
+}
+
+template <typename... T, typename Fn, size_t... I>
+void EntityStore::CallChunk(const Archetype *archetype, const size_t chunk, Fn &fn, std::index_sequence<I...>) {
+  const auto count = archetype->GetChunkRowCount(chunk);
+  const int32_t columns[] = {archetype->GetColumn(getComponentTypeId<T>())..., 0};
+  fn(std::span<const EntityId>{archetype->GetEntities(chunk), count},
+     std::span<T>{static_cast<T *>(archetype->GetColumnData(chunk, columns[I])), count}...);
+}
+
+template <typename... T, typename Fn>
+void EntityStore::EachChunk(Fn &&fn) const {
+  for (const auto archetype : Match<T...>()) {
+    for (size_t chunk = 0; chunk < archetype->GetChunkCount(); chunk++) {
+      CallChunk<T...>(archetype, chunk, fn, std::index_sequence_for<T...>{});
+    }
+  }
+}
+
+template <typename... T, typename Fn>
+void EntityStore::Each(Fn &&fn) const {
+  EachChunk<T...>([&fn](const std::span<const EntityId> entities, std::span<T>... components) {
+    for (size_t i = 0; i < entities.size(); i++) {
+      fn(entities[i], components[i]...);
+    }
+  });
+}
+
+template <typename... T, typename Fn>
+void EntityStore::ParallelEachChunk(Fn &&fn) const {
+  struct ChunkRef {
+    Archetype *archetype;
+    size_t chunk;
+  };
+
+  std::vector<ChunkRef> chunks;
+  for (const auto archetype : Match<T...>()) {
+    for (size_t chunk = 0; chunk < archetype->GetChunkCount(); chunk++) {
+      chunks.push_back({archetype, chunk});
+    }
+  }
+
+  async::parallelFor(chunks.size(), [&](const size_t begin, const size_t end) {
+    for (auto i = begin; i < end; i++) {
+      CallChunk<T...>(chunks[i].archetype, chunks[i].chunk, fn, std::index_sequence_for<T...>{});
+    }
+  }, 1);
+}
+}
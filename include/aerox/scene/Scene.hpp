@@ -4,7 +4,12 @@
 #include "aerox/containers/Array.hpp"
 #include "aerox/containers/Serializable.hpp"
 #include "aerox/input/SceneInputConsumer.hpp"
+#include "aerox/math/Bounds.hpp"
+#include "aerox/math/BoundsTree.hpp"
 #include "aerox/math/Transform.hpp"
+#include "aerox/physics/types.hpp"
+#include "aerox/scene/TickScheduler.hpp"
+#include "aerox/scene/TransformStore.hpp"
 #include "aerox/utils.hpp"
 #include "gen/scene/Scene.gen.hpp"
 
@@ -23,9 +28,22 @@ class ScenePhysics;
 
 namespace aerox::scene {
 class SceneObject;
+class SceneComponent;
 class LightComponent;
 class Light;
 
+// Amount the spatial index fattens object bounds by
+constexpr float SPATIAL_INDEX_MARGIN = 0.5f;
+// Ticks between spatial index quality checks
+constexpr uint32_t SPATIAL_INDEX_CHECK_INTERVAL = 120;
+// Rebuild the spatial index once its area ratio grows past the last rebuild by this factor
+constexpr float SPATIAL_INDEX_REBUILD_THRESHOLD = 1.5f;
+
+struct SceneRayHit {
+  std::weak_ptr<SceneObject> object;
+  float distance = 0.0f;
+};
+
 META_TYPE()
 class Scene : public TOwnedBy<Engine>,public Serializable {
 
@@ -38,6 +56,16 @@ class Scene : public TOwnedBy<Engine>,public Serializable {
   Array<std::shared_ptr<SceneObject>> _objectsPendingInit;
   std::shared_ptr<input::SceneInputConsumer> _inputConsumer;
   std::list<std::weak_ptr<LightComponent>> _lights;
+  math::BoundsTree _spatialIndex{SPATIAL_INDEX_MARGIN};
+  Array<SceneObject *> _spatialDirty;
+  // Objects with a rendered component that has no bounds, returned by every frustum query
+  Array<SceneObject *> _unbounded;
+  uint32_t _ticksSinceSpatialCheck = 0;
+  float _spatialAreaRatio = 0.0f;
+  TransformStore _transformStore;
+  TickScheduler _tickScheduler;
+
+  void RebalanceSpatialIndex();
 public:
   
   META_BODY()
@@ -72,6 +100,75 @@ public:
 
   void RegisterLight(const std::weak_ptr<LightComponent>& light);
 
+  /**
+   * \brief Queue an object to have its bounds updated in the spatial index
+   */
+  void MarkSpatialDirty(SceneObject *object);
+
+  void RemoveFromSpatialIndex(SceneObject *object);
+
+  /**
+   * \brief Applies all pending bounds changes to the spatial index, queries call this before running
+   */
+  void UpdateSpatialIndex();
+
+  const math::BoundsTree &GetSpatialIndex() const;
+
+  /**
+   * \brief Local and world matrices of every scene component in this scene, world matrices are brought up to date once per tick
+   */
+  TransformStore &GetTransformStore();
+
+  /**
+   * \brief Ticks the objects that opted in to ticking, grouped around the physics step
+   */
+  TickScheduler &GetTickScheduler();
+
+  /**
+   * \brief Runs fn once the current tick group is done, immediately outside of ticks. Use for structural changes from ticking objects.
+   */
+  void Defer(std::function<void()> fn);
+
+  /**
+   * \brief Removes object from the scene, deferred until the current tick group is done when called while ticking
+   */
+  void DestroySceneObject(const std::shared_ptr<SceneObject> &object);
+
+  /**
+   * \brief Objects without bounds are never returned, they have nothing to test against
+   */
+  Array<std::weak_ptr<SceneObject>> QueryBounds(const math::Bounds &bounds);
+
+  /**
+   * \brief Objects without bounds are never returned, they have nothing to test against
+   */
+  Array<std::weak_ptr<SceneObject>> QuerySphere(const math::Sphere &sphere);
+
+  /**
+   * \brief Objects without bounds are always returned so they are never culled
+   */
+  Array<std::weak_ptr<SceneObject>> QueryFrustum(const math::Frustum &frustum);
+
+  /**
+   * \brief Finds the closest object whose world bounds are hit by the ray
+   */
+  std::optional<SceneRayHit> RayCast(const math::Ray &ray, float maxDistance);
+
+  /**
+   * \brief Finds the closest collision shape hit by the ray in the physics world
+   */
+  std::optional<physics::PhysicsHit> PhysicsRayCast(const math::Ray &ray, float maxDistance);
+
+  /**
+   * \brief Collision shapes overlapping a sphere in the physics world
+   */
+  Array<std::weak_ptr<SceneComponent>> PhysicsOverlapSphere(const glm::vec3 &center, float radius);
+
+  /**
+   * \brief Collision shapes overlapping a box in the physics world, transform's scale is ignored
+   */
+  Array<std::weak_ptr<SceneComponent>> PhysicsOverlapBox(const math::Transform &transform, const glm::vec3 &halfExtents);
+
   /**
    * \brief Called every tick
    */
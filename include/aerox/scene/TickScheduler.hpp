@@ -0,0 +1,80 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace aerox::scene {
+class SceneObject;
+
+/**
+ * \brief When in the scene tick an object is ticked, groups run in declaration order
+ */
+enum class ETickGroup : uint8_t {
+  // Before physics steps, gameplay that drives physics
+  PrePhysics,
+  // After physics steps, gameplay that reads simulated results
+  PostPhysics,
+  // After world transforms are updated, cameras and anything that follows other objects
+  Late
+};
+
+constexpr size_t NUM_TICK_GROUPS = 3;
+
+/**
+ * \brief Ticks the scene objects that opted in to ticking. Objects in a group are split into waves so an object always ticks after
+ * the prerequisites it shares a group with, thread safe objects in a wave tick in parallel and the rest tick one by one after them.
+ * Structural changes made while a group is ticking are deferred until the group is done, objects the scene was asked to destroy in the
+ * meantime are skipped.
+ */
+class TickScheduler {
+  struct Group {
+    std::vector<SceneObject *> objects;
+    // Per wave, thread safe objects first then the rest starting at the wave's serial offset
+    std::vector<std::vector<SceneObject *>> waves;
+    std::vector<size_t> serialOffsets;
+    bool bDirty = false;
+  };
+
+  std::array<Group, NUM_TICK_GROUPS> _groups;
+  std::vector<std::function<void()>> _commands;
+  std::mutex _commandsMutex;
+  // Objects whose bounds changed during the current parallel wave, gathered per batch and handed to the scene after the wave
+  std::vector<SceneObject *> _waveSpatialDirty;
+  std::mutex _waveMutex;
+  bool _bTicking = false;
+
+  void BuildWaves(Group &group);
+
+public:
+  void Register(SceneObject *object);
+
+  void Unregister(SceneObject *object);
+
+  /**
+   * \brief Rebuilds the waves of object's group before it next ticks, call when its prerequisites change
+   */
+  void MarkDirty(const SceneObject *object);
+
+  /**
+   * \brief Runs fn once the current group is done ticking, immediately if no group is ticking. Safe to call from ticking threads.
+   */
+  void Defer(std::function<void()> fn);
+
+  void Tick(ETickGroup group, float deltaTime);
+
+  bool IsTicking() const;
+
+  /**
+   * \brief Called by the scene when an object's bounds change, keeps the object in the calling thread's list if it is ticking a parallel
+   * batch so the scene's shared list is only written once the wave is done
+   * \return True if the object was kept for later
+   */
+  static bool DeferSpatialDirty(SceneObject *object);
+
+  size_t GetCount(ETickGroup group) const;
+
+  void Clear();
+};
+}
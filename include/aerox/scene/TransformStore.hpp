@@ -0,0 +1,93 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace aerox::scene {
+
+/**
+ * \brief Scene owned storage for the local and world matrices of every scene component. Matrices are kept in flat arrays sorted by depth
+ * so parents always come before their children, Update recomputes every dirty world matrix one depth level at a time with each level
+ * split across the async subsystem. Entries are addressed by ids that stay valid until the entry is removed. Everything except Update is
+ * safe to call from several threads.
+ */
+class TransformStore {
+public:
+  static constexpr uint32_t INVALID_ID = std::numeric_limits<uint32_t>::max();
+
+private:
+  // Indexed by position in the sorted arrays
+  std::vector<glm::mat4> _local;
+  std::vector<glm::mat4> _world;
+  std::vector<uint32_t> _ids;
+  std::vector<uint32_t> _parentIndices;
+  std::vector<uint8_t> _dirty;
+
+  // Indexed by id
+  std::vector<uint32_t> _idToIndex;
+  std::vector<uint32_t> _parentIds;
+  std::vector<uint32_t> _freeIds;
+
+  // Start of every depth level in the sorted arrays, the last entry is the total count
+  std::vector<uint32_t> _levelOffsets;
+  std::vector<uint32_t> _sortChain;
+  // Held by every entry access. Objects ticking in parallel move their own components while others resolve world matrices through
+  // shared parents, Update runs outside ticks and does not take it
+  mutable std::mutex _mutex;
+  size_t _count = 0;
+  uint64_t _updates = 0;
+  bool _bOrderDirty = false;
+
+  void Sort();
+
+public:
+  /**
+   * \brief Adds an entry without a parent
+   * \return The id of the entry
+   */
+  uint32_t Add(const glm::mat4 &local);
+
+  /**
+   * \brief Removes an entry, children of the entry must be re-parented first
+   */
+  void Remove(uint32_t id);
+
+  /**
+   * \param parent The new parent or INVALID_ID to make the entry a root
+   */
+  void SetParent(uint32_t id, uint32_t parent);
+
+  uint32_t GetParent(uint32_t id) const;
+
+  void SetLocal(uint32_t id, const glm::mat4 &local);
+
+  glm::mat4 GetLocal(uint32_t id) const;
+
+  /**
+   * \brief Flags the world matrix of an entry for recomputation, this does not reach the entry's children
+   */
+  void MarkDirty(uint32_t id);
+
+  /**
+   * \brief Returns the world matrix of an entry, recomputing it and any dirty parents first. Returned by value, a reference into the
+   * arrays would outlive the lock and be moved by the next sort
+   */
+  glm::mat4 GetWorld(uint32_t id);
+
+  /**
+   * \brief Recomputes every dirty world matrix in one top down pass
+   */
+  void Update();
+
+  size_t GetCount() const;
+
+  /**
+   * \brief Number of world matrices recomputed since the last reset
+   */
+  uint64_t GetWorldUpdates() const;
+
+  void ResetWorldUpdates();
+};
+}
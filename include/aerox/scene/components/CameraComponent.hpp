@@ -24,6 +24,11 @@ public:
       const math::Transform &parentTransform) override;
 
   void SetRelativeTransform(const math::Transform &val) override;
+
+  /**
+   * \brief A point, cameras draw nothing and should not keep their owner out of culling
+   */
+  std::optional<math::Bounds> GetLocalBounds() const override;
   
   META_FUNCTION()
   static std::shared_ptr<CameraComponent> Construct() {
@@ -7,21 +7,46 @@ struct GpuLight;
 }
 
 namespace aerox::scene {
+// Irradiance below which a light is treated as out of reach when its radius is derived from its intensity
+constexpr float LIGHT_CUTOFF_IRRADIANCE = 1.0f / 256.0f;
+
 META_TYPE()
 class LightComponent : public SceneComponent {
 protected:
   float _intensity = 1.0f;
-  float _radius = 1.0f;
+  // Lights with a radius <= 0 derive one from their intensity, see GetAttenuationRadius
+  float _radius = 0.0f;
   glm::vec4 _color{1.0f};
+  uint64_t _lightVersion = 1;
+
+  /**
+   * \brief Bumps the light version so drawers refresh their copy of the light info
+   */
+  void MarkLightDirty();
+
+  void OnTransformChanged() override;
 public:
 
   META_BODY()
+
+  /**
+   * \brief Registers this light with the owner's scene
+   */
+  void OnInit(SceneObject *owner) override;
   
   void SetIntensity(float intensity);
   void SetRadius(float radius);
   void SetColor(glm::vec4 color);
 
   float GetIntensity() const;
+  float GetRadius() const;
+
+  /**
+   * \brief The radius if one was set, otherwise the distance at which inverse square falloff takes the intensity below
+   * LIGHT_CUTOFF_IRRADIANCE. Lights are culled to this radius.
+   */
+  float GetAttenuationRadius() const;
+  uint64_t GetLightVersion() const;
   glm::vec4 GetColor() const;
 
   virtual drawing::GpuLight GetLightInfo() = 0;
@@ -10,5 +10,13 @@ class RenderedComponent : public SceneComponent, public drawing::SceneDrawable {
 
 public:
   META_BODY()
+
+  /**
+   * \brief Adds this component to the owner's render list
+   */
+  void OnInit(SceneObject *owner) override;
+
+  // Override GetLocalBounds to be culled, without bounds the owner is kept out of the spatial index and drawn every frame
+
 };
 }
@@ -1,17 +1,41 @@
 ﻿#pragma once
 #include "Component.hpp"
 #include "aerox/containers/Set.hpp"
+#include "aerox/math/Bounds.hpp"
 #include "aerox/math/Transform.hpp"
+#include "aerox/scene/TransformStore.hpp"
 #include "gen/scene/components/SceneComponent.gen.hpp"
 namespace aerox::scene {
 META_TYPE()
 class SceneComponent : public Component {
   math::Transform _relativeTransform;
   SceneComponent *_parent = nullptr;
-  Set<std::weak_ptr<SceneComponent>> _children;
+  Set<std::weak_ptr<SceneComponent>,std::owner_less<std::weak_ptr<SceneComponent>>> _children;
+
+  // Entry in the scene's transform store, set once this component is initialized. The store owns the world matrix, components outside
+  // it compute theirs from the parent on every query
+  TransformStore *_transformStore = nullptr;
+  uint32_t _transformId = TransformStore::INVALID_ID;
+
+  /**
+   * \brief True when this component and all its parents scale uniformly, the world matrix then has no shear
+   */
+  bool HasUniformWorldScale() const;
+  bool UsesTransformStore() const;
+  void SyncTransformParent();
+
+protected:
+  /**
+   * \brief Called whenever the relative transform of this component or one of its parents changes
+   */
+  virtual void OnTransformChanged();
 
 public:
   META_BODY()
+
+  void OnInit(SceneObject *owner) override;
+  void OnDestroy() override;
+
   // Transformable Interface
   virtual math::Vec3<> GetRelativeLocation() const;
   virtual math::Quat GetRelativeRotation() const;
@@ -21,6 +45,7 @@ public:
   virtual math::Quat GetWorldRotation() const;
   virtual math::Vec3<> GetWorldScale() const;
   virtual math::Transform GetWorldTransform() const;
+  virtual glm::mat4 GetWorldMatrix() const;
 
   virtual void SetRelativeLocation(const math::Vec3<> &val);
   virtual void SetRelativeRotation(const math::Quat &val);
@@ -37,6 +62,11 @@ public:
                                  const std::optional<math::Quat> &rotation,
                                  const std::optional<math::Vec3<>> &scale);
 
+  /**
+   * \brief Bounds in this component's space, components without bounds return nothing
+   */
+  virtual std::optional<math::Bounds> GetLocalBounds() const;
+
   virtual SceneComponent *GetParent() const;
 
   virtual void AttachTo(const std::weak_ptr<SceneComponent> &parent);
@@ -14,6 +14,8 @@ public:
   std::weak_ptr<drawing::Mesh> GetMesh() const;
   void SetMesh(const std::shared_ptr<drawing::Mesh> &newMesh);
 
+  std::optional<math::Bounds> GetLocalBounds() const override;
+
   void Draw(
       drawing::SceneFrameData *frameData,
       const math::Transform &parentTransform) override;
@@ -3,10 +3,16 @@
 #include "aerox/Engine.hpp"
 #include "aerox/Object.hpp"
 #include "aerox/TObjectWithInit.hpp"
+#include "aerox/TypeId.hpp"
 #include "aerox/containers/Serializable.hpp"
 #include "aerox/drawing/scene/SceneDrawable.hpp"
 #include "aerox/input/SceneInputConsumer.hpp"
+#include "aerox/math/Bounds.hpp"
+#include "aerox/math/BoundsTree.hpp"
 #include "aerox/math/Transform.hpp"
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
 #include "gen/scene/objects/SceneObject.gen.hpp"
 
 namespace aerox::scene {
@@ -33,12 +39,31 @@ META_TYPE(Super=Object)
 class SceneObject : public TOwnedBy<Scene>, public drawing::SceneDrawable, public Serializable {
 
 private:
+  friend class Scene;
+  
   bool _canEverUpdate = false;
+  ETickGroup _tickGroup = ETickGroup::PrePhysics;
+  bool _bTickThreadSafe = false;
+  // Set when the scene is asked to destroy this object while a group ticks, it stops ticking at once and is removed after the group
+  std::atomic<bool> _bPendingRemoval = false;
+  std::vector<std::weak_ptr<SceneObject>> _tickPrerequisites;
   bool _isInitialized = false;
   std::weak_ptr<SceneObject> _owner;
   std::list<std::shared_ptr<Component>> _components;
+  // First component of every type GetComponentByClass was asked for, empty when there is none. Filled by the first lookup of each type
+  // so later ones never cast, adding a component starts it over
+  mutable std::unordered_map<TypeId, std::weak_ptr<void>> _componentLookup;
+  mutable std::mutex _componentLookupMutex;
   std::list<std::weak_ptr<RenderedComponent>> _renderedComponents;
   std::shared_ptr<SceneComponent> _rootComponent;
+  int32_t _spatialProxy = math::BoundsTree::NULL_NODE;
+  bool _spatialDirty = false;
+  // Kept out of the spatial index and drawn every frame because a rendered component has no bounds
+  bool _bUnbounded = false;
+  math::Bounds _spatialBounds;
+
+  void UpdateTickRegistration();
+  void ClearComponentLookup();
 public:
 
   META_BODY()
@@ -59,6 +84,17 @@ public:
   virtual void SetWorldRotation(const math::Quat &val);
   virtual void SetWorldScale(const math::Vec3<> &val);
   virtual void SetWorldTransform(const math::Transform &val);
+
+  /**
+   * \brief World space bounds of all bounded scene components, a point at the world location if there are none. Nothing when a
+   * rendered component has no bounds, the object could draw anywhere.
+   */
+  virtual std::optional<math::Bounds> GetWorldBounds() const;
+
+  /**
+   * \brief Lets the scene know this object's bounds need to be updated in the spatial index
+   */
+  void MarkBoundsDirty();
   
   /**
    * \brief Initializes all components, call after component creation is complete
@@ -70,12 +106,44 @@ public:
   virtual std::weak_ptr<input::SceneInputConsumer> GetInput();
   virtual Scene *GetScene() const;
   virtual void Tick(float deltaTime);
+
+  /**
+   * \brief Objects are only ticked once they opt in, off by default
+   */
+  void SetCanEverUpdate(bool canEverUpdate);
+  bool CanEverUpdate() const;
+
+  void SetTickGroup(ETickGroup group);
+  ETickGroup GetTickGroup() const;
+
+  /**
+   * \brief Thread safe objects may tick in parallel with other thread safe objects in their group, they must only touch their own
+   * state and make structural changes like creating or destroying objects through Scene::Defer. Moving their own components is fine,
+   * the bounds changes reach the spatial index once the wave is done
+   */
+  void SetTickThreadSafe(bool threadSafe);
+  bool IsTickThreadSafe() const;
+
+  /**
+   * \brief True once the object is being destroyed, or the scene was asked to destroy it and will once the current tick group is done
+   */
+  bool IsPendingRemoval() const;
+
+  /**
+   * \brief Makes this object tick after prerequisite when both are in the same tick group
+   */
+  void AddTickPrerequisite(const std::weak_ptr<SceneObject> &prerequisite);
+  const std::vector<std::weak_ptr<SceneObject>> &GetTickPrerequisites() const;
   
   template <typename T,typename... Args>
   TWeakConstruct<T,Args...> AddComponent(Args&&... args);
 
+  /**
+   * \brief First component that is a T. The first lookup of T casts every component, later ones read the cached result. Safe from any
+   * thread once the object stops adding components
+   */
   template <typename T>
-  std::weak_ptr<T> GetComponentByClass();
+  std::weak_ptr<T> GetComponentByClass() const;
 
   void AddToRenderList(const std::weak_ptr<RenderedComponent> &comp);
 
@@ -95,21 +163,29 @@ template <typename T, typename ... Args> TWeakConstruct<T,Args...> SceneObject::
     Args &&... args) {
   auto comp = newObject<T>(std::forward<Args>(args)...);
   auto compPtr = utils::castStatic<Component>(comp);
+  _components.push_back(compPtr);
+  ClearComponentLookup();
   if(IsInitialized() || IsInitializing()) {
     InitComponent(compPtr);
   }
-  _components.push_back(compPtr);
   
   return comp;
 }
 
-template <typename T> std::weak_ptr<T> SceneObject::GetComponentByClass() {
-  for(auto component : _components) {
-    if(auto dCast = utils::cast<T>(component)) {
-      return dCast;
+template <typename T> std::weak_ptr<T> SceneObject::GetComponentByClass() const {
+  std::lock_guard lock(_componentLookupMutex);
+  const auto [it, bInserted] = _componentLookup.try_emplace(typeIdOf<T>());
+  if (bInserted) {
+    // Earlier components win, the root is always first
+    for(const auto &component : _components) {
+      if(auto dCast = utils::cast<T>(component)) {
+        it->second = std::static_pointer_cast<void>(dCast);
+        break;
+      }
     }
   }
-  return {};
+
+  return std::static_pointer_cast<T>(it->second.lock());
 }
 
 }
@@ -6,15 +6,8 @@
 
 namespace aerox::widgets {
 
-struct ImageGpuData {
-  glm::vec4 tint; // the image tint
-  int bHasTexture = 0;
-  float borderRadius = 0.0f;
-};
-
 class Image : public GeometryWidget {
   std::shared_ptr<drawing::Texture> _image;
-  std::shared_ptr<drawing::AllocatedBuffer> _options;
   std::shared_ptr<drawing::MaterialInstance> _imageMat;
   Color _tint = {1.0f};
   
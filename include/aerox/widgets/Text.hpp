@@ -7,16 +7,11 @@ class Font;
 }
 
 namespace aerox::widgets {
-struct GpuTextOptions {
-  glm::vec4 color;
-};
-
 class Text : public Widget {
   
   String _content;
   std::shared_ptr<drawing::Font>  _font;
   std::shared_ptr<drawing::MaterialInstance> _material;
-  std::shared_ptr<drawing::AllocatedBuffer> _gpuInfo;
   float _fontSize = 50;
   float _spacing = 4.0f;
   Color _color = {1.0f};
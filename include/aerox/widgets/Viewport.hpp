@@ -5,7 +5,8 @@
 
 namespace aerox::widgets {
 class Viewport : public Canvas {
-  vk::Sampler _sampler;
+  // The scene's render target, moved to the new image when the scene resizes it
+  std::shared_ptr<drawing::Texture> _texture;
   std::shared_ptr<drawing::MaterialInstance> _shader;
   std::shared_ptr<TDelegateHandle<>> _rootResizeHandle;
   std::weak_ptr<scene::Scene> _scene;
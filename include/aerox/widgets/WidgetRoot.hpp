@@ -11,17 +11,20 @@ class WidgetRoot : public TOwnedBy<WidgetSubsystem,const std::weak_ptr<window::W
   std::shared_ptr<drawing::AllocatedImage> _drawImage;
   Array<std::shared_ptr<Widget>> _widgets;
   Size2D _size{};
-  std::shared_ptr<drawing::AllocatedBuffer> _uiGlobalBuffer;
   std::list<std::weak_ptr<Widget>> _lastHoverList;
   std::weak_ptr<drawing::WindowDrawer> _windowDrawer;
 public:
 
   TDelegate<> onResize;
   
-  std::weak_ptr<drawing::AllocatedBuffer> GetGlobalBuffer() const;
   void OnInit(WidgetSubsystem * subsystem, const std::weak_ptr<window::Window> &window) override;
 
-  virtual void Draw(drawing::RawFrameData * frame);
+  /**
+   * \brief Lays out the widgets and copies their draws, runs on the game thread
+   */
+  virtual drawing::recordFn Collect();
+
+  virtual void Record(drawing::RawFrameData * frame, const WidgetFrameData &collected, const UiGlobalBuffer &uiGb, bool bHasWidgets);
   void HandleLastHovered(const std::shared_ptr<window::MouseMovedEvent>& event);
 
   std::weak_ptr<drawing::WindowDrawer> GetWindowDrawer() const;
@@ -32,7 +32,7 @@ public:
 
   String GetName() const override;
 
-  void Draw(drawing::RawFrameData *frameData) override;
+  drawing::recordFn Collect() override;
   
   template <typename T,typename... Args>
   TSharedConstruct<T,Args...> CreateWidget(Args &&... args);
@@ -44,7 +44,10 @@ public:
   virtual void CreateRoot(const std::weak_ptr<window::Window>& window);
   virtual void DestroyRoot(const std::weak_ptr<window::Window>& window);
 
-  std::shared_ptr<drawing::MaterialInstance> CreateMaterialInstance(const Array<std::shared_ptr<drawing::Shader>> &shaders);
+  /**
+   * \brief params are one slot each, in the order the shaders read them from materials.data[pRect.material]
+   */
+  std::shared_ptr<drawing::MaterialInstance> CreateMaterialInstance(const Array<std::shared_ptr<drawing::Shader>> &shaders, const Array<std::string> &params = {});
 
   virtual void Tick(float deltaTime);
 };
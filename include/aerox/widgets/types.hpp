@@ -92,13 +92,26 @@ struct DrawInfo {
   // Rect drawRect;
 };
 
+struct WidgetFrameData;
+
+typedef std::function<void(const WidgetFrameData *)> widgetDrawFn;
+
 struct WidgetFrameData : drawing::SimpleFrameData {
 private:
   WidgetRoot * _root = nullptr;
+  // UiGlobalBuffer for this frame, empty while collecting
+  drawing::FrameUpload _globals;
 public:
-  WidgetFrameData(drawing::RawFrameData * frame,WidgetRoot * root);
+  WidgetFrameData(drawing::RawFrameData * frame,WidgetRoot * root,const drawing::FrameUpload &globals = {});
   
   WidgetRoot * GetRoot() const;
+
+  const drawing::FrameUpload &GetGlobals() const;
+
+  // Recorded in order on the render thread, widgets only lay out and add draws while collecting
+  Array<widgetDrawFn> draws;
+
+  void AddDraw(const widgetDrawFn& drawFn);
 };
 
 struct UiGlobalBuffer {
@@ -111,6 +124,9 @@ struct WidgetPushConstants {
   glm::vec4 clip{0};
   glm::vec4 extent{0};
   glm::mat4 transform{1.0f};
+  uint32_t material = 0;
+  // Address of this frame's UiGlobalBuffer
+  vk::DeviceAddress globals = 0;
 };
 
 enum EVisibility {
@@ -10,7 +10,7 @@
 #define META_FILE_ID midb1e6c6978022449780e842e52b3e6b13
 
 
-#define _meta_midb1e6c6978022449780e842e52b3e6b13_50() \
+#define _meta_midb1e6c6978022449780e842e52b3e6b13_55() \
 static std::shared_ptr<meta::Metadata> Meta; \
 std::shared_ptr<meta::Metadata> GetMeta() const;
 
@@ -10,7 +10,7 @@
 #define META_FILE_ID mid502b5ba1aff84a478a4295342211bac9
 
 
-#define _meta_mid502b5ba1aff84a478a4295342211bac9_30() \
+#define _meta_mid502b5ba1aff84a478a4295342211bac9_35() \
 static std::shared_ptr<meta::Metadata> Meta; \
 std::shared_ptr<meta::Metadata> GetMeta() const;
 
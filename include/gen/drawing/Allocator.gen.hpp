@@ -10,17 +10,17 @@
 #define META_FILE_ID mid6bcae3f110a34c42bc10d87418cb4a60
 
 
-#define _meta_mid6bcae3f110a34c42bc10d87418cb4a60_40() \
+#define _meta_mid6bcae3f110a34c42bc10d87418cb4a60_95() \
 static std::shared_ptr<meta::Metadata> Meta; \
 std::shared_ptr<meta::Metadata> GetMeta() const;
 
 
-#define _meta_mid6bcae3f110a34c42bc10d87418cb4a60_52() \
+#define _meta_mid6bcae3f110a34c42bc10d87418cb4a60_107() \
 static std::shared_ptr<meta::Metadata> Meta; \
 std::shared_ptr<meta::Metadata> GetMeta() const;
 
 
-#define _meta_mid6bcae3f110a34c42bc10d87418cb4a60_71() \
+#define _meta_mid6bcae3f110a34c42bc10d87418cb4a60_136() \
 static std::shared_ptr<meta::Metadata> Meta; \
 std::shared_ptr<meta::Metadata> GetMeta() const;
 
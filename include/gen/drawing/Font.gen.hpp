@@ -10,7 +10,7 @@
 #define META_FILE_ID mid60dca0ca41664e15a222265f95969d23
 
 
-#define _meta_mid60dca0ca41664e15a222265f95969d23_58() \
+#define _meta_mid60dca0ca41664e15a222265f95969d23_56() \
 static std::shared_ptr<meta::Metadata> Meta; \
 std::shared_ptr<meta::Metadata> GetMeta() const;
 
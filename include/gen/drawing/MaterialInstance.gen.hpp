@@ -10,7 +10,7 @@
 #define META_FILE_ID mid8246669507974e9baf0474363530d98c
 
 
-#define _meta_mid8246669507974e9baf0474363530d98c_32() \
+#define _meta_mid8246669507974e9baf0474363530d98c_48() \
 static std::shared_ptr<meta::Metadata> Meta; \
 std::shared_ptr<meta::Metadata> GetMeta() const;
 
@@ -10,7 +10,7 @@
 #define META_FILE_ID mid588fb92dd9e248c9b1980fef31340095
 
 
-#define _meta_mid588fb92dd9e248c9b1980fef31340095_46() \
+#define _meta_mid588fb92dd9e248c9b1980fef31340095_63() \
 static std::shared_ptr<meta::Metadata> Meta; \
 std::shared_ptr<meta::Metadata> GetMeta() const;
 
@@ -10,7 +10,7 @@
 #define META_FILE_ID midfe89c9ea62db4f6f8560f5666d2cecaf
 
 
-#define _meta_midfe89c9ea62db4f6f8560f5666d2cecaf_42() \
+#define _meta_midfe89c9ea62db4f6f8560f5666d2cecaf_46() \
 static std::shared_ptr<meta::Metadata> Meta; \
 std::shared_ptr<meta::Metadata> GetMeta() const;
 
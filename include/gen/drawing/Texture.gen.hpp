@@ -10,7 +10,7 @@
 #define META_FILE_ID midcaab3e5073bf4a1ab7817fdb615393b9
 
 
-#define _meta_midcaab3e5073bf4a1ab7817fdb615393b9_40() \
+#define _meta_midcaab3e5073bf4a1ab7817fdb615393b9_46() \
 static std::shared_ptr<meta::Metadata> Meta; \
 std::shared_ptr<meta::Metadata> GetMeta() const;
 
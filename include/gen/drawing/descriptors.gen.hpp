@@ -10,7 +10,7 @@
 #define META_FILE_ID mid2b4907a6730c4c4bb6b9fe8e95a0f693
 
 
-#define _meta_mid2b4907a6730c4c4bb6b9fe8e95a0f693_31() \
+#define _meta_mid2b4907a6730c4c4bb6b9fe8e95a0f693_81() \
 static std::shared_ptr<meta::Metadata> Meta; \
 std::shared_ptr<meta::Metadata> GetMeta() const;
 
@@ -10,7 +10,7 @@
 #define META_FILE_ID mid093791895ccc4e228c0b4287ebb45199
 
 
-#define _meta_mid093791895ccc4e228c0b4287ebb45199_43() \
+#define _meta_mid093791895ccc4e228c0b4287ebb45199_71() \
 static std::shared_ptr<meta::Metadata> Meta; \
 std::shared_ptr<meta::Metadata> GetMeta() const;
 
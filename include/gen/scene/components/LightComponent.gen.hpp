@@ -10,7 +10,7 @@
 #define META_FILE_ID mid57672ad715d642a780b51a32926d841d
 
 
-#define _meta_mid57672ad715d642a780b51a32926d841d_18() \
+#define _meta_mid57672ad715d642a780b51a32926d841d_30() \
 static std::shared_ptr<meta::Metadata> Meta; \
 std::shared_ptr<meta::Metadata> GetMeta() const;
 
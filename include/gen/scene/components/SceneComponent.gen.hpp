@@ -10,7 +10,7 @@
 #define META_FILE_ID mid756376ef26dc49a5916e33ab91c68a8a
 
 
-#define _meta_mid756376ef26dc49a5916e33ab91c68a8a_14() \
+#define _meta_mid756376ef26dc49a5916e33ab91c68a8a_34() \
 static std::shared_ptr<meta::Metadata> Meta; \
 std::shared_ptr<meta::Metadata> GetMeta() const;
 
@@ -10,7 +10,7 @@
 #define META_FILE_ID mid7e37907faebd4a7dae41f22b5a24471a
 
 
-#define _meta_mid7e37907faebd4a7dae41f22b5a24471a_44() \
+#define _meta_mid7e37907faebd4a7dae41f22b5a24471a_69() \
 static std::shared_ptr<meta::Metadata> Meta; \
 std::shared_ptr<meta::Metadata> GetMeta() constoverride;
 
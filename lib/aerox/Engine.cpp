@@ -12,6 +12,7 @@
 #include <aerox/scripting/ScriptSubsystem.hpp>
 #include <aerox/widgets/WidgetSubsystem.hpp>
 #include <aerox/io/IoSubsystem.hpp>
+#include <aerox/utils.hpp>
 #include <bass/utils.hpp>
 
 namespace aerox {
@@ -53,6 +54,8 @@ void Engine::Run() {
   });
 
   RunGame();
+  // Wake the render thread if it is waiting for a snapshot
+  _drawer->StopRendering();
   drawThread.join();
 
   bIsRunning = false;
@@ -61,6 +64,46 @@ void Engine::Run() {
   Clean();
 }
 
+void Engine::Start() {
+  bIsRunning = true;
+  Init();
+
+  // Collecting draws right away so each step's frame is finished when Step returns
+  _drawer->SetFrameLatency(0);
+  _lastTickTime = Now();
+}
+
+void Engine::Step(const float deltaSeconds) {
+  _runTime += static_cast<long long>(static_cast<double>(deltaSeconds) * 1000.0);
+
+  if (!bHeadless) {
+    window::getManager()->Poll();
+  }
+
+  _inputManager->CheckMouse(deltaSeconds);
+
+  Tick(deltaSeconds);
+
+  _drawer->Collect();
+}
+
+void Engine::Stop() {
+  _drawer->StopRendering();
+  bIsRunning = false;
+
+  _asyncSubsystem->StopAll();
+  Clean();
+}
+
+void Engine::SetHeadless(const bool headless) {
+  utils::vassert(!IsRunning(), "Headless mode can only be changed before the engine starts");
+  bHeadless = headless;
+}
+
+bool Engine::IsHeadless() const {
+  return bHeadless;
+}
+
 void Engine::RunGame() {
   while (bIsRunning && !ShouldExit()) {
     const auto tickStart = Now();
@@ -69,7 +112,9 @@ void Engine::RunGame() {
     const auto deltaFloat = static_cast<float>(
       static_cast<double>(delta) / 1000.0);
 
-    window::getManager()->Poll();
+    if (!bHeadless) {
+      window::getManager()->Poll();
+    }
 
     if (!_mainWindow.expired()) {
       bExitRequested = bExitRequested || GetMainWindow().lock()->
@@ -107,7 +152,8 @@ void Engine::RunGame() {
     Tick(deltaFloat);
 
     if (!bIsMinimized) {
-      _drawer->Draw();
+      // Snapshots what to draw, the render thread records it while the next frame ticks
+      _drawer->Collect();
     }
 
     _lastTickTime = tickStart;
@@ -116,13 +162,7 @@ void Engine::RunGame() {
 
 void Engine::RunDraw() const {
   while (!ShouldExit()) {
-    std::this_thread::sleep_for(std::chrono::milliseconds{1000});
-    // if(bIsMinimized) {
-    //   std::this_thread::sleep_for(std::chrono::milliseconds{1000});
-    //   return;
-    // }
-
-    // _drawer->Draw();
+    _drawer->Draw();
   }
 }
 
@@ -148,6 +188,11 @@ std::weak_ptr<window::Window> Engine::GetMainWindow() const {
 
 vk::Extent2D Engine::GetMainWindowSize() const { return _windowExtent; }
 
+void Engine::SetMainWindowSize(const vk::Extent2D &size) {
+  utils::vassert(!IsRunning(), "The main window size can only be set before the engine starts");
+  _windowExtent = size;
+}
+
 std::weak_ptr<drawing::DrawingSubsystem> Engine::GetDrawingSubsystem() const {
   return _drawer;
 }
@@ -260,6 +305,12 @@ void Engine::Tick(float deltaTime) {
 
 
 void Engine::InitWindow() {
+  // Glfw needs a display, headless runs never start it
+  if (bHeadless) {
+    log::engine->Info("Running headless, frames are drawn offscreen");
+    return;
+  }
+
   window::getManager()->Start();
 
   AddCleanup(window::getManager()->onWindowFocusChanged->BindFunction(
@@ -288,7 +339,14 @@ void Engine::InitDrawingSubsystem() {
   _drawer = CreateDrawingSubsystem();
   _drawer->Init(this);
 
+  AddCleanup(_drawer->GetAllocator().lock()->onBudgetWarning->BindFunction(
+      [this](const drawing::GpuHeapBudget &heap) {
+        _assetManager->OnGpuMemoryPressure(heap);
+      }));
+
   AddCleanup([this] {
+    // Cached textures and meshes free their gpu memory through the drawing subsystem
+    _assetManager->ReleaseRetained(false);
     _drawer.reset();
   });
 }
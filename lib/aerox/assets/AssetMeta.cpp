@@ -3,16 +3,16 @@
 namespace aerox::assets {
 
 void AssetMeta::ReadFrom(Buffer &store) {
-  store << version;
-  store << type;
-  store << id;
-  store << tags;
-}
-
-void AssetMeta::WriteTo(Buffer &store) {
   store >> version;
   store >> type;
   store >> id;
   store >> tags;
 }
+
+void AssetMeta::WriteTo(Buffer &store) {
+  store << version;
+  store << type;
+  store << id;
+  store << tags;
+}
 }
\ No newline at end of file
@@ -1,8 +1,11 @@
 ﻿#include <aerox/assets/AssetSubsystem.hpp>
 #include "aerox/Engine.hpp"
+#include "aerox/log.hpp"
+#include "aerox/drawing/Allocator.hpp"
 #include "aerox/drawing/Font.hpp"
 #include "aerox/drawing/Mesh.hpp"
 #include "aerox/drawing/Texture.hpp"
+#include "aerox/physics/cooking.hpp"
 #include <aerox/io/io.hpp>
 #include <fstream>
 #include <fastgltf/glm_element_traits.hpp>
@@ -52,7 +55,7 @@ std::shared_ptr<AssetMeta> AssetSubsystem::CreateAssetMeta(
   meta->id = CreateAssetId();
   meta->tags = tags;
   meta->type = type;
-  meta->version = 0;
+  meta->version = ASSET_VERSION;
   return meta;
 }
 
@@ -151,6 +154,19 @@ std::shared_ptr<LiveAsset> AssetSubsystem::ImportAsset(const fs::path &path,
 }
 
 std::shared_ptr<LiveAsset> AssetSubsystem::LoadAsset(const std::string &assetId) {
+  std::shared_ptr<LiveAsset> live;
+  {
+    std::lock_guard guard(LiveAsset::_liveAssetCacheMutex);
+    if (const auto cached = LiveAsset::_liveAssetCache.find(assetId); cached != LiveAsset::_liveAssetCache.end()) {
+      live = cached->second.lock();
+    }
+  }
+
+  if (live) {
+    Retain(live);
+    return live;
+  }
+
   if (const auto assetInfo = _assets.find(assetId);
     assetInfo != _assets.end()) {
     if (const auto reflectedType = meta::find(
@@ -177,8 +193,16 @@ std::shared_ptr<LiveAsset> AssetSubsystem::LoadAsset(const std::string &assetId)
 
       inFile.close();
 
+      // Lets the asset read data written before its layout last changed
+      result->_assetVersion = assetInfo->second->meta->version;
       result->ReadFrom(assetData);
 
+      {
+        std::lock_guard guard(LiveAsset::_liveAssetCacheMutex);
+        LiveAsset::_liveAssetCache[assetId] = result;
+      }
+      Retain(result);
+
       return result;
 
     }
@@ -284,6 +308,7 @@ std::shared_ptr<drawing::Mesh> AssetSubsystem::ImportMesh(const fs::path &path)
   result->SetVertices(vertices);
   result->SetIndices(indices);
   result->SetSurfaces(surfaces);
+  result->SetCollisionData(physics::cookMeshCollision(vertices, indices));
 
   return result;
 }
@@ -634,6 +659,57 @@ std::shared_ptr<audio::AudioBuffer> AssetSubsystem::ImportAudio(
   return {};
 }
 
+void AssetSubsystem::Retain(const std::shared_ptr<LiveAsset> &asset) {
+  // Destroyed outside the lock if this was the last reference, gpu assets wait for the device when destroyed
+  std::shared_ptr<LiveAsset> evicted;
+  {
+    std::lock_guard guard(_retainedMutex);
+    _retainedAssets.remove(asset);
+    _retainedAssets.push_back(asset);
+    if (_retainedAssets.size() > NUM_RETAINED_ASSETS) {
+      evicted = std::move(_retainedAssets.front());
+      _retainedAssets.pop_front();
+    }
+  }
+}
+
+size_t AssetSubsystem::ReleaseRetained(const bool bOnlyUnused) {
+  std::list<std::shared_ptr<LiveAsset>> released;
+  {
+    std::lock_guard guard(_retainedMutex);
+    for (auto it = _retainedAssets.begin(); it != _retainedAssets.end();) {
+      const auto next = std::next(it);
+      if (!bOnlyUnused || it->use_count() == 1) {
+        released.splice(released.end(), _retainedAssets, it);
+      }
+      it = next;
+    }
+  }
+
+  const auto numReleased = released.size();
+  released.clear();
+
+  std::lock_guard guard(LiveAsset::_liveAssetCacheMutex);
+  std::erase_if(LiveAsset::_liveAssetCache, [](const auto &entry) {
+    return entry.second.expired();
+  });
+
+  return numReleased;
+}
+
+size_t AssetSubsystem::GetNumRetained() {
+  std::lock_guard guard(_retainedMutex);
+  return _retainedAssets.size();
+}
+
+void AssetSubsystem::OnGpuMemoryPressure(const drawing::GpuHeapBudget &heap) {
+  // Assets still in use would keep their memory anyway, only the ones the cache alone holds are worth letting go
+  const auto numReleased = ReleaseRetained();
+
+  log::engine->Warn("Gpu heap {} is using {} of its {} byte budget, released {} cached assets", heap.heap, heap.usage,
+                    heap.budget, numReleased);
+}
+
 String AssetSubsystem::GetName() const {
   return "assets";
 }
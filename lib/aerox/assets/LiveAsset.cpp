@@ -6,6 +6,7 @@
 
 namespace aerox::assets {
 std::unordered_map<std::string,std::weak_ptr<LiveAsset>> LiveAsset::_liveAssetCache = {};
+std::mutex LiveAsset::_liveAssetCacheMutex;
 
 void LiveAsset::SetAssetId(const std::string &id) {
   _assetId = id;
@@ -15,8 +16,14 @@ std::string LiveAsset::GetAssetId() const {
   return _assetId;
 }
 
+uint32_t LiveAsset::GetAssetVersion() const {
+  return _assetVersion;
+}
+
 bool LiveAsset::IsCached(const std::string &assetId) {
-  return _liveAssetCache.contains(assetId) && !_liveAssetCache[assetId].expired();
+  std::lock_guard guard(_liveAssetCacheMutex);
+  const auto cached = _liveAssetCache.find(assetId);
+  return cached != _liveAssetCache.end() && !cached->second.expired();
 }
 
 std::shared_ptr<LiveAsset> LiveAsset::Resolve(const std::string &assetId) {
@@ -24,40 +24,78 @@ void AsyncSubsystem::OnInit(Engine *subsystem) {
 
 void AsyncSubsystem::RunOneThread() {
   while(true) {
-    if(_tasks.empty()) {
-      std::unique_lock<std::mutex> l(_taskMutex);
-      _taskCond.wait(l);
-    }
-
-    _taskMutex.lock();
-    if(!_tasks.empty()) {
-      
-      const auto front = _tasks.front();
-      _tasks.pop();
-      _taskMutex.unlock();
+    std::shared_ptr<Task> front;
+    std::function<void()> job;
+    size_t pending;
+    {
+      std::unique_lock l(_taskMutex);
+      _taskCond.wait(l,[this] {
+        return !_tasks.empty() || !_jobs.empty();
+      });
 
-      if(!front) {
-        break;
+      if(!_jobs.empty()) {
+        job = std::move(_jobs.front());
+        _jobs.pop();
       }
-      
-      try {
-        front->Run();
-        GetLogger()->Info("Task completed, {} pending",_tasks.size());
-      } catch (std::exception& e) {
-        front->onException->Execute(e);
+      else {
+        front = _tasks.front();
+        _tasks.pop();
+        if(!front) {
+          break;
+        }
       }
-      
+      pending = _tasks.size();
     }
-    else {
-      _taskMutex.unlock();
+
+    if(job) {
+      job();
+      continue;
+    }
+      
+    try {
+      front->Run();
+      GetLogger()->Info("Task completed, {} pending",pending);
+    } catch (std::exception& e) {
+      front->onException->Execute(e);
     }
   }
 }
 
 void AsyncSubsystem::EnqueueTask(const std::shared_ptr<Task> &task) {
-  _tasks.emplace(task);
+  size_t pending;
+  {
+    std::lock_guard l(_taskMutex);
+    _tasks.emplace(task);
+    pending = _tasks.size();
+  }
+  _taskCond.notify_one();
+  GetLogger()->Info("Enqueued task, {} pending",pending);
+}
+
+void AsyncSubsystem::EnqueueJob(std::function<void()> job) {
+  {
+    std::lock_guard l(_taskMutex);
+    _jobs.emplace(std::move(job));
+  }
   _taskCond.notify_one();
-  GetLogger()->Info("Enqueued task, {} pending",_tasks.size());
+}
+
+bool AsyncSubsystem::TryRunJob() {
+  std::function<void()> job;
+  {
+    std::lock_guard l(_taskMutex);
+    if(_jobs.empty()) {
+      return false;
+    }
+    job = std::move(_jobs.front());
+    _jobs.pop();
+  }
+  job();
+  return true;
+}
+
+size_t AsyncSubsystem::GetNumThreads() const {
+  return _pool.size();
 }
 
 void AsyncSubsystem::OnDestroy() {
@@ -66,9 +104,13 @@ void AsyncSubsystem::OnDestroy() {
 }
 
 void AsyncSubsystem::StopAll() {
-  decltype(_tasks)().swap(_tasks);
-  for(auto i = 0; i < _pool.size(); i++) {
-    _tasks.emplace();
+  {
+    std::lock_guard l(_taskMutex);
+    decltype(_tasks)().swap(_tasks);
+    decltype(_jobs)().swap(_jobs);
+    for(auto i = 0; i < _pool.size(); i++) {
+      _tasks.emplace();
+    }
   }
   _taskCond.notify_all();
   for(auto &q : _pool) {
@@ -0,0 +1,77 @@
+#include "aerox/async/parallel.hpp"
+#include "aerox/Engine.hpp"
+#include "aerox/async/AsyncSubsystem.hpp"
+#include <atomic>
+
+namespace aerox::async {
+
+static std::shared_ptr<AsyncSubsystem> getRunningSubsystem() {
+  auto subsystem = Engine::Get()->GetAsyncSubsystem().lock();
+  if (subsystem && !subsystem->IsInitialized()) {
+    subsystem.reset();
+  }
+  return subsystem;
+}
+
+size_t getNumWorkers() {
+  const auto subsystem = getRunningSubsystem();
+  return subsystem ? subsystem->GetNumThreads() + 1 : 1;
+}
+
+std::vector<std::pair<size_t, size_t>> partition(const size_t count, const size_t maxBatches, const size_t minBatchSize) {
+  std::vector<std::pair<size_t, size_t>> batches;
+  if (count == 0) {
+    return batches;
+  }
+
+  const auto smallestBatch = std::max(minBatchSize, static_cast<size_t>(1));
+  // Rounded down so spreading count over the batches never leaves one below smallestBatch
+  const auto numBatches = std::max(std::min(maxBatches, count / smallestBatch), static_cast<size_t>(1));
+  const auto batchSize = (count + numBatches - 1) / numBatches;
+
+  for (size_t begin = 0; begin < count; begin += batchSize) {
+    batches.emplace_back(begin, std::min(count, begin + batchSize));
+  }
+  return batches;
+}
+
+void parallelFor(const size_t count, const std::function<void(size_t begin, size_t end)> &fn, const size_t minBatchSize) {
+  parallelFor(getRunningSubsystem(), count, fn, minBatchSize);
+}
+
+void parallelFor(const std::shared_ptr<AsyncSubsystem> &runner, const size_t count,
+                 const std::function<void(size_t begin, size_t end)> &fn, const size_t minBatchSize) {
+  if (count == 0) {
+    return;
+  }
+
+  const auto subsystem = runner && runner->IsInitialized() ? runner : nullptr;
+  const size_t numWorkers = subsystem ? subsystem->GetNumThreads() + 1 : 1;
+  const auto batches = partition(count, numWorkers, minBatchSize);
+
+  if (batches.size() <= 1) {
+    fn(0, count);
+    return;
+  }
+
+  std::atomic<size_t> remaining = 0;
+
+  for (size_t i = 1; i < batches.size(); i++) {
+    const auto [begin, end] = batches[i];
+    remaining.fetch_add(1, std::memory_order_relaxed);
+    subsystem->EnqueueJob([&fn, &remaining, begin, end] {
+      fn(begin, end);
+      remaining.fetch_sub(1, std::memory_order_release);
+    });
+  }
+
+  fn(batches.front().first, batches.front().second);
+
+  // Help out instead of blocking so nested calls from pool threads cannot starve
+  while (remaining.load(std::memory_order_acquire) > 0) {
+    if (!subsystem->TryRunJob()) {
+      std::this_thread::yield();
+    }
+  }
+}
+}
@@ -5,9 +5,15 @@
 #include <aerox/drawing/DrawingSubsystem.hpp>
 #include "VkBootstrap.h"
 #include <aerox/drawing/Allocator.hpp>
+#include <fmt/format.h>
 
 namespace aerox::drawing {
 
+    const char *getGpuMemoryCategoryName(const EGpuMemoryCategory category) {
+      static const char *names[] = {"textures", "meshes", "renderTargets", "uniforms", "staging", "other"};
+      return names[static_cast<size_t>(category)];
+    }
+
     void VmaAllocated::Write(const void * src, size_t size, size_t offset) const {
         vmaCopyMemoryToAllocation(_allocator,src,alloc,offset,size);
     }
@@ -18,10 +24,20 @@ namespace aerox::drawing {
         vmaCopyAllocationToMemory(_allocator,alloc,offset,dst,info.size);
     }
 
+    void * VmaAllocated::GetMappedData() const {
+        VmaAllocationInfo info;
+        vmaGetAllocationInfo(_allocator,alloc,&info);
+        return info.pMappedData;
+    }
+
     void Allocator::OnInit(DrawingSubsystem *subsystem) {
       TOwnedBy::OnInit(subsystem);
       auto allocatorCreateInfo = VmaAllocatorCreateInfo{};
       allocatorCreateInfo.flags = VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT;
+      // Without the extension VMA estimates budgets from the heap sizes
+      if (GetOwner()->HasMemoryBudgetExtension()) {
+        allocatorCreateInfo.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+      }
       allocatorCreateInfo.device = GetOwner()->GetVirtualDevice();
       allocatorCreateInfo.physicalDevice = GetOwner()->GetPhysicalDevice();
       allocatorCreateInfo.instance = GetOwner()->GetVulkanInstance();
@@ -30,6 +46,28 @@ namespace aerox::drawing {
       vmaCreateAllocator(&allocatorCreateInfo, &_allocator);
     }
 
+    void Allocator::Track(VmaAllocated &allocation, const EGpuMemoryCategory category) const {
+      if (allocation.alloc == nullptr) {
+        return;
+      }
+
+      VmaAllocationInfo info;
+      vmaGetAllocationInfo(_allocator, allocation.alloc, &info);
+      allocation.category = category;
+      allocation.allocatedSize = info.size;
+      _categoryBytes[static_cast<size_t>(category)] += info.size;
+      ++_categoryCounts[static_cast<size_t>(category)];
+    }
+
+    void Allocator::Untrack(const VmaAllocated &allocation) const {
+      if (allocation.allocatedSize == 0) {
+        return;
+      }
+
+      _categoryBytes[static_cast<size_t>(allocation.category)] -= allocation.allocatedSize;
+      --_categoryCounts[static_cast<size_t>(allocation.category)];
+    }
+
     void Allocator::OnDestroy() {
         vmaDestroyAllocator(_allocator);
         Object::OnDestroy();
@@ -38,7 +76,8 @@ namespace aerox::drawing {
     std::shared_ptr<AllocatedBuffer> Allocator::CreateBuffer(const size_t allocSize,
                                                      const vk::BufferUsageFlags usage, const VmaMemoryUsage memoryUsage,
                                                      const vk::MemoryPropertyFlags requiredFlags,
-                                                     const VmaAllocationCreateFlags flags,const std::string& name) const {
+                                                     const VmaAllocationCreateFlags flags,const std::string& name,
+                                                     const EGpuMemoryCategory category) const {
         const auto bufferInfo = vk::BufferCreateInfo({}, allocSize,
                                                      usage);
         //vma::AllocationCreateFlagBits::eMapped
@@ -62,6 +101,8 @@ namespace aerox::drawing {
         result->buffer = rawBuffer;
         result->size = allocSize;
       vmaSetAllocationName(_allocator,result->alloc,name.c_str());
+      Track(*result, category);
+      ++_buffers;
 
         return result;
     }
@@ -77,7 +118,8 @@ namespace aerox::drawing {
                             vk::MemoryPropertyFlagBits::eHostCoherent,
                             VMA_ALLOCATION_CREATE_MAPPED_BIT | (randomAccess
                                                                 ? VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT
-                                                                : VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT),name);
+                                                                : VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT),name,
+                            EGpuMemoryCategory::Staging);
     }
 
     std::shared_ptr<AllocatedBuffer> Allocator::CreateUniformCpuGpuBuffer(
@@ -90,10 +132,13 @@ namespace aerox::drawing {
                 VMA_ALLOCATION_CREATE_MAPPED_BIT |
                 (randomAccess
                  ? VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT
-                 : VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT),name);
+                 : VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT),name,
+                EGpuMemoryCategory::Uniform);
     }
 
     void Allocator::DestroyBuffer(const AllocatedBuffer &buffer) const {
+        Untrack(buffer);
+        --_buffers;
         vmaDestroyBuffer(_allocator, buffer.buffer, buffer.alloc);
     }
 
@@ -123,16 +168,140 @@ namespace aerox::drawing {
         result->extent = createInfo.extent;
 
       vmaSetAllocationName(_allocator,result->alloc,name.c_str());
+      constexpr auto attachmentUsage = vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eDepthStencilAttachment;
+      Track(*result, createInfo.usage & attachmentUsage ? EGpuMemoryCategory::RenderTarget : EGpuMemoryCategory::Texture);
+      ++_images;
 
         return result;
     }
 
     void Allocator::DestroyImage(const AllocatedImage &image) const {
+        Untrack(image);
+        --_images;
         GetOwner()->GetVirtualDevice().destroyImageView(image.view);
 
         vmaDestroyImage(_allocator, image.image, image.alloc);
     }
 
+    std::shared_ptr<VmaAllocated> Allocator::AllocateMemory(
+            const vk::MemoryRequirements &requirements,
+            const vk::MemoryPropertyFlags requiredFlags,const std::string& name,
+            const EGpuMemoryCategory category) const {
+        std::shared_ptr<VmaAllocated> result = std::shared_ptr<VmaAllocated>(new VmaAllocated(_allocator), [this](const VmaAllocated *ptr) {
+            Untrack(*ptr);
+            vmaFreeMemory(_allocator, ptr->alloc);
+            delete ptr;
+        });
+
+        VmaAllocationCreateInfo allocInfo = {};
+        allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+        allocInfo.requiredFlags = static_cast<VkMemoryPropertyFlags>(requiredFlags);
+
+        const VkMemoryRequirements vmaRequirements = requirements;
+        vmaAllocateMemory(_allocator, &vmaRequirements, &allocInfo, &result->alloc, nullptr);
+
+      vmaSetAllocationName(_allocator,result->alloc,name.c_str());
+      Track(*result, category);
+
+        return result;
+    }
+
+    std::shared_ptr<AllocatedImage> Allocator::AllocateAliasedImage(
+            vk::ImageCreateInfo &createInfo,
+            const std::shared_ptr<VmaAllocated> &memory,
+            const vk::DeviceSize offset) const {
+        // The image has no allocation of its own so destroying it leaves the memory alone
+        std::shared_ptr<AllocatedImage> result = std::shared_ptr<AllocatedImage>(new AllocatedImage(_allocator), [this, memory](const AllocatedImage *ptr) {
+            DestroyImage(*ptr);
+            delete ptr;
+        });
+        result->alloc = nullptr;
+
+        result->image = GetOwner()->GetVirtualDevice().createImage(createInfo);
+        vmaBindImageMemory2(_allocator, memory->alloc, offset, static_cast<VkImage>(result->image), nullptr);
+
+        result->format = createInfo.format;
+        result->extent = createInfo.extent;
+        ++_images;
+
+        return result;
+    }
+
+    Array<GpuHeapBudget> Allocator::GetHeapBudgets() const {
+        const VkPhysicalDeviceMemoryProperties *memoryProperties = nullptr;
+        vmaGetMemoryProperties(_allocator, &memoryProperties);
+
+        VmaBudget budgets[VK_MAX_MEMORY_HEAPS];
+        vmaGetHeapBudgets(_allocator, budgets);
+
+        Array<GpuHeapBudget> result;
+        for (uint32_t i = 0; i < memoryProperties->memoryHeapCount; i++) {
+            const auto &budget = budgets[i];
+            GpuHeapBudget heap;
+            heap.heap = i;
+            heap.bDeviceLocal = (memoryProperties->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+            heap.budget = budget.budget;
+            heap.usage = budget.usage;
+            heap.blockBytes = budget.statistics.blockBytes;
+            heap.allocationBytes = budget.statistics.allocationBytes;
+            heap.blockCount = budget.statistics.blockCount;
+            heap.allocationCount = budget.statistics.allocationCount;
+            result.push(heap);
+        }
+
+        return result;
+    }
+
+    GpuMemoryStats Allocator::GetMemoryStats() const {
+        GpuMemoryStats stats;
+        stats.heaps = GetHeapBudgets();
+        for (size_t i = 0; i < stats.categories.size(); i++) {
+            stats.categories[i].bytes = _categoryBytes[i];
+            stats.categories[i].count = _categoryCounts[i];
+        }
+        stats.liveBuffers = _buffers;
+        stats.liveImages = _images;
+        return stats;
+    }
+
+    std::string Allocator::DumpStatsJson(const bool detailed) const {
+        char *vmaStats = nullptr;
+        vmaBuildStatsString(_allocator, &vmaStats, detailed);
+        std::string vmaJson = vmaStats;
+        vmaFreeStatsString(_allocator, vmaStats);
+
+        const auto stats = GetMemoryStats();
+        std::string categories;
+        for (size_t i = 0; i < stats.categories.size(); i++) {
+            categories += fmt::format("{}\"{}\": {{\"bytes\": {}, \"count\": {}}}", i == 0 ? "" : ", ",
+                                      getGpuMemoryCategoryName(static_cast<EGpuMemoryCategory>(i)),
+                                      stats.categories[i].bytes, stats.categories[i].count);
+        }
+
+        return fmt::format("{{\"categories\": {{{}}}, \"liveBuffers\": {}, \"liveImages\": {}, \"vma\": {}}}", categories,
+                           stats.liveBuffers, stats.liveImages, vmaJson);
+    }
+
+    void Allocator::CheckBudget(const uint32_t frameIndex) {
+        vmaSetCurrentFrameIndex(_allocator, frameIndex);
+
+        for (const auto &heap : GetHeapBudgets()) {
+            const uint32_t bit = 1u << heap.heap;
+            const bool bOver = heap.budget > 0 &&
+                               static_cast<double>(heap.usage) >= static_cast<double>(heap.budget) * GPU_BUDGET_WARNING_RATIO;
+            if (!bOver) {
+                _warnedHeaps &= ~bit;
+                continue;
+            }
+
+            // Only warn again once the heap has gone back under
+            if ((_warnedHeaps & bit) == 0) {
+                _warnedHeaps |= bit;
+                onBudgetWarning->Execute(heap);
+            }
+        }
+    }
+
 
 
 
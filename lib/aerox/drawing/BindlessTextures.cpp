@@ -0,0 +1,161 @@
+#include "aerox/drawing/BindlessTextures.hpp"
+#include "aerox/drawing/types.hpp"
+#include "aerox/utils.hpp"
+#include <array>
+
+namespace aerox::drawing {
+
+IndexAllocator::IndexAllocator(const uint32_t capacity) : _capacity(capacity) {
+}
+
+uint32_t IndexAllocator::Allocate() {
+  if (!_free.empty()) {
+    const auto index = _free.back();
+    _free.pop();
+    _allocated[index] = true;
+    return index;
+  }
+
+  if (_next == _capacity) {
+    return INVALID_BINDLESS_INDEX;
+  }
+
+  _allocated.push_back(true);
+  return _next++;
+}
+
+void IndexAllocator::Free(const uint32_t index) {
+  utils::vassert(index < _next, "Freeing index {} which was never allocated", index);
+  utils::vassert(_allocated[index], "Freeing index {} twice", index);
+  _allocated[index] = false;
+  _free.push(index);
+}
+
+uint32_t IndexAllocator::GetNumAllocated() const {
+  return _next - static_cast<uint32_t>(_free.size());
+}
+
+uint32_t IndexAllocator::GetCapacity() const {
+  return _capacity;
+}
+
+void BindlessTextures::Write(const uint32_t index, const vk::ImageView view, const vk::Sampler sampler) const {
+  const vk::DescriptorImageInfo info{sampler, view, vk::ImageLayout::eShaderReadOnlyOptimal};
+  vk::WriteDescriptorSet write{};
+  write.setDstSet(_set);
+  write.setDstBinding(0);
+  write.setDstArrayElement(index);
+  write.setDescriptorType(vk::DescriptorType::eCombinedImageSampler);
+  write.setImageInfo(info);
+
+  _device.updateDescriptorSets(write, {});
+}
+
+void BindlessTextures::Init(const vk::Device device) {
+  _device = device;
+
+  // Slots without a texture are never read, written ones may change while earlier frames using other slots are in flight
+  const std::array bindings{
+      vk::DescriptorSetLayoutBinding{0, vk::DescriptorType::eCombinedImageSampler, MAX_BINDLESS_TEXTURES,
+                                     vk::ShaderStageFlagBits::eAll},
+      vk::DescriptorSetLayoutBinding{1, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eAll}};
+  const vk::DescriptorBindingFlags flags = vk::DescriptorBindingFlagBits::ePartiallyBound |
+                                           vk::DescriptorBindingFlagBits::eUpdateAfterBind;
+  const std::array bindingFlags{flags, flags};
+  const vk::DescriptorSetLayoutBindingFlagsCreateInfo flagsInfo{bindingFlags};
+  _layout = _device.createDescriptorSetLayout(
+      vk::DescriptorSetLayoutCreateInfo(vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool, bindings, &flagsInfo));
+
+  const std::array poolSizes{vk::DescriptorPoolSize{vk::DescriptorType::eCombinedImageSampler, MAX_BINDLESS_TEXTURES},
+                             vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer, 1}};
+  _pool = _device.createDescriptorPool(
+      vk::DescriptorPoolCreateInfo{vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind, 1, poolSizes});
+
+  _set = _device.allocateDescriptorSets(vk::DescriptorSetAllocateInfo{_pool, _layout}).at(0);
+}
+
+void BindlessTextures::Destroy() {
+  // Nothing is in flight anymore
+  for (auto &retired : _retired) {
+    if (retired.release) {
+      retired.release();
+    }
+  }
+  _retired.clear();
+  _device.destroyDescriptorPool(_pool);
+  _device.destroyDescriptorSetLayout(_layout);
+  _set = nullptr;
+}
+
+uint32_t BindlessTextures::Add(const vk::ImageView view, const vk::Sampler sampler) {
+  std::lock_guard guard(_mutex);
+  const auto index = _indices.Allocate();
+  utils::vassert(index != INVALID_BINDLESS_INDEX, "More than {} bindless textures", MAX_BINDLESS_TEXTURES);
+  Write(index, view, sampler);
+  return index;
+}
+
+uint32_t BindlessTextures::Replace(const uint32_t oldIndex, const vk::ImageView view, const vk::Sampler sampler,
+                                   std::function<void()> release) {
+  const auto index = Add(view, sampler);
+  Retire(oldIndex, std::move(release));
+  return index;
+}
+
+void BindlessTextures::Retire(const uint32_t index, std::function<void()> release) {
+  std::lock_guard guard(_mutex);
+  _retired.push(Retired{index, std::move(release)});
+}
+
+void BindlessTextures::Flush(RawFrameData *frame) {
+  Array<Retired> retired;
+  {
+    std::lock_guard guard(_mutex);
+    if (_retired.empty()) {
+      return;
+    }
+    retired = std::move(_retired);
+    _retired.clear();
+  }
+
+  // Earlier frames' fences have signalled by the time this frame's is waited on
+  frame->cleaner.Push([this, retired = std::move(retired)] {
+    for (const auto &[index, release] : retired) {
+      if (index != INVALID_BINDLESS_INDEX) {
+        Remove(index);
+      }
+      if (release) {
+        release();
+      }
+    }
+  });
+}
+
+void BindlessTextures::Remove(const uint32_t index) {
+  std::lock_guard guard(_mutex);
+  _indices.Free(index);
+}
+
+vk::DescriptorSetLayout BindlessTextures::GetLayout() const {
+  return _layout;
+}
+
+vk::DescriptorSet BindlessTextures::GetSet() const {
+  return _set;
+}
+
+void BindlessTextures::SetMaterialBuffer(const vk::Buffer buffer) {
+  std::lock_guard guard(_mutex);
+  // Frames bind the set without waiting for each other, binding 1 is not rewritten under them
+  utils::vassert(!_bMaterialBufferSet, "The material buffer is already bound");
+  _bMaterialBufferSet = true;
+  const vk::DescriptorBufferInfo info{buffer, 0, vk::WholeSize};
+  vk::WriteDescriptorSet write{};
+  write.setDstSet(_set);
+  write.setDstBinding(1);
+  write.setDescriptorType(vk::DescriptorType::eStorageBuffer);
+  write.setBufferInfo(info);
+
+  _device.updateDescriptorSets(write, {});
+}
+}
@@ -11,6 +11,8 @@
 #include <aerox/drawing/scene/SceneDrawer.hpp>
 #include "aerox/utils.hpp"
 #include "aerox/drawing/WindowDrawer.hpp"
+#include "aerox/drawing/OffscreenDrawer.hpp"
+#include "aerox/drawing/barriers.hpp"
 #include "aerox/widgets/WidgetSubsystem.hpp"
 #include "aerox/window/Window.hpp"
 
@@ -72,7 +74,14 @@ void DrawingSubsystem::InitDescriptors() {
 
   _globalAllocator.Init(_device, 10, sizes);
 
+  _bindlessTextures.Init(_device);
+
+  _materialBuffer.Init(this);
+  _bindlessTextures.SetMaterialBuffer(_materialBuffer.GetBuffer()->buffer);
+
   AddCleanup([this] {
+    _materialBuffer.Destroy();
+    _bindlessTextures.Destroy();
     _globalAllocator.DestroyPools();
   });
 }
@@ -160,10 +169,7 @@ void DrawingSubsystem::GenerateMipMaps(const vk::CommandBuffer cmd,
     halfSize.width /= 2;
     halfSize.height /= 2;
 
-    vk::ImageMemoryBarrier2 imageBarrier{};
-
-    TransitionImage(cmd, image, vk::ImageLayout::eTransferDstOptimal,
-                    vk::ImageLayout::eTransferSrcOptimal,
+    transitionImage(cmd, image, EImageUsage::TransferDst, EImageUsage::TransferSrc,
                     ImageSubResourceRange(vk::ImageAspectFlagBits::eColor).setLevelCount(1).setBaseMipLevel(mip));
 
     if (mip < mipLevels - 1) {
@@ -196,54 +202,20 @@ void DrawingSubsystem::GenerateMipMaps(const vk::CommandBuffer cmd,
     }
   }
 
-  TransitionImage(cmd, image, vk::ImageLayout::eTransferSrcOptimal,
-                    vk::ImageLayout::eShaderReadOnlyOptimal);
-}
-
-void DrawingSubsystem::TransitionImage(vk::CommandBuffer cmd, vk::Image image,
-                                       vk::ImageLayout from, vk::ImageLayout to,
-                                       const std::variant<
-                                         vk::ImageSubresourceRange,
-                                         vk::ImageAspectFlags> &
-                                       resourceOrAspect,
-                                       vk::PipelineStageFlags2 srcStageFlags,
-                                       vk::PipelineStageFlags2 dstStageFlags,
-                                       vk::AccessFlags2 srcAccessFlags,
-                                       vk::AccessFlags2 dstAccessFlags
-                                       ) {
-  vk::ImageMemoryBarrier2 imageBarrier;
-  imageBarrier
-      .setSrcStageMask(srcStageFlags)
-      .setSrcAccessMask(srcAccessFlags)
-      .setDstStageMask(dstStageFlags)
-      .setDstAccessMask(dstAccessFlags)
-      .setOldLayout(from)
-      .setNewLayout(to);
-
-  imageBarrier.setSubresourceRange(
-      std::holds_alternative<vk::ImageSubresourceRange>(resourceOrAspect)
-        ? std::get<vk::ImageSubresourceRange>(resourceOrAspect)
-        : ImageSubResourceRange(
-            std::get<vk::ImageAspectFlags>(resourceOrAspect)));
-
-  imageBarrier.setImage(image);
-
-  vk::DependencyInfo depInfo;
-  depInfo.setImageMemoryBarriers(imageBarrier);
-
-  cmd.pipelineBarrier2(&depInfo);
+  transitionImage(cmd, image, EImageUsage::TransferSrc, EImageUsage::FragmentSampled);
 }
 
 void DrawingSubsystem::WaitDeviceIdle() {
-  _deviceMutex.lock();
+  // Waiting for the device idle needs every queue, the render thread may be submitting
+  std::lock_guard deviceGuard(_deviceMutex);
+  std::lock_guard queueGuard(_queueMutex);
   _device.waitIdle();
-  _deviceMutex.unlock();
 }
 
 std::weak_ptr<WindowDrawer> DrawingSubsystem::GetWindowDrawer(
     const std::weak_ptr<window::Window> &window) {
-  if (_windowDrawers.contains(window.lock()->GetId())) {
-    return _windowDrawers[window.lock()->GetId()];
+  if (const auto windowRef = window.lock(); windowRef && _windowDrawers.contains(windowRef->GetId())) {
+    return _windowDrawers[windowRef->GetId()];
   }
 
   return {};
@@ -306,19 +278,26 @@ vk::ImageSubresourceRange DrawingSubsystem::ImageSubResourceRange(
 void DrawingSubsystem::OnInit(Engine *outer) {
   EngineSubsystem::OnInit(outer);
 
+  const auto bHeadless = GetOwner()->IsHeadless();
+
   vkb::InstanceBuilder builder;
 
-  auto [numExtensions,extensions] = window::getExtensions();
-  auto instanceResult =
-      builder.set_app_name(GetOwner()->GetAppName().c_str())
-             .require_api_version(1, 3, 0)
-             //.request_validation_layers(true)
-             .enable_extensions(numExtensions, extensions)
+  builder.set_app_name(GetOwner()->GetAppName().c_str())
+         .require_api_version(1, 3, 0);
+         //.request_validation_layers(true)
 #ifndef VULKAN_HPP_DISABLE_ENHANCED_MODE
-            .use_default_debug_messenger()
+  builder.use_default_debug_messenger();
 #endif
 
-      .build();
+  // Glfw was never started when headless, no surface extensions are needed either
+  if (bHeadless) {
+    builder.set_headless(true);
+  } else {
+    auto [numExtensions,extensions] = window::getExtensions();
+    builder.enable_extensions(numExtensions, extensions);
+  }
+
+  auto instanceResult = builder.build();
 
   auto vkbInstance = instanceResult.value();
   _instance = vkbInstance.instance;
@@ -327,9 +306,9 @@ void DrawingSubsystem::OnInit(Engine *outer) {
   debugMessenger = vkbInstance.debug_messenger;
 #endif
 
-  auto mainWindow = GetOwner()->GetMainWindow();
-
-  auto mainWindowDrawer = CreateWindowDrawer(mainWindow).lock();
+  auto mainWindowDrawer = bHeadless
+                            ? CreateOffscreenDrawer(GetOwner()->GetMainWindowSize()).lock()
+                            : CreateWindowDrawer(GetOwner()->GetMainWindow()).lock();
 
   AddCleanup([this] {
     _windowDrawers.clear();
@@ -345,16 +324,27 @@ void DrawingSubsystem::OnInit(Engine *outer) {
             .setDescriptorBindingSampledImageUpdateAfterBind(true)
             .setDescriptorBindingStorageImageUpdateAfterBind(true)
             .setScalarBlockLayout(true)
-            .setDescriptorBindingUniformBufferUpdateAfterBind(true);
+            .setDescriptorBindingUniformBufferUpdateAfterBind(true)
+            .setDescriptorBindingPartiallyBound(true)
+            .setDescriptorBindingStorageBufferUpdateAfterBind(true)
+            .setRuntimeDescriptorArray(true)
+            .setTimelineSemaphore(true)
+            .setShaderSampledImageArrayNonUniformIndexing(true);
 
   vkb::PhysicalDeviceSelector selector{vkbInstance};
-  vkb::PhysicalDevice physicalDevice =
-      selector.set_minimum_version(1, 3)
-              .set_required_features_13(features)
-              .set_required_features_12(features12)
-              .set_surface(mainWindowDrawer->GetSurface())
-              .select()
-              .value();
+  selector.set_minimum_version(1, 3)
+          .set_required_features_13(features)
+          .set_required_features_12(features12);
+
+  if (bHeadless) {
+    selector.require_present(false);
+  } else {
+    selector.set_surface(mainWindowDrawer->GetSurface());
+  }
+
+  vkb::PhysicalDevice physicalDevice = selector.select().value();
+
+  _bMemoryBudgetExtension = physicalDevice.enable_extension_if_present(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
 
   vkb::DeviceBuilder deviceBuilder{physicalDevice};
 
@@ -369,6 +359,12 @@ void DrawingSubsystem::OnInit(Engine *outer) {
   _graphicsQueueFamily = vkbDevice.get_queue_index(vkb::QueueType::graphics).
                                    value();
 
+  // Uploads run next to rendering when there is a transfer only queue
+  if (auto transferQueue = vkbDevice.get_dedicated_queue(vkb::QueueType::transfer); transferQueue.has_value()) {
+    _transferQueue = transferQueue.value();
+    _transferQueueFamily = vkbDevice.get_dedicated_queue_index(vkb::QueueType::transfer).value();
+  }
+
   _submitThread = std::thread([this] {
     while(!IsPendingDestroy()) {
       if(_submitQueue.empty()) {
@@ -426,10 +422,17 @@ instance.destroyDebugUtilsMessengerEXT(debugMessenger);
 
   InitSyncStructures();
 
-  InitDefaultTextures();
-  
+  _uploader.Init(this, _transferQueue, _transferQueueFamily);
+
+  AddCleanup([this] {
+    _uploader.Destroy();
+  });
+
+  // Textures take a bindless index when uploaded
   InitDescriptors();
 
+  InitDefaultTextures();
+
   _shaderManager = newObject<ShaderManager>();
   _shaderManager->Init(this);
 
@@ -446,6 +449,7 @@ instance.destroyDebugUtilsMessengerEXT(debugMessenger);
   AddCleanup(window::getManager()->onWindowDestroyed->BindFunction(
                  [this](const std::weak_ptr<window::Window> &window) {
                    if(auto drawer = GetWindowDrawer(window).lock()) {
+                     WaitForRenderThread();
                      _windowDrawers.erase(_windowDrawers.find(window.lock()->GetId()));
                    }
                  }));
@@ -471,8 +475,13 @@ vk::Instance DrawingSubsystem::GetVulkanInstance() const {
   return _instance;
 }
 
+bool DrawingSubsystem::HasMemoryBudgetExtension() const {
+  return _bMemoryBudgetExtension;
+}
+
 
 void DrawingSubsystem::OnDestroy() {
+  StopRendering();
   // Wait for the device to idle
   WaitDeviceIdle();
   Object::OnDestroy();
@@ -524,9 +533,17 @@ uint32_t DrawingSubsystem::CalcMipLevels(const vk::Extent2D &extent) {
 }
 
 std::weak_ptr<WindowDrawer> DrawingSubsystem::GetMainWindowDrawer() {
+  if (const auto offscreen = _offscreenDrawer.lock()) {
+    return offscreen;
+  }
+
   return GetWindowDrawer(GetOwner()->GetMainWindow());
 }
 
+std::weak_ptr<OffscreenDrawer> DrawingSubsystem::GetOffscreenDrawer() const {
+  return _offscreenDrawer;
+}
+
 std::weak_ptr<WindowDrawer> DrawingSubsystem::CreateWindowDrawer(
     const std::weak_ptr<window::Window> &window) {
   auto drawer = newObject<WindowDrawer>();
@@ -535,8 +552,17 @@ std::weak_ptr<WindowDrawer> DrawingSubsystem::CreateWindowDrawer(
   return drawer;
 }
 
+std::weak_ptr<WindowDrawer> DrawingSubsystem::CreateOffscreenDrawer(const vk::Extent2D &extent) {
+  auto drawer = newObject<OffscreenDrawer>(extent);
+  drawer->Init({}, this);
+  // Collected and drawn like any window
+  _windowDrawers.emplace(OFFSCREEN_DRAWER_ID, drawer);
+  _offscreenDrawer = drawer;
+  return drawer;
+}
+
 vk::Format DrawingSubsystem::GetSwapchainFormat() {
-  return GetWindowDrawer(GetOwner()->GetMainWindow()).lock()->GetSwapchainFormat();
+  return GetMainWindowDrawer().lock()->GetSwapchainFormat();
 }
 
 void DrawingSubsystem::SubmitThreadSafe(const vk::SubmitInfo2 &info,
@@ -604,40 +630,13 @@ std::shared_ptr<AllocatedImage> DrawingSubsystem::CreateImage(
 
   const auto dataSize = size.depth * size.width * size.height * channels;
 
-  const auto uploadBuffer = GetAllocator().lock()->
-                                           CreateTransferCpuGpuBuffer(
-                                               dataSize, false);
-
-  uploadBuffer->Write(data,dataSize);
-
   auto newImage = CreateImage(size, format,
                               usage |
                               vk::ImageUsageFlagBits::eTransferDst
                               | vk::ImageUsageFlagBits::eTransferSrc,
                               mipMapped,name);
 
-  ImmediateSubmit([&](const vk::CommandBuffer cmd) {
-    TransitionImage(cmd, newImage->image, vk::ImageLayout::eUndefined,
-                    vk::ImageLayout::eTransferDstOptimal);
-
-    vk::BufferImageCopy copyRegion{0, 0, 0};
-    copyRegion.setImageSubresource({vk::ImageAspectFlagBits::eColor, 0, 0, 1});
-    copyRegion.setImageExtent(size);
-
-    cmd.copyBufferToImage(uploadBuffer->buffer, newImage->image,
-                          vk::ImageLayout::eTransferDstOptimal, 1, &copyRegion);
-
-    if (mipMapped) {
-      GenerateMipMaps(cmd, newImage->image,
-                      {newImage->extent.width, newImage->extent.height},
-                      mipMapFilter);
-    } else {
-      TransitionImage(cmd, newImage->image,
-                      vk::ImageLayout::eTransferDstOptimal,
-                      vk::ImageLayout::eShaderReadOnlyOptimal);
-    }
-
-  });
+  _uploader.UploadImage(newImage, data, dataSize, mipMapped, mipMapFilter);
 
   return newImage;
 }
@@ -686,13 +685,81 @@ DescriptorAllocatorGrowable *DrawingSubsystem::GetGlobalDescriptorAllocator() {
   return &_globalAllocator;
 }
 
-void DrawingSubsystem::Draw() {
+BindlessTextures *DrawingSubsystem::GetBindlessTextures() {
+  return &_bindlessTextures;
+}
+
+MaterialBuffer *DrawingSubsystem::GetMaterialBuffer() {
+  return &_materialBuffer;
+}
+
+StagingUploader *DrawingSubsystem::GetUploader() {
+  return &_uploader;
+}
+
+uint64_t DrawingSubsystem::NextFrameId() {
+  return ++_numRecorded;
+}
+
+void DrawingSubsystem::Collect() {
+  auto snapshot = std::make_shared<FrameSnapshot>();
+  snapshot->frame = _numCollected++;
+
+  _allocator->CheckBudget(static_cast<uint32_t>(snapshot->frame));
 
   for (auto &window : _windowDrawers | views::values) {
     if (window->ShouldDraw()) {
-      window->Draw();
+      WindowSnapshot windowSnapshot;
+      window->Collect(windowSnapshot);
+      snapshot->windows.push(std::move(windowSnapshot));
     }
+  }
 
+  // Everything uploaded while collecting is in flight before the snapshot is drawn
+  _uploader.Flush();
+
+  if (_frameQueue.GetLatency() == 0) {
+    DrawSnapshot(*snapshot);
+    return;
   }
+
+  _frameQueue.Push(std::move(snapshot));
+}
+
+void DrawingSubsystem::Draw() {
+  auto snapshot = _frameQueue.Pop();
+  if (!snapshot) {
+    return;
+  }
+
+  DrawSnapshot(*snapshot);
+
+  // Anything the snapshot kept alive must be released before the game thread is told it is done
+  snapshot.reset();
+  _frameQueue.Release();
+}
+
+void DrawingSubsystem::DrawSnapshot(const FrameSnapshot &snapshot) {
+  for (const auto &window : snapshot.windows) {
+    window.drawer->Draw(window);
+  }
+}
+
+void DrawingSubsystem::SetFrameLatency(const uint32_t latency) {
+  // Queued snapshots were collected for the old latency, let them drain first
+  WaitForRenderThread();
+  _frameQueue.SetLatency(std::min(latency, MAX_FRAME_LATENCY));
+}
+
+uint32_t DrawingSubsystem::GetFrameLatency() {
+  return _frameQueue.GetLatency();
+}
+
+void DrawingSubsystem::WaitForRenderThread() {
+  _frameQueue.WaitIdle();
+}
+
+void DrawingSubsystem::StopRendering() {
+  _frameQueue.Close();
 }
 }
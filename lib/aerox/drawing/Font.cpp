@@ -46,32 +46,30 @@ void Font::AddGlyph(const Glyph &glyph) {
 }
 
 bool Font::IsUploaded() const {
-  return static_cast<bool>(_gpuGlyphs);
+  return _glyphBlock.IsValid();
 }
 
 void Font::Upload() {
   if (!IsUploaded()) {
-    auto gpuData = Engine::Get()->
-                   GetDrawingSubsystem().lock()->GetAllocator().lock()->
-                   CreateUniformCpuGpuBuffer(
-                       sizeof(PackedGpuGlyphs), false);
-
-    PackedGpuGlyphs packed;
-    for (auto glyph : _glyphs) {
-      packed.glyphs[packed.numChars] = Pack(glyph);
-      if (++packed.numChars >= FONT_CHARACTERS_MAX) {
-        break;
-      }
+    const auto materials = Engine::Get()->GetDrawingSubsystem().lock()->GetMaterialBuffer();
+    auto block = materials->Allocate(static_cast<uint32_t>(_glyphs.size() * sizeof(PackedGlyph)));
+
+    Array<PackedGlyph> packed;
+    packed.reserve(_glyphs.size());
+    for (const auto &glyph : _glyphs) {
+      packed.push(Pack(glyph));
     }
 
-    gpuData->Write(packed);
-    _gpuGlyphs = gpuData;
+    materials->Write(block, packed.data(), static_cast<uint32_t>(packed.size() * sizeof(PackedGlyph)));
+    _glyphBlock = block;
   }
 }
 
 PackedGlyph Font::Pack(const Glyph &glyph) const {
   PackedGlyph gpuChar{};
-  gpuChar.info = glm::vec4{glyph.textureIndex, 0, 0, 0};
+  // Glyphs point straight at their atlas in the bindless texture set
+  const auto atlas = glyph.HasTexture() ? _textures[glyph.textureIndex]->GetBindlessIndex() : 0;
+  gpuChar.info = glm::vec4{static_cast<float>(atlas), 0, 0, 0};
   return gpuChar;
 }
 
@@ -91,13 +89,14 @@ std::optional<int> Font::GetGlyphIndex(const int id) const {
   return {};
 }
 
-std::weak_ptr<AllocatedBuffer> Font::GetPackedGlyphs() const {
-  return _gpuGlyphs;
+uint32_t Font::GetGlyphsIndex() const {
+  return _glyphBlock.GetIndex();
 }
 
-
 void Font::OnDestroy() {
   Object::OnDestroy();
-  Engine::Get()->GetDrawingSubsystem().lock()->WaitDeviceIdle();
+  const auto drawer = Engine::Get()->GetDrawingSubsystem().lock();
+  drawer->WaitDeviceIdle();
+  drawer->GetMaterialBuffer()->Free(_glyphBlock);
 }
 }
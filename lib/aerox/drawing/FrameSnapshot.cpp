@@ -0,0 +1,76 @@
+#include "aerox/drawing/FrameSnapshot.hpp"
+#include <algorithm>
+
+namespace aerox::drawing {
+
+void FrameSnapshotQueue::SetLatency(const uint32_t latency) {
+  std::lock_guard guard(_mutex);
+  _latency = latency;
+  _cond.notify_all();
+}
+
+uint32_t FrameSnapshotQueue::GetLatency() {
+  std::lock_guard guard(_mutex);
+  return _latency;
+}
+
+void FrameSnapshotQueue::Push(std::shared_ptr<FrameSnapshot> snapshot) {
+  std::unique_lock guard(_mutex);
+  _cond.wait(guard, [this] {
+    return _bClosed || _pending.size() < std::max(_latency, 1u);
+  });
+
+  if (_bClosed) {
+    return;
+  }
+
+  _pending.push_back(std::move(snapshot));
+  _cond.notify_all();
+}
+
+std::shared_ptr<FrameSnapshot> FrameSnapshotQueue::Pop() {
+  std::unique_lock guard(_mutex);
+  _renderThread = std::this_thread::get_id();
+  _cond.wait(guard, [this] {
+    return _bClosed || !_pending.empty();
+  });
+
+  if (_bClosed) {
+    return {};
+  }
+
+  auto snapshot = std::move(_pending.front());
+  _pending.pop_front();
+  _bDrawing = true;
+  _cond.notify_all();
+  return snapshot;
+}
+
+void FrameSnapshotQueue::Release() {
+  std::lock_guard guard(_mutex);
+  _bDrawing = false;
+  _cond.notify_all();
+}
+
+void FrameSnapshotQueue::WaitIdle() {
+  std::unique_lock guard(_mutex);
+  if (std::this_thread::get_id() == _renderThread) {
+    return;
+  }
+
+  _cond.wait(guard, [this] {
+    return _bClosed || (_pending.empty() && !_bDrawing);
+  });
+}
+
+void FrameSnapshotQueue::Close() {
+  std::deque<std::shared_ptr<FrameSnapshot>> dropped;
+  {
+    std::lock_guard guard(_mutex);
+    _bClosed = true;
+    dropped = std::move(_pending);
+    _pending.clear();
+    _cond.notify_all();
+  }
+}
+}
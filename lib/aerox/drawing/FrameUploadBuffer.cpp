@@ -0,0 +1,87 @@
+#include "aerox/drawing/FrameUploadBuffer.hpp"
+#include "aerox/drawing/Allocator.hpp"
+#include "aerox/drawing/DrawingSubsystem.hpp"
+#include "aerox/utils.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace aerox::drawing {
+
+LinearAllocator::LinearAllocator(const uint64_t capacity) : _capacity(capacity) {
+}
+
+std::optional<uint64_t> LinearAllocator::Allocate(const uint64_t size, const uint64_t alignment) {
+  // Rounding up below masks off the low bits, which only works for powers of two
+  utils::vassert(alignment != 0 && (alignment & (alignment - 1)) == 0, "Alignment {} is not a power of two", alignment);
+  const auto offset = (_head + alignment - 1) & ~(alignment - 1);
+  if (offset > _capacity || size > _capacity - offset) {
+    return {};
+  }
+
+  _head = offset + size;
+  return offset;
+}
+
+void LinearAllocator::Reset() {
+  _head = 0;
+}
+
+uint64_t LinearAllocator::GetUsed() const {
+  return _head;
+}
+
+uint64_t LinearAllocator::GetCapacity() const {
+  return _capacity;
+}
+
+void FrameUploadBuffer::Init(DrawingSubsystem *drawer, const vk::DeviceSize size) {
+  const auto limits = drawer->GetPhysicalDevice().getProperties().limits;
+  _minAlignment = std::max({_minAlignment, limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment});
+
+  // Coherent so writes need no flush before the frame is submitted
+  _buffer = drawer->GetAllocator().lock()->CreateBuffer(
+      size,
+      vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eStorageBuffer |
+      vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer |
+      vk::BufferUsageFlagBits::eShaderDeviceAddress,
+      VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+      vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+      VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT, "Frame Upload Buffer",
+      EGpuMemoryCategory::Uniform);
+
+  _mapped = static_cast<std::byte *>(_buffer->GetMappedData());
+  _address = drawer->GetVirtualDevice().getBufferAddress(vk::BufferDeviceAddressInfo{_buffer->buffer});
+  _allocator = LinearAllocator(size);
+}
+
+void FrameUploadBuffer::Destroy() {
+  _buffer.reset();
+  _mapped = nullptr;
+  _address = 0;
+  _allocator = LinearAllocator();
+}
+
+FrameUpload FrameUploadBuffer::Allocate(const vk::DeviceSize size, const vk::DeviceSize alignment) {
+  std::lock_guard guard(_mutex);
+  const auto offset = _allocator.Allocate(size, std::max(alignment, _minAlignment));
+  utils::vassert(offset.has_value(), "Frame upload buffer is out of space for {} bytes, {} of {} used", size,
+                 _allocator.GetUsed(), _allocator.GetCapacity());
+
+  return FrameUpload{_buffer->buffer, *offset, size, _mapped + *offset, _address + *offset};
+}
+
+FrameUpload FrameUploadBuffer::Upload(const void *src, const vk::DeviceSize size, const vk::DeviceSize alignment) {
+  const auto upload = Allocate(size, alignment);
+  std::memcpy(upload.data, src, size);
+  return upload;
+}
+
+void FrameUploadBuffer::Reset() {
+  std::lock_guard guard(_mutex);
+  _allocator.Reset();
+}
+
+vk::DeviceSize FrameUploadBuffer::GetUsed() const {
+  return _allocator.GetUsed();
+}
+}
@@ -0,0 +1,80 @@
+#include "aerox/drawing/GpuTimer.hpp"
+#include "aerox/drawing/DrawingSubsystem.hpp"
+
+namespace aerox::drawing {
+
+void GpuTimer::Init(DrawingSubsystem *drawer) {
+  _device = drawer->GetVirtualDevice();
+  const auto gpu = drawer->GetPhysicalDevice();
+  const auto limits = gpu.getProperties().limits;
+  const auto families = gpu.getQueueFamilyProperties();
+
+  if (families.at(drawer->GetQueueFamily()).timestampValidBits == 0) {
+    return;
+  }
+
+  _period = limits.timestampPeriod;
+  _pool = _device.createQueryPool({{}, vk::QueryType::eTimestamp, GPU_TIMER_MAX_SCOPES * 2});
+}
+
+void GpuTimer::Destroy() {
+  if (_pool) {
+    _device.destroyQueryPool(_pool);
+    _pool = nullptr;
+  }
+  _scopes.clear();
+}
+
+void GpuTimer::Reset(const vk::CommandBuffer cmd) {
+  _scopes.clear();
+  if (_pool) {
+    cmd.resetQueryPool(_pool, 0, GPU_TIMER_MAX_SCOPES * 2);
+  }
+}
+
+uint32_t GpuTimer::Begin(const vk::CommandBuffer cmd, const String &name) {
+  if (!_pool || _scopes.size() == GPU_TIMER_MAX_SCOPES) {
+    return INVALID_SCOPE;
+  }
+
+  const auto scope = static_cast<uint32_t>(_scopes.size());
+  _scopes.push(name);
+  cmd.writeTimestamp2(vk::PipelineStageFlagBits2::eAllCommands, _pool, scope * 2);
+  return scope;
+}
+
+void GpuTimer::End(const vk::CommandBuffer cmd, const uint32_t scope) const {
+  if (scope == INVALID_SCOPE) {
+    return;
+  }
+
+  cmd.writeTimestamp2(vk::PipelineStageFlagBits2::eAllCommands, _pool, scope * 2 + 1);
+}
+
+Array<GpuTiming> GpuTimer::Resolve() const {
+  Array<GpuTiming> timings;
+  if (!_pool || _scopes.empty()) {
+    return timings;
+  }
+
+  const auto numQueries = static_cast<uint32_t>(_scopes.size() * 2);
+  const auto [result, ticks] = _device.getQueryPoolResults<uint64_t>(
+      _pool, 0, numQueries, numQueries * sizeof(uint64_t), sizeof(uint64_t), vk::QueryResultFlagBits::e64);
+
+  // A scope that was never ended or a frame that was never submitted leaves queries unavailable
+  if (result != vk::Result::eSuccess) {
+    return timings;
+  }
+
+  for (size_t i = 0; i < _scopes.size(); i++) {
+    const auto elapsed = static_cast<double>(ticks[i * 2 + 1] - ticks[i * 2]) * _period;
+    timings.push(GpuTiming{_scopes[i], elapsed / 1000000.0});
+  }
+
+  return timings;
+}
+
+bool GpuTimer::IsSupported() const {
+  return _pool != nullptr;
+}
+}
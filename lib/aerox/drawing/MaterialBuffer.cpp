@@ -0,0 +1,159 @@
+#include "aerox/drawing/MaterialBuffer.hpp"
+#include "aerox/drawing/Allocator.hpp"
+#include "aerox/drawing/DrawingSubsystem.hpp"
+#include "aerox/utils.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace aerox::drawing {
+
+// vkCmdUpdateBuffer copies at most this much at a time
+constexpr uint32_t MAX_UPDATE_SIZE = 65536;
+
+// Dirty ranges closer than this are copied as one
+constexpr uint32_t DIRTY_MERGE_GAP = 256;
+
+constexpr vk::PipelineStageFlags2 MATERIAL_READ_STAGES = vk::PipelineStageFlagBits2::eVertexShader |
+                                                         vk::PipelineStageFlagBits2::eFragmentShader |
+                                                         vk::PipelineStageFlagBits2::eComputeShader;
+
+bool MaterialBlock::IsValid() const {
+  return size > 0;
+}
+
+uint32_t MaterialBlock::GetIndex() const {
+  return offset / MATERIAL_SLOT_SIZE;
+}
+
+void MaterialBuffer::RecordBarrier(const vk::CommandBuffer cmd, const vk::PipelineStageFlags2 srcStages,
+                                   const vk::AccessFlags2 srcAccess, const vk::PipelineStageFlags2 dstStages,
+                                   const vk::AccessFlags2 dstAccess) const {
+  vk::BufferMemoryBarrier2 barrier;
+  barrier
+      .setSrcStageMask(srcStages)
+      .setSrcAccessMask(srcAccess)
+      .setDstStageMask(dstStages)
+      .setDstAccessMask(dstAccess)
+      .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
+      .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
+      .setBuffer(_buffer->buffer)
+      .setSize(vk::WholeSize);
+
+  vk::DependencyInfo depInfo;
+  depInfo.setBufferMemoryBarriers(barrier);
+
+  cmd.pipelineBarrier2(&depInfo);
+}
+
+void MaterialBuffer::Init(DrawingSubsystem *drawer) {
+  _data.resize(MATERIAL_BUFFER_SIZE);
+  _free.push(MaterialBlock{0, MATERIAL_BUFFER_SIZE});
+  _buffer = drawer->GetAllocator().lock()->CreateBuffer(
+      MATERIAL_BUFFER_SIZE, vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst,
+      VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE, vk::MemoryPropertyFlagBits::eDeviceLocal, 0, "Material Buffer",
+      EGpuMemoryCategory::Uniform);
+}
+
+void MaterialBuffer::Destroy() {
+  _buffer.reset();
+  _free.clear();
+  _dirty.clear();
+}
+
+MaterialBlock MaterialBuffer::Allocate(const uint32_t size) {
+  std::lock_guard guard(_mutex);
+  const auto alignedSize = (std::max(size, 1u) + MATERIAL_SLOT_SIZE - 1) / MATERIAL_SLOT_SIZE * MATERIAL_SLOT_SIZE;
+
+  // First fit keeps small blocks packed at the start
+  for (auto it = _free.begin(); it != _free.end(); ++it) {
+    if (it->size < alignedSize) {
+      continue;
+    }
+
+    const MaterialBlock block{it->offset, alignedSize};
+    it->offset += alignedSize;
+    it->size -= alignedSize;
+    if (it->size == 0) {
+      _free.erase(it);
+    }
+    return block;
+  }
+
+  utils::vassert(false, "Material buffer is out of space for {} bytes", alignedSize);
+  return {};
+}
+
+void MaterialBuffer::Free(MaterialBlock &block) {
+  if (!block.IsValid()) {
+    return;
+  }
+
+  std::lock_guard guard(_mutex);
+  auto it = std::ranges::lower_bound(_free, block.offset, {}, &MaterialBlock::offset);
+  it = _free.insert(it, block);
+
+  if (const auto next = it + 1; next != _free.end() && it->offset + it->size == next->offset) {
+    it->size += next->size;
+    _free.erase(next);
+  }
+
+  if (it != _free.begin()) {
+    if (const auto prev = it - 1; prev->offset + prev->size == it->offset) {
+      prev->size += it->size;
+      _free.erase(it);
+    }
+  }
+
+  block = {};
+}
+
+void MaterialBuffer::Write(const MaterialBlock &block, const void *src, const uint32_t size, const uint32_t offset) {
+  utils::vassert(offset + size <= block.size, "Write of {} bytes at {} is outside a block of {} bytes", size, offset, block.size);
+  std::lock_guard guard(_mutex);
+  std::memcpy(_data.data() + block.offset + offset, src, size);
+
+  // Copies need 4 byte aligned offsets and sizes
+  const auto begin = (block.offset + offset) & ~3u;
+  const auto end = (block.offset + offset + size + 3) & ~3u;
+  _dirty.push(MaterialBlock{begin, end - begin});
+}
+
+void MaterialBuffer::Flush(const vk::CommandBuffer cmd) {
+  Array<MaterialBlock> ranges;
+  {
+    std::lock_guard guard(_mutex);
+    if (_dirty.empty()) {
+      return;
+    }
+
+    std::ranges::sort(_dirty, {}, &MaterialBlock::offset);
+    for (const auto &range : _dirty) {
+      if (!ranges.empty() && range.offset <= ranges.back().offset + ranges.back().size + DIRTY_MERGE_GAP) {
+        auto &last = ranges.back();
+        last.size = std::max(last.offset + last.size, range.offset + range.size) - last.offset;
+      } else {
+        ranges.push(range);
+      }
+    }
+    _dirty.clear();
+
+    // Earlier frames may still be reading what is about to be overwritten
+    RecordBarrier(cmd, MATERIAL_READ_STAGES, {}, vk::PipelineStageFlagBits2::eTransfer, vk::AccessFlagBits2::eTransferWrite);
+
+    // The data is copied into the command buffer so the cpu copy may change right after
+    for (const auto &range : ranges) {
+      for (uint32_t offset = 0; offset < range.size; offset += MAX_UPDATE_SIZE) {
+        const auto size = std::min(MAX_UPDATE_SIZE, range.size - offset);
+        cmd.updateBuffer(_buffer->buffer, range.offset + offset, size, _data.data() + range.offset + offset);
+      }
+    }
+  }
+
+  RecordBarrier(cmd, vk::PipelineStageFlagBits2::eTransfer, vk::AccessFlagBits2::eTransferWrite, MATERIAL_READ_STAGES,
+                vk::AccessFlagBits2::eShaderStorageRead);
+}
+
+std::shared_ptr<AllocatedBuffer> MaterialBuffer::GetBuffer() const {
+  return _buffer;
+}
+}
@@ -33,6 +33,13 @@ MaterialBuilder &MaterialBuilder::SetType(const EMaterialType type) {
   return *this;
 }
 
+MaterialBuilder &MaterialBuilder::AddParam(const std::string &param, const uint32_t numSlots) {
+  utils::vassert(!_params.contains(param), "Param [ {} ] Was Already Added", param);
+  _params.emplace(param, MaterialParamInfo{_numParamSlots, numSlots});
+  _numParamSlots += numSlots;
+  return *this;
+}
+
 Array<vk::PushConstantRange> MaterialBuilder::ComputePushConstantRanges(
     ShaderResources &resources) {
   Array<vk::PushConstantRange> ranges;
@@ -50,12 +57,24 @@ std::shared_ptr<MaterialInstance> MaterialBuilder::Create() {
 
   std::unordered_map<EMaterialSetType, DescriptorLayoutBuilder> layoutBuilders;
   uint32_t maxLayout = 0;
+  bool bUsesBindless = false;
   for (auto &shader : _shaders) {
     auto shaderResources = shader->GetResources();
     auto shaderStage = shader->GetStage();
+    if (shaderResources.bUsesMaterialBuffer) {
+      bUsesBindless = true;
+      maxLayout = std::max<uint32_t>(maxLayout, EMaterialSetType::Bindless);
+    }
     for (auto &val : shaderResources.images) {
       resources.images.insert(val);
 
+      // The bindless set has its own layout shared by every material
+      if (val.second.set == EMaterialSetType::Bindless) {
+        bUsesBindless = true;
+        maxLayout = std::max<uint32_t>(maxLayout, EMaterialSetType::Bindless);
+        continue;
+      }
+
       if (!layoutBuilders.contains(val.second.set)) {
         layoutBuilders.insert({val.second.set, {}});
 
@@ -103,6 +122,10 @@ std::shared_ptr<MaterialInstance> MaterialBuilder::Create() {
   Array<vk::DescriptorSetLayout> layoutsArr;
   for (auto i = 0; i < maxLayout + 1; i++) {
     auto layoutType = static_cast<EMaterialSetType>(i);
+    if (layoutType == EMaterialSetType::Bindless && bUsesBindless) {
+      layoutsArr.push(drawer->GetBindlessTextures()->GetLayout());
+      continue;
+    }
     auto layout = layoutBuilders.contains(layoutType)
                     ? layoutBuilders[layoutType].Build()
                     : DescriptorLayoutBuilder().Build();
@@ -148,10 +171,11 @@ std::shared_ptr<MaterialInstance> MaterialBuilder::Create() {
 
   instance->SetPipeline(_pipelineBuilder.Build(drawer->GetVirtualDevice()));
 
+  // Params live in the material buffer, only sets the shaders actually declare bindings in are allocated
   auto globalAllocator = drawer->GetGlobalDescriptorAllocator();
   std::unordered_map<EMaterialSetType, std::weak_ptr<DescriptorSet>> sets;
   for (auto layout : layouts) {
-    if (layout.first == EMaterialSetType::Dynamic) {
+    if (layout.first == EMaterialSetType::Dynamic || !layoutBuilders.contains(layout.first)) {
       continue;
     }
 
@@ -159,6 +183,13 @@ std::shared_ptr<MaterialInstance> MaterialBuilder::Create() {
   }
 
   instance->SetSets(sets, layouts);
+  instance->SetUsesDynamicSet(layoutBuilders.contains(EMaterialSetType::Dynamic));
+  if (bUsesBindless) {
+    instance->SetBindlessSet(drawer->GetBindlessTextures()->GetSet());
+  }
+  if (_numParamSlots > 0) {
+    instance->SetParams(_params, drawer->GetMaterialBuffer()->Allocate(_numParamSlots * MATERIAL_SLOT_SIZE));
+  }
   instance->SetResources(resources);
 
   return instance;
@@ -36,6 +36,75 @@ void MaterialInstance::SetResources(
   _shaderResources = resources;
 }
 
+void MaterialInstance::SetBindlessSet(const vk::DescriptorSet set) {
+  _bindlessSet = set;
+}
+
+void MaterialInstance::SetUsesDynamicSet(const bool bUsesDynamicSet) {
+  _bUsesDynamicSet = bUsesDynamicSet;
+}
+
+void MaterialInstance::SetParams(
+    const std::unordered_map<std::string, MaterialParamInfo> &params,
+    const MaterialBlock &block) {
+  _params = params;
+  _block = block;
+  if (_block.IsValid()) {
+    // Freed blocks are handed out again with whatever the last owner wrote
+    const Array<std::byte> zeros(_block.size);
+    Engine::Get()->GetDrawingSubsystem().lock()->GetMaterialBuffer()->Write(_block, zeros.data(), _block.size);
+  }
+}
+
+void MaterialInstance::WriteParam(const std::string &param, const void *data,
+                                  const uint32_t size) {
+  const auto info = _params.find(param);
+  utils::vassert(info != _params.end(), "Param [ {} ] Does Not Exist In Material", param);
+  utils::vassert(size <= info->second.numSlots * MATERIAL_SLOT_SIZE,
+                 "Param [ {} ] holds {} bytes, got {}", param, info->second.numSlots * MATERIAL_SLOT_SIZE, size);
+
+  Engine::Get()->GetDrawingSubsystem().lock()->GetMaterialBuffer()->Write(
+      _block, data, size, info->second.slot * MATERIAL_SLOT_SIZE);
+}
+
+void MaterialInstance::SetParamData(const std::string &param, const void *data,
+                                    const uint32_t size) {
+  {
+    std::lock_guard guard(_paramsMutex);
+    if (const auto existing = _textureParams.find(param); existing != _textureParams.end()) {
+      existing->second.second->UnBind();
+      _textureParams.erase(existing);
+    }
+  }
+
+  WriteParam(param, data, size);
+}
+
+void MaterialInstance::SetParam(const std::string &param,
+                                const std::shared_ptr<Texture> &texture) {
+  utils::vassert(static_cast<bool>(texture), "Texture Is Invalid");
+
+  const auto writeIndex = [this, param](const uint32_t index) {
+    const auto value = index == INVALID_BINDLESS_INDEX ? glm::vec4{0.0f}
+                                                       : glm::vec4{static_cast<float>(index), 1.0f, 0.0f, 0.0f};
+    WriteParam(param, &value, sizeof(value));
+  };
+
+  {
+    std::lock_guard guard(_paramsMutex);
+    if (const auto existing = _textureParams.find(param); existing != _textureParams.end()) {
+      existing->second.second->UnBind();
+    }
+    _textureParams[param] = {texture, texture->onBindlessIndexChanged->BindFunction(writeIndex)};
+  }
+
+  writeIndex(texture->GetBindlessIndex());
+}
+
+uint32_t MaterialInstance::GetBlockIndex() const {
+  return _block.GetIndex();
+}
+
 
 vk::Pipeline MaterialInstance::GetPipeline() const {
   return _pipeline;
@@ -70,6 +139,8 @@ void MaterialInstance::SetImage(const std::string &param,
 
   utils::vassert(imageInfo.set != EMaterialSetType::Dynamic,
                  "This function does not support dynamic descriptor sets");
+  utils::vassert(imageInfo.set != EMaterialSetType::Bindless,
+                 "Bindless textures are indexed with Texture::GetBindlessIndex");
 
   _sets[imageInfo.set].lock()->WriteImage(imageInfo.binding, image, sampler,
                                              vk::ImageLayout::eShaderReadOnlyOptimal,
@@ -88,6 +159,8 @@ void MaterialInstance::SetTexture(const std::string &param,
 
   utils::vassert(imageInfo.set != EMaterialSetType::Dynamic,
                  "This function does not support dynamic descriptor sets");
+  utils::vassert(imageInfo.set != EMaterialSetType::Bindless,
+                 "Bindless textures are indexed with Texture::GetBindlessIndex");
 
   _sets[imageInfo.set].lock()->WriteTexture(imageInfo.binding, texture,
                                                vk::ImageLayout::eShaderReadOnlyOptimal,
@@ -106,9 +179,24 @@ void MaterialInstance::SetDynamicTexture(RawFrameData *frame,
   utils::vassert(imageInfo.set == EMaterialSetType::Dynamic,
                  "This function only supports dynamic descriptor sets");
 
-  _dynamicSets[frame].lock()->WriteTexture(imageInfo.binding, texture,
-                                              vk::ImageLayout::eShaderReadOnlyOptimal,
-                                              vk::DescriptorType::eCombinedImageSampler);
+  GetDynamicSet(frame)->WriteTexture(imageInfo.binding, texture,
+                                     vk::ImageLayout::eShaderReadOnlyOptimal,
+                                     vk::DescriptorType::eCombinedImageSampler);
+}
+
+void MaterialInstance::SetDynamicBuffer(RawFrameData *frame,
+                                        const std::string &param,
+                                        const FrameUpload &upload) {
+  utils::vassert(_shaderResources.uniformBuffers.contains(param),
+                 "UniformBuffer [ {} ] Does Not Exist In Material", param);
+
+  const auto bufferInfo = _shaderResources.uniformBuffers[param];
+
+  utils::vassert(bufferInfo.set == EMaterialSetType::Dynamic,
+                 "This function only supports dynamic descriptor sets");
+
+  GetDynamicSet(frame)->WriteBuffer(bufferInfo.binding, upload,
+                                    vk::DescriptorType::eUniformBuffer);
 }
 
 void MaterialInstance::SetTextureArray(const std::string &param,
@@ -121,6 +209,8 @@ void MaterialInstance::SetTextureArray(const std::string &param,
   const auto imageInfo = _shaderResources.images[param];
   utils::vassert(imageInfo.set != EMaterialSetType::Dynamic,
                  "This function does not support dynamic descriptor sets");
+  utils::vassert(imageInfo.set != EMaterialSetType::Bindless,
+                 "Bindless textures are indexed with Texture::GetBindlessIndex");
 
   _sets[imageInfo.set].lock()->WriteTextureArray(
       imageInfo.binding, textures, vk::ImageLayout::eShaderReadOnlyOptimal,
@@ -144,41 +234,70 @@ void MaterialInstance::SetBuffer(const std::string &param,
 }
 
 void MaterialInstance::BindPipeline(RawFrameData *frame) const {
+  const SimpleFrameData frameData(frame);
+  BindPipeline(&frameData);
+}
+
+void MaterialInstance::BindPipeline(const SimpleFrameData *frame) const {
   const auto cmd = frame->GetCmd();
   cmd->bindPipeline(vk::PipelineBindPoint::eGraphics, _pipeline);
 }
 
 void MaterialInstance::BindSets(RawFrameData *frame) {
+  const SimpleFrameData frameData(frame);
+  BindSets(&frameData);
+}
+
+void MaterialInstance::BindSets(const SimpleFrameData *frame) {
 
   if (!_sets.empty()) {
     const auto cmd = frame->GetCmd();
     for (auto [fst, snd] : _sets) {
+      const auto set = snd.lock();
+      // Writes queued before the frame went out when it started, only ones made while recording are left
+      if(set->HasPendingWrites() && set->CanFlush()) {
+        set->Flush();
+      }
       cmd->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, _pipelineLayout,
                               static_cast<uint32_t>(fst),
-                              static_cast<vk::DescriptorSet>(*snd.lock().
-                                get()), {});
+                              static_cast<vk::DescriptorSet>(*set), {});
+      set->MarkUsed(frame->GetRaw()->GetId());
     }
   }
 
-  if (_layouts.contains(Dynamic)) {
+  if (_bindlessSet) {
+    frame->GetCmd()->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, _pipelineLayout,
+                                        Bindless, _bindlessSet, {});
+  }
+
+  if (_bUsesDynamicSet) {
     const auto cmd = frame->GetCmd();
+    const auto dynamicSet = GetDynamicSet(frame->GetRaw());
 
-    if (!_dynamicSets.contains(frame) || _dynamicSets[frame].expired()) {
-      AllocateDynamicSet(frame);
+    if(dynamicSet->HasPendingWrites() && dynamicSet->CanFlush()) {
+      dynamicSet->Flush();
     }
-
     cmd->bindDescriptorSets(vk::PipelineBindPoint::eGraphics, _pipelineLayout,
                             Dynamic,
-                            static_cast<vk::DescriptorSet>(*_dynamicSets[frame].
-                              lock().get()), {});
+                            static_cast<vk::DescriptorSet>(*dynamicSet.get()), {});
+    dynamicSet->MarkUsed(frame->GetRaw()->GetId());
   }
 }
 
 void MaterialInstance::AllocateDynamicSet(RawFrameData *frame) {
+  std::lock_guard guard(*frame->GetDescriptorMutex());
   _dynamicSets[frame] = frame->GetDescriptorAllocator()->Allocate(
       _layouts[EMaterialSetType::Dynamic]);
 }
 
+std::shared_ptr<DescriptorSet> MaterialInstance::GetDynamicSet(RawFrameData *frame) {
+  std::lock_guard guard(_dynamicSetsMutex);
+  if (!_dynamicSets.contains(frame) || _dynamicSets[frame].expired()) {
+    AllocateDynamicSet(frame);
+  }
+  return _dynamicSets[frame].lock();
+}
+
 void MaterialInstance::OnDestroy() {
   Object::OnDestroy();
   auto drawer = Engine::Get()->GetDrawingSubsystem().lock();
@@ -191,6 +310,15 @@ void MaterialInstance::OnDestroy() {
   }
   _dynamicSets.clear();
   _sets.clear();
+
+  {
+    std::lock_guard guard(_paramsMutex);
+    for (const auto &handle : _textureParams | std::views::values | std::views::values) {
+      handle->UnBind();
+    }
+    _textureParams.clear();
+  }
+  drawer->GetMaterialBuffer()->Free(_block);
 }
 
 }
@@ -29,8 +29,28 @@ Array<std::weak_ptr<MaterialInstance>> Mesh::GetMaterials() const {
   return weakPtr;
 }
 
+math::Bounds Mesh::GetBounds() const {
+  return _bounds;
+}
+
+const MeshCollisionData &Mesh::GetCollisionData() const {
+  return _collision;
+}
+
+bool Mesh::HasCollisionData() const {
+  return !_collision.triangleIndices.empty();
+}
+
+void Mesh::ComputeBounds() {
+  _bounds = {};
+  for(const auto &vertex : _vertices) {
+    _bounds = _bounds.Expand(glm::vec3(vertex.location));
+  }
+}
+
 void Mesh::SetVertices(const Array<Vertex> &vertices) {
   _vertices = vertices;
+  ComputeBounds();
 }
 
 void Mesh::SetIndices(const Array<uint32_t> &indices) {
@@ -48,6 +68,10 @@ void Mesh::SetMaterial(uint32_t index,
   _materials[index] = material;
 }
 
+void Mesh::SetCollisionData(MeshCollisionData collision) {
+  _collision = std::move(collision);
+}
+
 void Mesh::Upload() {
   if(!IsUploaded()) {
     _gpuData = Engine::Get()->GetDrawingSubsystem().lock()->CreateGeometryBuffers(this);
@@ -75,13 +99,25 @@ void Mesh::ReadFrom(Buffer &store) {
   store >> _vertices;
   store >> _indices;
   store >> _surfaces;
+  // Meshes saved before collision data was cooked end here
+  if(GetAssetVersion() >= assets::ASSET_VERSION_MESH_COLLISION) {
+    store >> _collision.triangleVertices;
+    store >> _collision.triangleIndices;
+    store >> _collision.hullVertices;
+    store >> _collision.hullFaces;
+  }
   _materials.resize(_surfaces.size());
+  ComputeBounds();
 }
 
 void Mesh::WriteTo(Buffer &store) {
   store << _vertices;
   store << _indices;
   store << _surfaces;
+  store << _collision.triangleVertices;
+  store << _collision.triangleIndices;
+  store << _collision.hullVertices;
+  store << _collision.hullFaces;
 }
 
 
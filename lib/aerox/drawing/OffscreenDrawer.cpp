@@ -0,0 +1,155 @@
+#include "aerox/drawing/OffscreenDrawer.hpp"
+#include "aerox/utils.hpp"
+#include "aerox/drawing/Allocator.hpp"
+#include "aerox/drawing/barriers.hpp"
+#include <cstring>
+
+namespace aerox::drawing {
+
+OffscreenDrawer::OffscreenDrawer(const vk::Extent2D &extent) {
+  _extent = extent;
+}
+
+void OffscreenDrawer::OnInit(const std::weak_ptr<window::Window> &window, DrawingSubsystem *drawer) {
+  // Skips WindowDrawer::OnInit, there is no surface to create
+  TObjectWithInit::OnInit(window, drawer);
+  _drawingSubsystem = drawer;
+  _viewport.x = 0;
+  _viewport.y = 0;
+  _viewport.width = static_cast<float>(_extent.width);
+  _viewport.height = static_cast<float>(_extent.height);
+  _viewport.minDepth = 0.0f;
+  _viewport.maxDepth = 1.0f;
+}
+
+void OffscreenDrawer::CreateResources() {
+  CreateSwapchain();
+
+  AddCleanup([this] {
+    DestroySwapchain();
+  });
+
+  InitFrames();
+  InitSyncStructures();
+  InitDescriptors();
+
+  _isReady = true;
+}
+
+void OffscreenDrawer::CreateSwapchain() {
+  _swapchainImageFormat = OFFSCREEN_FORMAT;
+  const auto allocator = _drawingSubsystem->GetAllocator().lock();
+  const auto readbackSize = static_cast<vk::DeviceSize>(_extent.width) * _extent.height * 4;
+
+  for (uint32_t i = 0; i < FRAME_OVERLAP; i++) {
+    _targets[i] = _drawingSubsystem->CreateImage(
+        vk::Extent3D{_extent.width, _extent.height, 1}, _swapchainImageFormat,
+        vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eTransferSrc, false, "Offscreen Target");
+
+    _readbacks[i] = allocator->CreateBuffer(readbackSize, vk::BufferUsageFlagBits::eTransferDst,
+                                            VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+                                            vk::MemoryPropertyFlagBits::eHostVisible |
+                                            vk::MemoryPropertyFlagBits::eHostCoherent,
+                                            VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+                                            "Offscreen Readback", EGpuMemoryCategory::Staging);
+  }
+}
+
+void OffscreenDrawer::DestroySwapchain() {
+  for (uint32_t i = 0; i < FRAME_OVERLAP; i++) {
+    _targets[i].reset();
+    _readbacks[i].reset();
+  }
+}
+
+vk::Extent2D OffscreenDrawer::GetSwapchainExtent() const {
+  return _extent;
+}
+
+void OffscreenDrawer::Draw(const WindowSnapshot &snapshot) {
+  const auto frame = GetCurrentFrame();
+  BeginFrame(frame);
+
+  const auto frameIndex = _frameCount % FRAME_OVERLAP;
+  const auto target = _targets[frameIndex];
+  const auto cmd = frame->GetCmd();
+  cmd->reset();
+  cmd->begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+
+  RecordSnapshot(frame, snapshot);
+
+  const auto timer = frame->GetTimer();
+  const auto readbackScope = timer->Begin(*cmd, "Readback");
+
+  ImageBarriers()
+      .Discard(target->image, EImageUsage::Undefined, EImageUsage::TransferDst)
+      .Record(*cmd);
+
+  if (snapshot.output) {
+    DrawingSubsystem::CopyImageToImage(*cmd, snapshot.output->image, target->image, _extent, _extent);
+  } else {
+    // Frames with nothing to show read back as transparent black instead of whatever the target held
+    cmd->clearColorImage(target->image, vk::ImageLayout::eTransferDstOptimal, vk::ClearColorValue{0.0f, 0.0f, 0.0f, 0.0f},
+                         DrawingSubsystem::ImageSubResourceRange(vk::ImageAspectFlagBits::eColor));
+  }
+
+  transitionImage(*cmd, target->image, EImageUsage::TransferDst, EImageUsage::TransferSrc);
+
+  const vk::BufferImageCopy region{0, 0, 0, {vk::ImageAspectFlagBits::eColor, 0, 0, 1}, {},
+                                   vk::Extent3D{_extent.width, _extent.height, 1}};
+  cmd->copyImageToBuffer(target->image, vk::ImageLayout::eTransferSrcOptimal, _readbacks[frameIndex]->buffer, region);
+
+  vk::BufferMemoryBarrier2 hostBarrier;
+  hostBarrier
+      .setSrcStageMask(vk::PipelineStageFlagBits2::eCopy)
+      .setSrcAccessMask(vk::AccessFlagBits2::eTransferWrite)
+      .setDstStageMask(vk::PipelineStageFlagBits2::eHost)
+      .setDstAccessMask(vk::AccessFlagBits2::eHostRead)
+      .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
+      .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
+      .setBuffer(_readbacks[frameIndex]->buffer)
+      .setSize(vk::WholeSize);
+
+  vk::DependencyInfo depInfo;
+  depInfo.setBufferMemoryBarriers(hostBarrier);
+  cmd->pipelineBarrier2(&depInfo);
+
+  timer->End(*cmd, readbackScope);
+
+  cmd->end();
+
+  const auto cmdInfo = vk::CommandBufferSubmitInfo(*cmd, 0);
+
+  // Nothing to acquire or present, the frame only waits for uploads
+  const auto uploader = _drawingSubsystem->GetUploader();
+  const auto waitingInfo = vk::SemaphoreSubmitInfo(uploader->GetSemaphore(), uploader->Flush(),
+                                                   vk::PipelineStageFlagBits2::eAllCommands);
+
+  _drawingSubsystem->SubmitThreadSafe(vk::SubmitInfo2({}, waitingInfo, cmdInfo), frame->GetRenderFence());
+
+  _frameCount++;
+}
+
+FrameCapture OffscreenDrawer::ReadFrame() {
+  utils::vassert(_frameCount > 0, "Offscreen drawer has not drawn a frame yet");
+
+  const auto frameIndex = (_frameCount - 1) % FRAME_OVERLAP;
+  auto &frame = _frames[frameIndex];
+  vk::resultCheck(GetVirtualDevice().waitForFences({frame.GetRenderFence()}, true, UINT64_MAX),
+                  "Failed to wait for the offscreen frame");
+
+  FrameCapture capture;
+  capture.frame = static_cast<uint64_t>(_frameCount - 1);
+  capture.extent = _extent;
+  capture.pixels.resize(static_cast<size_t>(_extent.width) * _extent.height * 4);
+  std::memcpy(capture.pixels.data(), _readbacks[frameIndex]->GetMappedData(), capture.pixels.size());
+  capture.timings = frame.GetTimer()->Resolve();
+
+  return capture;
+}
+
+void OffscreenDrawer::OnDestroy() {
+  // Skips WindowDrawer::OnDestroy, there is no surface to destroy
+  Object::OnDestroy();
+}
+}
@@ -0,0 +1,71 @@
+#include "aerox/drawing/ParallelRecorder.hpp"
+#include "aerox/async/parallel.hpp"
+#include "aerox/drawing/WindowDrawer.hpp"
+
+namespace aerox::drawing {
+
+ParallelRecorder::ParallelRecorder(RawFrameData *frame, const size_t count, const size_t minBatchSize) {
+  _frame = frame;
+  // One batch per worker pool so a pool is never used by two threads at once
+  _batches = async::partition(count, _frame->GetWorkerPools()->GetNumWorkers(), minBatchSize);
+}
+
+bool ParallelRecorder::IsParallel() const {
+  return _batches.size() > 1;
+}
+
+vk::RenderingFlags ParallelRecorder::GetRenderingFlags() const {
+  return IsParallel() ? vk::RenderingFlagBits::eContentsSecondaryCommandBuffers : vk::RenderingFlags{};
+}
+
+void ParallelRecorder::Record(const Array<vk::Format> &colorFormats, const vk::Format depthFormat,
+                              const std::function<void(vk::CommandBuffer *cmd, size_t begin, size_t end)> &fn) const {
+  if (_batches.empty()) {
+    return;
+  }
+
+  if (!IsParallel()) {
+    fn(_frame->GetCmd(), _batches.front().first, _batches.front().second);
+    return;
+  }
+
+  vk::CommandBufferInheritanceRenderingInfo renderingInheritance{};
+  renderingInheritance.setColorAttachmentFormats(colorFormats);
+  renderingInheritance.setDepthAttachmentFormat(depthFormat);
+  renderingInheritance.setRasterizationSamples(vk::SampleCountFlagBits::e1);
+
+  vk::CommandBufferInheritanceInfo inheritance{};
+  inheritance.setPNext(&renderingInheritance);
+
+  const auto beginInfo = vk::CommandBufferBeginInfo(
+      vk::CommandBufferUsageFlagBits::eOneTimeSubmit |
+      vk::CommandBufferUsageFlagBits::eRenderPassContinue, &inheritance);
+
+  // Dynamic state is not inherited from the primary buffer
+  const auto viewport = _frame->GetViewport();
+  const vk::Rect2D scissor{
+      {0, 0},
+      {static_cast<uint32_t>(viewport.width),
+       static_cast<uint32_t>(viewport.height)}};
+
+  const auto pools = _frame->GetWorkerPools();
+  Array<vk::CommandBuffer> buffers;
+  buffers.resize(_batches.size());
+
+  async::parallelFor(_batches.size(), [&](const size_t begin, const size_t end) {
+    for (auto i = begin; i < end; i++) {
+      auto buffer = pools->Allocate(static_cast<uint32_t>(i));
+      buffer.begin(beginInfo);
+      buffer.setViewport(0, {viewport});
+      buffer.setScissor(0, {scissor});
+
+      fn(&buffer, _batches[i].first, _batches[i].second);
+
+      buffer.end();
+      buffers[i] = buffer;
+    }
+  }, 1);
+
+  _frame->GetCmd()->executeCommands(buffers);
+}
+}
@@ -0,0 +1,372 @@
+#include "aerox/drawing/RenderGraph.hpp"
+#include "aerox/utils.hpp"
+#include <algorithm>
+
+namespace aerox::drawing {
+
+/**
+ * \brief What has touched an image since its last barrier, enough to scope the next one
+ */
+struct GraphImageState {
+  vk::ImageLayout layout = vk::ImageLayout::eUndefined;
+  vk::PipelineStageFlags2 writeStages;
+  vk::AccessFlags2 writeAccess;
+  // Reads since the last write, a write has to wait for them
+  vk::PipelineStageFlags2 readStages;
+  // Reads the last write was already made visible to
+  vk::AccessFlags2 readAccess;
+};
+
+/**
+ * \brief Moves state to the usage described by access, returns false when it needs no barrier
+ */
+static bool transition(GraphImageState &state, const ImageUsageInfo &access, RenderGraphBarrier &barrier) {
+  barrier.dstStages = access.stages;
+  barrier.dstAccess = access.access;
+  barrier.oldLayout = state.layout;
+  barrier.newLayout = access.layout;
+
+  if (state.layout == access.layout && !access.bWrite) {
+    // Reads only wait on the last write, once per stage and access
+    const auto bCovered = (access.stages & ~state.readStages) == vk::PipelineStageFlags2{} &&
+                          (access.access & ~state.readAccess) == vk::AccessFlags2{};
+    state.readStages |= access.stages;
+    state.readAccess |= access.access;
+    if (bCovered || !state.writeStages) {
+      return false;
+    }
+
+    barrier.srcStages = state.writeStages;
+    barrier.srcAccess = state.writeAccess;
+    return true;
+  }
+
+  // Writes and layout transitions wait on everything since the last write
+  barrier.srcStages = state.writeStages | state.readStages;
+  barrier.srcAccess = state.writeAccess;
+
+  state.layout = access.layout;
+  if (access.bWrite) {
+    state.writeStages = access.stages;
+    state.writeAccess = getWriteAccess(access.access);
+    state.readStages = {};
+    state.readAccess = {};
+  } else {
+    // The transition is the write these reads have seen
+    state.writeStages = access.stages;
+    state.writeAccess = {};
+    state.readStages = access.stages;
+    state.readAccess = access.access;
+  }
+  return true;
+}
+
+static vk::DeviceSize alignUp(const vk::DeviceSize value, const vk::DeviceSize alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+static bool lifetimesOverlap(const CompiledRenderGraphImage &a, const CompiledRenderGraphImage &b) {
+  return a.firstUse <= b.lastUse && b.firstUse <= a.lastUse;
+}
+
+static bool memoryOverlaps(const CompiledRenderGraphImage &a, const CompiledRenderGraphImage &b) {
+  return a.offset < b.offset + b.requirements.size && b.offset < a.offset + a.requirements.size;
+}
+
+/**
+ * \brief Places the largest images first, each at the lowest offset not used by an image alive at the same time
+ */
+static void aliasTransients(CompiledRenderGraph &compiled, const Array<graphImageId> &transients) {
+  auto order = transients;
+  std::ranges::stable_sort(order, [&compiled](const graphImageId a, const graphImageId b) {
+    return compiled.images[a].requirements.size > compiled.images[b].requirements.size;
+  });
+
+  Array<graphImageId> placed;
+  for (const auto id : order) {
+    auto &image = compiled.images[id];
+
+    Array<graphImageId> conflicts;
+    for (const auto other : placed) {
+      if (lifetimesOverlap(image, compiled.images[other])) {
+        conflicts.push(other);
+      }
+    }
+
+    std::ranges::sort(conflicts, [&compiled](const graphImageId a, const graphImageId b) {
+      return compiled.images[a].offset < compiled.images[b].offset;
+    });
+
+    const auto alignment = std::max<vk::DeviceSize>(image.requirements.alignment, 1);
+    vk::DeviceSize offset = 0;
+    for (const auto other : conflicts) {
+      const auto &otherImage = compiled.images[other];
+      if (alignUp(offset, alignment) + image.requirements.size <= otherImage.offset) {
+        break;
+      }
+      offset = std::max(offset, otherImage.offset + otherImage.requirements.size);
+    }
+
+    image.offset = alignUp(offset, alignment);
+    compiled.heapSize = std::max(compiled.heapSize, image.offset + image.requirements.size);
+    compiled.heapAlignment = std::max(compiled.heapAlignment, alignment);
+    compiled.heapMemoryTypes &= image.requirements.memoryTypeBits;
+    placed.push(id);
+  }
+
+  utils::vassert(transients.empty() || compiled.heapMemoryTypes != 0,
+                 "Render graph transient images have no memory type in common");
+}
+
+RenderGraphPass &RenderGraphPass::Read(const graphImageId image, const EImageUsage usage) {
+  return Use(image, usage, true, false);
+}
+
+RenderGraphPass &RenderGraphPass::Write(const graphImageId image, const EImageUsage usage) {
+  utils::vassert(getUsageInfo(usage).bWrite, "Pass [ {} ] writes image {} with a usage that only reads", name.c_str(), image);
+  return Use(image, usage, false, true);
+}
+
+RenderGraphPass &RenderGraphPass::Use(const graphImageId image, const EImageUsage usage, const bool bRead,
+                                      const bool bWrite) {
+  utils::vassert(usage != EImageUsage::Undefined && usage != EImageUsage::Present,
+                 "Pass [ {} ] uses image {} in a way a pass cannot", name.c_str(), image);
+  for (auto &use : uses) {
+    if (use.image == image) {
+      utils::vassert(use.usage == usage, "Pass [ {} ] uses image {} in two different ways", name.c_str(), image);
+      use.bRead |= bRead;
+      use.bWrite |= bWrite;
+      return *this;
+    }
+  }
+
+  uses.push(RenderGraphUse{image, usage, bRead, bWrite});
+  return *this;
+}
+
+graphImageId RenderGraph::CreateImage(const String &name, const vk::Format format, const vk::Extent2D extent,
+                                      const vk::ImageAspectFlags aspect) {
+  RenderGraphImage image;
+  image.name = name;
+  image.format = format;
+  image.extent = extent;
+  image.aspect = aspect;
+  _images.push(image);
+  return static_cast<graphImageId>(_images.size() - 1);
+}
+
+graphImageId RenderGraph::ImportImage(const String &name, const std::shared_ptr<AllocatedImage> &image,
+                                      const RenderGraphImport &import, const vk::ImageAspectFlags aspect) {
+  RenderGraphImage imported;
+  imported.name = name;
+  imported.aspect = aspect;
+  imported.bImported = true;
+  imported.import = import;
+  imported.image = image;
+  if (image) {
+    imported.format = image->format;
+    imported.extent = vk::Extent2D{image->extent.width, image->extent.height};
+  }
+  _images.push(imported);
+  return static_cast<graphImageId>(_images.size() - 1);
+}
+
+RenderGraphPass &RenderGraph::AddPass(const String &name, graphPassFn fn) {
+  RenderGraphPass pass;
+  pass.name = name;
+  pass.fn = std::move(fn);
+  _passes.push(pass);
+  return _passes.back();
+}
+
+const Array<RenderGraphImage> &RenderGraph::GetImages() const {
+  return _images;
+}
+
+const Array<RenderGraphPass> &RenderGraph::GetPasses() const {
+  return _passes;
+}
+
+CompiledRenderGraph RenderGraph::Compile(const graphRequirementsFn &getRequirements) const {
+  CompiledRenderGraph compiled;
+  compiled.images.resize(_images.size());
+
+  for (const auto &pass : _passes) {
+    for (const auto &use : pass.uses) {
+      utils::vassert(use.image < _images.size(), "Pass [ {} ] uses image {} which is not in the graph", pass.name.c_str(),
+                     use.image);
+    }
+  }
+
+  // Walk back from the imported images, a pass survives if something later needs what it writes
+  std::vector<bool> needed(_images.size(), false);
+  std::vector<bool> alive(_passes.size(), false);
+  for (auto i = static_cast<int64_t>(_passes.size()) - 1; i >= 0; i--) {
+    const auto &pass = _passes[i];
+    for (const auto &use : pass.uses) {
+      if (use.bWrite && (_images[use.image].bImported || needed[use.image])) {
+        alive[i] = true;
+      }
+    }
+
+    if (!alive[i]) {
+      compiled.numCulled++;
+      continue;
+    }
+
+    // A write that does not read discards what earlier passes wrote
+    for (const auto &use : pass.uses) {
+      if (use.bWrite && !use.bRead) {
+        needed[use.image] = false;
+      }
+    }
+    for (const auto &use : pass.uses) {
+      if (use.bRead) {
+        needed[use.image] = true;
+      }
+    }
+  }
+
+  // Surviving passes keep the order they were added in, which already has every writer ahead of its readers
+  std::vector<bool> written(_images.size(), false);
+  for (uint32_t i = 0; i < _passes.size(); i++) {
+    if (!alive[i]) {
+      continue;
+    }
+
+    const auto compiledIndex = static_cast<uint32_t>(compiled.passes.size());
+    for (const auto &use : _passes[i].uses) {
+      utils::vassert(!use.bRead || written[use.image] || _images[use.image].bImported,
+                     "Pass [ {} ] reads [ {} ] before any pass writes it", _passes[i].name.c_str(),
+                     _images[use.image].name.c_str());
+      written[use.image] = written[use.image] || use.bWrite;
+
+      auto &image = compiled.images[use.image];
+      if (!image.bUsed) {
+        image.bUsed = true;
+        image.firstUse = compiledIndex;
+      }
+      image.lastUse = compiledIndex;
+      image.usage |= getUsageInfo(use.usage).usage;
+    }
+
+    CompiledRenderGraphPass compiledPass;
+    compiledPass.pass = i;
+    compiled.passes.push(compiledPass);
+  }
+
+  Array<graphImageId> transients;
+  for (graphImageId id = 0; id < _images.size(); id++) {
+    if (_images[id].bImported || !compiled.images[id].bUsed) {
+      continue;
+    }
+
+    compiled.images[id].requirements = getRequirements(_images[id], compiled.images[id].usage);
+    transients.push(id);
+  }
+
+  aliasTransients(compiled, transients);
+
+  // Run every image through its uses once to find the state it ends in
+  Array<GraphImageState> states(_images.size());
+  for (const auto &compiledPass : compiled.passes) {
+    for (const auto &use : _passes[compiledPass.pass].uses) {
+      RenderGraphBarrier ignored;
+      transition(states[use.image], getUsageInfo(use.usage), ignored);
+    }
+  }
+
+  // A transient image starts undefined but its memory was last used by whatever shares it, in this frame or the one before
+  Array<GraphImageState> initial(_images.size());
+  for (const auto id : transients) {
+    for (const auto other : transients) {
+      if (!memoryOverlaps(compiled.images[id], compiled.images[other])) {
+        continue;
+      }
+
+      initial[id].writeStages |= states[other].writeStages;
+      initial[id].writeAccess |= states[other].writeAccess;
+      initial[id].readStages |= states[other].readStages;
+    }
+  }
+
+  for (graphImageId id = 0; id < _images.size(); id++) {
+    if (!_images[id].bImported) {
+      continue;
+    }
+
+    const auto &import = _images[id].import;
+    const auto &before = getUsageInfo(import.before);
+    initial[id].layout = import.bDiscard ? vk::ImageLayout::eUndefined : before.layout;
+    if (before.bWrite) {
+      initial[id].writeStages = before.stages;
+      initial[id].writeAccess = getWriteAccess(before.access);
+    } else {
+      initial[id].readStages = before.stages;
+      initial[id].readAccess = before.access;
+    }
+  }
+
+  states = initial;
+  for (auto &compiledPass : compiled.passes) {
+    for (const auto &use : _passes[compiledPass.pass].uses) {
+      RenderGraphBarrier barrier;
+      barrier.image = use.image;
+      if (transition(states[use.image], getUsageInfo(use.usage), barrier)) {
+        compiledPass.barriers.push(barrier);
+      }
+    }
+  }
+
+  for (graphImageId id = 0; id < _images.size(); id++) {
+    if (!_images[id].bImported) {
+      continue;
+    }
+
+    RenderGraphBarrier barrier;
+    barrier.image = id;
+    if (transition(states[id], getUsageInfo(_images[id].import.after), barrier)) {
+      compiled.finalBarriers.push(barrier);
+    }
+  }
+
+  return compiled;
+}
+
+Array<String> RenderGraph::Validate(const CompiledRenderGraph &compiled) const {
+  BarrierValidator validator;
+  for (graphImageId id = 0; id < _images.size(); id++) {
+    if (_images[id].bImported && !_images[id].import.bDiscard) {
+      validator.Assume(id, _images[id].import.before);
+    }
+  }
+
+  const auto toBarrier = [](const RenderGraphBarrier &barrier) {
+    return vk::ImageMemoryBarrier2{barrier.srcStages, barrier.srcAccess, barrier.dstStages, barrier.dstAccess,
+                                   barrier.oldLayout, barrier.newLayout};
+  };
+
+  for (const auto &compiledPass : compiled.passes) {
+    for (const auto &barrier : compiledPass.barriers) {
+      validator.Barrier(barrier.image, toBarrier(barrier));
+    }
+
+    const auto &pass = _passes[compiledPass.pass];
+    for (const auto &use : pass.uses) {
+      validator.Access(use.image, use.usage, pass.name + " / " + _images[use.image].name);
+    }
+  }
+
+  for (const auto &barrier : compiled.finalBarriers) {
+    validator.Barrier(barrier.image, toBarrier(barrier));
+  }
+
+  for (graphImageId id = 0; id < _images.size(); id++) {
+    if (_images[id].bImported) {
+      validator.Access(id, _images[id].import.after, _images[id].name);
+    }
+  }
+
+  return validator.GetHazards();
+}
+}
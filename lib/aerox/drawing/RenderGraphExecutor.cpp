@@ -0,0 +1,150 @@
+#include "aerox/drawing/RenderGraphExecutor.hpp"
+#include "aerox/drawing/DrawingSubsystem.hpp"
+
+namespace aerox::drawing {
+
+bool RenderGraphExecutor::TransientKey::operator==(const TransientKey &other) const {
+  return format == other.format && extent == other.extent && aspect == other.aspect && usage == other.usage &&
+         offset == other.offset && bUsed == other.bUsed;
+}
+
+vk::MemoryRequirements RenderGraphExecutor::GetRequirements(const RenderGraphImage &image, const vk::ImageUsageFlags usage) {
+  for (const auto &cached : _requirements) {
+    if (cached.format == image.format && cached.extent == image.extent && cached.usage == usage) {
+      return cached.requirements;
+    }
+  }
+
+  // Asks without creating the image, the graph is compiled before any transient image exists
+  auto createInfo = DrawingSubsystem::MakeImageCreateInfo(image.format, vk::Extent3D{image.extent.width, image.extent.height, 1},
+                                                          usage);
+  const vk::DeviceImageMemoryRequirements info{&createInfo};
+  const auto requirements = _drawer->GetVirtualDevice().getImageMemoryRequirements(info).memoryRequirements;
+  _requirements.push(CachedRequirements{image.format, image.extent, usage, requirements});
+  return requirements;
+}
+
+void RenderGraphExecutor::CreateTransients(const RenderGraph &graph, const CompiledRenderGraph &compiled) {
+  const auto &images = graph.GetImages();
+
+  Array<TransientKey> keys;
+  for (graphImageId id = 0; id < images.size(); id++) {
+    TransientKey key;
+    if (!images[id].bImported) {
+      key = {images[id].format, images[id].extent, images[id].aspect, compiled.images[id].usage, compiled.images[id].offset,
+             compiled.images[id].bUsed};
+    }
+    keys.push(key);
+  }
+
+  if (keys == _keys) {
+    return;
+  }
+
+  if (_heap) {
+    // Earlier frames may still be using the old images
+    _drawer->WaitDeviceIdle();
+  }
+
+  _images.clear();
+  _images.resize(images.size());
+  _heap.reset();
+  _keys = keys;
+  _generation++;
+
+  if (compiled.heapSize == 0) {
+    return;
+  }
+
+  const auto allocator = _drawer->GetAllocator().lock();
+  _heap = allocator->AllocateMemory(
+      vk::MemoryRequirements{compiled.heapSize, compiled.heapAlignment, compiled.heapMemoryTypes},
+      vk::MemoryPropertyFlagBits::eDeviceLocal, "Render Graph Transients");
+
+  for (graphImageId id = 0; id < images.size(); id++) {
+    if (images[id].bImported || !compiled.images[id].bUsed) {
+      continue;
+    }
+
+    auto createInfo = DrawingSubsystem::MakeImageCreateInfo(
+        images[id].format, vk::Extent3D{images[id].extent.width, images[id].extent.height, 1}, compiled.images[id].usage);
+    auto image = allocator->AllocateAliasedImage(createInfo, _heap, compiled.images[id].offset);
+    image->view = _drawer->GetVirtualDevice().createImageView(
+        DrawingSubsystem::MakeImageViewCreateInfo(image->format, image->image, images[id].aspect));
+    _images[id] = image;
+  }
+}
+
+void RenderGraphExecutor::IssueBarriers(const vk::CommandBuffer cmd, const RenderGraph &graph,
+                                        const Array<RenderGraphBarrier> &barriers) const {
+  ImageBarriers imageBarriers;
+  for (const auto &barrier : barriers) {
+    vk::ImageMemoryBarrier2 imageBarrier;
+    imageBarrier
+        .setSrcStageMask(barrier.srcStages)
+        .setSrcAccessMask(barrier.srcAccess)
+        .setDstStageMask(barrier.dstStages)
+        .setDstAccessMask(barrier.dstAccess)
+        .setOldLayout(barrier.oldLayout)
+        .setNewLayout(barrier.newLayout)
+        .setImage(_images[barrier.image]->image)
+        .setSubresourceRange(DrawingSubsystem::ImageSubResourceRange(graph.GetImages()[barrier.image].aspect));
+    imageBarriers.Add(imageBarrier);
+  }
+
+  imageBarriers.Record(cmd);
+}
+
+void RenderGraphExecutor::Init(DrawingSubsystem *drawer) {
+  _drawer = drawer;
+}
+
+void RenderGraphExecutor::Destroy() {
+  _images.clear();
+  _keys.clear();
+  _heap.reset();
+}
+
+void RenderGraphExecutor::Execute(RawFrameData *frame, const RenderGraph &graph) {
+  const auto compiled = graph.Compile([this](const RenderGraphImage &image, const vk::ImageUsageFlags usage) {
+    return GetRequirements(image, usage);
+  });
+
+  CreateTransients(graph, compiled);
+
+  const auto &images = graph.GetImages();
+  for (graphImageId id = 0; id < images.size(); id++) {
+    if (images[id].bImported) {
+      _images[id] = images[id].image;
+    }
+  }
+
+  const auto cmd = frame->GetCmd();
+  const auto &passes = graph.GetPasses();
+  for (const auto &compiledPass : compiled.passes) {
+    IssueBarriers(*cmd, graph, compiledPass.barriers);
+    if (const auto &pass = passes[compiledPass.pass]; pass.fn) {
+      const auto scope = frame->GetTimer()->Begin(*cmd, pass.name);
+      pass.fn(frame, *this);
+      frame->GetTimer()->End(*cmd, scope);
+    }
+  }
+
+  IssueBarriers(*cmd, graph, compiled.finalBarriers);
+
+  // Imported images belong to their owners between frames
+  for (graphImageId id = 0; id < images.size(); id++) {
+    if (images[id].bImported) {
+      _images[id].reset();
+    }
+  }
+}
+
+std::shared_ptr<AllocatedImage> RenderGraphExecutor::GetImage(const graphImageId id) const {
+  return id < _images.size() ? _images[id] : std::shared_ptr<AllocatedImage>{};
+}
+
+uint64_t RenderGraphExecutor::GetGeneration() const {
+  return _generation;
+}
+}
@@ -108,6 +108,13 @@ std::shared_ptr<Shader> Shader::FromSource(
     
     newResources.uniformBuffers.insert({resource.name,{set,binding,numRequired}});
   }
+
+  for ( auto &resource : resources.storage_buffers)
+  {
+    if (glsl.get_decoration(resource.id, spv::DecorationDescriptorSet) == EMaterialSetType::Bindless) {
+      newResources.bUsesMaterialBuffer = true;
+    }
+  }
   
   const auto device = Engine::Get()->GetDrawingSubsystem().lock()->GetVirtualDevice();
   const auto shaderCreateInfo = vk::ShaderModuleCreateInfo(
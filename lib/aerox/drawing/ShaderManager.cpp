@@ -6,6 +6,7 @@
 #include <glslang/Public/ResourceLimits.h>
 #include <glslang/SPIRV/GlslangToSpv.h>
 #include <aerox/drawing/DrawingSubsystem.hpp>
+#include <aerox/drawing/scene/GBuffer.hpp>
 
 namespace aerox::drawing {
 
@@ -17,11 +18,21 @@ GlslShaderIncluder::GlslShaderIncluder(ShaderManager * manager,const fs::path &i
   }
 }
 
+glslang::TShader::Includer::IncludeResult * GlslShaderIncluder::MakeResult(const std::string &name, const std::string &content) {
+  const auto fileContent = new std::string(content);
+  auto result = new IncludeResult(name,fileContent->c_str(),fileContent->size(),fileContent);
+  _results.Add(result);
+  return result;
+}
+
 glslang::TShader::Includer::IncludeResult * GlslShaderIncluder::includeSystem(const char*filePath, const char *includerName, size_t inclusionDepth) {
   const fs::path actualPath(filePath);
   if(_bDebug) {
     _manager->GetLogger()->Info("Including Shader File {:s}",actualPath.string());
   }
+  if(const auto generated = _manager->GetGeneratedInclude(filePath)) {
+    return MakeResult(filePath,*generated);
+  }
   const auto fileContent = new std::string(io::readFileAsString(actualPath));
   auto result = new IncludeResult(actualPath.string(),fileContent->c_str(),fileContent->size(),fileContent);
   _results.Add(result);
@@ -34,6 +45,9 @@ glslang::TShader::Includer::IncludeResult * GlslShaderIncluder::includeLocal(con
   if(_bDebug) {
    _manager->GetLogger()->Info("Including Shader File {:s}",actualPath.string());
   }
+  if(const auto generated = _manager->GetGeneratedInclude(filePath)) {
+    return MakeResult(filePath,*generated);
+  }
   const auto fileContent = new std::string(io::readFileAsString(actualPath));
   auto result = new IncludeResult(actualPath.string(),fileContent->c_str(),fileContent->size(),fileContent);
   _results.Add(result);
@@ -126,6 +140,24 @@ std::shared_ptr<Shader> ShaderManager::GetLoadedShader(
   return _shaders.at(shaderPath);
 }
 
+void ShaderManager::SetGeneratedInclude(const std::string &name, const std::string &content) {
+  _generatedIncludes[name] = content;
+}
+
+const std::string * ShaderManager::GetGeneratedInclude(const std::string &name) const {
+  const auto found = _generatedIncludes.find(name);
+  return found == _generatedIncludes.end() ? nullptr : &found->second;
+}
+
+std::string ShaderManager::HashSource(const fs::path &shaderPath) const {
+  auto source = io::readFileAsString(shaderPath);
+  for(const auto &[name,content] : _generatedIncludes) {
+    source += name;
+    source += content;
+  }
+  return utils::hash(source.data(),source.size() * sizeof(char));
+}
+
 Array<unsigned int> ShaderManager::Compile(const fs::path &shaderPath){
   if (!fs::exists(shaderPath)) {
     throw std::runtime_error(
@@ -221,11 +253,7 @@ Array<unsigned> ShaderManager::CompileAndSave(
 
   glslang::OutputSpvBin(compiledData,compiledPath.string().c_str());
   
-  const auto sourceFile = io::readFileAsString(shaderPath);
-  
-  const auto sourceFileHash = utils::hash(sourceFile.data(),sourceFile.size() * sizeof(char));
-  
-  io::writeStringToFile(compiledHashPath,sourceFileHash);
+  io::writeStringToFile(compiledHashPath,HashSource(shaderPath));
   
   return compiledData;
 }
@@ -239,9 +267,7 @@ Array<unsigned int> ShaderManager::LoadOrCompileSpv(const fs::path &shaderPath){
   if(fs::exists(compiledDir) && fs::exists(compiledPath) && fs::exists(compiledHashPath)) {
     auto shader = io::readFile<unsigned int>(compiledPath);
     const auto oldShaderHash = io::readFileAsString(compiledHashPath);
-    const auto sourceFile = io::readFileAsString(shaderPath);
-
-    if(const auto newShaderHash = utils::hash(sourceFile.data(),sourceFile.size() * sizeof(char)); oldShaderHash == newShaderHash) {
+    if(const auto newShaderHash = HashSource(shaderPath); oldShaderHash == newShaderHash) {
       GetLogger()->Info("Loaded shader from disk: {}",shaderPath.string());
       return shader;
     }
@@ -278,6 +304,7 @@ void ShaderManager::OnInit(DrawingSubsystem * owner) {
   TOwnedBy::OnInit(owner);
   glslang::InitializeProcess();
   InitLogger("shaders");
+  SetGeneratedInclude("gbuffer_layout.glsl",makeGBufferGlsl());
 }
 
 
@@ -0,0 +1,316 @@
+#include "aerox/drawing/StagingUploader.hpp"
+#include "aerox/drawing/Allocator.hpp"
+#include "aerox/drawing/DrawingSubsystem.hpp"
+#include "aerox/drawing/barriers.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace aerox::drawing {
+
+static void recordBarrier(const vk::CommandBuffer cmd, const vk::BufferMemoryBarrier2 &barrier) {
+  vk::DependencyInfo depInfo;
+  depInfo.setBufferMemoryBarriers(barrier);
+  cmd.pipelineBarrier2(&depInfo);
+}
+
+static void recordBarrier(const vk::CommandBuffer cmd, const vk::ImageMemoryBarrier2 &barrier) {
+  vk::DependencyInfo depInfo;
+  depInfo.setImageMemoryBarriers(barrier);
+  cmd.pipelineBarrier2(&depInfo);
+}
+
+vk::CommandBuffer StagingUploader::TakeCmd(const vk::CommandPool pool, Array<vk::CommandBuffer> &free) const {
+  if (!free.empty()) {
+    const auto cmd = free.back();
+    free.pop();
+    return cmd;
+  }
+
+  return _device.allocateCommandBuffers(vk::CommandBufferAllocateInfo{pool, vk::CommandBufferLevel::ePrimary, 1}).at(0);
+}
+
+void StagingUploader::BeginBatch() {
+  if (_recording.transferCmd) {
+    return;
+  }
+
+  _recording.value = _nextValue;
+  _recording.transferCmd = TakeCmd(_transferPool, _freeTransferCmds);
+  _recording.transferCmd.begin({vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+  if (_bDedicatedTransfer) {
+    _recording.graphicsCmd = TakeCmd(_graphicsPool, _freeGraphicsCmds);
+    _recording.graphicsCmd.begin({vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+  }
+}
+
+vk::CommandBuffer StagingUploader::GetGraphicsCmd() const {
+  return _bDedicatedTransfer ? _recording.graphicsCmd : _recording.transferCmd;
+}
+
+std::pair<vk::Buffer, vk::DeviceSize> StagingUploader::Stage(const void *data, const vk::DeviceSize size) {
+  if (size > STAGING_RING_SIZE) {
+    // Too big for the ring, it gets a buffer of its own that lives as long as the batch
+    auto staging = _drawer->GetAllocator().lock()->CreateTransferCpuGpuBuffer(size, false, "Staging Buffer");
+    staging->Write(data, size);
+    _recording.keepAlive.push(staging);
+    return {staging->buffer, 0};
+  }
+
+  while (true) {
+    // Nothing uses the ring, start again from the beginning
+    if (_inFlight.empty() && _ringTail == _ringHead) {
+      _ringHead = _ringTail = 0;
+    }
+
+    auto position = (_ringHead + _ringAlignment - 1) / _ringAlignment * _ringAlignment;
+    // A copy can't wrap around the end of the ring
+    if (position % STAGING_RING_SIZE + size > STAGING_RING_SIZE) {
+      position = (position / STAGING_RING_SIZE + 1) * STAGING_RING_SIZE;
+    }
+
+    if (position + size - _ringTail <= STAGING_RING_SIZE) {
+      _ringHead = position + size;
+      const auto offset = position % STAGING_RING_SIZE;
+      std::memcpy(_ringData + offset, data, size);
+      return {_ring->buffer, offset};
+    }
+
+    // The ring is full, the oldest batch has to finish before its part can be reused
+    if (_inFlight.empty()) {
+      SubmitLocked();
+    }
+
+    vk::resultCheck(_device.waitSemaphores(vk::SemaphoreWaitInfo{{}, _timeline, _inFlight.front().value}, UINT64_MAX),
+                    "Failed to wait for a staging batch");
+    ReclaimLocked();
+  }
+}
+
+void StagingUploader::SubmitLocked() {
+  if (!_recording.transferCmd) {
+    return;
+  }
+
+  auto batch = std::move(_recording);
+  _recording = {};
+  batch.ringEnd = _ringHead;
+
+  batch.transferCmd.end();
+  if (batch.graphicsCmd) {
+    batch.graphicsCmd.end();
+  }
+
+  const vk::CommandBufferSubmitInfo transferCmdInfo{batch.transferCmd, 0};
+  const vk::SemaphoreSubmitInfo signalInfo{_timeline, batch.value, vk::PipelineStageFlagBits2::eAllCommands};
+
+  // Both queues are submitted to under the drawer's queue lock so waiting for the device idle stays safe
+  _drawer->RunQueueOperation([&](const vk::Queue &graphicsQueue) {
+    if (!_bDedicatedTransfer) {
+      graphicsQueue.submit2(vk::SubmitInfo2{{}, {}, transferCmdInfo, signalInfo});
+      return;
+    }
+
+    const vk::SemaphoreSubmitInfo transferSignalInfo{_transferTimeline, batch.value, vk::PipelineStageFlagBits2::eAllCommands};
+    _transferQueue.submit2(vk::SubmitInfo2{{}, {}, transferCmdInfo, transferSignalInfo});
+
+    const vk::SemaphoreSubmitInfo transferWaitInfo{_transferTimeline, batch.value, vk::PipelineStageFlagBits2::eAllCommands};
+    const vk::CommandBufferSubmitInfo graphicsCmdInfo{batch.graphicsCmd, 0};
+    graphicsQueue.submit2(vk::SubmitInfo2{{}, transferWaitInfo, graphicsCmdInfo, signalInfo});
+  });
+
+  _submittedValue = batch.value;
+  _nextValue++;
+  _inFlight.push_back(std::move(batch));
+}
+
+void StagingUploader::ReclaimLocked() {
+  const auto completed = _device.getSemaphoreCounterValue(_timeline);
+  while (!_inFlight.empty() && _inFlight.front().value <= completed) {
+    auto &batch = _inFlight.front();
+    batch.transferCmd.reset();
+    _freeTransferCmds.push(batch.transferCmd);
+    if (batch.graphicsCmd) {
+      batch.graphicsCmd.reset();
+      _freeGraphicsCmds.push(batch.graphicsCmd);
+    }
+
+    _ringTail = batch.ringEnd;
+    _inFlight.pop_front();
+  }
+}
+
+void StagingUploader::Init(DrawingSubsystem *drawer, const vk::Queue transferQueue, const uint32_t transferFamily) {
+  _drawer = drawer;
+  _device = drawer->GetVirtualDevice();
+  _graphicsFamily = drawer->GetQueueFamily();
+  _bDedicatedTransfer = transferQueue && transferFamily != _graphicsFamily;
+  _transferQueue = transferQueue;
+  _transferFamily = _bDedicatedTransfer ? transferFamily : _graphicsFamily;
+
+  // Command buffers are reset one by one as their batch completes
+  const vk::CommandPoolCreateFlags poolFlags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer |
+                                               vk::CommandPoolCreateFlagBits::eTransient;
+  _transferPool = _device.createCommandPool(vk::CommandPoolCreateInfo{poolFlags, _transferFamily});
+  if (_bDedicatedTransfer) {
+    _graphicsPool = _device.createCommandPool(vk::CommandPoolCreateInfo{poolFlags, _graphicsFamily});
+  }
+
+  vk::SemaphoreTypeCreateInfo timelineInfo{vk::SemaphoreType::eTimeline, 0};
+  _timeline = _device.createSemaphore(vk::SemaphoreCreateInfo{{}, &timelineInfo});
+  if (_bDedicatedTransfer) {
+    _transferTimeline = _device.createSemaphore(vk::SemaphoreCreateInfo{{}, &timelineInfo});
+  }
+
+  const auto limits = drawer->GetPhysicalDevice().getProperties().limits;
+  _ringAlignment = std::max<vk::DeviceSize>(_ringAlignment, limits.optimalBufferCopyOffsetAlignment);
+  _ring = drawer->GetAllocator().lock()->CreateTransferCpuGpuBuffer(STAGING_RING_SIZE, false, "Staging Ring");
+  _ringData = static_cast<std::byte *>(_ring->GetMappedData());
+}
+
+void StagingUploader::Destroy() {
+  std::lock_guard guard(_mutex);
+  if (const uint64_t submitted = _submittedValue; submitted > 0) {
+    vk::resultCheck(_device.waitSemaphores(vk::SemaphoreWaitInfo{{}, _timeline, submitted}, UINT64_MAX),
+                    "Failed to wait for staging batches");
+  }
+
+  // Destroying the pools frees every command buffer, including one still being recorded
+  _recording = {};
+  _inFlight.clear();
+  _freeTransferCmds.clear();
+  _freeGraphicsCmds.clear();
+
+  _device.destroyCommandPool(_transferPool);
+  if (_graphicsPool) {
+    _device.destroyCommandPool(_graphicsPool);
+  }
+  _device.destroySemaphore(_timeline);
+  if (_transferTimeline) {
+    _device.destroySemaphore(_transferTimeline);
+  }
+
+  _ring.reset();
+  _ringData = nullptr;
+}
+
+uint64_t StagingUploader::UploadBuffer(const std::shared_ptr<AllocatedBuffer> &dst, const void *data, const vk::DeviceSize size,
+                                       const vk::DeviceSize dstOffset) {
+  if (size == 0) {
+    return GetSubmittedValue();
+  }
+
+  std::lock_guard guard(_mutex);
+  const auto [src, srcOffset] = Stage(data, size);
+  BeginBatch();
+
+  const vk::BufferCopy region{srcOffset, dstOffset, size};
+  _recording.transferCmd.copyBuffer(src, dst->buffer, region);
+
+  if (_bDedicatedTransfer) {
+    // Release on the transfer queue and acquire on the graphics queue, each side only sets its own stages
+    vk::BufferMemoryBarrier2 release;
+    release
+        .setSrcStageMask(vk::PipelineStageFlagBits2::eTransfer)
+        .setSrcAccessMask(vk::AccessFlagBits2::eTransferWrite)
+        .setSrcQueueFamilyIndex(_transferFamily)
+        .setDstQueueFamilyIndex(_graphicsFamily)
+        .setBuffer(dst->buffer)
+        .setOffset(dstOffset)
+        .setSize(size);
+
+    auto acquire = release;
+    acquire
+        .setSrcStageMask(vk::PipelineStageFlagBits2::eNone)
+        .setSrcAccessMask(vk::AccessFlagBits2::eNone)
+        .setDstStageMask(vk::PipelineStageFlagBits2::eAllCommands)
+        .setDstAccessMask(vk::AccessFlagBits2::eMemoryRead);
+
+    recordBarrier(_recording.transferCmd, release);
+    recordBarrier(_recording.graphicsCmd, acquire);
+  }
+
+  _recording.keepAlive.push(dst);
+  _recording.numUploads++;
+  return _recording.value;
+}
+
+uint64_t StagingUploader::UploadImage(const std::shared_ptr<AllocatedImage> &dst, const void *data, const vk::DeviceSize size,
+                                      const bool mipMapped, const vk::Filter mipMapFilter) {
+  std::lock_guard guard(_mutex);
+  const auto [src, srcOffset] = Stage(data, size);
+  BeginBatch();
+
+  const auto cmd = _recording.transferCmd;
+  transitionImage(cmd, dst->image, EImageUsage::Undefined, EImageUsage::TransferDst);
+
+  vk::BufferImageCopy copyRegion{srcOffset, 0, 0};
+  copyRegion.setImageSubresource({vk::ImageAspectFlagBits::eColor, 0, 0, 1});
+  copyRegion.setImageExtent(dst->extent);
+  cmd.copyBufferToImage(src, dst->image, vk::ImageLayout::eTransferDstOptimal, copyRegion);
+
+  // Mips are blitted on the graphics queue, without them the image goes straight to being sampled
+  const auto nextUsage = mipMapped ? EImageUsage::TransferDst : EImageUsage::FragmentSampled;
+  if (_bDedicatedTransfer) {
+    auto release = makeImageBarrier(dst->image, EImageUsage::TransferDst, nextUsage);
+    release
+        .setSrcQueueFamilyIndex(_transferFamily)
+        .setDstQueueFamilyIndex(_graphicsFamily);
+
+    auto acquire = release;
+    release
+        .setDstStageMask(vk::PipelineStageFlagBits2::eNone)
+        .setDstAccessMask(vk::AccessFlagBits2::eNone);
+    acquire
+        .setSrcStageMask(vk::PipelineStageFlagBits2::eNone)
+        .setSrcAccessMask(vk::AccessFlagBits2::eNone);
+
+    recordBarrier(cmd, release);
+    recordBarrier(_recording.graphicsCmd, acquire);
+  } else if (!mipMapped) {
+    transitionImage(cmd, dst->image, EImageUsage::TransferDst, EImageUsage::FragmentSampled);
+  }
+
+  if (mipMapped) {
+    DrawingSubsystem::GenerateMipMaps(GetGraphicsCmd(), dst->image, {dst->extent.width, dst->extent.height}, mipMapFilter);
+  }
+
+  _recording.keepAlive.push(dst);
+  _recording.numUploads++;
+  return _recording.value;
+}
+
+uint64_t StagingUploader::Flush() {
+  std::lock_guard guard(_mutex);
+  ReclaimLocked();
+  SubmitLocked();
+  return _submittedValue;
+}
+
+bool StagingUploader::IsComplete(const uint64_t value) const {
+  return _device.getSemaphoreCounterValue(_timeline) >= value;
+}
+
+void StagingUploader::Wait(const uint64_t value) {
+  {
+    std::lock_guard guard(_mutex);
+    if (value > _submittedValue) {
+      SubmitLocked();
+    }
+  }
+
+  vk::resultCheck(_device.waitSemaphores(vk::SemaphoreWaitInfo{{}, _timeline, value}, UINT64_MAX),
+                  "Failed to wait for an upload");
+}
+
+vk::Semaphore StagingUploader::GetSemaphore() const {
+  return _timeline;
+}
+
+uint64_t StagingUploader::GetSubmittedValue() const {
+  return _submittedValue;
+}
+
+bool StagingUploader::HasDedicatedTransferQueue() const {
+  return _bDedicatedTransfer;
+}
+}
@@ -8,10 +8,7 @@ namespace aerox::drawing {
 
 void Texture::MakeSampler() {
   auto drawer = Engine::Get()->GetDrawingSubsystem().lock();
-  if(_sampler) {
-    drawer->GetVirtualDevice().destroySampler(_sampler);
-    _sampler = nullptr;
-  }
+  const auto oldSampler = _sampler;
   vk::SamplerCreateInfo samplerInfo{};
   samplerInfo.setMagFilter(_filter);
   samplerInfo.setMinFilter(_filter);
@@ -21,6 +18,43 @@ void Texture::MakeSampler() {
   samplerInfo.setMipmapMode(vk::SamplerMipmapMode::eNearest);
   samplerInfo.setAnisotropyEnable(true);
   _sampler = drawer->GetVirtualDevice().createSampler({{},_filter,_filter});
+  UpdateBindless(_gpuData, oldSampler);
+}
+
+void Texture::UpdateBindless(std::shared_ptr<AllocatedImage> oldImage, const vk::Sampler oldSampler) {
+  if(oldImage == _gpuData) {
+    oldImage.reset();
+  }
+
+  // Frames in flight may still sample the old image with the old sampler, both live as long as the old index
+  std::function<void()> release;
+  if(oldImage || oldSampler) {
+    release = [device = GetOwner()->GetVirtualDevice(), oldImage, oldSampler]() mutable {
+      if(oldSampler) {
+        device.destroySampler(oldSampler);
+      }
+      oldImage.reset();
+    };
+  }
+
+  const auto bindless = GetOwner()->GetBindlessTextures();
+  if(!_gpuData || !_sampler) {
+    if(release) {
+      bindless->Retire(INVALID_BINDLESS_INDEX, std::move(release));
+    }
+    return;
+  }
+
+  if(_bindlessIndex == INVALID_BINDLESS_INDEX) {
+    _bindlessIndex = bindless->Add(_gpuData->view,_sampler);
+    if(release) {
+      bindless->Retire(INVALID_BINDLESS_INDEX, std::move(release));
+    }
+  } else {
+    _bindlessIndex = bindless->Replace(_bindlessIndex,_gpuData->view,_sampler,std::move(release));
+  }
+
+  onBindlessIndexChanged->Execute(_bindlessIndex);
 }
 
 vk::Extent3D Texture::GetSize() const {
@@ -35,6 +69,13 @@ vk::Sampler Texture::GetSampler() const {
   return _sampler;
 }
 
+uint32_t Texture::GetBindlessIndex() {
+  if(!IsUploaded()) {
+    Upload();
+  }
+  return _bindlessIndex;
+}
+
 void Texture::SetMipMapped(const bool newMipMapped) {
   _mipMapped = newMipMapped;
 }
@@ -44,7 +85,9 @@ bool Texture::IsMipMapped() const {
 }
 
 void Texture::SetGpuData(const std::shared_ptr<AllocatedImage> &allocation) {
+  const auto oldImage = _gpuData;
   _gpuData = allocation;
+  UpdateBindless(oldImage, nullptr);
 }
 
 void Texture::SetTiling(const vk::SamplerAddressMode tiling) {
@@ -79,6 +122,7 @@ void Texture::WriteTo(Buffer &store) {
 void Texture::Upload() {
   if(!IsUploaded()) {
     _gpuData = Engine::Get()->GetDrawingSubsystem().lock()->CreateImage(_data.data(),_size,_format,vk::ImageUsageFlagBits::eSampled,_mipMapped,_filter,fmt::format("Texture : {}x{}",_size.width,_size.height));
+    UpdateBindless(nullptr, nullptr);
   }
 }
 
@@ -89,6 +133,10 @@ bool Texture::IsUploaded() const {
 void Texture::OnDestroy() {
   Object::OnDestroy();
   GetOwner()->WaitDeviceIdle();
+  if(_bindlessIndex != INVALID_BINDLESS_INDEX) {
+    GetOwner()->GetBindlessTextures()->Remove(_bindlessIndex);
+    _bindlessIndex = INVALID_BINDLESS_INDEX;
+  }
   GetOwner()->GetVirtualDevice().destroySampler(GetSampler());
   _gpuData.reset();
 }
@@ -141,6 +189,7 @@ std::shared_ptr<Texture> Texture::FromAllocated(const std::shared_ptr<AllocatedI
   tex->_filter = filter;
   tex->_tiling = tiling;
   tex->Init(Engine::Get()->GetDrawingSubsystem().lock().get());
+  tex->SetGpuData(image);
   return tex;
 }
 
@@ -2,9 +2,14 @@
 
 #include "VkBootstrap.h"
 #include "aerox/Engine.hpp"
+#include "aerox/utils.hpp"
+#include "aerox/async/parallel.hpp"
+#include "aerox/drawing/barriers.hpp"
+#include "aerox/drawing/descriptors.hpp"
 #include "aerox/drawing/scene/SceneDrawer.hpp"
 #include "aerox/widgets/WidgetRoot.hpp"
 #include "aerox/window/Window.hpp"
+#include <array>
 
 
 namespace aerox::drawing {
@@ -38,9 +43,11 @@ void WindowDrawer::CreateResources() {
                    if (newSize == glm::uvec2{0, 0}) {
                      return;
                    }
+                   // Queued snapshots still use the old swapchain and targets
+                   _drawingSubsystem->WaitForRenderThread();
+                   _drawingSubsystem->WaitDeviceIdle();
                    _viewport.width = newSize.x;
                    _viewport.height = newSize.y;
-                   _drawingSubsystem->WaitDeviceIdle();
                    DestroySwapchain();
                    CreateSwapchain();
                    onResizeScenes->Execute();
@@ -138,6 +145,13 @@ void WindowDrawer::InitFrames() {
               .
               at(0));
 
+    frame.GetWorkerPools()->Init(device, _drawingSubsystem->GetQueueFamily(),
+                                 static_cast<uint32_t>(async::getNumWorkers()));
+
+    frame.GetUploads()->Init(_drawingSubsystem);
+
+    frame.GetTimer()->Init(_drawingSubsystem);
+
     frame.SetDrawer(_drawingSubsystem);
     frame.SetWindowDrawer(this);
   }
@@ -146,6 +160,9 @@ void WindowDrawer::InitFrames() {
     const auto device = GetVirtualDevice();
 
     for (auto &frame : _frames) {
+      frame.GetWorkerPools()->Destroy();
+      frame.GetUploads()->Destroy();
+      frame.GetTimer()->Destroy();
       device.destroyCommandPool(*frame.GetCmdPool());
     }
   });
@@ -231,19 +248,79 @@ vk::Viewport WindowDrawer::GetViewport() const {
   return _viewport;
 }
 
-void WindowDrawer::Draw() {
+Array<GpuTiming> WindowDrawer::GetPassTimings() const {
+  return _passTimings;
+}
 
-  const auto frame = GetCurrentFrame();
+void WindowDrawer::Collect(WindowSnapshot &snapshot) {
+  snapshot.drawer = utils::castStatic<WindowDrawer>(shared_from_this());
+  snapshot.viewport = _viewport;
+  onCollectScenes->Execute(&snapshot);
+  onCollectUi->Execute(&snapshot);
+}
+
+void WindowDrawer::BeginFrame(RawFrameData *frame) {
   const auto device = GetVirtualDevice();
   // Wait for gpu to finish past work
   vk::resultCheck(
       device.waitForFences({frame->GetRenderFence()}, true, 1000000000),
       "Wait For Fences Failed");
 
+  _passTimings = frame->GetTimer()->Resolve();
+
+  // Sets bound by the frame that last used this data, or by anything submitted before it, may be written again
+  DescriptorSet::CompleteFrame(frame->GetId());
+  frame->SetId(_drawingSubsystem->NextFrameId());
+
   frame->cleaner.Run();
   frame->GetDescriptorAllocator()->ClearPools();
+  frame->GetWorkerPools()->Reset();
+  frame->GetUploads()->Reset();
 
   device.resetFences({frame->GetRenderFence()});
+}
+
+void WindowDrawer::RecordSnapshot(RawFrameData *frame, const WindowSnapshot &snapshot) {
+  const auto cmd = frame->GetCmd();
+  const auto timer = frame->GetTimer();
+  timer->Reset(*cmd);
+
+  // Secondary buffers recorded for this snapshot read it from the frame
+  frame->SetViewport(snapshot.viewport);
+  cmd->setViewport(0, {snapshot.viewport});
+
+  vk::Rect2D scissor{
+      {0, 0},
+      {static_cast<uint32_t>(snapshot.viewport.width),
+       static_cast<uint32_t>(snapshot.viewport.height)}};
+
+  cmd->setScissor(0, {scissor});
+
+  // Material parameters changed since the last frame are copied before anything reads them
+  _drawingSubsystem->GetMaterialBuffer()->Flush(*cmd);
+  // Same for descriptor writes, binds while recording then rarely have anything left to flush
+  DescriptorSet::FlushAll();
+  // Bindless slots replaced since the last frame are freed once this frame is done
+  _drawingSubsystem->GetBindlessTextures()->Flush(frame);
+
+  const auto scenesScope = timer->Begin(*cmd, "Scenes");
+  for (const auto &record : snapshot.scenes) {
+    record(frame);
+  }
+  timer->End(*cmd, scenesScope);
+
+  const auto uiScope = timer->Begin(*cmd, "Ui");
+  for (const auto &record : snapshot.ui) {
+    record(frame);
+  }
+  timer->End(*cmd, uiScope);
+}
+
+void WindowDrawer::Draw(const WindowSnapshot &snapshot) {
+
+  const auto frame = GetCurrentFrame();
+  const auto device = GetVirtualDevice();
+  BeginFrame(frame);
 
   // Request image index from swapchain
   uint32_t swapchainImageIndex;
@@ -272,29 +349,13 @@ void WindowDrawer::Draw() {
 
   cmd->begin(commandBeginInfo);
 
-  cmd->setViewport(0, {_viewport});
-
-  vk::Rect2D scissor{
-      {0, 0},
-      {static_cast<uint32_t>(_viewport.width),
-       static_cast<uint32_t>(_viewport.height)}};
-
-  cmd->setScissor(0, {scissor});
-
-  const auto willDrawScenes = onDrawScenes->GetNumListeners() > 0;
-  const auto willDrawUi = onDrawUi->GetNumListeners() > 0;
+  RecordSnapshot(frame, snapshot);
 
-  if (willDrawScenes) {
-    onDrawScenes->Execute(frame);
-  }
-
-  if (willDrawUi) {
-    onDrawUi->Execute(frame);
-  }
-
-  DrawingSubsystem::TransitionImage(*cmd, _swapchainImages[swapchainImageIndex],
-                                    vk::ImageLayout::eUndefined,
-                                    vk::ImageLayout::eTransferDstOptimal);
+  // Only the copy touches the swapchain image, it chains to the acquire semaphore which is waited on at the transfer stage
+  ImageBarriers()
+      .Discard(_swapchainImages[swapchainImageIndex], EImageUsage::Undefined, EImageUsage::TransferDst,
+               vk::ImageAspectFlagBits::eColor, vk::PipelineStageFlagBits2::eTransfer)
+      .Record(*cmd);
 
   // if(willDrawScenes) {
   //   if(auto sceneDrawn = Engine::Get()->GetScenes().at(0).Reserve()) {
@@ -304,30 +365,27 @@ void WindowDrawer::Draw() {
   //   }
   // }
 
-  if (willDrawUi) {
-    if (auto widgetRoot = Engine::Get()->GetWidgetSubsystem().lock()->
-                                         GetRoot(this->_window).lock()) {
-      DrawingSubsystem::CopyImageToImage(
-          *cmd, widgetRoot->GetRenderTarget().lock()->image,
-          _swapchainImages[swapchainImageIndex],
-          drawExtent, swapchainExtent);
-    }
+  if (snapshot.output) {
+    DrawingSubsystem::CopyImageToImage(
+        *cmd, snapshot.output->image,
+        _swapchainImages[swapchainImageIndex],
+        drawExtent, swapchainExtent);
   }
 
-  DrawingSubsystem::TransitionImage(*cmd, _swapchainImages[swapchainImageIndex],
-                                    vk::ImageLayout::eTransferDstOptimal,
-                                    vk::ImageLayout::ePresentSrcKHR);
+  transitionImage(*cmd, _swapchainImages[swapchainImageIndex], EImageUsage::TransferDst, EImageUsage::Present);
 
   // Cant add commands anymore
   cmd->end();
 
   const auto cmdInfo = vk::CommandBufferSubmitInfo(*cmd, 0);
 
-  const auto waitingInfo = vk::SemaphoreSubmitInfo(
-      frame->GetSwapchainSemaphore(), 1,
-      vk::PipelineStageFlagBits2::eColorAttachmentOutput);
+  // Uploads queued while recording are submitted first, the frame waits for every upload submitted so far
+  const auto uploader = _drawingSubsystem->GetUploader();
+  const std::array waitingInfo{
+      vk::SemaphoreSubmitInfo(frame->GetSwapchainSemaphore(), 1, vk::PipelineStageFlagBits2::eTransfer),
+      vk::SemaphoreSubmitInfo(uploader->GetSemaphore(), uploader->Flush(), vk::PipelineStageFlagBits2::eAllCommands)};
   const auto signalInfo = vk::SemaphoreSubmitInfo(
-      frame->GetRenderSemaphore(), 1, vk::PipelineStageFlagBits2::eAllGraphics);
+      frame->GetRenderSemaphore(), 1, vk::PipelineStageFlagBits2::eAllCommands);
 
   const auto submitInfo = vk::SubmitInfo2({}, waitingInfo, cmdInfo,
                                           signalInfo);
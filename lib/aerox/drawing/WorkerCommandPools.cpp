@@ -0,0 +1,45 @@
+#include "aerox/drawing/WorkerCommandPools.hpp"
+
+namespace aerox::drawing {
+
+void WorkerCommandPools::Init(const vk::Device device, const uint32_t queueFamily, const uint32_t numWorkers) {
+  _device = device;
+
+  // Buffers are reset with their pool, not one by one
+  const auto commandPoolInfo = vk::CommandPoolCreateInfo({}, queueFamily);
+  for (uint32_t i = 0; i < numWorkers; i++) {
+    Pool pool;
+    pool.pool = _device.createCommandPool(commandPoolInfo);
+    _pools.push(pool);
+  }
+}
+
+void WorkerCommandPools::Destroy() {
+  for (const auto &pool : _pools) {
+    _device.destroyCommandPool(pool.pool);
+  }
+  _pools.clear();
+}
+
+void WorkerCommandPools::Reset() {
+  for (auto &pool : _pools) {
+    // Untouched pools have nothing to reset
+    if (pool.buffers.Reset()) {
+      _device.resetCommandPool(pool.pool);
+    }
+  }
+}
+
+vk::CommandBuffer WorkerCommandPools::Allocate(const uint32_t worker) {
+  auto &pool = _pools[worker];
+  return pool.buffers.Acquire([&] {
+    const auto allocateInfo = vk::CommandBufferAllocateInfo(
+        pool.pool, vk::CommandBufferLevel::eSecondary, 1);
+    return _device.allocateCommandBuffers(allocateInfo).at(0);
+  });
+}
+
+uint32_t WorkerCommandPools::GetNumWorkers() const {
+  return static_cast<uint32_t>(_pools.size());
+}
+}
@@ -0,0 +1,232 @@
+#include "aerox/drawing/barriers.hpp"
+#include <fmt/format.h>
+
+namespace aerox::drawing {
+
+const ImageUsageInfo &getUsageInfo(const EImageUsage usage) {
+  static const ImageUsageInfo infos[] = {
+      // Undefined
+      {vk::PipelineStageFlagBits2::eNone, vk::AccessFlagBits2::eNone, vk::ImageLayout::eUndefined, {}, false},
+      // ColorAttachmentWrite, blending reads the attachment too
+      {vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+       vk::AccessFlagBits2::eColorAttachmentRead | vk::AccessFlagBits2::eColorAttachmentWrite,
+       vk::ImageLayout::eColorAttachmentOptimal, vk::ImageUsageFlagBits::eColorAttachment, true},
+      // DepthAttachmentWrite
+      {vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests,
+       vk::AccessFlagBits2::eDepthStencilAttachmentRead | vk::AccessFlagBits2::eDepthStencilAttachmentWrite,
+       vk::ImageLayout::eDepthAttachmentOptimal, vk::ImageUsageFlagBits::eDepthStencilAttachment, true},
+      // DepthAttachmentRead
+      {vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests,
+       vk::AccessFlagBits2::eDepthStencilAttachmentRead,
+       vk::ImageLayout::eDepthReadOnlyOptimal, vk::ImageUsageFlagBits::eDepthStencilAttachment, false},
+      // FragmentSampled
+      {vk::PipelineStageFlagBits2::eFragmentShader, vk::AccessFlagBits2::eShaderSampledRead,
+       vk::ImageLayout::eShaderReadOnlyOptimal, vk::ImageUsageFlagBits::eSampled, false},
+      // ComputeSampled
+      {vk::PipelineStageFlagBits2::eComputeShader, vk::AccessFlagBits2::eShaderSampledRead,
+       vk::ImageLayout::eShaderReadOnlyOptimal, vk::ImageUsageFlagBits::eSampled, false},
+      // TransferSrc
+      {vk::PipelineStageFlagBits2::eTransfer, vk::AccessFlagBits2::eTransferRead,
+       vk::ImageLayout::eTransferSrcOptimal, vk::ImageUsageFlagBits::eTransferSrc, false},
+      // TransferDst
+      {vk::PipelineStageFlagBits2::eTransfer, vk::AccessFlagBits2::eTransferWrite,
+       vk::ImageLayout::eTransferDstOptimal, vk::ImageUsageFlagBits::eTransferDst, true},
+      // Present, only ever the last usage in a submission which signals its semaphore after all commands
+      {vk::PipelineStageFlagBits2::eAllCommands, vk::AccessFlagBits2::eNone, vk::ImageLayout::ePresentSrcKHR, {}, false},
+  };
+
+  return infos[static_cast<size_t>(usage)];
+}
+
+vk::AccessFlags2 getWriteAccess(const vk::AccessFlags2 access) {
+  return access & (vk::AccessFlagBits2::eColorAttachmentWrite |
+                   vk::AccessFlagBits2::eDepthStencilAttachmentWrite |
+                   vk::AccessFlagBits2::eTransferWrite |
+                   vk::AccessFlagBits2::eShaderWrite |
+                   vk::AccessFlagBits2::eShaderStorageWrite |
+                   vk::AccessFlagBits2::eHostWrite |
+                   vk::AccessFlagBits2::eMemoryWrite);
+}
+
+static vk::ImageSubresourceRange toRange(const std::variant<vk::ImageSubresourceRange, vk::ImageAspectFlags> &resourceOrAspect) {
+  if (std::holds_alternative<vk::ImageSubresourceRange>(resourceOrAspect)) {
+    return std::get<vk::ImageSubresourceRange>(resourceOrAspect);
+  }
+
+  return {std::get<vk::ImageAspectFlags>(resourceOrAspect), 0, vk::RemainingMipLevels, 0, vk::RemainingArrayLayers};
+}
+
+vk::ImageMemoryBarrier2 makeImageBarrier(const vk::Image image, const EImageUsage from, const EImageUsage to,
+                                         const std::variant<vk::ImageSubresourceRange, vk::ImageAspectFlags> &resourceOrAspect,
+                                         const vk::PipelineStageFlags2 waitStages, const bool bDiscard) {
+  const auto &src = getUsageInfo(from);
+  const auto &dst = getUsageInfo(to);
+
+  // Only writes have to be made available, reads just have to finish before the next use starts
+  vk::ImageMemoryBarrier2 barrier;
+  barrier
+      .setSrcStageMask(src.stages | waitStages)
+      .setSrcAccessMask(getWriteAccess(src.access))
+      .setDstStageMask(dst.stages)
+      .setDstAccessMask(dst.access)
+      .setOldLayout(bDiscard ? vk::ImageLayout::eUndefined : src.layout)
+      .setNewLayout(dst.layout)
+      .setImage(image)
+      .setSubresourceRange(toRange(resourceOrAspect));
+  return barrier;
+}
+
+ImageBarriers &ImageBarriers::Add(const vk::Image image, const EImageUsage from, const EImageUsage to,
+                                  const std::variant<vk::ImageSubresourceRange, vk::ImageAspectFlags> &resourceOrAspect,
+                                  const vk::PipelineStageFlags2 waitStages) {
+  return Add(makeImageBarrier(image, from, to, resourceOrAspect, waitStages));
+}
+
+ImageBarriers &ImageBarriers::Discard(const vk::Image image, const EImageUsage from, const EImageUsage to,
+                                      const std::variant<vk::ImageSubresourceRange, vk::ImageAspectFlags> &resourceOrAspect,
+                                      const vk::PipelineStageFlags2 waitStages) {
+  return Add(makeImageBarrier(image, from, to, resourceOrAspect, waitStages, true));
+}
+
+ImageBarriers &ImageBarriers::Add(const vk::ImageMemoryBarrier2 &barrier) {
+  _barriers.push(barrier);
+  return *this;
+}
+
+const Array<vk::ImageMemoryBarrier2> &ImageBarriers::GetBarriers() const {
+  return _barriers;
+}
+
+bool ImageBarriers::IsEmpty() const {
+  return _barriers.empty();
+}
+
+void ImageBarriers::Record(const vk::CommandBuffer cmd) {
+  if (_barriers.empty()) {
+    return;
+  }
+
+  vk::DependencyInfo depInfo;
+  depInfo.setImageMemoryBarriers(_barriers);
+
+  cmd.pipelineBarrier2(&depInfo);
+  _barriers.clear();
+}
+
+void transitionImage(const vk::CommandBuffer cmd, const vk::Image image, const EImageUsage from, const EImageUsage to,
+                     const std::variant<vk::ImageSubresourceRange, vk::ImageAspectFlags> &resourceOrAspect) {
+  ImageBarriers().Add(image, from, to, resourceOrAspect).Record(cmd);
+}
+
+static bool contains(const vk::PipelineStageFlags2 flags, const vk::PipelineStageFlags2 other) {
+  return (other & ~flags) == vk::PipelineStageFlags2{};
+}
+
+static bool contains(const vk::AccessFlags2 flags, const vk::AccessFlags2 other) {
+  return (other & ~flags) == vk::AccessFlags2{};
+}
+
+void BarrierValidator::Assume(const uint64_t image, const EImageUsage usage) {
+  const auto &info = getUsageInfo(usage);
+  ImageState state;
+  state.layout = info.layout;
+  if (info.bWrite) {
+    state.writeStages = info.stages;
+    state.writeAccess = getWriteAccess(info.access);
+    state.bAvailable = false;
+  } else {
+    state.readStages = info.stages;
+  }
+  _images[image] = state;
+}
+
+void BarrierValidator::Barrier(const uint64_t image, const vk::ImageMemoryBarrier2 &barrier) {
+  auto &state = _images[image];
+
+  if (barrier.oldLayout != vk::ImageLayout::eUndefined && barrier.oldLayout != state.layout) {
+    _hazards.push(fmt::format("Image {} transitions from {} but is in {}", image, vk::to_string(barrier.oldLayout),
+                              vk::to_string(state.layout)));
+  }
+
+  // A barrier waits on the write if it covers its stages directly or chains through an earlier barrier that did
+  const auto bWaitsOnWrite = contains(barrier.srcStageMask, state.writeStages) ||
+                             (state.visibleStages & barrier.srcStageMask) != vk::PipelineStageFlags2{};
+  const auto bWaitsOnReads = contains(barrier.srcStageMask, state.readStages) ||
+                             (state.readsWaitedBy & barrier.srcStageMask) != vk::PipelineStageFlags2{};
+
+  if (barrier.oldLayout != barrier.newLayout) {
+    const auto bWriteAvailable = state.bAvailable || contains(barrier.srcAccessMask, state.writeAccess);
+    if (!bWaitsOnWrite || !bWriteAvailable || !bWaitsOnReads) {
+      _hazards.push(fmt::format("Image {} changes layout to {} without waiting on earlier uses", image,
+                                vk::to_string(barrier.newLayout)));
+    }
+
+    // The transition is a write every later use in the second scope sees
+    state.layout = barrier.newLayout;
+    state.writeStages = barrier.dstStageMask;
+    state.writeAccess = {};
+    state.bAvailable = true;
+    state.visibleStages = barrier.dstStageMask;
+    state.visibleAccess = barrier.dstAccessMask;
+    state.readStages = {};
+    state.readsWaitedBy = barrier.dstStageMask;
+    return;
+  }
+
+  if (bWaitsOnWrite) {
+    state.bAvailable = state.bAvailable || contains(barrier.srcAccessMask, state.writeAccess);
+    if (state.bAvailable) {
+      state.visibleStages |= barrier.dstStageMask;
+      state.visibleAccess |= barrier.dstAccessMask;
+    }
+  }
+
+  if (bWaitsOnReads) {
+    state.readsWaitedBy |= barrier.dstStageMask;
+  }
+}
+
+void BarrierValidator::Access(const uint64_t image, const EImageUsage usage, const String &what) {
+  auto &state = _images[image];
+  const auto &info = getUsageInfo(usage);
+  const auto name = what.empty() ? fmt::format("Image {}", image) : fmt::format("{} (image {})", what.c_str(), image);
+
+  if (state.layout != info.layout) {
+    _hazards.push(fmt::format("{} is used in {} but is in {}", name, vk::to_string(info.layout), vk::to_string(state.layout)));
+  }
+
+  const auto bWriteSeen = !state.writeStages ||
+                          (state.bAvailable && contains(state.visibleStages, info.stages) &&
+                           contains(state.visibleAccess, info.access));
+
+  if (!info.bWrite) {
+    if (!bWriteSeen) {
+      _hazards.push(fmt::format("{} is read before the last write is visible", name));
+    }
+    // Stages that waited on earlier reads did not wait on this one
+    state.readStages |= info.stages;
+    state.readsWaitedBy = {};
+    return;
+  }
+
+  if (state.writeStages && !(state.bAvailable && contains(state.visibleStages, info.stages))) {
+    _hazards.push(fmt::format("{} is written before the last write finished", name));
+  }
+
+  if (state.readStages && !contains(state.readsWaitedBy, info.stages)) {
+    _hazards.push(fmt::format("{} is written before earlier reads finished", name));
+  }
+
+  state.writeStages = info.stages;
+  state.writeAccess = getWriteAccess(info.access);
+  state.bAvailable = false;
+  state.visibleStages = {};
+  state.visibleAccess = {};
+  state.readStages = {};
+  state.readsWaitedBy = {};
+}
+
+const Array<String> &BarrierValidator::GetHazards() const {
+  return _hazards;
+}
+}
@@ -1,118 +1,206 @@
 ﻿#include "aerox/Engine.hpp"
 
 #include <aerox/drawing/descriptors.hpp>
+#include <aerox/drawing/FrameUploadBuffer.hpp>
 #include <aerox/drawing/Texture.hpp>
 #include <aerox/utils.hpp>
 #include <ranges>
 
 namespace aerox::drawing {
 
+std::atomic<uint64_t> DescriptorSet::_writesIssued = 0;
+std::atomic<uint64_t> DescriptorSet::_writesSkipped = 0;
+std::atomic<uint64_t> DescriptorSet::_flushes = 0;
+std::atomic<uint64_t> DescriptorSet::_completedFrame = 0;
+std::mutex DescriptorSet::_queuedSetsMutex;
+std::vector<DescriptorSet *> DescriptorSet::_queuedSets;
+
+bool DescriptorWrite::HasSameDescriptors(const DescriptorWrite &other) const {
+  return type == other.type && images == other.images && buffers == other.buffers;
+}
+
 DescriptorSet::DescriptorSet(const vk::Device &device,
-    const vk::DescriptorSet &set) {
+    const vk::DescriptorSet &set, const bool bUpdateAfterBind) {
   _device = device;
   _set = set;
+  _bUpdateAfterBind = bUpdateAfterBind;
 }
 
 DescriptorSet::~DescriptorSet() {
-  _resources.clear();
+  {
+    std::lock_guard guard(_queuedSetsMutex);
+    std::erase(_queuedSets, this);
+  }
+  _pending.clear();
+  _bound.clear();
 }
 
 DescriptorSet::operator vk::DescriptorSet() const {
   return _set;
 }
 
+void DescriptorSet::Queue(const uint32_t binding, DescriptorWrite &&write) {
+  {
+    std::lock_guard guard(_mutex);
+
+    if(const auto bound = _bound.find(binding); bound != _bound.end() && bound->second.HasSameDescriptors(write)) {
+      // Anything queued since would only change it back
+      _pending.erase(binding);
+      ++_writesSkipped;
+      return;
+    }
+
+    if(_pending.contains(binding)) {
+      // The earlier write never reaches the device
+      ++_writesSkipped;
+    }
+
+    _pending[binding] = std::move(write);
+    if(_bPending.exchange(true)) {
+      return;
+    }
+  }
+
+  // Listed outside the set's lock, FlushAll takes the list's lock first
+  std::lock_guard guard(_queuedSetsMutex);
+  _queuedSets.push_back(this);
+}
+
+void DescriptorSet::Flush() {
+  std::lock_guard guard(_mutex);
+  _bPending = false;
+
+  if(_pending.empty()) {
+    return;
+  }
+
+  Array<vk::WriteDescriptorSet> writes;
+  writes.reserve(_pending.size());
+  for(const auto &[binding, pending] : _pending) {
+    vk::WriteDescriptorSet write{};
+    write.setDstSet(_set);
+    write.setDescriptorType(pending.type);
+    write.setDstBinding(binding);
+    if(pending.images.empty()) {
+      write.setBufferInfo(pending.buffers);
+    } else {
+      write.setImageInfo(pending.images);
+    }
+    writes.push(write);
+  }
+
+  _device.updateDescriptorSets(writes,{});
+
+  _writesIssued += writes.size();
+  ++_flushes;
+
+  for(auto &[binding, pending] : _pending) {
+    _bound[binding] = std::move(pending);
+  }
+  _pending.clear();
+}
+
+bool DescriptorSet::HasPendingWrites() const {
+  return _bPending.load(std::memory_order_acquire);
+}
+
+bool DescriptorSet::CanFlush() const {
+  return _bUpdateAfterBind || _lastUse.load(std::memory_order_acquire) <= _completedFrame.load(std::memory_order_acquire);
+}
+
+void DescriptorSet::MarkUsed(const uint64_t frameId) {
+  _lastUse.store(frameId, std::memory_order_release);
+}
+
+void DescriptorSet::CompleteFrame(const uint64_t frameId) {
+  auto completed = _completedFrame.load();
+  while(completed < frameId && !_completedFrame.compare_exchange_weak(completed, frameId)) {
+  }
+}
+
+void DescriptorSet::FlushAll() {
+  // Held throughout so a set cannot be destroyed while it is flushed
+  std::lock_guard guard(_queuedSetsMutex);
+  std::erase_if(_queuedSets, [](DescriptorSet *set) {
+    if(!set->CanFlush()) {
+      // A frame in flight still reads the set, written once that frame is done
+      return false;
+    }
+    set->Flush();
+    return true;
+  });
+}
+
+DescriptorWriteStats DescriptorSet::GetWriteStats() {
+  return {_writesIssued.load(),_writesSkipped.load(),_flushes.load()};
+}
 
 void DescriptorSet::WriteBuffer(uint32_t binding,
                                 const std::shared_ptr<AllocatedBuffer> &buffer,size_t offset,
                                 vk::DescriptorType type) {
-  std::lock_guard guard(_mutex);
-  
-  const auto shared = buffer;
-  vk::DescriptorBufferInfo info{shared->buffer,offset,shared->size};
-  vk::WriteDescriptorSet write{};
-  write.setDstSet(_set);
-  write.setDescriptorType(type);
-  write.setDstBinding(binding);
-  write.setBufferInfo(info);
-
-  _resources[binding] = shared;
-  
-  _device.updateDescriptorSets(write,{});
+  DescriptorWrite write{};
+  write.type = type;
+  write.buffers.emplace_back(buffer->buffer,offset,buffer->size);
+  write.resource = buffer;
+
+  Queue(binding,std::move(write));
+}
+
+void DescriptorSet::WriteBuffer(uint32_t binding, const FrameUpload &upload, vk::DescriptorType type) {
+  DescriptorWrite write{};
+  write.type = type;
+  write.buffers.emplace_back(upload.buffer,upload.offset,upload.size);
+
+  Queue(binding,std::move(write));
 }
 
 void DescriptorSet::WriteImage(uint32_t binding,
     const std::shared_ptr<AllocatedImage> &image,vk::Sampler sampler, vk::ImageLayout layout,
     vk::DescriptorType type) {
-  std::lock_guard guard(_mutex);
-  
-  const auto shared = image;
-  vk::DescriptorImageInfo info{sampler,shared->view,layout};
-  vk::WriteDescriptorSet write{};
-  write.setDstSet(_set);
-  write.setDescriptorType(type);
-  write.setDstBinding(binding);
-  write.setImageInfo(info);
-
-  _resources[binding] = shared;
-  
-  _device.updateDescriptorSets(write,{});
+  DescriptorWrite write{};
+  write.type = type;
+  write.images.emplace_back(sampler,image->view,layout);
+  write.resource = image;
+
+  Queue(binding,std::move(write));
 }
 
 void DescriptorSet::WriteTexture(uint32_t binding,
     const std::shared_ptr<Texture> &texture, vk::ImageLayout layout,
     const vk::DescriptorType type) {
-  std::lock_guard guard(_mutex);
-  
-  const auto shared = texture;
-
-  if(!shared->IsUploaded()) {
-    shared->Upload();
+  if(!texture->IsUploaded()) {
+    texture->Upload();
   }
-  
-  vk::DescriptorImageInfo info{shared->GetSampler(),shared->GetGpuData().lock()->view,layout};
-  vk::WriteDescriptorSet write{};
-  write.setDstSet(_set);
-  write.setDescriptorType(type);
-  write.setDstBinding(binding);
-  write.setImageInfo(info);
-  
-  _resources[binding] = shared;
-  
-  _device.updateDescriptorSets(write,{});
+
+  DescriptorWrite write{};
+  write.type = type;
+  write.images.emplace_back(texture->GetSampler(),texture->GetGpuData().lock()->view,layout);
+  write.resource = texture;
+
+  Queue(binding,std::move(write));
 }
 
 void DescriptorSet::WriteTextureArray(uint32_t binding,
     const Array<std::shared_ptr<Texture>> &textures, vk::ImageLayout layout,
     const vk::DescriptorType type) {
-  std::lock_guard guard(_mutex);
-  
-  Array<std::shared_ptr<Texture>> sharedTextures;
-  Array<vk::DescriptorImageInfo> infos;
-  
-  for(auto &texture : textures) {
-    const auto shared = texture;
+  DescriptorWrite write{};
+  write.type = type;
 
-    if(!shared->IsUploaded()) {
-      shared->Upload();
+  for(auto &texture : textures) {
+    if(!texture->IsUploaded()) {
+      texture->Upload();
     }
-    
-    sharedTextures.push(shared);
-    infos.emplace_back(shared->GetSampler(),shared->GetGpuData().lock()->view,layout);
+
+    write.images.emplace_back(texture->GetSampler(),texture->GetGpuData().lock()->view,layout);
   }
-  
-  vk::WriteDescriptorSet write{};
-  write.setDstSet(_set);
-  write.setDescriptorType(type);
-  write.setDstBinding(binding);
-  write.setImageInfo(infos);
 
-  _resources[binding] = sharedTextures;
-  
-  _device.updateDescriptorSets(write,{});
+  write.resource = textures;
+
+  Queue(binding,std::move(write));
 }
 
 bool DescriptorSet::IsBound(const uint32_t binding) const {
-  return !_resources.contains(binding) || std::holds_alternative<std::monostate>(_resources.at(binding));
+  return _bound.contains(binding) || _pending.contains(binding);
 }
 
 DescriptorLayoutBuilder & DescriptorLayoutBuilder::AddBinding(const uint32_t binding,
@@ -134,7 +222,7 @@ DescriptorLayoutBuilder & DescriptorLayoutBuilder::Clear() {
   return *this;
 }
 
-vk::DescriptorSetLayout DescriptorLayoutBuilder::Build() {
+vk::DescriptorSetLayout DescriptorLayoutBuilder::Build(const bool bUpdateAfterBind) {
   const auto device = Engine::Get()->GetDrawingSubsystem().lock()->GetVirtualDevice();
   std::vector<vk::DescriptorSetLayoutBinding> bindingsArr;
   
@@ -142,12 +230,13 @@ vk::DescriptorSetLayout DescriptorLayoutBuilder::Build() {
   
   for(auto val : bindings | std::views::values) {
     bindingsArr.push_back(val);
-    flags.push_back(vk::DescriptorBindingFlagBits::eUpdateAfterBind);
+    flags.push_back(bUpdateAfterBind ? vk::DescriptorBindingFlagBits::eUpdateAfterBind : vk::DescriptorBindingFlags{});
   }
   
   const vk::DescriptorSetLayoutBindingFlagsCreateInfo pNext{flags};
   
-  const auto info = vk::DescriptorSetLayoutCreateInfo(vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool,bindingsArr,&pNext);
+  const auto info = vk::DescriptorSetLayoutCreateInfo(
+      bUpdateAfterBind ? vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool : vk::DescriptorSetLayoutCreateFlags{},bindingsArr,&pNext);
 
   return device.createDescriptorSetLayout(info);
 }
@@ -309,7 +398,7 @@ void DescriptorAllocatorGrowable::DestroyPools() {
 
 
 std::weak_ptr<DescriptorSet> DescriptorAllocatorGrowable::Allocate(
-    vk::DescriptorSetLayout layout) {
+    vk::DescriptorSetLayout layout, const bool bUpdateAfterBind) {
 
   // Get or create a pool
   auto poolToUse = GetPool();
@@ -320,7 +409,7 @@ std::weak_ptr<DescriptorSet> DescriptorAllocatorGrowable::Allocate(
 
   bool failed = true;
   try {
-    descriptorSet = DescriptorSetToPtr(_device.allocateDescriptorSets(allocInfo).at(0));
+    descriptorSet = DescriptorSetToPtr(_device.allocateDescriptorSets(allocInfo).at(0),bUpdateAfterBind);
     failed = false;
   } catch (vk::OutOfPoolMemoryError &_) {
     
@@ -334,7 +423,7 @@ std::weak_ptr<DescriptorSet> DescriptorAllocatorGrowable::Allocate(
     poolToUse = GetPool();
     allocInfo.setDescriptorPool(poolToUse.second);
 
-    descriptorSet = DescriptorSetToPtr(_device.allocateDescriptorSets(allocInfo).at(0));
+    descriptorSet = DescriptorSetToPtr(_device.allocateDescriptorSets(allocInfo).at(0),bUpdateAfterBind);
   }
 
   if(!_descriptorsInUse.contains(poolToUse.first)) {
@@ -386,7 +475,7 @@ DescriptorPoolWithId DescriptorAllocatorGrowable::CreatePool(const uint32_t setC
   return  {++_lastPoolId,_device.createDescriptorPool(poolInfo)};
 }
 
-std::shared_ptr<DescriptorSet> DescriptorAllocatorGrowable::DescriptorSetToPtr(const vk::DescriptorSet &set) const {
-  return std::shared_ptr<DescriptorSet>(new DescriptorSet(_device, set));
+std::shared_ptr<DescriptorSet> DescriptorAllocatorGrowable::DescriptorSetToPtr(const vk::DescriptorSet &set, const bool bUpdateAfterBind) const {
+  return std::shared_ptr<DescriptorSet>(new DescriptorSet(_device, set, bUpdateAfterBind));
 }
 }
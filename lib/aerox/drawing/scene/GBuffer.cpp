@@ -0,0 +1,55 @@
+#include "aerox/drawing/scene/GBuffer.hpp"
+#include <fmt/format.h>
+
+namespace aerox::drawing {
+
+const GBufferTargetInfo &getGBufferTarget(const EGBufferTarget target) {
+  // 12 bytes a pixel, position comes from depth
+  static const GBufferTargetInfo targets[] = {
+      {"GBuffer Albedo", vk::Format::eR8G8B8A8Srgb, "vec4", "oAlbedo", "TAlbedo"},
+      {"GBuffer Normal", vk::Format::eR16G16Snorm, "vec2", "oNormal", "TNormal"},
+      {"GBuffer Material", vk::Format::eR8G8B8A8Unorm, "vec4", "oMaterial", "TMaterial"},
+  };
+
+  return targets[static_cast<size_t>(target)];
+}
+
+Array<vk::Format> getGBufferFormats() {
+  Array<vk::Format> formats;
+  for (uint8_t i = 0; i < static_cast<uint8_t>(EGBufferTarget::Count); i++) {
+    formats.push(getGBufferTarget(static_cast<EGBufferTarget>(i)).format);
+  }
+  return formats;
+}
+
+std::string makeGBufferGlsl() {
+  std::string outputs;
+  std::string samplers;
+  uint8_t i = 0;
+  for (; i < static_cast<uint8_t>(EGBufferTarget::Count); i++) {
+    const auto &info = getGBufferTarget(static_cast<EGBufferTarget>(i));
+    outputs += fmt::format("layout(location = {}) out {} {};\n", i, info.outputType, info.output);
+    samplers += fmt::format("layout(set = 1, binding = {}) uniform sampler2D {};\n", i, info.sampler);
+  }
+  samplers += fmt::format("layout(set = 1, binding = {}) uniform sampler2D {};\n", i, GBUFFER_DEPTH_SAMPLER);
+
+  return fmt::format("// Generated from aerox/drawing/scene/GBuffer.hpp\n"
+                     "#define GBUFFER_EMISSIVE_RANGE {:.1f}\n"
+                     "#ifdef GBUFFER_OUTPUTS\n{}#else\n{}#endif\n",
+                     GBUFFER_EMISSIVE_RANGE, outputs, samplers);
+}
+
+GBuffer GBuffer::Create(RenderGraph &graph, const vk::Extent2D extent) {
+  GBuffer gBuffer;
+  for (uint8_t i = 0; i < static_cast<uint8_t>(EGBufferTarget::Count); i++) {
+    const auto &info = getGBufferTarget(static_cast<EGBufferTarget>(i));
+    gBuffer.targets.push(graph.CreateImage(info.name, info.format, extent));
+  }
+  gBuffer.depth = graph.CreateImage("Scene Depth", GBUFFER_DEPTH_FORMAT, extent, vk::ImageAspectFlagBits::eDepth);
+  return gBuffer;
+}
+
+graphImageId GBuffer::Get(const EGBufferTarget target) const {
+  return targets[static_cast<size_t>(target)];
+}
+}
@@ -0,0 +1,223 @@
+#include "aerox/drawing/scene/LightClusters.hpp"
+#include "aerox/async/parallel.hpp"
+#include <algorithm>
+
+namespace aerox::drawing {
+
+LightClusters::LightClusters(const uint32_t sizeX, const uint32_t sizeY, const uint32_t sizeZ) : _sizeX(sizeX), _sizeY(sizeY),
+  _sizeZ(sizeZ) {
+  _bounds.resize(GetNumClusters());
+  _counts.resize(GetNumClusters());
+  _indices.resize(static_cast<size_t>(GetNumClusters()) * MAX_LIGHTS_PER_CLUSTER);
+}
+
+void LightClusters::Build(const glm::mat4 &projection, const float near, const float far) {
+  if (projection == _projection && near == _near && far == _far) {
+    return;
+  }
+
+  _projection = projection;
+  _near = near;
+  _far = far;
+
+  const auto inverseProjection = glm::inverse(projection);
+  const auto unProject = [&](const float x, const float y) {
+    const auto point = inverseProjection * glm::vec4{x, y, 0.0f, 1.0f};
+    return glm::vec3(point) / point.w;
+  };
+
+  _forward = glm::normalize(unProject(0.0f, 0.0f));
+
+  for (uint32_t y = 0; y < _sizeY; y++) {
+    for (uint32_t x = 0; x < _sizeX; x++) {
+      // Tile corners scaled so they sit at a depth of 1 along the forward axis
+      glm::vec3 corners[4];
+      for (auto i = 0; i < 4; i++) {
+        const auto ndcX = -1.0f + 2.0f * static_cast<float>(x + (i & 1)) / static_cast<float>(_sizeX);
+        const auto ndcY = -1.0f + 2.0f * static_cast<float>(y + (i >> 1)) / static_cast<float>(_sizeY);
+        const auto corner = unProject(ndcX, ndcY);
+        corners[i] = corner / glm::dot(corner, _forward);
+      }
+
+      for (uint32_t z = 0; z < _sizeZ; z++) {
+        const auto sliceNear = near * std::pow(far / near, static_cast<float>(z) / static_cast<float>(_sizeZ));
+        const auto sliceFar = near * std::pow(far / near, static_cast<float>(z + 1) / static_cast<float>(_sizeZ));
+
+        math::Bounds bounds;
+        for (const auto &corner : corners) {
+          bounds = bounds.Expand(corner * sliceNear).Expand(corner * sliceFar);
+        }
+        _bounds[GetClusterIndex(x, y, z)] = bounds;
+      }
+    }
+  }
+}
+
+LightClusters::LightRange LightClusters::ComputeRange(const math::Sphere &light) const {
+  LightRange range{};
+  const auto depth = glm::dot(light.center, _forward);
+  if (depth + light.radius < _near || depth - light.radius > _far) {
+    return range;
+  }
+
+  range.bVisible = true;
+  range.minZ = GetSlice(depth - light.radius);
+  range.maxZ = GetSlice(depth + light.radius);
+  range.minX = 0;
+  range.maxX = _sizeX - 1;
+  range.minY = 0;
+  range.maxY = _sizeY - 1;
+
+  // Project the corners of the sphere's box to find the tiles it covers, lights crossing the camera plane cover every tile
+  auto minNdc = glm::vec3{std::numeric_limits<float>::max()};
+  auto maxNdc = glm::vec3{std::numeric_limits<float>::lowest()};
+  for (auto i = 0; i < 8; i++) {
+    const glm::vec3 offset{i & 1 ? light.radius : -light.radius, i & 2 ? light.radius : -light.radius,
+                           i & 4 ? light.radius : -light.radius};
+    const auto clip = _projection * glm::vec4(light.center + offset, 1.0f);
+    if (clip.w <= std::numeric_limits<float>::epsilon()) {
+      return range;
+    }
+    const auto ndc = glm::vec3(clip) / clip.w;
+    minNdc = glm::min(minNdc, ndc);
+    maxNdc = glm::max(maxNdc, ndc);
+  }
+
+  const auto toTile = [](const float ndc, const uint32_t size) {
+    const auto tile = (ndc * 0.5f + 0.5f) * static_cast<float>(size);
+    return static_cast<uint32_t>(std::clamp(tile, 0.0f, static_cast<float>(size - 1)));
+  };
+
+  if (maxNdc.x < -1.0f || minNdc.x > 1.0f || maxNdc.y < -1.0f || minNdc.y > 1.0f) {
+    range.bVisible = false;
+    return range;
+  }
+
+  range.minX = toTile(minNdc.x, _sizeX);
+  range.maxX = toTile(maxNdc.x, _sizeX);
+  range.minY = toTile(minNdc.y, _sizeY);
+  range.maxY = toTile(maxNdc.y, _sizeY);
+  return range;
+}
+
+void LightClusters::Assign(const Array<math::Sphere> &lights, const Array<uint32_t> &ids) {
+  const auto numClusters = GetNumClusters();
+  _ranges.resize(lights.size());
+
+  async::parallelFor(lights.size(), [&](const size_t begin, const size_t end) {
+    for (auto i = begin; i < end; i++) {
+      if (lights[i].radius > 0.0f) {
+        _ranges[i] = ComputeRange(lights[i]);
+      }
+    }
+  }, 256);
+
+  // Every slice is owned by one batch so the per cluster lists can be written without locking
+  async::parallelFor(_sizeZ, [&](const size_t begin, const size_t end) {
+    for (auto z = static_cast<uint32_t>(begin); z < end; z++) {
+      const auto sliceStart = GetClusterIndex(0, 0, z);
+      std::fill_n(_counts.begin() + sliceStart, _sizeX * _sizeY, 0);
+
+      for (uint32_t lightIndex = 0; lightIndex < lights.size(); lightIndex++) {
+        const auto &light = lights[lightIndex];
+        const auto &range = _ranges[lightIndex];
+        if (light.radius <= 0.0f || !range.bVisible || z < range.minZ || z > range.maxZ) {
+          continue;
+        }
+
+        for (auto y = range.minY; y <= range.maxY; y++) {
+          for (auto x = range.minX; x <= range.maxX; x++) {
+            const auto cluster = GetClusterIndex(x, y, z);
+            if (_counts[cluster] < MAX_LIGHTS_PER_CLUSTER && _bounds[cluster].Intersects(light)) {
+              _indices[cluster * MAX_LIGHTS_PER_CLUSTER + _counts[cluster]++] = lightIndex;
+            }
+          }
+        }
+      }
+    }
+  }, 1);
+
+  // Compact into [offset,count] pairs followed by the indices
+  const auto headerSize = (numClusters + 1) * 2;
+  uint32_t total = headerSize;
+  for (uint32_t i = 0; i < numClusters; i++) {
+    total += _counts[i];
+  }
+
+  uint32_t numGlobal = 0;
+  for (const auto &light : lights) {
+    if (light.radius <= 0.0f) {
+      numGlobal++;
+    }
+  }
+  total += numGlobal;
+
+  _data.resize(total);
+  auto offset = headerSize;
+  for (uint32_t i = 0; i < numClusters; i++) {
+    _data[i * 2] = offset;
+    _data[i * 2 + 1] = _counts[i];
+    std::copy_n(_indices.begin() + static_cast<size_t>(i) * MAX_LIGHTS_PER_CLUSTER, _counts[i], _data.begin() + offset);
+    offset += _counts[i];
+  }
+
+  if (!ids.empty()) {
+    for (auto i = headerSize; i < offset; i++) {
+      _data[i] = ids[_data[i]];
+    }
+  }
+
+  _data[numClusters * 2] = offset;
+  _data[numClusters * 2 + 1] = numGlobal;
+  for (uint32_t i = 0; i < lights.size(); i++) {
+    if (lights[i].radius <= 0.0f) {
+      _data[offset++] = ids.empty() ? i : ids[i];
+    }
+  }
+}
+
+uint32_t LightClusters::GetNumClusters() const {
+  return _sizeX * _sizeY * _sizeZ;
+}
+
+glm::uvec3 LightClusters::GetGridSize() const {
+  return {_sizeX, _sizeY, _sizeZ};
+}
+
+glm::vec3 LightClusters::GetForward() const {
+  return _forward;
+}
+
+glm::vec4 LightClusters::GetDepthParams() const {
+  const auto scale = static_cast<float>(_sizeZ) / std::log(_far / _near);
+  return {_near, _far, scale, -std::log(_near) * scale};
+}
+
+uint32_t LightClusters::GetSlice(const float depth) const {
+  const auto params = GetDepthParams();
+  const auto slice = std::log(std::max(depth, _near)) * params.z + params.w;
+  return static_cast<uint32_t>(std::clamp(slice, 0.0f, static_cast<float>(_sizeZ - 1)));
+}
+
+uint32_t LightClusters::GetClusterIndex(const uint32_t x, const uint32_t y, const uint32_t z) const {
+  return x + y * _sizeX + z * _sizeX * _sizeY;
+}
+
+const math::Bounds &LightClusters::GetClusterBounds(const uint32_t cluster) const {
+  return _bounds[cluster];
+}
+
+const Array<uint32_t> &LightClusters::GetData() const {
+  return _data;
+}
+
+Array<uint32_t> LightClusters::GetLights(const uint32_t cluster) const {
+  const auto offset = _data[cluster * 2];
+  const auto count = _data[cluster * 2 + 1];
+  return {_data.begin() + offset, _data.begin() + offset + count};
+}
+
+Array<uint32_t> LightClusters::GetGlobalLights() const {
+  return GetLights(GetNumClusters());
+}
+}
@@ -0,0 +1,149 @@
+#include "aerox/drawing/scene/LightStore.hpp"
+#include "aerox/drawing/Allocator.hpp"
+#include "aerox/scene/components/LightComponent.hpp"
+
+namespace aerox::drawing {
+
+LightStore::LightStore(const uint32_t capacity) : _capacity(capacity) {
+  _slots.resize(capacity);
+  _lights.resize(capacity);
+}
+
+void LightStore::FreeSlot(const uint32_t slot) {
+  _slotMap.erase(_slots[slot].key);
+  _slots[slot] = {};
+  _slots[slot].bDirty = true;
+  _lights[slot] = {};
+  _freeSlots.push(slot);
+  _bLayoutChanged = true;
+}
+
+void LightStore::ApplyRestored() {
+  std::lock_guard guard(_restoreMutex);
+  for (const auto &[start, count] : _restoredRuns) {
+    for (auto i = start; i < start + count && i < _numSlots; i++) {
+      _slots[i].bDirty = true;
+    }
+  }
+  _restoredRuns.clear();
+}
+
+void LightStore::Update(const std::list<std::weak_ptr<scene::LightComponent>> &lights) {
+  ApplyRestored();
+
+  for (uint32_t i = 0; i < _numSlots; i++) {
+    if (_slots[i].key && _slots[i].light.expired()) {
+      FreeSlot(i);
+    }
+  }
+
+  for (const auto &light : lights) {
+    const auto lightRef = light.lock();
+    if (!lightRef) {
+      continue;
+    }
+
+    uint32_t slot;
+    if (const auto existing = _slotMap.find(lightRef.get()); existing != _slotMap.end()) {
+      slot = existing->second;
+    }
+    else {
+      if (!_freeSlots.empty()) {
+        slot = _freeSlots.back();
+        _freeSlots.pop();
+      }
+      else if (_numSlots < _capacity) {
+        slot = _numSlots++;
+      }
+      else {
+        continue;
+      }
+
+      _slots[slot].light = light;
+      _slots[slot].key = lightRef.get();
+      _slotMap.emplace(lightRef.get(), slot);
+      _bLayoutChanged = true;
+    }
+
+    if (auto &slotRef = _slots[slot]; slotRef.version != lightRef->GetLightVersion()) {
+      _lights[slot] = lightRef->GetLightInfo();
+      slotRef.version = lightRef->GetLightVersion();
+      slotRef.bDirty = true;
+    }
+  }
+
+  if (_bLayoutChanged) {
+    _usedSlots.clear();
+    for (uint32_t i = 0; i < _numSlots; i++) {
+      if (_slots[i].key) {
+        _usedSlots.push(i);
+      }
+    }
+    _bLayoutChanged = false;
+  }
+}
+
+size_t LightUpload::Write(const AllocatedBuffer &buffer) const {
+  size_t written = 0;
+  size_t offset = 0;
+  for (const auto &[start, count] : runs) {
+    const auto size = static_cast<size_t>(count) * sizeof(GpuLight);
+    buffer.Write(&lights[offset], size, static_cast<size_t>(start) * sizeof(GpuLight));
+    offset += count;
+    written += size;
+  }
+  return written;
+}
+
+void LightStore::TakeDirty(LightUpload &upload) {
+  uint32_t i = 0;
+  while (i < _numSlots) {
+    if (!_slots[i].bDirty) {
+      i++;
+      continue;
+    }
+
+    const auto start = i;
+    while (i < _numSlots && _slots[i].bDirty) {
+      _slots[i].bDirty = false;
+      upload.lights.push(_lights[i]);
+      i++;
+    }
+
+    upload.runs.push(std::pair{start, i - start});
+  }
+}
+
+void LightStore::Restore(const LightUpload &upload) {
+  if (upload.runs.empty()) {
+    return;
+  }
+
+  std::lock_guard guard(_restoreMutex);
+  for (const auto &run : upload.runs) {
+    _restoredRuns.push(run);
+  }
+}
+
+size_t LightStore::Upload(const AllocatedBuffer &buffer) {
+  LightUpload upload;
+  TakeDirty(upload);
+  return upload.Write(buffer);
+}
+
+const Array<uint32_t> &LightStore::GetUsedSlots() const {
+  return _usedSlots;
+}
+
+const GpuLight &LightStore::GetLight(const uint32_t slot) const {
+  return _lights[slot];
+}
+
+uint32_t LightStore::GetNumSlots() const {
+  return _numSlots;
+}
+
+uint32_t LightStore::GetCapacity() const {
+  return _capacity;
+}
+}
@@ -1,29 +1,35 @@
 #include "aerox/drawing/scene/SceneDeferredDrawer.hpp"
 #include "glm/gtx/transform2.hpp"
 #include "aerox/drawing/MaterialBuilder.hpp"
+#include "aerox/drawing/ParallelRecorder.hpp"
 #include "aerox/drawing/WindowDrawer.hpp"
 #include "aerox/io/io.hpp"
+#include "aerox/utils.hpp"
 #include "aerox/scene/components/CameraComponent.hpp"
 #include "aerox/scene/components/LightComponent.hpp"
 #include "aerox/scene/objects/SceneObject.hpp"
 
 namespace aerox::drawing {
 
-void GBuffer::Clear() {
-  location.reset();
-  color.reset();
-  normals.reset();
-  roughnessMetallic.reset();
-  emissive.reset();
-  specular.reset();
-}
-
 void SceneDeferredDrawer::OnInit(scene::Scene * owner) {
   SceneDrawer::OnInit(owner);
   
 
   auto drawer = GetDrawer().lock();
-  _sceneGlobalBuffer = drawer->GetAllocator().lock()->CreateUniformCpuGpuBuffer<SceneGlobalBuffer>(false,"Scene Global Buffer");
+  
+  for (auto &lights : _lightBuffers) {
+    lights.buffer = drawer->GetAllocator().lock()->CreateBuffer(
+        sizeof(GpuLight) * _lightStore.GetCapacity(),
+        vk::BufferUsageFlagBits::eStorageBuffer |
+        vk::BufferUsageFlagBits::eShaderDeviceAddress,
+        VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+        vk::MemoryPropertyFlagBits::eHostVisible,
+        VMA_ALLOCATION_CREATE_MAPPED_BIT |
+        VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT, "Scene Light Buffer");
+
+    lights.address = drawer->GetVirtualDevice().getBufferAddress(
+        vk::BufferDeviceAddressInfo{lights.buffer->buffer});
+  }
 
   auto shaderManager = drawer->GetShaderManager().lock();
   _defaultCheckeredMaterial = CreateMaterialInstance({
@@ -32,15 +38,10 @@ void SceneDeferredDrawer::OnInit(scene::Scene * owner) {
   });
   
   
-  const auto resources = _defaultCheckeredMaterial->GetResources();
-  //
-  for(const auto &key : resources.images | std::views::keys) {
-    _defaultCheckeredMaterial->SetTexture(key,drawer->GetDefaultBlackTexture().lock());
+  for(const auto &param : MESH_TEXTURE_PARAMS) {
+    _defaultCheckeredMaterial->SetParam(param,drawer->GetDefaultBlackTexture().lock());
   }
-  //
-  _defaultCheckeredMaterial->SetTexture("ColorT",drawer->GetDefaultErrorCheckerboardTexture().lock());
-  //
-  _defaultCheckeredMaterial->SetBuffer("SceneGlobalBuffer",_sceneGlobalBuffer);
+  _defaultCheckeredMaterial->SetParam("ColorT",drawer->GetDefaultErrorCheckerboardTexture().lock());
 
   AddCleanup([this] {
     _defaultCheckeredMaterial.reset();
@@ -67,47 +68,28 @@ void SceneDeferredDrawer::OnInit(scene::Scene * owner) {
                              .AddAttachmentFormats(
                                  {vk::Format::eR16G16B16A16Sfloat})
                              .Create();
-  
-  CreateBuffers();
+
+  _graph.Init(drawer.get());
+
+  _result = CreateRenderTargetImage();
 
   AddCleanup(GetWindowDrawer().lock()->onResizeScenes->BindFunction([this] {
-               CreateBuffers();
+               _result = CreateRenderTargetImage();
              }));
 
   AddCleanup([this] {
     _defaultCheckeredMaterial.reset();
     _shader.reset();
-    _sceneGlobalBuffer.reset();
-    _gBuffer.Clear();
+    for (auto &lights : _lightBuffers) {
+      lights.buffer.reset();
+      lights.pending.clear();
+    }
+    _graph.Destroy();
     _result.reset();
-    _depth.reset();
   });
 }
 
-void SceneDeferredDrawer::CreateBuffers() {
-  _gBuffer = {
-      CreateBufferImage(),
-      CreateBufferImage(),
-      CreateBufferImage(),
-      CreateBufferImage(),
-      CreateBufferImage(),
-      CreateBufferImage()
-  };
-
-  _depth = CreateDepthImage();
-
-  _result = CreateRenderTargetImage();
-
-  _shader->SetImage("TColor", _gBuffer.color, _sampler);
-  _shader->SetImage("TLocation", _gBuffer.location, _sampler);
-  _shader->SetImage("TNormal", _gBuffer.normals, _sampler);
-  _shader->SetImage("TRoughMetallic", _gBuffer.roughnessMetallic, _sampler);
-  _shader->SetImage("TSpecular", _gBuffer.specular, _sampler);
-  _shader->SetImage("TEmissive", _gBuffer.emissive, _sampler);
-  _shader->SetBuffer("SceneGlobalBuffer", _sceneGlobalBuffer);
-}
-
-std::shared_ptr<AllocatedImage> SceneDeferredDrawer::CreateBufferImage() {
+std::shared_ptr<AllocatedImage> SceneDeferredDrawer::CreateRenderTargetImage() {
   const auto swapchainExtent = GetWindowDrawer().lock()->
                                                  GetSwapchainExtent();
 
@@ -116,9 +98,9 @@ std::shared_ptr<AllocatedImage> SceneDeferredDrawer::CreateBufferImage() {
 
   vk::ImageUsageFlags drawImageUsages;
   drawImageUsages |= vk::ImageUsageFlagBits::eTransferSrc;
-  drawImageUsages |= vk::ImageUsageFlagBits::eTransferDst;
-  drawImageUsages |= vk::ImageUsageFlagBits::eSampled;
+  // drawImageUsages |= vk::ImageUsageFlagBits::eTransferDst;
   drawImageUsages |= vk::ImageUsageFlagBits::eColorAttachment;
+  drawImageUsages |= vk::ImageUsageFlagBits::eSampled;
 
   auto drawCreateInfo = DrawingSubsystem::MakeImageCreateInfo(
       vk::Format::eR16G16B16A16Sfloat,
@@ -143,234 +125,223 @@ std::shared_ptr<AllocatedImage> SceneDeferredDrawer::CreateBufferImage() {
   return newImage;
 }
 
-std::shared_ptr<AllocatedImage> SceneDeferredDrawer::CreateDepthImage() {
-
-  const auto swapchainExtent = GetWindowDrawer().lock()->
-                                                 GetSwapchainExtent();
+void SceneDeferredDrawer::UploadLightClusters(RawFrameData *frame) {
+  const auto &data = _lightClusters.GetData();
+  _sceneData.clusterBuffer = frame->GetUploads()->Upload(data.data(), data.byte_size()).address;
 
-  const auto imageExtent = vk::Extent3D{
-      swapchainExtent.width, swapchainExtent.height, 1};
-
-  auto depthCreateInfo = DrawingSubsystem::MakeImageCreateInfo(
-      vk::Format::eD32Sfloat,
-      imageExtent,
-      vk::ImageUsageFlagBits::eDepthStencilAttachment);
-
-  auto newImage = GetDrawer().lock()->GetAllocator().lock()->
-                              AllocateImage(depthCreateInfo,
-                                            VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
-                                            vk::MemoryPropertyFlagBits::eDeviceLocal);
-
-  const auto depthViewInfo = vk::ImageViewCreateInfo({}, newImage->image,
-    vk::ImageViewType::e2D,
-    newImage->format, {},
-    {vk::ImageAspectFlagBits::eDepth, 0,
-     1, 0, 1});
-
-  newImage->view = GetDrawer().lock()->GetVirtualDevice().createImageView(
-      depthViewInfo);
-
-  return newImage;
+  const auto gridSize = _lightClusters.GetGridSize();
+  _sceneData.clusterGrid = glm::uvec4{gridSize, 0};
+  _sceneData.clusterDepth = _lightClusters.GetDepthParams();
+  _sceneData.clusterForward = glm::vec4{_lightClusters.GetForward(), 0.0f};
 }
 
-std::shared_ptr<AllocatedImage> SceneDeferredDrawer::CreateRenderTargetImage() {
-  const auto swapchainExtent = GetWindowDrawer().lock()->
-                                                 GetSwapchainExtent();
+void SceneDeferredDrawer::CollectLights(SceneSnapshot &snapshot) {
+  _lightStore.Update(GetOwner()->GetSceneLights());
+  _lightStore.TakeDirty(snapshot.lights);
+  snapshot.lightSlots = _lightStore.GetUsedSlots();
 
-  const auto imageExtent = vk::Extent3D{
-      swapchainExtent.width, swapchainExtent.height, 1};
+  // Light info is cached in the store, only the view space location changes with the camera
+  for (const auto slot : snapshot.lightSlots) {
+    const auto &info = _lightStore.GetLight(slot);
+    const auto viewLocation = snapshot.viewMatrix * glm::vec4(glm::vec3(info.location), 1.0f);
+    snapshot.clusterLights.push(math::Sphere{glm::vec3(viewLocation), info.location.w});
+  }
+}
 
-  vk::ImageUsageFlags drawImageUsages;
-  drawImageUsages |= vk::ImageUsageFlagBits::eTransferSrc;
-  // drawImageUsages |= vk::ImageUsageFlagBits::eTransferDst;
-  drawImageUsages |= vk::ImageUsageFlagBits::eColorAttachment;
-  drawImageUsages |= vk::ImageUsageFlagBits::eSampled;
+LightBufferCopy &SceneDeferredDrawer::GetLightBuffer(RawFrameData *frame) {
+  if (!_lightBufferIndices.contains(frame)) {
+    utils::vassert(_lightBufferIndices.size() < _lightBuffers.size(), "Scene Recorded By More Frames Than There Are Light Buffers");
+    _lightBufferIndices.emplace(frame, static_cast<uint32_t>(_lightBufferIndices.size()));
+  }
 
-  auto drawCreateInfo = DrawingSubsystem::MakeImageCreateInfo(
-      vk::Format::eR16G16B16A16Sfloat,
-      imageExtent,
-      drawImageUsages);
-  std::shared_ptr<AllocatedImage> newImage = GetDrawer().lock()->GetAllocator().
-                                                 lock()->AllocateImage(
-                                                     drawCreateInfo,
-                                                     VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
-                                                     vk::MemoryPropertyFlagBits::eDeviceLocal);
+  return _lightBuffers[_lightBufferIndices[frame]];
+}
 
-  const auto drawViewInfo = vk::ImageViewCreateInfo({}, newImage->image,
-                                                    vk::ImageViewType::e2D,
-                                                    newImage->format, {},
-                                                    {vk::ImageAspectFlagBits::eColor,
-                                                      0,
-                                                      1, 0, 1});
+void SceneDeferredDrawer::UploadLights(RawFrameData *frame, const SceneSnapshot &snapshot) {
+  // The frame's copy was last read by the frame's previous submission, which has finished. Catch it up before writing this frame's runs.
+  auto &lights = GetLightBuffer(frame);
+  for (const auto &upload : lights.pending) {
+    upload.Write(*lights.buffer);
+  }
+  lights.pending.clear();
+  snapshot.lights.Write(*lights.buffer);
+
+  if (!snapshot.lights.runs.empty()) {
+    for (auto &other : _lightBuffers) {
+      if (&other != &lights) {
+        other.pending.push(snapshot.lights);
+      }
+    }
+  }
 
-  newImage->view = GetDrawer().lock()->GetVirtualDevice().createImageView(
-      drawViewInfo);
+  _sceneData.lightBuffer = lights.address;
+  _sceneData.numLights.x = static_cast<float>(snapshot.lightSlots.size());
 
-  return newImage;
+  _lightClusters.Build(snapshot.projectionMatrix, snapshot.nearClip, snapshot.farClip);
+  _lightClusters.Assign(snapshot.clusterLights, snapshot.lightSlots);
+  UploadLightClusters(frame);
 }
 
-void SceneDeferredDrawer::Draw(RawFrameData *frameData) {
-  auto cmd = frameData->GetCmd();
-
+recordFn SceneDeferredDrawer::Collect() {
   const auto scene = GetOwner();
 
   const auto cameraRef = scene->GetViewTarget().lock()->GetComponentByClass<
     scene::CameraComponent>().lock();
 
   if (!cameraRef || !cameraRef->IsInitialized()) {
-    frameData->GetDrawer()->GetLogger()->Warn(
+    GetDrawer().lock()->GetLogger()->Warn(
         "Skipping scene, no active camera");
-    return;
+    return {};
   }
 
-  const vk::Extent2D drawExtent = GetWindowDrawer().lock()->
-                                                    GetSwapchainExtent();
-
-  TransitionGBuffer(*cmd, vk::ImageLayout::eUndefined,
-                    vk::ImageLayout::eColorAttachmentOptimal);
+  // Frames can be dropped after collection (swapchain out of date, queue closed), their dirty lights would never be uploaded otherwise
+  const std::shared_ptr<SceneSnapshot> snapshot(
+      new SceneSnapshot{},
+      [weakSelf = std::weak_ptr(utils::castStatic<SceneDeferredDrawer>(shared_from_this()))](const SceneSnapshot *dropped) {
+        if (!dropped->bLightsUploaded) {
+          if (const auto self = weakSelf.lock()) {
+            self->_lightStore.Restore(dropped->lights);
+          }
+        }
+        delete dropped;
+      });
+  snapshot->extent = GetWindowDrawer().lock()->GetSwapchainExtent();
+
+  snapshot->viewMatrix = cameraRef->GetViewMatrix();
+  snapshot->projectionMatrix = cameraRef->GetProjection(
+      static_cast<float>(snapshot->extent.width) / static_cast<float>(snapshot->extent.
+        height));
+  const auto loc = cameraRef->GetWorldLocation();
+  snapshot->cameraLocation = glm::vec4{loc.x, loc.y, loc.z, 0.0f};
+  snapshot->nearClip = cameraRef->nearClipPlane;
+  snapshot->farClip = cameraRef->farClipPlane;
 
-  DrawingSubsystem::TransitionImage(*cmd, _depth->image,
-                                    vk::ImageLayout::eUndefined,
-                                    vk::ImageLayout::eDepthAttachmentOptimal,
-                                    vk::ImageAspectFlagBits::eDepth);
+  CollectLights(*snapshot);
 
-  auto renderingInfo = DrawingSubsystem::MakeRenderingInfo(drawExtent);
-  const auto attachments = MakeAttachments();
-  renderingInfo.setColorAttachments(attachments);
+  // Gather scene, only objects whose bounds touch the view frustum. Draw packets copy what they need so the scene can keep changing.
+  SceneFrameData drawData(nullptr, this);
+  const math::Frustum frustum{snapshot->projectionMatrix * snapshot->viewMatrix};
+  for (const auto &drawable : scene->QueryFrustum(frustum)) {
+    if (auto drawableRef = drawable.lock(); drawableRef->IsInitialized()) {
+      drawableRef->Draw(&drawData, {});
+    }
+  }
 
-  vk::ClearValue depthClear;
-  depthClear.setDepthStencil({1.f});
-  auto depthAttachment = DrawingSubsystem::MakeRenderingAttachment(
-      _depth->view, vk::ImageLayout::eDepthAttachmentOptimal, depthClear);
+  snapshot->lit = std::move(drawData.lit);
+  snapshot->translucent = std::move(drawData.translucent);
 
-  renderingInfo.setPDepthAttachment(&depthAttachment);
+  return [self = utils::castStatic<SceneDeferredDrawer>(shared_from_this()), snapshot](RawFrameData *frameData) {
+    self->Record(frameData, *snapshot);
+    snapshot->bLightsUploaded = true;
+  };
+}
 
-  frameData->GetCmd()->beginRendering(renderingInfo);
+void SceneDeferredDrawer::Record(RawFrameData *frameData, const SceneSnapshot &snapshot) {
+  const vk::Extent2D drawExtent = snapshot.extent;
 
-  _sceneData.viewMatrix = cameraRef->GetViewMatrix();
-  //glm::translate(glm::vec3{ 0,0,-5 }); glm::translate(glm::vec3{ 0,0,15 }); glm::translate(glm::vec3{ 0,0,15 });//
-  // camera projection
-  _sceneData.projectionMatrix = cameraRef->GetProjection(
-      static_cast<float>(drawExtent.width) / static_cast<float>(drawExtent.
-        height));
+  _sceneData.viewMatrix = snapshot.viewMatrix;
+  _sceneData.projectionMatrix = snapshot.projectionMatrix;
+  _sceneData.inverseViewProjection = glm::inverse(snapshot.projectionMatrix * snapshot.viewMatrix);
 
   //some default lighting parameters
   _sceneData.ambientColor = glm::vec4(.1f);
-  const auto loc = cameraRef->GetWorldLocation();
-  _sceneData.cameraLocation = glm::vec4{loc.x, loc.y, loc.z, 0.0f};
-
-  _sceneData.numLights.x = 0;
-  for (const auto &light : scene->GetSceneLights()) {
-    if (_sceneData.numLights.x == 1024)
-      break;
-    if (const auto lightRef = light.lock().get()) {
-      _sceneData.lights[static_cast<int>(_sceneData.numLights.x)] = lightRef->
-          GetLightInfo();
-      _sceneData.numLights.x++;
-    }
-  }
+  _sceneData.cameraLocation = snapshot.cameraLocation;
 
-  auto size = sizeof(_sceneData);
-  // Write the buffer
-  _sceneGlobalBuffer->Write(_sceneData);
+  UploadLights(frameData, snapshot);
 
-  SceneFrameData drawData(frameData, this);
+  // Frames in flight each read their own copy, draws push its address
+  const auto sceneGlobals = frameData->GetUploads()->Upload(_sceneData).address;
 
-  // Gather scene
-  for (const auto &drawable : scene->GetSceneObjects().clone()) {
-    if (auto drawableRef = drawable.lock(); drawableRef->IsInitialized()) {
-      drawableRef->Draw(&drawData, {});
-    }
-  }
+  // The G-buffer and depth only live for this frame so the graph may share their memory
+  RenderGraph graph;
+  const auto gBuffer = GBuffer::Create(graph, drawExtent);
 
-  // Draw Scene
-  for (const auto &lit : drawData.lit) {
-    lit(&drawData);
-  }
+  // The window copies the result every frame and it is cleared before it is drawn
+  const auto result = graph.ImportImage("Scene Result", _result,
+                                        {EImageUsage::TransferSrc, EImageUsage::TransferSrc, true});
 
-  cmd->endRendering();
+  auto &basePass = graph.AddPass("Scene Base", [this, &snapshot, gBuffer, drawExtent, sceneGlobals](RawFrameData *frame, const RenderGraphExecutor &executor) {
+    auto renderingInfo = DrawingSubsystem::MakeRenderingInfo(drawExtent);
+    const auto attachments = MakeAttachments(executor, gBuffer);
+    renderingInfo.setColorAttachments(attachments);
 
-  DrawingSubsystem::TransitionImage(*cmd, _result->image,
-                                    vk::ImageLayout::eUndefined,
-                                    vk::ImageLayout::eColorAttachmentOptimal);
+    vk::ClearValue depthClear;
+    depthClear.setDepthStencil({1.f});
+    auto depthAttachment = DrawingSubsystem::MakeRenderingAttachment(
+        executor.GetImage(gBuffer.depth)->view, vk::ImageLayout::eDepthAttachmentOptimal, depthClear);
 
-  TransitionGBuffer(*cmd, vk::ImageLayout::eColorAttachmentOptimal,
-                    vk::ImageLayout::eShaderReadOnlyOptimal);
+    renderingInfo.setPDepthAttachment(&depthAttachment);
 
-  renderingInfo = DrawingSubsystem::MakeRenderingInfo(drawExtent);
-  auto resultAttachment = DrawingSubsystem::MakeRenderingAttachment(
-      _result->view, vk::ImageLayout::eColorAttachmentOptimal,vk::ClearValue{{0, 0, 0, 0}});
-  renderingInfo.setColorAttachments(resultAttachment);
+    // Draw Scene, packet ranges are recorded in parallel once there are enough of them
+    const ParallelRecorder recorder(frame, snapshot.lit.size());
+    renderingInfo.setFlags(recorder.GetRenderingFlags());
 
-  cmd->beginRendering(renderingInfo);
+    const auto cmd = frame->GetCmd();
+    cmd->beginRendering(renderingInfo);
 
-  _shader->BindPipeline(frameData);
-  _shader->BindSets(frameData);
-  cmd->draw(6, 1, 0, 0);
+    recorder.Record(GetColorAttachmentFormats(), GBUFFER_DEPTH_FORMAT,
+                    [this, frame, &snapshot, sceneGlobals](vk::CommandBuffer *recordCmd, const size_t begin, const size_t end) {
+                      SceneFrameData drawData(frame, this, recordCmd, sceneGlobals);
+                      for (auto i = begin; i < end; i++) {
+                        snapshot.lit[i](&drawData);
+                      }
+                    });
 
-  cmd->endRendering();
+    cmd->endRendering();
+  });
+  for (const auto image : gBuffer.targets) {
+    basePass.Write(image, EImageUsage::ColorAttachmentWrite);
+  }
+  basePass.Write(gBuffer.depth, EImageUsage::DepthAttachmentWrite);
+
+  auto &lightingPass = graph.AddPass("Scene Lighting", [this, gBuffer, result, drawExtent, sceneGlobals](RawFrameData *frame, const RenderGraphExecutor &executor) {
+    // Descriptors only change when the graph recreated its images, which waits for the device first
+    if (_gBufferGeneration != executor.GetGeneration()) {
+      for (uint8_t i = 0; i < static_cast<uint8_t>(EGBufferTarget::Count); i++) {
+        _shader->SetImage(getGBufferTarget(static_cast<EGBufferTarget>(i)).sampler, executor.GetImage(gBuffer.targets[i]), _sampler);
+      }
+      _shader->SetImage(GBUFFER_DEPTH_SAMPLER, executor.GetImage(gBuffer.depth), _sampler);
+      _gBufferGeneration = executor.GetGeneration();
+    }
 
-  DrawingSubsystem::TransitionImage(*cmd, _result->image,
-                                    vk::ImageLayout::eColorAttachmentOptimal,
-                                    vk::ImageLayout::eTransferSrcOptimal);
-}
+    auto renderingInfo = DrawingSubsystem::MakeRenderingInfo(drawExtent);
+    auto resultAttachment = DrawingSubsystem::MakeRenderingAttachment(
+        executor.GetImage(result)->view, vk::ImageLayout::eColorAttachmentOptimal,vk::ClearValue{{0, 0, 0, 0}});
+    renderingInfo.setColorAttachments(resultAttachment);
 
-void SceneDeferredDrawer::TransitionGBuffer(vk::CommandBuffer cmd,
-                                            vk::ImageLayout from,
-                                            vk::ImageLayout to) {
-  DrawingSubsystem::TransitionImage(cmd, _gBuffer.color->image,
-                                    from,
-                                    to);
-  DrawingSubsystem::TransitionImage(cmd, _gBuffer.emissive->image,
-                                    from,
-                                    to);
-  DrawingSubsystem::TransitionImage(cmd, _gBuffer.location->image,
-                                    from,
-                                    to);
-  DrawingSubsystem::TransitionImage(cmd, _gBuffer.normals->image,
-                                    from,
-                                    to);
-  DrawingSubsystem::TransitionImage(cmd, _gBuffer.specular->image,
-                                    from,
-                                    to);
-  DrawingSubsystem::TransitionImage(cmd, _gBuffer.roughnessMetallic->image,
-                                    from,
-                                    to);
-}
+    const auto cmd = frame->GetCmd();
+    cmd->beginRendering(renderingInfo);
 
+    _shader->BindPipeline(frame);
+    _shader->BindSets(frame);
+    _shader->Push(cmd, "pScene", sceneGlobals);
+    cmd->draw(6, 1, 0, 0);
 
-Array<vk::RenderingAttachmentInfo> SceneDeferredDrawer::MakeAttachments() {
+    cmd->endRendering();
+  });
+  // Locations are rebuilt from depth so it is sampled along with the targets
+  for (const auto image : gBuffer.targets) {
+    lightingPass.Read(image, EImageUsage::FragmentSampled);
+  }
+  lightingPass.Read(gBuffer.depth, EImageUsage::FragmentSampled);
+  lightingPass.Write(result, EImageUsage::ColorAttachmentWrite);
+
+  _graph.Execute(frameData, graph);
+}
+Array<vk::RenderingAttachmentInfo> SceneDeferredDrawer::MakeAttachments(const RenderGraphExecutor &executor, const GBuffer &gBuffer) {
 
   Array<vk::RenderingAttachmentInfo> attachments;
-  attachments.push(DrawingSubsystem::MakeRenderingAttachment(
-      _gBuffer.color->view, vk::ImageLayout::eColorAttachmentOptimal,
-      vk::ClearValue{{0, 0, 0, 0}}));
-  attachments.push(DrawingSubsystem::MakeRenderingAttachment(
-      _gBuffer.location->view, vk::ImageLayout::eColorAttachmentOptimal,
-      vk::ClearValue{{0, 0, 0, 0}}));
-  attachments.push(DrawingSubsystem::MakeRenderingAttachment(
-      _gBuffer.normals->view, vk::ImageLayout::eColorAttachmentOptimal,
-      vk::ClearValue{{0, 0, 0, 0}}));
-  attachments.push(DrawingSubsystem::MakeRenderingAttachment(
-      _gBuffer.roughnessMetallic->view,
-      vk::ImageLayout::eColorAttachmentOptimal, vk::ClearValue{{0, 0, 0, 0}}));
-  attachments.push(DrawingSubsystem::MakeRenderingAttachment(
-      _gBuffer.specular->view, vk::ImageLayout::eColorAttachmentOptimal,
-      vk::ClearValue{{0, 0, 0, 0}}));
-  attachments.push(DrawingSubsystem::MakeRenderingAttachment(
-      _gBuffer.emissive->view, vk::ImageLayout::eColorAttachmentOptimal,
-      vk::ClearValue{{0, 0, 0, 0}}));
+  for (const auto image : gBuffer.targets) {
+    attachments.push(DrawingSubsystem::MakeRenderingAttachment(
+        executor.GetImage(image)->view, vk::ImageLayout::eColorAttachmentOptimal,
+        vk::ClearValue{{0, 0, 0, 0}}));
+  }
 
   return attachments;
 }
 
 Array<vk::Format> SceneDeferredDrawer::GetColorAttachmentFormats() {
-  return {vk::Format::eR16G16B16A16Sfloat,
-          vk::Format::eR16G16B16A16Sfloat,
-          vk::Format::eR16G16B16A16Sfloat,
-          vk::Format::eR16G16B16A16Sfloat,
-          vk::Format::eR16G16B16A16Sfloat,
-          vk::Format::eR16G16B16A16Sfloat};
+  return getGBufferFormats();
 }
 
 std::weak_ptr<AllocatedImage> SceneDeferredDrawer::GetRenderTarget() {
@@ -379,9 +350,12 @@ std::weak_ptr<AllocatedImage> SceneDeferredDrawer::GetRenderTarget() {
 
 std::shared_ptr<MaterialInstance> SceneDeferredDrawer::CreateMaterialInstance(
     const Array<std::shared_ptr<Shader>> &shaders) {
-  auto mat = MaterialBuilder().AddShaders(shaders).SetType(EMaterialType::Lit).AddAttachmentFormats(GetColorAttachmentFormats()).Create();
-  mat->SetBuffer("SceneGlobalBuffer",_sceneGlobalBuffer);
-  return mat;
+  MaterialBuilder builder;
+  builder.AddShaders(shaders).SetType(EMaterialType::Lit).AddAttachmentFormats(GetColorAttachmentFormats());
+  for (const auto &param : MESH_TEXTURE_PARAMS) {
+    builder.AddParam(param);
+  }
+  return builder.Create();
 }
 
 std::weak_ptr<MaterialInstance> SceneDeferredDrawer::GetDefaultMaterial() {
@@ -389,6 +363,7 @@ std::weak_ptr<MaterialInstance> SceneDeferredDrawer::GetDefaultMaterial() {
 }
 
 void SceneDeferredDrawer::OnDestroy() {
+  GetDrawer().lock()->WaitForRenderThread();
   GetDrawer().lock()->WaitDeviceIdle();
   SceneDrawer::OnDestroy();
 }
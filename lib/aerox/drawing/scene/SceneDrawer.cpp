@@ -16,11 +16,17 @@ void SceneDrawer::OnInit(scene::Scene * owner) {
   TOwnedBy::OnInit(owner);
   auto drawer = GetDrawer().lock();
 
-  if (auto windowDrawer = drawer->GetWindowDrawer(Engine::Get()->GetMainWindow()).lock()) {
+  if (auto windowDrawer = drawer->GetMainWindowDrawer().lock()) {
     _windowDrawer = windowDrawer;
-    AddCleanup(windowDrawer->onDrawScenes->BindFunction(
-                   [this](drawing::RawFrameData *rawFrame) {
-                     Draw(rawFrame);
+    AddCleanup(windowDrawer->onCollectScenes->BindFunction(
+                   [this](WindowSnapshot *snapshot) {
+                     if (auto record = Collect()) {
+                       snapshot->scenes.push(std::move(record));
+                       // Ui replaces this with the image it composites, headless runs have no ui so the scene is shown as is
+                       if (!snapshot->output) {
+                         snapshot->output = GetRenderTarget().lock();
+                       }
+                     }
                    }));
   }
 }
@@ -2,14 +2,19 @@
 
 namespace aerox::drawing {
 
-SceneFrameData::SceneFrameData(RawFrameData *frame, SceneDrawer *drawer) : SimpleFrameData(frame){
+SceneFrameData::SceneFrameData(RawFrameData *frame, SceneDrawer *drawer, vk::CommandBuffer *cmd, const vk::DeviceAddress sceneGlobals) : SimpleFrameData(frame, cmd){
   _sceneDrawer = drawer;
+  _sceneGlobals = sceneGlobals;
 }
 
 SceneDrawer * SceneFrameData::GetSceneDrawer() const {
   return _sceneDrawer;
 }
 
+vk::DeviceAddress SceneFrameData::GetSceneGlobals() const {
+  return _sceneGlobals;
+}
+
 void SceneFrameData::AddLit(const drawFn &litFn) {
   lit.push(litFn);
 }
@@ -10,10 +10,26 @@ vk::CommandPool * RawFrameData::GetCmdPool() {
   return &_cmdPool;
 }
 
+WorkerCommandPools * RawFrameData::GetWorkerPools() {
+  return &_workerPools;
+}
+
+FrameUploadBuffer * RawFrameData::GetUploads() {
+  return &_uploads;
+}
+
+GpuTimer * RawFrameData::GetTimer() {
+  return &_timer;
+}
+
 DescriptorAllocatorGrowable * RawFrameData::GetDescriptorAllocator() {
   return &_frameDescriptors;
 }
 
+std::mutex * RawFrameData::GetDescriptorMutex() {
+  return &_descriptorMutex;
+}
+
 vk::Semaphore RawFrameData::GetSwapchainSemaphore() const {
   return _swapchainSemaphore;
 }
@@ -34,6 +50,18 @@ WindowDrawer * RawFrameData::GetWindowDrawer() const {
   return _windowDrawer;
 }
 
+vk::Viewport RawFrameData::GetViewport() const {
+  return _viewport;
+}
+
+uint64_t RawFrameData::GetId() const {
+  return _id;
+}
+
+void RawFrameData::SetId(const uint64_t id) {
+  _id = id;
+}
+
 void RawFrameData::SetSemaphores(const vk::Semaphore &swapchain, const vk::Semaphore &render) {
   _swapchainSemaphore = swapchain;
   _renderSemaphore = render;
@@ -59,6 +87,10 @@ void RawFrameData::SetWindowDrawer(WindowDrawer *windowDrawer) {
   _windowDrawer = windowDrawer;
 }
 
+void RawFrameData::SetViewport(const vk::Viewport &viewport) {
+  _viewport = viewport;
+}
+
 
 BasicShaderResourceInfo::BasicShaderResourceInfo() = default;
 
@@ -88,12 +120,13 @@ PushConstantInfo::PushConstantInfo(uint32_t inOffset, uint32_t _size,
   
 }
 
-SimpleFrameData::SimpleFrameData(RawFrameData *frame) {
+SimpleFrameData::SimpleFrameData(RawFrameData *frame, vk::CommandBuffer *cmd) {
   _frame = frame;
+  _cmd = cmd;
 }
 
 vk::CommandBuffer * SimpleFrameData::GetCmd() const {
-  return _frame->GetCmd();
+  return _cmd ? _cmd : _frame->GetCmd();
 }
 
 
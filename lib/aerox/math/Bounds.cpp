@@ -0,0 +1,185 @@
+#include <aerox/math/Bounds.hpp>
+#include <algorithm>
+
+namespace aerox::math {
+
+Sphere::Sphere(const glm::vec3 &inCenter, const float inRadius) : center(inCenter), radius(inRadius) {
+}
+
+Ray::Ray(const glm::vec3 &inOrigin, const glm::vec3 &inDirection) : origin(inOrigin),
+  direction(glm::normalize(inDirection)) {
+}
+
+glm::vec3 Ray::At(const float distance) const {
+  return origin + direction * distance;
+}
+
+Bounds::Bounds(const glm::vec3 &inMin, const glm::vec3 &inMax) : min(inMin), max(inMax) {
+}
+
+Bounds Bounds::FromPoint(const glm::vec3 &point) {
+  return {point, point};
+}
+
+Bounds Bounds::FromSphere(const Sphere &sphere) {
+  return {sphere.center - glm::vec3{sphere.radius}, sphere.center + glm::vec3{sphere.radius}};
+}
+
+bool Bounds::IsValid() const {
+  return min.x <= max.x && min.y <= max.y && min.z <= max.z;
+}
+
+glm::vec3 Bounds::GetCenter() const {
+  return (min + max) * 0.5f;
+}
+
+glm::vec3 Bounds::GetExtent() const {
+  return (max - min) * 0.5f;
+}
+
+float Bounds::GetSurfaceArea() const {
+  const auto size = max - min;
+  return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+Bounds Bounds::Union(const Bounds &other) const {
+  return {glm::min(min, other.min), glm::max(max, other.max)};
+}
+
+Bounds Bounds::Expand(const float amount) const {
+  return {min - glm::vec3{amount}, max + glm::vec3{amount}};
+}
+
+Bounds Bounds::Expand(const glm::vec3 &point) const {
+  return {glm::min(min, point), glm::max(max, point)};
+}
+
+bool Bounds::Contains(const glm::vec3 &point) const {
+  return point.x >= min.x && point.y >= min.y && point.z >= min.z &&
+         point.x <= max.x && point.y <= max.y && point.z <= max.z;
+}
+
+bool Bounds::Contains(const Bounds &other) const {
+  return other.min.x >= min.x && other.min.y >= min.y && other.min.z >= min.z &&
+         other.max.x <= max.x && other.max.y <= max.y && other.max.z <= max.z;
+}
+
+bool Bounds::Intersects(const Bounds &other) const {
+  return min.x <= other.max.x && max.x >= other.min.x &&
+         min.y <= other.max.y && max.y >= other.min.y &&
+         min.z <= other.max.z && max.z >= other.min.z;
+}
+
+bool Bounds::Intersects(const Sphere &sphere) const {
+  const auto closest = glm::clamp(sphere.center, min, max);
+  const auto delta = sphere.center - closest;
+  return glm::dot(delta, delta) <= sphere.radius * sphere.radius;
+}
+
+bool Bounds::Intersects(const Ray &ray, const float maxDistance, float &outDistance) const {
+  auto tMin = 0.0f;
+  auto tMax = maxDistance;
+
+  for (auto i = 0; i < 3; i++) {
+    if (std::abs(ray.direction[i]) < std::numeric_limits<float>::epsilon()) {
+      if (ray.origin[i] < min[i] || ray.origin[i] > max[i]) {
+        return false;
+      }
+      continue;
+    }
+
+    const auto invDir = 1.0f / ray.direction[i];
+    auto t1 = (min[i] - ray.origin[i]) * invDir;
+    auto t2 = (max[i] - ray.origin[i]) * invDir;
+    if (t1 > t2) {
+      std::swap(t1, t2);
+    }
+
+    tMin = std::max(tMin, t1);
+    tMax = std::min(tMax, t2);
+
+    if (tMin > tMax) {
+      return false;
+    }
+  }
+
+  outDistance = tMin;
+  return true;
+}
+
+Bounds Bounds::TransformBy(const glm::mat4 &matrix) const {
+  if (!IsValid()) {
+    return *this;
+  }
+
+  // Arvo's method, transforms the center and sums the absolute extents of each axis
+  const auto center = glm::vec3(matrix * glm::vec4(GetCenter(), 1.0f));
+  const auto extent = GetExtent();
+  glm::vec3 newExtent{0.0f};
+  for (auto i = 0; i < 3; i++) {
+    newExtent += glm::abs(glm::vec3(matrix[i])) * extent[i];
+  }
+
+  return {center - newExtent, center + newExtent};
+}
+
+Frustum::Frustum(const glm::mat4 &viewProjection) {
+  // Gribb/Hartmann plane extraction, glm matrices are column major
+  const auto row = [&](const int index) {
+    return glm::vec4{viewProjection[0][index], viewProjection[1][index], viewProjection[2][index],
+                     viewProjection[3][index]};
+  };
+
+  const auto r0 = row(0);
+  const auto r1 = row(1);
+  const auto r2 = row(2);
+  const auto r3 = row(3);
+
+  planes[0] = r3 + r0; // Left
+  planes[1] = r3 - r0; // Right
+  planes[2] = r3 + r1; // Bottom
+  planes[3] = r3 - r1; // Top
+  planes[4] = r3 + r2; // Near
+  planes[5] = r3 - r2; // Far
+
+  for (auto &plane : planes) {
+    plane /= glm::length(glm::vec3(plane));
+  }
+}
+
+bool Frustum::Intersects(const Bounds &bounds) const {
+  for (const auto &plane : planes) {
+    const auto normal = glm::vec3(plane);
+    // The corner furthest along the plane normal
+    const glm::vec3 positive{normal.x >= 0 ? bounds.max.x : bounds.min.x,
+                             normal.y >= 0 ? bounds.max.y : bounds.min.y,
+                             normal.z >= 0 ? bounds.max.z : bounds.min.z};
+    if (glm::dot(normal, positive) + plane.w < 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Frustum::Intersects(const Sphere &sphere) const {
+  for (const auto &plane : planes) {
+    if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Frustum::Contains(const Bounds &bounds) const {
+  for (const auto &plane : planes) {
+    const auto normal = glm::vec3(plane);
+    const glm::vec3 negative{normal.x >= 0 ? bounds.min.x : bounds.max.x,
+                             normal.y >= 0 ? bounds.min.y : bounds.max.y,
+                             normal.z >= 0 ? bounds.min.z : bounds.max.z};
+    if (glm::dot(normal, negative) + plane.w < 0) {
+      return false;
+    }
+  }
+  return true;
+}
+}
@@ -0,0 +1,460 @@
+#include <aerox/math/BoundsTree.hpp>
+#include <algorithm>
+
+namespace aerox::math {
+
+BoundsTree::BoundsTree(const float margin) : _margin(margin) {
+}
+
+int32_t BoundsTree::AllocateNode() {
+  if (_freeList == NULL_NODE) {
+    _nodes.emplace_back();
+    _nodes.back().height = 0;
+    return static_cast<int32_t>(_nodes.size() - 1);
+  }
+
+  const auto node = _freeList;
+  _freeList = _nodes[node].parent;
+  _nodes[node] = Node{};
+  _nodes[node].height = 0;
+  return node;
+}
+
+void BoundsTree::FreeNode(const int32_t node) {
+  _nodes[node].parent = _freeList;
+  _nodes[node].left = NULL_NODE;
+  _nodes[node].right = NULL_NODE;
+  _nodes[node].userData = nullptr;
+  _nodes[node].height = -1;
+  _freeList = node;
+}
+
+int32_t BoundsTree::Insert(const Bounds &bounds, void *userData) {
+  const auto proxy = AllocateNode();
+  _nodes[proxy].bounds = bounds.Expand(_margin);
+  _nodes[proxy].userData = userData;
+  InsertLeaf(proxy);
+  _proxyCount++;
+  return proxy;
+}
+
+void BoundsTree::Remove(const int32_t proxy) {
+  RemoveLeaf(proxy);
+  FreeNode(proxy);
+  _proxyCount--;
+}
+
+bool BoundsTree::Move(const int32_t proxy, const Bounds &bounds, const glm::vec3 &displacement) {
+  auto fat = bounds.Expand(_margin);
+  const auto predicted = displacement * DISPLACEMENT_MULTIPLIER;
+  fat.min += glm::min(predicted, glm::vec3{0.0f});
+  fat.max += glm::max(predicted, glm::vec3{0.0f});
+
+  if (_nodes[proxy].bounds.Contains(bounds)) {
+    // Also re-insert leaves that are now far larger than what they hold so queries stay tight
+    const auto large = fat.Expand(_margin * 4.0f);
+    if (large.Contains(_nodes[proxy].bounds)) {
+      return false;
+    }
+  }
+
+  RemoveLeaf(proxy);
+  _nodes[proxy].bounds = fat;
+  InsertLeaf(proxy);
+  return true;
+}
+
+void *BoundsTree::GetUserData(const int32_t proxy) const {
+  return _nodes[proxy].userData;
+}
+
+const Bounds &BoundsTree::GetFatBounds(const int32_t proxy) const {
+  return _nodes[proxy].bounds;
+}
+
+void BoundsTree::InsertLeaf(const int32_t leaf) {
+  if (_root == NULL_NODE) {
+    _root = leaf;
+    _nodes[leaf].parent = NULL_NODE;
+    return;
+  }
+
+  // Descend towards the cheapest sibling using the surface area heuristic
+  const auto leafBounds = _nodes[leaf].bounds;
+  auto index = _root;
+  while (!_nodes[index].IsLeaf()) {
+    const auto &node = _nodes[index];
+    const auto area = node.bounds.GetSurfaceArea();
+    const auto combinedArea = node.bounds.Union(leafBounds).GetSurfaceArea();
+
+    // Cost of making a new parent for this node and the leaf
+    const auto cost = 2.0f * combinedArea;
+
+    // Minimum cost of pushing the leaf further down the tree
+    const auto inheritanceCost = 2.0f * (combinedArea - area);
+
+    const auto childCost = [&](const int32_t child) {
+      const auto &childNode = _nodes[child];
+      const auto unionArea = childNode.bounds.Union(leafBounds).GetSurfaceArea();
+      if (childNode.IsLeaf()) {
+        return unionArea + inheritanceCost;
+      }
+      return unionArea - childNode.bounds.GetSurfaceArea() + inheritanceCost;
+    };
+
+    const auto costLeft = childCost(node.left);
+    const auto costRight = childCost(node.right);
+
+    if (cost < costLeft && cost < costRight) {
+      break;
+    }
+
+    index = costLeft < costRight ? node.left : node.right;
+  }
+
+  const auto sibling = index;
+  const auto oldParent = _nodes[sibling].parent;
+  const auto newParent = AllocateNode();
+  _nodes[newParent].parent = oldParent;
+  _nodes[newParent].bounds = leafBounds.Union(_nodes[sibling].bounds);
+  _nodes[newParent].height = _nodes[sibling].height + 1;
+  _nodes[newParent].left = sibling;
+  _nodes[newParent].right = leaf;
+  _nodes[sibling].parent = newParent;
+  _nodes[leaf].parent = newParent;
+
+  if (oldParent == NULL_NODE) {
+    _root = newParent;
+  }
+  else if (_nodes[oldParent].left == sibling) {
+    _nodes[oldParent].left = newParent;
+  }
+  else {
+    _nodes[oldParent].right = newParent;
+  }
+
+  Refit(_nodes[leaf].parent);
+}
+
+void BoundsTree::RemoveLeaf(const int32_t leaf) {
+  if (leaf == _root) {
+    _root = NULL_NODE;
+    return;
+  }
+
+  const auto parent = _nodes[leaf].parent;
+  const auto grandParent = _nodes[parent].parent;
+  const auto sibling = _nodes[parent].left == leaf ? _nodes[parent].right : _nodes[parent].left;
+
+  if (grandParent == NULL_NODE) {
+    _root = sibling;
+    _nodes[sibling].parent = NULL_NODE;
+    FreeNode(parent);
+    return;
+  }
+
+  if (_nodes[grandParent].left == parent) {
+    _nodes[grandParent].left = sibling;
+  }
+  else {
+    _nodes[grandParent].right = sibling;
+  }
+  _nodes[sibling].parent = grandParent;
+  FreeNode(parent);
+
+  Refit(grandParent);
+}
+
+void BoundsTree::Refit(int32_t node) {
+  while (node != NULL_NODE) {
+    node = Balance(node);
+
+    auto &current = _nodes[node];
+    const auto &left = _nodes[current.left];
+    const auto &right = _nodes[current.right];
+    current.height = 1 + std::max(left.height, right.height);
+    current.bounds = left.bounds.Union(right.bounds);
+
+    node = current.parent;
+  }
+}
+
+int32_t BoundsTree::Balance(const int32_t a) {
+  // Rotates the taller child of a up if the subtree is out of balance, returns the new root of the subtree
+  auto &nodeA = _nodes[a];
+  if (nodeA.IsLeaf() || nodeA.height < 2) {
+    return a;
+  }
+
+  const auto b = nodeA.left;
+  const auto c = nodeA.right;
+  const auto balance = _nodes[c].height - _nodes[b].height;
+
+  const auto rotate = [&](const int32_t up, const int32_t other, const bool upIsRight) {
+    auto &nodeUp = _nodes[up];
+    const auto f = nodeUp.left;
+    const auto g = nodeUp.right;
+
+    nodeUp.left = a;
+    nodeUp.parent = _nodes[a].parent;
+    _nodes[a].parent = up;
+
+    if (nodeUp.parent == NULL_NODE) {
+      _root = up;
+    }
+    else if (_nodes[nodeUp.parent].left == a) {
+      _nodes[nodeUp.parent].left = up;
+    }
+    else {
+      _nodes[nodeUp.parent].right = up;
+    }
+
+    // Keep the taller grandchild under up, give the shorter one to a
+    const auto keep = _nodes[f].height > _nodes[g].height ? f : g;
+    const auto give = keep == f ? g : f;
+
+    nodeUp.right = keep;
+    if (upIsRight) {
+      _nodes[a].right = give;
+    }
+    else {
+      _nodes[a].left = give;
+    }
+    _nodes[give].parent = a;
+
+    auto &lowered = _nodes[a];
+    lowered.bounds = _nodes[other].bounds.Union(_nodes[give].bounds);
+    lowered.height = 1 + std::max(_nodes[other].height, _nodes[give].height);
+
+    nodeUp.bounds = lowered.bounds.Union(_nodes[keep].bounds);
+    nodeUp.height = 1 + std::max(lowered.height, _nodes[keep].height);
+    return up;
+  };
+
+  if (balance > 1) {
+    return rotate(c, b, true);
+  }
+
+  if (balance < -1) {
+    return rotate(b, c, false);
+  }
+
+  return a;
+}
+
+void BoundsTree::Query(const Bounds &bounds, const QueryCallback &callback) const {
+  if (_root == NULL_NODE) {
+    return;
+  }
+
+  Array<int32_t> stack;
+  stack.reserve(64);
+  stack.push(_root);
+  while (!stack.empty()) {
+    const auto index = stack.back();
+    stack.pop();
+
+    const auto &node = _nodes[index];
+    if (!node.bounds.Intersects(bounds)) {
+      continue;
+    }
+
+    if (node.IsLeaf()) {
+      if (!callback(index)) {
+        return;
+      }
+      continue;
+    }
+
+    stack.push(node.left);
+    stack.push(node.right);
+  }
+}
+
+void BoundsTree::Query(const Sphere &sphere, const QueryCallback &callback) const {
+  if (_root == NULL_NODE) {
+    return;
+  }
+
+  Array<int32_t> stack;
+  stack.reserve(64);
+  stack.push(_root);
+  while (!stack.empty()) {
+    const auto index = stack.back();
+    stack.pop();
+
+    const auto &node = _nodes[index];
+    if (!node.bounds.Intersects(sphere)) {
+      continue;
+    }
+
+    if (node.IsLeaf()) {
+      if (!callback(index)) {
+        return;
+      }
+      continue;
+    }
+
+    stack.push(node.left);
+    stack.push(node.right);
+  }
+}
+
+void BoundsTree::Query(const Frustum &frustum, const QueryCallback &callback) const {
+  if (_root == NULL_NODE) {
+    return;
+  }
+
+  // Second value is true once an ancestor was fully inside the frustum, those subtrees skip the plane tests
+  Array<std::pair<int32_t, bool>> stack;
+  stack.reserve(64);
+  stack.push({_root, false});
+  while (!stack.empty()) {
+    auto [index, inside] = stack.back();
+    stack.pop();
+
+    const auto &node = _nodes[index];
+    if (!inside) {
+      if (!frustum.Intersects(node.bounds)) {
+        continue;
+      }
+      inside = frustum.Contains(node.bounds);
+    }
+
+    if (node.IsLeaf()) {
+      if (!callback(index)) {
+        return;
+      }
+      continue;
+    }
+
+    stack.push({node.left, inside});
+    stack.push({node.right, inside});
+  }
+}
+
+void BoundsTree::RayCast(const Ray &ray, float maxDistance, const RayCastCallback &callback) const {
+  if (_root == NULL_NODE) {
+    return;
+  }
+
+  Array<int32_t> stack;
+  stack.reserve(64);
+  stack.push(_root);
+  while (!stack.empty()) {
+    const auto index = stack.back();
+    stack.pop();
+
+    const auto &node = _nodes[index];
+    float distance;
+    if (!node.bounds.Intersects(ray, maxDistance, distance)) {
+      continue;
+    }
+
+    if (node.IsLeaf()) {
+      const auto newMax = callback(index, distance, maxDistance);
+      if (newMax <= 0.0f) {
+        return;
+      }
+      maxDistance = std::min(maxDistance, newMax);
+      continue;
+    }
+
+    stack.push(node.left);
+    stack.push(node.right);
+  }
+}
+
+int32_t BoundsTree::BuildTopDown(int32_t *leaves, const size_t count) {
+  if (count == 1) {
+    return leaves[0];
+  }
+
+  Bounds centroids;
+  for (size_t i = 0; i < count; i++) {
+    centroids = centroids.Expand(_nodes[leaves[i]].bounds.GetCenter());
+  }
+
+  const auto size = centroids.max - centroids.min;
+  const auto axis = size.x > size.y ? (size.x > size.z ? 0 : 2) : (size.y > size.z ? 1 : 2);
+  const auto half = count / 2;
+
+  std::nth_element(leaves, leaves + half, leaves + count, [&](const int32_t a, const int32_t b) {
+    return _nodes[a].bounds.GetCenter()[axis] < _nodes[b].bounds.GetCenter()[axis];
+  });
+
+  const auto left = BuildTopDown(leaves, half);
+  const auto right = BuildTopDown(leaves + half, count - half);
+
+  const auto parent = AllocateNode();
+  auto &node = _nodes[parent];
+  node.left = left;
+  node.right = right;
+  node.bounds = _nodes[left].bounds.Union(_nodes[right].bounds);
+  node.height = 1 + std::max(_nodes[left].height, _nodes[right].height);
+  _nodes[left].parent = parent;
+  _nodes[right].parent = parent;
+  return parent;
+}
+
+void BoundsTree::Rebuild() {
+  if (_root == NULL_NODE) {
+    return;
+  }
+
+  Array<int32_t> leaves;
+  leaves.reserve(_proxyCount);
+  for (auto i = 0; i < static_cast<int32_t>(_nodes.size()); i++) {
+    if (_nodes[i].height < 0) {
+      continue;
+    }
+
+    if (_nodes[i].IsLeaf()) {
+      _nodes[i].parent = NULL_NODE;
+      leaves.push(i);
+    }
+    else {
+      FreeNode(i);
+    }
+  }
+
+  _root = BuildTopDown(leaves.data(), leaves.size());
+  _nodes[_root].parent = NULL_NODE;
+}
+
+void BoundsTree::Clear() {
+  _nodes.clear();
+  _root = NULL_NODE;
+  _freeList = NULL_NODE;
+  _proxyCount = 0;
+}
+
+size_t BoundsTree::GetProxyCount() const {
+  return _proxyCount;
+}
+
+int32_t BoundsTree::GetHeight() const {
+  return _root == NULL_NODE ? 0 : _nodes[_root].height;
+}
+
+float BoundsTree::GetAreaRatio() const {
+  if (_root == NULL_NODE) {
+    return 0.0f;
+  }
+
+  const auto rootArea = _nodes[_root].bounds.GetSurfaceArea();
+  if (rootArea <= 0.0f) {
+    return 0.0f;
+  }
+
+  auto totalArea = 0.0f;
+  for (const auto &node : _nodes) {
+    if (node.height < 0) {
+      continue;
+    }
+    totalArea += node.bounds.GetSurfaceArea();
+  }
+
+  return totalArea / rootArea;
+}
+}
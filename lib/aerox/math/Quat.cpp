@@ -1,6 +1,7 @@
 ﻿#include <aerox/math/Quat.hpp>
 #include <aerox/math/Vec3.hpp>
 #include <aerox/math/constants.hpp>
+#include <aerox/math/simd.hpp>
 
 
 namespace aerox::math {
@@ -42,15 +43,20 @@ namespace aerox::math {
     }
 
     Vec3<float> Quat::operator*(const Vec3<> &other) const {
-        auto r = glm::quat{w,x,y,z} * glm::vec3{other.x,other.y,other.z};
+        auto r = simd::rotate(glm::quat{w,x,y,z},glm::vec3{other.x,other.y,other.z});
         return {r.x,r.y,r.z};
     }
 
     Quat Quat::operator*(const Quat &other) const {
-        auto r = glm::quat{w,x,y,z} * glm::quat{other.w,other.x,other.y,other.z};
+        auto r = simd::multiply(glm::quat{w,x,y,z},glm::quat{other.w,other.x,other.y,other.z});
         return {r.x,r.y,r.z,r.w};
     }
 
+    Quat Quat::Inverse() const {
+        const auto lengthSquared = x * x + y * y + z * z + w * w;
+        return {-x / lengthSquared, -y / lengthSquared, -z / lengthSquared, w / lengthSquared};
+    }
+
     Quat::Quat(float inX, float inY, float inZ, float inW)  {
         x = inX;
         y = inY;
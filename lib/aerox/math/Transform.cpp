@@ -1,5 +1,7 @@
 ﻿#include <aerox/math/Transform.hpp>
 #include <aerox/math/constants.hpp>
+#include <aerox/math/simd.hpp>
+#include <algorithm>
 
 
 namespace aerox::math {
@@ -12,12 +14,18 @@ namespace aerox::math {
         location = Vec3<float>(l.x, l.y, l.z);
 
 
-        auto r = glm::quat(glm::mat3(mat));
-        rotation = Quat(r.x, r.y, r.z, r.w);
-
         auto s = glm::vec3(length(glm::vec3(mat[0])), length(glm::vec3(mat[1])), length(glm::vec3(mat[2])));
 
+        // A mirrored basis has no rotation, the flip is folded into the scale instead
+        if (glm::dot(glm::cross(glm::vec3(mat[0]), glm::vec3(mat[1])), glm::vec3(mat[2])) < 0.0f) {
+            s.x = -s.x;
+        }
+
         scale = Vec3<float>(s.x, s.y, s.z);
+
+        // Scale has to be removed from the basis before it is turned into a rotation
+        auto r = glm::quat_cast(glm::mat3(glm::vec3(mat[0]) / s.x, glm::vec3(mat[1]) / s.y, glm::vec3(mat[2]) / s.z));
+        rotation = Quat(r.x, r.y, r.z, r.w);
     }
 
     Transform::Transform(const Vec3<> &_loc, const Quat &_rot, const Vec3<> &_scale) : location(_loc),
@@ -26,12 +34,69 @@ namespace aerox::math {
 
     }
 
+    bool Transform::HasUniformScale() const {
+        // Relative so large and small scales get the same tolerance
+        const auto tolerance = std::max({std::abs(scale.x), std::abs(scale.y), std::abs(scale.z)}) * 1e-6f;
+        return std::abs(scale.x - scale.y) <= tolerance && std::abs(scale.x - scale.z) <= tolerance;
+    }
+
     Transform Transform::RelativeTo(const Transform &other) const {
-        return inverse(other.Matrix()) * this->Matrix();
+        if (!other.HasUniformScale()) {
+            return Transform(simd::multiply(other.InverseMatrix(), Matrix()));
+        }
+
+        const auto invRotation = other.rotation.Inverse();
+        return {(invRotation * (location - other.location)) / other.scale, invRotation * rotation, scale / other.scale};
+    }
+
+    Transform Transform::RelativeTo(const glm::mat4 &other) const {
+        return Transform(simd::multiply(simd::inverseAffine(other), Matrix()));
+    }
+
+    Transform Transform::operator*(const Transform &child) const {
+        if (!HasUniformScale()) {
+            return Transform(simd::multiply(Matrix(), child.Matrix()));
+        }
+
+        return {location + rotation * (scale * child.location), rotation * child.rotation, scale * child.scale};
+    }
+
+    Transform Transform::Interpolate(const Transform &to, const float alpha) const {
+        const auto r = simd::slerp(glm::quat{rotation.w, rotation.x, rotation.y, rotation.z},
+                                   glm::quat{to.rotation.w, to.rotation.x, to.rotation.y, to.rotation.z}, alpha);
+        return {location + (to.location - location) * alpha, {r.x, r.y, r.z, r.w}, scale + (to.scale - scale) * alpha};
+    }
+
+    Transform Transform::Inverse() const {
+        if (!HasUniformScale()) {
+            return Transform(InverseMatrix());
+        }
+
+        const auto invRotation = rotation.Inverse();
+        const auto invScale = Vec3<>{1.0f} / scale;
+        return {(invRotation * location) * invScale * -1.0f, invRotation, invScale};
+    }
+
+    glm::mat4 Transform::InverseMatrix() const {
+        // (T * R * S)^-1 = S^-1 * R^T * T^-1, rows of the rotation become columns scaled by the inverse scale
+        const auto r = GetRotationMatrix();
+        const float invScale[3] = {1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z};
+
+        glm::mat4 result{1.0f};
+        for (auto column = 0; column < 3; column++) {
+            for (auto row = 0; row < 3; row++) {
+                result[column][row] = r[row][column] * invScale[row];
+            }
+        }
+
+        result[3] = glm::vec4{-(glm::vec3(result[0]) * location.x + glm::vec3(result[1]) * location.y + glm::vec3(result[2]) * location.z),
+                              1.0f};
+        return result;
     }
 
     glm::mat4 Transform::Matrix() const {
-        return glm::scale(GetLocationMatrix() * GetRotationMatrix(), {scale.x, scale.y, scale.z});
+        return simd::composeTrs({location.x, location.y, location.z}, glm::quat{rotation.w, rotation.x, rotation.y, rotation.z},
+                                {scale.x, scale.y, scale.z});
     }
 
     glm::mat4 Transform::GetRotationMatrix() const {
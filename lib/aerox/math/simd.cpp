@@ -0,0 +1,360 @@
+#include "aerox/math/simd.hpp"
+#include <cmath>
+#include <limits>
+
+#if defined(AEROX_SIMD_SSE)
+#include <xmmintrin.h>
+#elif defined(AEROX_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace aerox::math::simd {
+
+#if defined(AEROX_SIMD_SSE)
+
+inline __m128 load(const glm::vec4 &v) {
+  return _mm_loadu_ps(&v.x);
+}
+
+inline __m128 load(const glm::quat &q) {
+  return _mm_setr_ps(q.x, q.y, q.z, q.w);
+}
+
+inline void store(glm::vec4 &v, const __m128 value) {
+  _mm_storeu_ps(&v.x, value);
+}
+
+inline glm::quat toQuat(const __m128 value) {
+  alignas(16) float stored[4];
+  _mm_store_ps(stored, value);
+  return glm::quat{stored[3], stored[0], stored[1], stored[2]};
+}
+
+// Summed as (w + x) + (y + z) like glm's quaternion dot
+inline float quatDot(const __m128 p, const __m128 q) {
+  const auto products = _mm_mul_ps(p, q);
+  const auto sums = _mm_add_ps(products, _mm_shuffle_ps(products, products, _MM_SHUFFLE(2, 1, 0, 3)));
+  return _mm_cvtss_f32(_mm_add_ss(sums, _mm_movehl_ps(sums, sums)));
+}
+
+inline __m128 splat(const __m128 v, const int lane) {
+  switch (lane) {
+  case 0:
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+  case 1:
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+  case 2:
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+  default:
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+  }
+}
+
+// columns[0] * v.x + columns[1] * v.y + columns[2] * v.z + columns[3] * v.w, summed left to right like glm
+inline __m128 combine(const __m128 *columns, const __m128 v) {
+  auto result = _mm_mul_ps(columns[0], splat(v, 0));
+  result = _mm_add_ps(result, _mm_mul_ps(columns[1], splat(v, 1)));
+  result = _mm_add_ps(result, _mm_mul_ps(columns[2], splat(v, 2)));
+  return _mm_add_ps(result, _mm_mul_ps(columns[3], splat(v, 3)));
+}
+
+inline __m128 cross(const __m128 a, const __m128 b) {
+  const auto aYzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+  const auto bYzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+  const auto result = _mm_sub_ps(_mm_mul_ps(a, bYzx), _mm_mul_ps(aYzx, b));
+  return _mm_shuffle_ps(result, result, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+const char *getBackendName() {
+  return "sse";
+}
+
+glm::mat4 multiply(const glm::mat4 &a, const glm::mat4 &b) {
+  const __m128 columns[4] = {load(a[0]), load(a[1]), load(a[2]), load(a[3])};
+  glm::mat4 result;
+  for (auto i = 0; i < 4; i++) {
+    store(result[i], combine(columns, load(b[i])));
+  }
+  return result;
+}
+
+glm::mat4 inverseAffine(const glm::mat4 &matrix) {
+  const auto c0 = load(matrix[0]);
+  const auto c1 = load(matrix[1]);
+  const auto c2 = load(matrix[2]);
+
+  // Rows of the inverse of the upper 3x3 are the cross products of its columns over the determinant
+  auto r0 = cross(c1, c2);
+  auto r1 = cross(c2, c0);
+  auto r2 = cross(c0, c1);
+  auto r3 = _mm_setzero_ps();
+
+  alignas(16) float det[4];
+  _mm_store_ps(det, _mm_mul_ps(c0, r0));
+  const auto invDet = _mm_set1_ps(1.0f / (det[0] + det[1] + det[2]));
+  r0 = _mm_mul_ps(r0, invDet);
+  r1 = _mm_mul_ps(r1, invDet);
+  r2 = _mm_mul_ps(r2, invDet);
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+  const __m128 columns[4] = {r0, r1, r2, _mm_setzero_ps()};
+  const auto translation = _mm_sub_ps(_mm_setzero_ps(), combine(columns, _mm_setr_ps(matrix[3].x, matrix[3].y, matrix[3].z, 0.0f)));
+
+  glm::mat4 result;
+  store(result[0], r0);
+  store(result[1], r1);
+  store(result[2], r2);
+  store(result[3], translation);
+  result[3].w = 1.0f;
+  return result;
+}
+
+glm::quat multiply(const glm::quat &a, const glm::quat &b) {
+  const auto p = load(a);
+  const auto q = load(b);
+  const auto wSign = _mm_setr_ps(0.0f, 0.0f, 0.0f, -0.0f);
+
+  // Lane w of the second and third products is subtracted, xor flips their sign so every lane sums in glm's order
+  const auto first = _mm_mul_ps(splat(p, 3), q);
+  const auto second = _mm_xor_ps(_mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(0, 2, 1, 0)), _mm_shuffle_ps(q, q, _MM_SHUFFLE(0, 3, 3, 3))),
+                                 wSign);
+  const auto third = _mm_xor_ps(_mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 0, 2, 1)), _mm_shuffle_ps(q, q, _MM_SHUFFLE(1, 1, 0, 2))),
+                                wSign);
+  const auto fourth = _mm_mul_ps(_mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 1, 0, 2)), _mm_shuffle_ps(q, q, _MM_SHUFFLE(2, 0, 2, 1)));
+
+  return toQuat(_mm_sub_ps(_mm_add_ps(_mm_add_ps(first, second), third), fourth));
+}
+
+glm::quat slerp(const glm::quat &a, const glm::quat &b, const float alpha) {
+  const auto p = load(a);
+  auto q = load(b);
+  auto cosTheta = quatDot(p, q);
+  if (cosTheta < 0.0f) {
+    q = _mm_xor_ps(q, _mm_set1_ps(-0.0f));
+    cosTheta = -cosTheta;
+  }
+
+  if (cosTheta > 1.0f - std::numeric_limits<float>::epsilon()) {
+    return toQuat(_mm_add_ps(_mm_mul_ps(p, _mm_set1_ps(1.0f - alpha)), _mm_mul_ps(q, _mm_set1_ps(alpha))));
+  }
+
+  const auto angle = std::acos(cosTheta);
+  const auto blended = _mm_add_ps(_mm_mul_ps(p, _mm_set1_ps(std::sin((1.0f - alpha) * angle))),
+                                  _mm_mul_ps(q, _mm_set1_ps(std::sin(alpha * angle))));
+  return toQuat(_mm_div_ps(blended, _mm_set1_ps(std::sin(angle))));
+}
+
+void transformPoints(const glm::mat4 &matrix, const glm::vec3 *points, glm::vec3 *out, const size_t count) {
+  const __m128 columns[3] = {load(matrix[0]), load(matrix[1]), load(matrix[2])};
+  const auto translation = load(matrix[3]);
+  for (size_t i = 0; i < count; i++) {
+    auto result = _mm_mul_ps(columns[0], _mm_set1_ps(points[i].x));
+    result = _mm_add_ps(result, _mm_mul_ps(columns[1], _mm_set1_ps(points[i].y)));
+    result = _mm_add_ps(result, _mm_mul_ps(columns[2], _mm_set1_ps(points[i].z)));
+    result = _mm_add_ps(result, translation);
+
+    alignas(16) float stored[4];
+    _mm_store_ps(stored, result);
+    out[i] = {stored[0], stored[1], stored[2]};
+  }
+}
+
+#elif defined(AEROX_SIMD_NEON)
+
+inline float32x4_t load(const glm::vec4 &v) {
+  return vld1q_f32(&v.x);
+}
+
+inline void store(glm::vec4 &v, const float32x4_t value) {
+  vst1q_f32(&v.x, value);
+}
+
+inline float32x4_t set(const float x, const float y, const float z, const float w) {
+  const float values[4] = {x, y, z, w};
+  return vld1q_f32(values);
+}
+
+inline float32x4_t load(const glm::quat &q) {
+  return set(q.x, q.y, q.z, q.w);
+}
+
+inline glm::quat toQuat(const float32x4_t value) {
+  return glm::quat{vgetq_lane_f32(value, 3), vgetq_lane_f32(value, 0), vgetq_lane_f32(value, 1), vgetq_lane_f32(value, 2)};
+}
+
+// Summed as (w + x) + (y + z) like glm's quaternion dot
+inline float quatDot(const float32x4_t p, const float32x4_t q) {
+  const auto products = vmulq_f32(p, q);
+  const auto sums = vaddq_f32(products, vextq_f32(products, products, 3));
+  return vgetq_lane_f32(sums, 0) + vgetq_lane_f32(sums, 2);
+}
+
+inline float32x4_t divide(const float32x4_t v, const float divisor) {
+#if defined(__aarch64__) || defined(_M_ARM64)
+  return vdivq_f32(v, vdupq_n_f32(divisor));
+#else
+  // 32 bit NEON has no vector divide
+  return set(vgetq_lane_f32(v, 0) / divisor, vgetq_lane_f32(v, 1) / divisor, vgetq_lane_f32(v, 2) / divisor,
+             vgetq_lane_f32(v, 3) / divisor);
+#endif
+}
+
+// Separate multiplies and adds so the compiler does not fuse them and results stay identical to glm
+inline float32x4_t combine(const float32x4_t *columns, const float32x4_t v) {
+  auto result = vmulq_n_f32(columns[0], vgetq_lane_f32(v, 0));
+  result = vaddq_f32(result, vmulq_n_f32(columns[1], vgetq_lane_f32(v, 1)));
+  result = vaddq_f32(result, vmulq_n_f32(columns[2], vgetq_lane_f32(v, 2)));
+  return vaddq_f32(result, vmulq_n_f32(columns[3], vgetq_lane_f32(v, 3)));
+}
+
+const char *getBackendName() {
+  return "neon";
+}
+
+glm::mat4 multiply(const glm::mat4 &a, const glm::mat4 &b) {
+  const float32x4_t columns[4] = {load(a[0]), load(a[1]), load(a[2]), load(a[3])};
+  glm::mat4 result;
+  for (auto i = 0; i < 4; i++) {
+    store(result[i], combine(columns, load(b[i])));
+  }
+  return result;
+}
+
+glm::mat4 inverseAffine(const glm::mat4 &matrix) {
+  const auto c0 = glm::vec3(matrix[0]);
+  const auto c1 = glm::vec3(matrix[1]);
+  const auto c2 = glm::vec3(matrix[2]);
+  const auto invDet = 1.0f / glm::dot(c0, glm::cross(c1, c2));
+  const auto r0 = glm::cross(c1, c2) * invDet;
+  const auto r1 = glm::cross(c2, c0) * invDet;
+  const auto r2 = glm::cross(c0, c1) * invDet;
+
+  glm::mat4 result{r0.x, r1.x, r2.x, 0.0f, r0.y, r1.y, r2.y, 0.0f, r0.z, r1.z, r2.z, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+  const float32x4_t columns[4] = {load(result[0]), load(result[1]), load(result[2]), vdupq_n_f32(0.0f)};
+  const float translation[4] = {matrix[3].x, matrix[3].y, matrix[3].z, 0.0f};
+  store(result[3], vnegq_f32(combine(columns, vld1q_f32(translation))));
+  result[3].w = 1.0f;
+  return result;
+}
+
+glm::quat multiply(const glm::quat &a, const glm::quat &b) {
+  // Same lanes as the SSE version, NEON has no arbitrary shuffle so the swizzled operands are gathered from the scalars
+  const auto wSign = set(1.0f, 1.0f, 1.0f, -1.0f);
+  const auto first = vmulq_n_f32(load(b), a.w);
+  const auto second = vmulq_f32(vmulq_f32(set(a.x, a.y, a.z, a.x), set(b.w, b.w, b.w, b.x)), wSign);
+  const auto third = vmulq_f32(vmulq_f32(set(a.y, a.z, a.x, a.y), set(b.z, b.x, b.y, b.y)), wSign);
+  const auto fourth = vmulq_f32(set(a.z, a.x, a.y, a.z), set(b.y, b.z, b.x, b.z));
+  return toQuat(vsubq_f32(vaddq_f32(vaddq_f32(first, second), third), fourth));
+}
+
+glm::quat slerp(const glm::quat &a, const glm::quat &b, const float alpha) {
+  const auto p = load(a);
+  auto q = load(b);
+  auto cosTheta = quatDot(p, q);
+  if (cosTheta < 0.0f) {
+    q = vnegq_f32(q);
+    cosTheta = -cosTheta;
+  }
+
+  if (cosTheta > 1.0f - std::numeric_limits<float>::epsilon()) {
+    return toQuat(vaddq_f32(vmulq_n_f32(p, 1.0f - alpha), vmulq_n_f32(q, alpha)));
+  }
+
+  const auto angle = std::acos(cosTheta);
+  const auto blended = vaddq_f32(vmulq_n_f32(p, std::sin((1.0f - alpha) * angle)), vmulq_n_f32(q, std::sin(alpha * angle)));
+  return toQuat(divide(blended, std::sin(angle)));
+}
+
+void transformPoints(const glm::mat4 &matrix, const glm::vec3 *points, glm::vec3 *out, const size_t count) {
+  const float32x4_t columns[3] = {load(matrix[0]), load(matrix[1]), load(matrix[2])};
+  const auto translation = load(matrix[3]);
+  for (size_t i = 0; i < count; i++) {
+    auto result = vmulq_n_f32(columns[0], points[i].x);
+    result = vaddq_f32(result, vmulq_n_f32(columns[1], points[i].y));
+    result = vaddq_f32(result, vmulq_n_f32(columns[2], points[i].z));
+    result = vaddq_f32(result, translation);
+    out[i] = {vgetq_lane_f32(result, 0), vgetq_lane_f32(result, 1), vgetq_lane_f32(result, 2)};
+  }
+}
+
+#else
+
+const char *getBackendName() {
+  return "scalar";
+}
+
+glm::mat4 multiply(const glm::mat4 &a, const glm::mat4 &b) {
+  return a * b;
+}
+
+glm::mat4 inverseAffine(const glm::mat4 &matrix) {
+  const auto c0 = glm::vec3(matrix[0]);
+  const auto c1 = glm::vec3(matrix[1]);
+  const auto c2 = glm::vec3(matrix[2]);
+  const auto invDet = 1.0f / glm::dot(c0, glm::cross(c1, c2));
+  const auto r0 = glm::cross(c1, c2) * invDet;
+  const auto r1 = glm::cross(c2, c0) * invDet;
+  const auto r2 = glm::cross(c0, c1) * invDet;
+  const auto t = glm::vec3(matrix[3]);
+
+  return glm::mat4{r0.x, r1.x, r2.x, 0.0f, r0.y, r1.y, r2.y, 0.0f, r0.z, r1.z, r2.z, 0.0f, -glm::dot(r0, t), -glm::dot(r1, t),
+                   -glm::dot(r2, t), 1.0f};
+}
+
+glm::quat multiply(const glm::quat &a, const glm::quat &b) {
+  return a * b;
+}
+
+glm::quat slerp(const glm::quat &a, const glm::quat &b, const float alpha) {
+  auto target = b;
+  auto cosTheta = glm::dot(a, b);
+  if (cosTheta < 0.0f) {
+    target = -b;
+    cosTheta = -cosTheta;
+  }
+
+  if (cosTheta > 1.0f - std::numeric_limits<float>::epsilon()) {
+    return glm::quat{glm::mix(a.w, target.w, alpha), glm::mix(a.x, target.x, alpha), glm::mix(a.y, target.y, alpha),
+                     glm::mix(a.z, target.z, alpha)};
+  }
+
+  const auto angle = std::acos(cosTheta);
+  return (std::sin((1.0f - alpha) * angle) * a + std::sin(alpha * angle) * target) / std::sin(angle);
+}
+
+void transformPoints(const glm::mat4 &matrix, const glm::vec3 *points, glm::vec3 *out, const size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = glm::vec3(matrix * glm::vec4(points[i], 1.0f));
+  }
+}
+
+#endif
+
+glm::mat4 composeTrs(const glm::vec3 &location, const glm::quat &rotation, const glm::vec3 &scale) {
+  // Rotation terms as computed by glm::mat4_cast
+  const auto qxx = rotation.x * rotation.x;
+  const auto qyy = rotation.y * rotation.y;
+  const auto qzz = rotation.z * rotation.z;
+  const auto qxz = rotation.x * rotation.z;
+  const auto qxy = rotation.x * rotation.y;
+  const auto qyz = rotation.y * rotation.z;
+  const auto qwx = rotation.w * rotation.x;
+  const auto qwy = rotation.w * rotation.y;
+  const auto qwz = rotation.w * rotation.z;
+
+  glm::mat4 result;
+  result[0] = glm::vec4{1.0f - 2.0f * (qyy + qzz), 2.0f * (qxy + qwz), 2.0f * (qxz - qwy), 0.0f} * scale.x;
+  result[1] = glm::vec4{2.0f * (qxy - qwz), 1.0f - 2.0f * (qxx + qzz), 2.0f * (qyz + qwx), 0.0f} * scale.y;
+  result[2] = glm::vec4{2.0f * (qxz + qwy), 2.0f * (qyz - qwx), 1.0f - 2.0f * (qxx + qyy), 0.0f} * scale.z;
+  result[3] = glm::vec4{location, 1.0f};
+  return result;
+}
+
+glm::vec3 rotate(const glm::quat &rotation, const glm::vec3 &vector) {
+  // Same steps as glm's quat * vec3
+  const glm::vec3 axis{rotation.x, rotation.y, rotation.z};
+  const auto uv = glm::cross(axis, vector);
+  const auto uuv = glm::cross(axis, uv);
+  return vector + ((uv * rotation.w) + uuv) * 2.0f;
+}
+}
@@ -0,0 +1,27 @@
+#include "aerox/physics/BoxCollision.hpp"
+#include "aerox/physics/rp3/RP3DScenePhysics.hpp"
+
+namespace aerox::physics {
+
+BoxCollision::BoxCollision(const glm::vec3 &halfExtents) : _halfExtents(halfExtents) {
+}
+
+rp3d::CollisionShape *BoxCollision::CreateShape(RP3DScenePhysics *physics) {
+  return RP3DScenePhysics::physicsCommon.createBoxShape({_halfExtents.x, _halfExtents.y, _halfExtents.z});
+}
+
+void BoxCollision::DestroyShape(rp3d::CollisionShape *shape) {
+  RP3DScenePhysics::physicsCommon.destroyBoxShape(static_cast<rp3d::BoxShape *>(shape));
+}
+
+void BoxCollision::SetHalfExtents(const glm::vec3 &halfExtents) {
+  _halfExtents = halfExtents;
+  UpdateShape([halfExtents](rp3d::CollisionShape *shape) {
+    static_cast<rp3d::BoxShape *>(shape)->setHalfExtents({halfExtents.x, halfExtents.y, halfExtents.z});
+  });
+}
+
+glm::vec3 BoxCollision::GetHalfExtents() const {
+  return _halfExtents;
+}
+}
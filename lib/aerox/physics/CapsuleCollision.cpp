@@ -0,0 +1,38 @@
+#include "aerox/physics/CapsuleCollision.hpp"
+#include "aerox/physics/rp3/RP3DScenePhysics.hpp"
+
+namespace aerox::physics {
+
+CapsuleCollision::CapsuleCollision(const float radius, const float height) : _radius(radius), _height(height) {
+}
+
+rp3d::CollisionShape *CapsuleCollision::CreateShape(RP3DScenePhysics *physics) {
+  return RP3DScenePhysics::physicsCommon.createCapsuleShape(_radius, _height);
+}
+
+void CapsuleCollision::DestroyShape(rp3d::CollisionShape *shape) {
+  RP3DScenePhysics::physicsCommon.destroyCapsuleShape(static_cast<rp3d::CapsuleShape *>(shape));
+}
+
+void CapsuleCollision::SetRadius(const float radius) {
+  _radius = radius;
+  UpdateShape([radius](rp3d::CollisionShape *shape) {
+    static_cast<rp3d::CapsuleShape *>(shape)->setRadius(radius);
+  });
+}
+
+float CapsuleCollision::GetRadius() const {
+  return _radius;
+}
+
+void CapsuleCollision::SetHeight(const float height) {
+  _height = height;
+  UpdateShape([height](rp3d::CollisionShape *shape) {
+    static_cast<rp3d::CapsuleShape *>(shape)->setHeight(height);
+  });
+}
+
+float CapsuleCollision::GetHeight() const {
+  return _height;
+}
+}
@@ -0,0 +1,142 @@
+#include "aerox/physics/CollisionComponent.hpp"
+#include "aerox/physics/RigidBodyComponent.hpp"
+#include "aerox/physics/rp3/RP3DScenePhysics.hpp"
+#include "aerox/scene/Scene.hpp"
+#include "aerox/scene/objects/SceneObject.hpp"
+
+namespace aerox::physics {
+
+void CollisionComponent::UpdateShape(std::function<void(rp3d::CollisionShape *)> fn) {
+  if (!_shape) {
+    return;
+  }
+
+  if (const auto physics = _physics.lock()) {
+    physics->PushCommand([shape = _shape, fn = std::move(fn)] {
+      fn(shape);
+    });
+  }
+}
+
+void CollisionComponent::OnInit(scene::SceneObject *owner) {
+  SceneComponent::OnInit(owner);
+  const auto physics = utils::cast<RP3DScenePhysics>(owner->GetScene()->GetPhysics().lock());
+  if (!physics) {
+    return;
+  }
+
+  _physics = physics;
+  const auto self = utils::castStatic<CollisionComponent>(shared_from_this());
+  if (const auto rigidBody = owner->GetComponentByClass<RigidBodyComponent>().lock()) {
+    _rigidBody = rigidBody;
+    rigidBody->AttachShape(self);
+    return;
+  }
+
+  _ownBody = physics->CreateBody(self, rp3d::BodyType::STATIC);
+  CreateCollider(physics.get(), _ownBody, GetWorldTransform());
+}
+
+void CollisionComponent::OnDestroy() {
+  if (const auto rigidBody = _rigidBody.lock()) {
+    rigidBody->DetachShape(this);
+  }
+
+  const auto physics = _physics.lock();
+  ReleaseCollider(!physics);
+  if (physics && _ownBody) {
+    physics->DestroyBody(_ownBody);
+  }
+  _ownBody = nullptr;
+
+  if (_shape) {
+    if (physics) {
+      physics->FlushCommands();
+    }
+    DestroyShape(_shape);
+    _shape = nullptr;
+  }
+  SceneComponent::OnDestroy();
+}
+
+void CollisionComponent::SyncColliderTransform() {
+  // A body of our own follows this component through the scene sync, the collider stays centered on it
+  if (!_collider || _colliderBody == _ownBody) {
+    return;
+  }
+
+  const auto physics = _physics.lock();
+  const auto rigidBody = _rigidBody.lock();
+  if (!physics || !rigidBody) {
+    return;
+  }
+
+  const auto localTransform = RP3DScenePhysics::toPhysics(GetWorldTransform().RelativeTo(rigidBody->GetWorldTransform()));
+  physics->PushCommand([collider = _collider, body = _colliderBody, localTransform] {
+    collider->setLocalToBodyTransform(localTransform);
+    // The body's mass is spread over its colliders, moving one moves its center of mass
+    body->updateLocalCenterOfMassFromColliders();
+    body->updateLocalInertiaTensorFromColliders();
+  });
+}
+
+void CollisionComponent::SetRelativeTransform(const math::Transform &val) {
+  SceneComponent::SetRelativeTransform(val);
+  SyncColliderTransform();
+}
+
+void CollisionComponent::SetTrigger(const bool bTrigger) {
+  _bTrigger = bTrigger;
+  if (!_collider) {
+    return;
+  }
+
+  if (const auto physics = _physics.lock()) {
+    physics->PushCommand([collider = _collider, bTrigger] {
+      collider->setIsTrigger(bTrigger);
+    });
+  }
+}
+
+bool CollisionComponent::IsTrigger() const {
+  return _bTrigger;
+}
+
+void CollisionComponent::CreateCollider(RP3DScenePhysics *physics, rp3d::RigidBody *body, const math::Transform &bodyTransform) {
+  if (_collider) {
+    return;
+  }
+
+  if (!_shape) {
+    _shape = CreateShape(physics);
+  }
+
+  if (!_shape) {
+    return;
+  }
+
+  // A body of our own sits exactly on this component
+  const auto localTransform = body == _ownBody ? math::Transform{} : GetWorldTransform().RelativeTo(bodyTransform);
+  _colliderBody = body;
+  _collider = physics->AddCollider(body, _shape, localTransform, this);
+  _collider->setIsTrigger(_bTrigger);
+}
+
+void CollisionComponent::ReleaseCollider(const bool bBodyDestroyed) {
+  if (!_collider) {
+    return;
+  }
+
+  if (!bBodyDestroyed) {
+    if (const auto physics = _physics.lock()) {
+      physics->RemoveCollider(_colliderBody, _collider);
+    }
+  }
+  _collider = nullptr;
+  _colliderBody = nullptr;
+}
+
+rp3d::Collider *CollisionComponent::GetCollider() const {
+  return _collider;
+}
+}
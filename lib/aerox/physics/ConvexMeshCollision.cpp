@@ -0,0 +1,36 @@
+#include "aerox/physics/ConvexMeshCollision.hpp"
+#include "aerox/log.hpp"
+#include "aerox/physics/rp3/RP3DScenePhysics.hpp"
+
+namespace aerox::physics {
+
+ConvexMeshCollision::ConvexMeshCollision(const std::shared_ptr<drawing::Mesh> &mesh) : _mesh(mesh) {
+}
+
+rp3d::CollisionShape *ConvexMeshCollision::CreateShape(RP3DScenePhysics *physics) {
+  if (!_mesh) {
+    return nullptr;
+  }
+
+  const auto convex = physics->GetConvexMesh(_mesh);
+  if (!convex) {
+    log::physics->Warn("Mesh has no cooked convex hull, reimport it to use it for collision");
+    return nullptr;
+  }
+
+  const auto scale = GetWorldScale();
+  return RP3DScenePhysics::physicsCommon.createConvexMeshShape(convex, {scale.x, scale.y, scale.z});
+}
+
+void ConvexMeshCollision::DestroyShape(rp3d::CollisionShape *shape) {
+  RP3DScenePhysics::physicsCommon.destroyConvexMeshShape(static_cast<rp3d::ConvexMeshShape *>(shape));
+}
+
+void ConvexMeshCollision::SetMesh(const std::shared_ptr<drawing::Mesh> &mesh) {
+  _mesh = mesh;
+}
+
+std::weak_ptr<drawing::Mesh> ConvexMeshCollision::GetMesh() const {
+  return _mesh;
+}
+}
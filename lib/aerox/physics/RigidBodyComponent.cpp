@@ -0,0 +1,145 @@
+#include "aerox/physics/RigidBodyComponent.hpp"
+#include "aerox/physics/CollisionComponent.hpp"
+#include "aerox/log.hpp"
+#include "aerox/physics/rp3/RP3DScenePhysics.hpp"
+#include "aerox/scene/Scene.hpp"
+#include "aerox/scene/objects/SceneObject.hpp"
+
+namespace aerox::physics {
+
+RigidBodyComponent::RigidBodyComponent(const EBodyType type) : _bodyType(type) {
+}
+
+void RigidBodyComponent::UpdateMassProperties() {
+  _body->setMass(_mass);
+  if (_body->getNbColliders() > 0) {
+    _body->updateLocalCenterOfMassFromColliders();
+    _body->updateLocalInertiaTensorFromColliders();
+  }
+}
+
+void RigidBodyComponent::PushBodyCommand(std::function<void(rp3d::RigidBody *)> fn) {
+  if (!_body) {
+    return;
+  }
+
+  if (const auto physics = _physics.lock()) {
+    physics->PushCommand([body = _body, fn = std::move(fn)] {
+      fn(body);
+    });
+  }
+}
+
+void RigidBodyComponent::OnInit(scene::SceneObject *owner) {
+  SceneComponent::OnInit(owner);
+  const auto physics = utils::cast<RP3DScenePhysics>(owner->GetScene()->GetPhysics().lock());
+  if (!physics) {
+    return;
+  }
+
+  _physics = physics;
+  if (_bodyType == EBodyType::Dynamic && owner->GetRootComponent().lock().get() != this) {
+    log::engine->Warn("A dynamic rigid body that is not its object's root only moves itself and its children");
+  }
+
+  // Creating the body waits for any step in flight so the body can be set up directly
+  _body = physics->CreateBody(utils::castStatic<SceneComponent>(shared_from_this()), RP3DScenePhysics::toPhysics(_bodyType));
+  _body->enableGravity(_bGravity);
+
+  const auto bodyTransform = GetWorldTransform();
+  for (const auto &weakShape : _shapes) {
+    if (const auto shape = weakShape.lock()) {
+      shape->CreateCollider(physics.get(), _body, bodyTransform);
+    }
+  }
+  UpdateMassProperties();
+}
+
+void RigidBodyComponent::OnDestroy() {
+  for (const auto &weakShape : _shapes) {
+    if (const auto shape = weakShape.lock()) {
+      shape->ReleaseCollider(true);
+    }
+  }
+  _shapes.clear();
+
+  if (const auto physics = _physics.lock(); physics && _body) {
+    physics->DestroyBody(_body);
+  }
+  _body = nullptr;
+  SceneComponent::OnDestroy();
+}
+
+void RigidBodyComponent::AttachShape(const std::shared_ptr<CollisionComponent> &shape) {
+  _shapes.push_back(shape);
+  if (!_body) {
+    return;
+  }
+
+  if (const auto physics = _physics.lock()) {
+    shape->CreateCollider(physics.get(), _body, GetWorldTransform());
+    UpdateMassProperties();
+  }
+}
+
+void RigidBodyComponent::DetachShape(const CollisionComponent *shape) {
+  std::erase_if(_shapes, [shape](const std::weak_ptr<CollisionComponent> &other) {
+    const auto locked = other.lock();
+    return !locked || locked.get() == shape;
+  });
+}
+
+EBodyType RigidBodyComponent::GetBodyType() const {
+  return _bodyType;
+}
+
+void RigidBodyComponent::SetMass(const float mass) {
+  _mass = mass;
+  PushBodyCommand([mass](rp3d::RigidBody *body) {
+    body->setMass(mass);
+  });
+}
+
+float RigidBodyComponent::GetMass() const {
+  return _mass;
+}
+
+void RigidBodyComponent::SetGravityEnabled(const bool bEnabled) {
+  _bGravity = bEnabled;
+  PushBodyCommand([bEnabled](rp3d::RigidBody *body) {
+    body->enableGravity(bEnabled);
+  });
+}
+
+bool RigidBodyComponent::IsGravityEnabled() const {
+  return _bGravity;
+}
+
+void RigidBodyComponent::ApplyForce(const glm::vec3 &force) {
+  PushBodyCommand([force](rp3d::RigidBody *body) {
+    body->applyWorldForceAtCenterOfMass({force.x, force.y, force.z});
+  });
+}
+
+void RigidBodyComponent::ApplyTorque(const glm::vec3 &torque) {
+  PushBodyCommand([torque](rp3d::RigidBody *body) {
+    body->applyWorldTorque({torque.x, torque.y, torque.z});
+  });
+}
+
+void RigidBodyComponent::SetLinearVelocity(const glm::vec3 &velocity) {
+  PushBodyCommand([velocity](rp3d::RigidBody *body) {
+    body->setLinearVelocity({velocity.x, velocity.y, velocity.z});
+  });
+}
+
+void RigidBodyComponent::SetAngularVelocity(const glm::vec3 &velocity) {
+  PushBodyCommand([velocity](rp3d::RigidBody *body) {
+    body->setAngularVelocity({velocity.x, velocity.y, velocity.z});
+  });
+}
+
+rp3d::RigidBody *RigidBodyComponent::GetBody() const {
+  return _body;
+}
+}
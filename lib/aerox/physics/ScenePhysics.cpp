@@ -1,14 +1,184 @@
 ﻿#include <aerox/physics/ScenePhysics.hpp>
-#include <aerox/physics/constants.hpp>
+#include "aerox/Engine.hpp"
+#include "aerox/async/AsyncSubsystem.hpp"
+#include <algorithm>
+#include <cmath>
 
 
 namespace aerox::physics {
 
+void ScenePhysics::RunSteps(const std::vector<std::function<void()>> &commands, const uint32_t count, const float stepSize) {
+  for(const auto &command : commands) {
+    command();
+  }
+
+  for(uint32_t i = 0; i < count; i++) {
+    InternalFixedUpdate(stepSize);
+  }
+}
+
+void ScenePhysics::RunPendingStep(const PendingStep &step) {
+  RunSteps(step.commands,step.count,step.stepSize);
+  _bStepping.store(false, std::memory_order_release);
+  _bStepping.notify_all();
+}
+
+void ScenePhysics::OnDestroy() {
+  WaitForStep();
+  _commands.Drain([](const std::function<void()> &) {
+  });
+  TOwnedBy::OnDestroy();
+}
+
 void ScenePhysics::FixedUpdate(float deltaTime) {
+  WaitForStep();
+
   _accum += deltaTime;
-  while(_accum >= PHYSICS_FIXED_UPDATE) {
-    InternalFixedUpdate(PHYSICS_FIXED_UPDATE);
-    _accum -= PHYSICS_FIXED_UPDATE;
+
+  uint32_t steps = 0;
+  while(_accum >= _stepSize && steps < _maxSubSteps) {
+    _accum -= _stepSize;
+    steps++;
+  }
+
+  if(_accum >= _stepSize) {
+    // Over budget, let the simulation fall behind real time instead of taking ever more steps
+    const auto dropped = std::floor(_accum / _stepSize);
+    _droppedSteps += static_cast<uint64_t>(dropped);
+    _accum -= dropped * _stepSize;
+  }
+
+  if(steps > 0) {
+    SyncToPhysics();
+    _bResultsPending = true;
+
+    // Taken here on the game thread so the frame a command lands on never depends on when the job starts
+    std::vector<std::function<void()>> commands;
+    _commands.Drain([&commands](std::function<void()> &command) {
+      commands.push_back(std::move(command));
+    });
+
+    auto subsystem = _bAsync ? GetStepRunner() : std::shared_ptr<async::AsyncSubsystem>{};
+    if(subsystem && subsystem->IsInitialized()) {
+      _pendingStep = std::make_shared<PendingStep>();
+      _pendingStep->commands = std::move(commands);
+      _pendingStep->count = steps;
+      _pendingStep->stepSize = _stepSize;
+      _bStepping.store(true, std::memory_order_relaxed);
+      subsystem->EnqueueJob([this,step = _pendingStep] {
+        // Left in the queue after a waiting thread ran the step, the physics object may be gone by now
+        if(step->Claim()) {
+          RunPendingStep(*step);
+        }
+      });
+    } else {
+      RunSteps(commands,steps,_stepSize);
+      WaitForStep();
+    }
+  }
+
+  _interpolationAlpha = std::clamp(_accum / _stepSize, 0.0f, 1.0f);
+  SyncFromPhysics(_interpolationAlpha);
+  DispatchEvents();
+}
+
+void ScenePhysics::DispatchEvents() {
+  if(!_contactEvents.empty()) {
+    onContacts->Execute(_contactEvents);
+    _contactEvents.clear();
+  }
+
+  if(!_triggerEvents.empty()) {
+    onTriggers->Execute(_triggerEvents);
+    _triggerEvents.clear();
+  }
+}
+
+std::shared_ptr<async::AsyncSubsystem> ScenePhysics::GetStepRunner() const {
+  return Engine::Get()->GetAsyncSubsystem().lock();
+}
+
+void ScenePhysics::SyncToPhysics() {
+  
+}
+
+void ScenePhysics::SyncFromPhysics(float alpha) {
+  
+}
+
+void ScenePhysics::ExchangeResults() {
+  
+}
+
+void ScenePhysics::WaitForStep() {
+  if(_pendingStep) {
+    // Only ever helps with this object's own step, either it is still queued and runs here or a pool thread has it and this waits
+    if(_pendingStep->Claim()) {
+      RunPendingStep(*_pendingStep);
+    }
+    _bStepping.wait(true, std::memory_order_acquire);
+    _pendingStep.reset();
+  }
+
+  if(_bResultsPending) {
+    _bResultsPending = false;
+    ExchangeResults();
   }
 }
+
+void ScenePhysics::PushCommand(std::function<void()> command) {
+  _commands.Push(std::move(command));
+}
+
+void ScenePhysics::FlushCommands() {
+  WaitForStep();
+  _commands.Drain([](const std::function<void()> &command) {
+    command();
+  });
+}
+
+void ScenePhysics::SetAsync(const bool bAsync) {
+  WaitForStep();
+  _bAsync = bAsync;
+}
+
+bool ScenePhysics::IsAsync() const {
+  return _bAsync;
+}
+
+std::optional<PhysicsHit> ScenePhysics::RayCast(const math::Ray &ray, float maxDistance) {
+  return {};
+}
+
+Array<std::weak_ptr<scene::SceneComponent>> ScenePhysics::OverlapSphere(const glm::vec3 &center, float radius) {
+  return {};
+}
+
+Array<std::weak_ptr<scene::SceneComponent>> ScenePhysics::OverlapBox(const math::Transform &transform, const glm::vec3 &halfExtents) {
+  return {};
+}
+
+void ScenePhysics::SetStepSize(const float stepSize) {
+  _stepSize = std::max(stepSize, 0.0001f);
+}
+
+float ScenePhysics::GetStepSize() const {
+  return _stepSize;
+}
+
+void ScenePhysics::SetMaxSubSteps(const uint32_t maxSubSteps) {
+  _maxSubSteps = std::max(maxSubSteps, 1u);
+}
+
+uint32_t ScenePhysics::GetMaxSubSteps() const {
+  return _maxSubSteps;
+}
+
+float ScenePhysics::GetInterpolationAlpha() const {
+  return _interpolationAlpha;
+}
+
+uint64_t ScenePhysics::GetDroppedSteps() const {
+  return _droppedSteps;
+}
 }
@@ -1 +1,27 @@
-#include <aerox/physics/SphereCollision.hpp>
+#include "aerox/physics/SphereCollision.hpp"
+#include "aerox/physics/rp3/RP3DScenePhysics.hpp"
+
+namespace aerox::physics {
+
+SphereCollision::SphereCollision(const float radius) : _radius(radius) {
+}
+
+rp3d::CollisionShape *SphereCollision::CreateShape(RP3DScenePhysics *physics) {
+  return RP3DScenePhysics::physicsCommon.createSphereShape(_radius);
+}
+
+void SphereCollision::DestroyShape(rp3d::CollisionShape *shape) {
+  RP3DScenePhysics::physicsCommon.destroySphereShape(static_cast<rp3d::SphereShape *>(shape));
+}
+
+void SphereCollision::SetRadius(const float radius) {
+  _radius = radius;
+  UpdateShape([radius](rp3d::CollisionShape *shape) {
+    static_cast<rp3d::SphereShape *>(shape)->setRadius(radius);
+  });
+}
+
+float SphereCollision::GetRadius() const {
+  return _radius;
+}
+}
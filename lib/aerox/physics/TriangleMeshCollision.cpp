@@ -0,0 +1,36 @@
+#include "aerox/physics/TriangleMeshCollision.hpp"
+#include "aerox/log.hpp"
+#include "aerox/physics/rp3/RP3DScenePhysics.hpp"
+
+namespace aerox::physics {
+
+TriangleMeshCollision::TriangleMeshCollision(const std::shared_ptr<drawing::Mesh> &mesh) : _mesh(mesh) {
+}
+
+rp3d::CollisionShape *TriangleMeshCollision::CreateShape(RP3DScenePhysics *physics) {
+  if (!_mesh) {
+    return nullptr;
+  }
+
+  const auto triangles = physics->GetTriangleMesh(_mesh);
+  if (!triangles) {
+    log::physics->Warn("Mesh has no cooked triangles, reimport it to use it for collision");
+    return nullptr;
+  }
+
+  const auto scale = GetWorldScale();
+  return RP3DScenePhysics::physicsCommon.createConcaveMeshShape(triangles, {scale.x, scale.y, scale.z});
+}
+
+void TriangleMeshCollision::DestroyShape(rp3d::CollisionShape *shape) {
+  RP3DScenePhysics::physicsCommon.destroyConcaveMeshShape(static_cast<rp3d::ConcaveMeshShape *>(shape));
+}
+
+void TriangleMeshCollision::SetMesh(const std::shared_ptr<drawing::Mesh> &mesh) {
+  _mesh = mesh;
+}
+
+std::weak_ptr<drawing::Mesh> TriangleMeshCollision::GetMesh() const {
+  return _mesh;
+}
+}
@@ -0,0 +1,93 @@
+#include "aerox/physics/cooking.hpp"
+#include "aerox/log.hpp"
+#include "aerox/physics/rp3/RP3DScenePhysics.hpp"
+#include <cstring>
+#include <unordered_map>
+
+namespace aerox::physics {
+
+struct WeldKey {
+  float x;
+  float y;
+  float z;
+
+  bool operator==(const WeldKey &other) const {
+    return std::memcmp(this, &other, sizeof(WeldKey)) == 0;
+  }
+};
+
+struct WeldKeyHash {
+  size_t operator()(const WeldKey &key) const {
+    uint32_t bits[3];
+    std::memcpy(bits, &key, sizeof(bits));
+    return (static_cast<size_t>(bits[0]) * 73856093) ^ (static_cast<size_t>(bits[1]) * 19349663) ^ (static_cast<size_t>(bits[2]) *
+             83492791);
+  }
+};
+
+drawing::MeshCollisionData cookMeshCollision(const Array<drawing::Vertex> &vertices, const Array<uint32_t> &indices) {
+  drawing::MeshCollisionData result;
+
+  // Vertices are split on normals and uvs for drawing, collision only cares about locations
+  std::unordered_map<WeldKey, uint32_t, WeldKeyHash> welded;
+  std::vector<uint32_t> remap(vertices.size());
+  for (size_t i = 0; i < vertices.size(); i++) {
+    const auto &location = vertices[i].location;
+    const WeldKey key{location.x, location.y, location.z};
+    const auto [it, inserted] = welded.emplace(key, static_cast<uint32_t>(result.triangleVertices.size() / 3));
+    if (inserted) {
+      result.triangleVertices.push_back(location.x);
+      result.triangleVertices.push_back(location.y);
+      result.triangleVertices.push_back(location.z);
+    }
+    remap[i] = it->second;
+  }
+
+  result.triangleIndices.reserve(indices.size());
+  for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+    const auto a = remap[indices[i]];
+    const auto b = remap[indices[i + 1]];
+    const auto c = remap[indices[i + 2]];
+    // Triangles collapsed by welding have no area and only upset the narrow phase
+    if (a == b || b == c || a == c) {
+      continue;
+    }
+    result.triangleIndices.push_back(a);
+    result.triangleIndices.push_back(b);
+    result.triangleIndices.push_back(c);
+  }
+
+  const auto numVertices = static_cast<uint32_t>(result.triangleVertices.size() / 3);
+  if (numVertices < 4) {
+    return result;
+  }
+
+  const rp3d::VertexArray points(result.triangleVertices.data(), 3 * sizeof(float), numVertices,
+                                 rp3d::VertexArray::DataType::VERTEX_FLOAT_TYPE);
+  std::vector<rp3d::Message> messages;
+  const auto hull = RP3DScenePhysics::physicsCommon.createConvexMesh(points, messages);
+  if (!hull) {
+    log::physics->Warn("Failed to compute the convex hull of a mesh, it can only be used as a triangle mesh");
+    return result;
+  }
+
+  for (uint32_t i = 0; i < hull->getNbVertices(); i++) {
+    const auto &vertex = hull->getVertex(i);
+    result.hullVertices.push_back(vertex.x);
+    result.hullVertices.push_back(vertex.y);
+    result.hullVertices.push_back(vertex.z);
+  }
+
+  const auto &halfEdges = hull->getHalfEdgeStructure();
+  for (uint32_t i = 0; i < hull->getNbFaces(); i++) {
+    const auto &face = halfEdges.getFace(i);
+    result.hullFaces.push_back(static_cast<uint32_t>(face.faceVertices.size()));
+    for (const auto index : face.faceVertices) {
+      result.hullFaces.push_back(index);
+    }
+  }
+
+  RP3DScenePhysics::physicsCommon.destroyConvexMesh(hull);
+  return result;
+}
+}
@@ -1,22 +1,376 @@
 ﻿#include <aerox/physics/rp3/RP3DScenePhysics.hpp>
 #include "aerox/scene/Scene.hpp"
+#include "aerox/drawing/Mesh.hpp"
+#include "aerox/scene/components/SceneComponent.hpp"
+#include <algorithm>
 
 namespace aerox::physics {
 rp3d::PhysicsCommon RP3DScenePhysics::physicsCommon = rp3d::PhysicsCommon();
 
+RP3DScenePhysics::EventRecorder::EventRecorder(RP3DScenePhysics *physics) : _physics(physics) {
+}
+
+void RP3DScenePhysics::EventRecorder::onContact(const rp3d::CollisionCallback::CallbackData &callbackData) {
+  for (uint32_t i = 0; i < callbackData.getNbContactPairs(); i++) {
+    const auto pair = callbackData.getContactPair(i);
+
+    StepContact contact{static_cast<scene::SceneComponent *>(pair.getCollider1()->getUserData()),
+                        static_cast<scene::SceneComponent *>(pair.getCollider2()->getUserData())};
+    switch (pair.getEventType()) {
+    case rp3d::CollisionCallback::ContactPair::EventType::ContactStart:
+      contact.type = EContactType::Begin;
+      break;
+    case rp3d::CollisionCallback::ContactPair::EventType::ContactStay:
+      contact.type = EContactType::Stay;
+      break;
+    case rp3d::CollisionCallback::ContactPair::EventType::ContactExit:
+      contact.type = EContactType::End;
+      break;
+    }
+
+    // One event per pair using its deepest point, per point events are rarely wanted and multiply the event count
+    for (uint32_t j = 0; j < pair.getNbContactPoints(); j++) {
+      const auto point = pair.getContactPoint(j);
+      if (j > 0 && point.getPenetrationDepth() <= contact.depth) {
+        continue;
+      }
+      const auto worldPoint = pair.getCollider1()->getLocalToWorldTransform() * point.getLocalPointOnCollider1();
+      const auto &normal = point.getWorldNormal();
+      contact.point = {worldPoint.x, worldPoint.y, worldPoint.z};
+      contact.normal = {normal.x, normal.y, normal.z};
+      contact.depth = point.getPenetrationDepth();
+    }
+
+    _physics->_stepContacts.push_back(contact);
+  }
+}
+
+void RP3DScenePhysics::EventRecorder::onTrigger(const rp3d::OverlapCallback::CallbackData &callbackData) {
+  for (uint32_t i = 0; i < callbackData.getNbOverlappingPairs(); i++) {
+    const auto pair = callbackData.getOverlappingPair(i);
+
+    StepTrigger trigger{static_cast<scene::SceneComponent *>(pair.getCollider1()->getUserData()),
+                        static_cast<scene::SceneComponent *>(pair.getCollider2()->getUserData())};
+    switch (pair.getEventType()) {
+    case rp3d::OverlapCallback::OverlapPair::EventType::OverlapStart:
+      trigger.type = EContactType::Begin;
+      break;
+    case rp3d::OverlapCallback::OverlapPair::EventType::OverlapStay:
+      trigger.type = EContactType::Stay;
+      break;
+    case rp3d::OverlapCallback::OverlapPair::EventType::OverlapExit:
+      trigger.type = EContactType::End;
+      break;
+    }
+
+    _physics->_stepTriggers.push_back(trigger);
+  }
+}
+
+std::weak_ptr<scene::SceneComponent> RP3DScenePhysics::getColliderComponent(scene::SceneComponent *component) {
+  if (!component) {
+    return {};
+  }
+  return utils::castStatic<scene::SceneComponent>(component->shared_from_this());
+}
+
+rp3d::Transform RP3DScenePhysics::toPhysics(const math::Transform &transform) {
+  return {{transform.location.x, transform.location.y, transform.location.z},
+          {transform.rotation.x, transform.rotation.y, transform.rotation.z, transform.rotation.w}};
+}
+
+math::Transform RP3DScenePhysics::fromPhysics(const rp3d::Transform &transform, const math::Vec3<> &scale) {
+  const auto &position = transform.getPosition();
+  const auto &orientation = transform.getOrientation();
+  return {{position.x, position.y, position.z}, {orientation.x, orientation.y, orientation.z, orientation.w}, scale};
+}
+
+rp3d::BodyType RP3DScenePhysics::toPhysics(const EBodyType type) {
+  switch (type) {
+  case EBodyType::Static:
+    return rp3d::BodyType::STATIC;
+  case EBodyType::Kinematic:
+    return rp3d::BodyType::KINEMATIC;
+  default:
+    return rp3d::BodyType::DYNAMIC;
+  }
+}
+
+void RP3DScenePhysics::ReadBodyTransforms(std::vector<math::Transform> &out) const {
+  for (size_t i = 0; i < _bodies.size(); i++) {
+    if (_bodyTypes[i] == rp3d::BodyType::DYNAMIC) {
+      out[i] = fromPhysics(_bodies[i]->getTransform(), out[i].scale);
+    }
+  }
+}
+
 void RP3DScenePhysics::OnInit(scene::Scene * owner) {
   ScenePhysics::OnInit(owner);
-  //_phys = physicsCommon.createPhysicsWorld();
+  _phys = physicsCommon.createPhysicsWorld();
+  _phys->setEventListener(&_eventRecorder);
 }
 
 void RP3DScenePhysics::OnDestroy() {
   ScenePhysics::OnDestroy();
-  //physicsCommon.destroyPhysicsWorld(_phys);
-  //_phys = nullptr;
+  _bodies.clear();
+  _bodyTypes.clear();
+  _bodyComponents.clear();
+  _previousTransforms.clear();
+  _currentTransforms.clear();
+  _stepPreviousTransforms.clear();
+  _stepCurrentTransforms.clear();
+  _stepContacts.clear();
+  _stepTriggers.clear();
+  if (_phys) {
+    // Destroys every body in the world as well
+    physicsCommon.destroyPhysicsWorld(_phys);
+    _phys = nullptr;
+  }
+
+  for (const auto &[mesh, cooked] : _cookedMeshes) {
+    if (cooked.convex) {
+      physicsCommon.destroyConvexMesh(cooked.convex);
+    }
+    if (cooked.triangles) {
+      physicsCommon.destroyTriangleMesh(cooked.triangles);
+    }
+  }
+  _cookedMeshes.clear();
+}
+
+rp3d::RigidBody *RP3DScenePhysics::CreateBody(const std::shared_ptr<scene::SceneComponent> &component, const rp3d::BodyType type) {
+  WaitForStep();
+  const auto transform = component->GetWorldTransform();
+  const auto body = _phys->createRigidBody(toPhysics(transform));
+  body->setType(type);
+  _bodies.push_back(body);
+  _bodyTypes.push_back(type);
+  _bodyComponents.push_back(component);
+  _previousTransforms.push_back(transform);
+  _currentTransforms.push_back(transform);
+  _stepPreviousTransforms.push_back(transform);
+  _stepCurrentTransforms.push_back(transform);
+  return body;
+}
+
+void RP3DScenePhysics::DestroyBody(rp3d::RigidBody *body) {
+  FlushCommands();
+  const auto it = std::ranges::find(_bodies, body);
+  if (it == _bodies.end()) {
+    return;
+  }
+
+  const auto index = it - _bodies.begin();
+  const auto last = _bodies.size() - 1;
+  _bodies[index] = _bodies[last];
+  _bodyTypes[index] = _bodyTypes[last];
+  _bodyComponents[index] = _bodyComponents[last];
+  _previousTransforms[index] = _previousTransforms[last];
+  _currentTransforms[index] = _currentTransforms[last];
+  _stepPreviousTransforms[index] = _stepPreviousTransforms[last];
+  _stepCurrentTransforms[index] = _stepCurrentTransforms[last];
+  _bodies.pop_back();
+  _bodyTypes.pop_back();
+  _bodyComponents.pop_back();
+  _previousTransforms.pop_back();
+  _currentTransforms.pop_back();
+  _stepPreviousTransforms.pop_back();
+  _stepCurrentTransforms.pop_back();
+
+  _phys->destroyRigidBody(body);
+}
+
+rp3d::Collider *RP3DScenePhysics::AddCollider(rp3d::RigidBody *body, rp3d::CollisionShape *shape, const math::Transform &localTransform,
+                                              scene::SceneComponent *component) {
+  WaitForStep();
+  const auto collider = body->addCollider(shape, toPhysics(localTransform));
+  collider->setUserData(component);
+  return collider;
+}
+
+void RP3DScenePhysics::RemoveCollider(rp3d::RigidBody *body, rp3d::Collider *collider) {
+  FlushCommands();
+  body->removeCollider(collider);
+}
+
+rp3d::ConvexMesh *RP3DScenePhysics::GetConvexMesh(const std::shared_ptr<drawing::Mesh> &mesh) {
+  auto &cooked = _cookedMeshes[mesh.get()];
+  cooked.mesh = mesh;
+  if (cooked.convex) {
+    return cooked.convex;
+  }
+
+  const auto &collision = mesh->GetCollisionData();
+  if (collision.hullFaces.empty()) {
+    return nullptr;
+  }
+
+  // The hull was computed when the mesh was imported, this only unpacks its faces
+  std::vector<uint32_t> indices;
+  std::vector<rp3d::PolygonVertexArray::PolygonFace> faces;
+  for (size_t i = 0; i < collision.hullFaces.size(); i += collision.hullFaces[i] + 1) {
+    const auto count = collision.hullFaces[i];
+    faces.push_back({count, static_cast<uint32_t>(indices.size())});
+    indices.insert(indices.end(), collision.hullFaces.begin() + static_cast<int64_t>(i) + 1,
+                   collision.hullFaces.begin() + static_cast<int64_t>(i + count) + 1);
+  }
+
+  const rp3d::PolygonVertexArray polygons(static_cast<uint32_t>(collision.hullVertices.size() / 3), collision.hullVertices.data(),
+                                          3 * sizeof(float), indices.data(), sizeof(uint32_t), static_cast<uint32_t>(faces.size()),
+                                          faces.data(), rp3d::PolygonVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                                          rp3d::PolygonVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+  std::vector<rp3d::Message> messages;
+  cooked.convex = physicsCommon.createConvexMesh(polygons, messages);
+  return cooked.convex;
+}
+
+rp3d::TriangleMesh *RP3DScenePhysics::GetTriangleMesh(const std::shared_ptr<drawing::Mesh> &mesh) {
+  auto &cooked = _cookedMeshes[mesh.get()];
+  cooked.mesh = mesh;
+  if (cooked.triangles) {
+    return cooked.triangles;
+  }
+
+  const auto &collision = mesh->GetCollisionData();
+  if (collision.triangleIndices.empty()) {
+    return nullptr;
+  }
+
+  const rp3d::TriangleVertexArray triangles(static_cast<uint32_t>(collision.triangleVertices.size() / 3),
+                                            collision.triangleVertices.data(), 3 * sizeof(float),
+                                            static_cast<uint32_t>(collision.triangleIndices.size() / 3),
+                                            collision.triangleIndices.data(), 3 * sizeof(uint32_t),
+                                            rp3d::TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                                            rp3d::TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+  std::vector<rp3d::Message> messages;
+  cooked.triangles = physicsCommon.createTriangleMesh(triangles, messages);
+  return cooked.triangles;
+}
+
+rp3d::PhysicsWorld *RP3DScenePhysics::GetWorld() const {
+  return _phys;
+}
+
+void RP3DScenePhysics::SyncToPhysics() {
+  // Gathered here on the game thread and applied as one batch on the stepping thread, no step is in flight while this runs
+  _transformBatch.resize(_bodies.size());
+  for (size_t i = 0; i < _bodies.size(); i++) {
+    if (_bodyTypes[i] == rp3d::BodyType::DYNAMIC) {
+      continue;
+    }
+
+    if (const auto component = _bodyComponents[i].lock()) {
+      _currentTransforms[i] = component->GetWorldTransform();
+      _previousTransforms[i] = _currentTransforms[i];
+    }
+    _transformBatch[i] = toPhysics(_currentTransforms[i]);
+  }
+
+  PushCommand([this] {
+    for (size_t i = 0; i < _bodies.size(); i++) {
+      if (_bodyTypes[i] != rp3d::BodyType::DYNAMIC) {
+        _bodies[i]->setTransform(_transformBatch[i]);
+      }
+    }
+  });
+}
+
+void RP3DScenePhysics::SyncFromPhysics(const float alpha) {
+  for (size_t i = 0; i < _bodies.size(); i++) {
+    if (_bodyTypes[i] != rp3d::BodyType::DYNAMIC) {
+      continue;
+    }
+
+    if (const auto component = _bodyComponents[i].lock()) {
+      component->SetWorldTransform(_previousTransforms[i].Interpolate(_currentTransforms[i], alpha));
+    }
+  }
+}
+
+void RP3DScenePhysics::ExchangeResults() {
+  _previousTransforms = _stepPreviousTransforms;
+  _currentTransforms = _stepCurrentTransforms;
+
+  for (const auto &contact : _stepContacts) {
+    _contactEvents.push_back({getColliderComponent(contact.a), getColliderComponent(contact.b), contact.type, contact.point,
+                              contact.normal, contact.depth});
+  }
+  _stepContacts.clear();
+
+  for (const auto &trigger : _stepTriggers) {
+    _triggerEvents.push_back({getColliderComponent(trigger.a), getColliderComponent(trigger.b), trigger.type});
+  }
+  _stepTriggers.clear();
 }
 
 void RP3DScenePhysics::InternalFixedUpdate(float deltaTime) {
-  //_phys->update(deltaTime);
+  _stepPreviousTransforms = _stepCurrentTransforms;
+  _phys->update(deltaTime);
+  ReadBodyTransforms(_stepCurrentTransforms);
 }
 
+std::optional<PhysicsHit> RP3DScenePhysics::RayCast(const math::Ray &ray, const float maxDistance) {
+  WaitForStep();
+
+  class ClosestHit : public rp3d::RaycastCallback {
+  public:
+    std::optional<PhysicsHit> hit;
+    float maxDistance = 0.0f;
+
+    rp3d::decimal notifyRaycastHit(const rp3d::RaycastInfo &info) override {
+      hit = PhysicsHit{getColliderComponent(static_cast<scene::SceneComponent *>(info.collider->getUserData())),
+                       {info.worldPoint.x, info.worldPoint.y, info.worldPoint.z},
+                       {info.worldNormal.x, info.worldNormal.y, info.worldNormal.z}, info.hitFraction * maxDistance};
+      // Clipping the ray to this hit leaves only closer hits to report
+      return info.hitFraction;
+    }
+  } callback;
+  callback.maxDistance = maxDistance;
+
+  const auto end = ray.At(maxDistance);
+  _phys->raycast(rp3d::Ray({ray.origin.x, ray.origin.y, ray.origin.z}, {end.x, end.y, end.z}), &callback);
+  return callback.hit;
+}
+
+Array<std::weak_ptr<scene::SceneComponent>> RP3DScenePhysics::OverlapSphere(const glm::vec3 &center, const float radius) {
+  const auto shape = physicsCommon.createSphereShape(radius);
+  auto result = Overlap(shape, {{center.x, center.y, center.z}, math::Quat{0, 0, 0, 1}, {1.0f, 1.0f, 1.0f}});
+  physicsCommon.destroySphereShape(shape);
+  return result;
+}
+
+Array<std::weak_ptr<scene::SceneComponent>> RP3DScenePhysics::OverlapBox(const math::Transform &transform, const glm::vec3 &halfExtents) {
+  const auto shape = physicsCommon.createBoxShape({halfExtents.x, halfExtents.y, halfExtents.z});
+  auto result = Overlap(shape, transform);
+  physicsCommon.destroyBoxShape(shape);
+  return result;
+}
+
+Array<std::weak_ptr<scene::SceneComponent>> RP3DScenePhysics::Overlap(rp3d::CollisionShape *shape, const math::Transform &transform) {
+  WaitForStep();
+
+  // rp3d only tests overlaps against bodies so the query shape gets a body that lives for the duration of the query
+  const auto queryBody = _phys->createRigidBody(toPhysics(transform));
+  queryBody->enableGravity(false);
+  const auto queryCollider = queryBody->addCollider(shape, rp3d::Transform::identity());
+
+  class Collector : public rp3d::OverlapCallback {
+  public:
+    rp3d::Collider *query = nullptr;
+    Array<std::weak_ptr<scene::SceneComponent>> result;
+
+    void onOverlap(CallbackData &callbackData) override {
+      for (uint32_t i = 0; i < callbackData.getNbOverlappingPairs(); i++) {
+        const auto pair = callbackData.getOverlappingPair(i);
+        const auto other = pair.getCollider1() == query ? pair.getCollider2() : pair.getCollider1();
+        result.push(getColliderComponent(static_cast<scene::SceneComponent *>(other->getUserData())));
+      }
+    }
+  } collector;
+  collector.query = queryCollider;
+
+  _phys->testOverlap(queryBody, collector);
+  _phys->destroyRigidBody(queryBody);
+  return collector.result;
+}
 }
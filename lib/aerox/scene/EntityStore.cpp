@@ -0,0 +1,335 @@
+#include "aerox/scene/EntityStore.hpp"
+#include "aerox/utils.hpp"
+#include <algorithm>
+#include <deque>
+#include <mutex>
+
+namespace aerox::scene {
+
+// Deque so references handed out stay valid as types are registered
+std::deque<ComponentTypeInfo> &getComponentTypes() {
+  static std::deque<ComponentTypeInfo> types;
+  return types;
+}
+
+std::mutex &getComponentTypesMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+bool EntityId::IsValid() const {
+  return index != std::numeric_limits<uint32_t>::max();
+}
+
+uint32_t registerComponentType(ComponentTypeInfo info) {
+  std::lock_guard guard(getComponentTypesMutex());
+  auto &types = getComponentTypes();
+  info.id = static_cast<uint32_t>(types.size());
+  types.push_back(info);
+  return info.id;
+}
+
+const ComponentTypeInfo &getComponentTypeInfo(const uint32_t id) {
+  std::lock_guard guard(getComponentTypesMutex());
+  return getComponentTypes()[id];
+}
+
+size_t Archetype::ComputeLayout(const uint32_t capacity) {
+  auto offset = sizeof(EntityId) * capacity;
+  for (size_t i = 0; i < _infos.size(); i++) {
+    offset = (offset + _infos[i]->alignment - 1) / _infos[i]->alignment * _infos[i]->alignment;
+    _offsets[i] = offset;
+    offset += _infos[i]->size * capacity;
+  }
+  return offset;
+}
+
+Archetype::Archetype(std::vector<uint32_t> types) : _types(std::move(types)) {
+  size_t rowSize = sizeof(EntityId);
+  for (const auto type : _types) {
+    const auto &info = getComponentTypeInfo(type);
+    utils::vassert(info.alignment <= ENTITY_CHUNK_ALIGNMENT, "Component alignment {} is larger than the chunk alignment",
+                   info.alignment);
+    _infos.push_back(&info);
+    rowSize += info.size;
+  }
+  _offsets.resize(_types.size());
+
+  _capacity = static_cast<uint32_t>(std::max<size_t>(ENTITY_CHUNK_SIZE / rowSize, 1));
+  while (_capacity > 1 && ComputeLayout(_capacity) > ENTITY_CHUNK_SIZE) {
+    _capacity--;
+  }
+  _chunkSize = std::max(ENTITY_CHUNK_SIZE, ComputeLayout(_capacity));
+}
+
+Archetype::~Archetype() {
+  for (auto &chunk : _chunks) {
+    for (size_t column = 0; column < _infos.size(); column++) {
+      for (uint32_t i = 0; i < chunk.count; i++) {
+        _infos[column]->destroy(chunk.data + _offsets[column] + _infos[column]->size * i);
+      }
+    }
+    ::operator delete(chunk.data, std::align_val_t{ENTITY_CHUNK_ALIGNMENT});
+  }
+}
+
+const std::vector<uint32_t> &Archetype::GetTypes() const {
+  return _types;
+}
+
+int32_t Archetype::GetColumn(const uint32_t type) const {
+  const auto it = std::lower_bound(_types.begin(), _types.end(), type);
+  if (it == _types.end() || *it != type) {
+    return -1;
+  }
+  return static_cast<int32_t>(it - _types.begin());
+}
+
+bool Archetype::HasAll(const std::span<const uint32_t> types) const {
+  return std::ranges::all_of(types, [this](const uint32_t type) {
+    return GetColumn(type) != -1;
+  });
+}
+
+size_t Archetype::GetCount() const {
+  return _count;
+}
+
+size_t Archetype::GetChunkCount() const {
+  return _chunks.size();
+}
+
+uint32_t Archetype::GetChunkRowCount(const size_t chunk) const {
+  return _chunks[chunk].count;
+}
+
+uint32_t Archetype::GetRowsPerChunk() const {
+  return _capacity;
+}
+
+EntityId *Archetype::GetEntities(const size_t chunk) const {
+  return reinterpret_cast<EntityId *>(_chunks[chunk].data);
+}
+
+void *Archetype::GetColumnData(const size_t chunk, const uint32_t column) const {
+  return _chunks[chunk].data + _offsets[column];
+}
+
+void *Archetype::GetComponent(const size_t row, const uint32_t column) const {
+  return _chunks[row / _capacity].data + _offsets[column] + _infos[column]->size * (row % _capacity);
+}
+
+EntityId Archetype::GetEntity(const size_t row) const {
+  return GetEntities(row / _capacity)[row % _capacity];
+}
+
+size_t Archetype::Push(const EntityId entity) {
+  if (_chunks.empty() || _chunks.back().count == _capacity) {
+    _chunks.push_back({static_cast<std::byte *>(::operator new(_chunkSize, std::align_val_t{ENTITY_CHUNK_ALIGNMENT})), 0});
+  }
+
+  auto &chunk = _chunks.back();
+  new(reinterpret_cast<EntityId *>(chunk.data) + chunk.count) EntityId(entity);
+  chunk.count++;
+  return _count++;
+}
+
+EntityId Archetype::Remove(const size_t row, const bool bDestroy) {
+  if (bDestroy) {
+    for (uint32_t column = 0; column < _infos.size(); column++) {
+      _infos[column]->destroy(GetComponent(row, column));
+    }
+  }
+
+  const auto last = _count - 1;
+  EntityId moved{};
+  if (row != last) {
+    for (uint32_t column = 0; column < _infos.size(); column++) {
+      const auto source = GetComponent(last, column);
+      _infos[column]->moveConstruct(GetComponent(row, column), source);
+      _infos[column]->destroy(source);
+    }
+    moved = GetEntity(last);
+    GetEntities(row / _capacity)[row % _capacity] = moved;
+  }
+
+  auto &chunk = _chunks.back();
+  chunk.count--;
+  if (chunk.count == 0) {
+    ::operator delete(chunk.data, std::align_val_t{ENTITY_CHUNK_ALIGNMENT});
+    _chunks.pop_back();
+  }
+  _count--;
+  return moved;
+}
+
+Archetype *EntityStore::GetOrCreateArchetype(const std::vector<uint32_t> &types) {
+  if (const auto it = _archetypeMap.find(types); it != _archetypeMap.end()) {
+    return it->second;
+  }
+
+  _archetypes.push_back(std::make_unique<Archetype>(types));
+  const auto archetype = _archetypes.back().get();
+  _archetypeMap.emplace(types, archetype);
+  return archetype;
+}
+
+void EntityStore::MoveEntity(const EntityId entity, Archetype *target, const uint32_t addedType,
+                             const std::function<void(void *)> &construct) {
+  auto &record = _records[entity.index];
+  const auto source = record.archetype;
+  const auto row = target->Push(entity);
+
+  for (uint32_t column = 0; column < target->GetTypes().size(); column++) {
+    const auto type = target->GetTypes()[column];
+    if (type == addedType) {
+      construct(target->GetComponent(row, column));
+      continue;
+    }
+
+    const auto &info = getComponentTypeInfo(type);
+    const auto sourceComponent = source->GetComponent(record.row, source->GetColumn(type));
+    info.moveConstruct(target->GetComponent(row, column), sourceComponent);
+    info.destroy(sourceComponent);
+  }
+
+  // Components the target does not have are dropped here
+  for (uint32_t column = 0; column < source->GetTypes().size(); column++) {
+    const auto type = source->GetTypes()[column];
+    if (target->GetColumn(type) == -1) {
+      getComponentTypeInfo(type).destroy(source->GetComponent(record.row, column));
+    }
+  }
+
+  if (const auto moved = source->Remove(record.row, false); moved.IsValid()) {
+    _records[moved.index].row = record.row;
+  }
+
+  record.archetype = target;
+  record.row = row;
+}
+
+void *EntityStore::GetComponent(const EntityId entity, const uint32_t type) const {
+  if (!IsAlive(entity)) {
+    return nullptr;
+  }
+
+  const auto &record = _records[entity.index];
+  if (!record.archetype) {
+    return nullptr;
+  }
+
+  const auto column = record.archetype->GetColumn(type);
+  return column == -1 ? nullptr : record.archetype->GetComponent(record.row, column);
+}
+
+EntityId EntityStore::Create() {
+  uint32_t index;
+  if (!_freeIndices.empty()) {
+    index = _freeIndices.back();
+    _freeIndices.pop_back();
+  }
+  else {
+    index = static_cast<uint32_t>(_records.size());
+    _records.emplace_back();
+  }
+
+  auto &record = _records[index];
+  record.bAlive = true;
+  record.archetype = nullptr;
+
+  const EntityId entity{index, record.generation};
+  _commands.push_back({Command::Type::Create, entity, 0, {}});
+  return entity;
+}
+
+void EntityStore::Destroy(const EntityId entity) {
+  _commands.push_back({Command::Type::Destroy, entity, 0, {}});
+}
+
+void EntityStore::Sync() {
+  // Commands may queue more commands through component constructors so they are moved out first
+  auto commands = std::move(_commands);
+  _commands.clear();
+
+  for (const auto &command : commands) {
+    if (!IsAlive(command.entity)) {
+      continue;
+    }
+
+    auto &record = _records[command.entity.index];
+    switch (command.type) {
+    case Command::Type::Create:
+      record.archetype = GetOrCreateArchetype({});
+      record.row = record.archetype->Push(command.entity);
+      _count++;
+      break;
+    case Command::Type::Destroy:
+      if (record.archetype) {
+        if (const auto moved = record.archetype->Remove(record.row); moved.IsValid()) {
+          _records[moved.index].row = record.row;
+        }
+        _count--;
+      }
+      record.archetype = nullptr;
+      record.bAlive = false;
+      record.generation++;
+      _freeIndices.push_back(command.entity.index);
+      break;
+    case Command::Type::Add: {
+      if (const auto column = record.archetype->GetColumn(command.componentType); column != -1) {
+        // Replace the existing value in place
+        const auto component = record.archetype->GetComponent(record.row, column);
+        getComponentTypeInfo(command.componentType).destroy(component);
+        command.construct(component);
+        break;
+      }
+
+      auto types = record.archetype->GetTypes();
+      types.insert(std::ranges::upper_bound(types, command.componentType), command.componentType);
+      MoveEntity(command.entity, GetOrCreateArchetype(types), command.componentType, command.construct);
+    }
+    break;
+    case Command::Type::Remove: {
+      if (record.archetype->GetColumn(command.componentType) == -1) {
+        break;
+      }
+
+      auto types = record.archetype->GetTypes();
+      std::erase(types, command.componentType);
+      MoveEntity(command.entity, GetOrCreateArchetype(types), command.componentType, {});
+    }
+    break;
+    }
+  }
+}
+
+bool EntityStore::IsAlive(const EntityId entity) const {
+  return entity.index < _records.size() && _records[entity.index].bAlive && _records[entity.index].generation == entity.generation;
+}
+
+void EntityStore::Clear() {
+  _commands.clear();
+  _archetypeMap.clear();
+  _archetypes.clear();
+  _freeIndices.clear();
+  for (uint32_t i = 0; i < _records.size(); i++) {
+    auto &record = _records[i];
+    if (record.bAlive) {
+      record.generation++;
+    }
+    record.bAlive = false;
+    record.archetype = nullptr;
+    _freeIndices.push_back(i);
+  }
+  _count = 0;
+}
+
+size_t EntityStore::GetCount() const {
+  return _count;
+}
+
+size_t EntityStore::GetArchetypeCount() const {
+  return _archetypes.size();
+}
+}
@@ -35,6 +35,13 @@ void Scene::OnInit(Engine * outer) {
 
 void Scene::OnDestroy() {
     TObjectWithInit::OnDestroy();
+  for(const auto &obj : _sceneObjects) {
+    obj->_spatialProxy = math::BoundsTree::NULL_NODE;
+    obj->_spatialDirty = false;
+  }
+  _spatialDirty.clear();
+  _spatialIndex.Clear();
+  _tickScheduler.Clear();
   _sceneObjects.clear();
 
   _drawer.reset();
@@ -127,13 +134,198 @@ void Scene::RegisterLight(const std::weak_ptr<LightComponent> &light) {
   _lights.push_back(light);
 }
 
+void Scene::MarkSpatialDirty(SceneObject *object) {
+  if(object->_spatialDirty || TickScheduler::DeferSpatialDirty(object)) {
+    return;
+  }
+  object->_spatialDirty = true;
+  _spatialDirty.push(object);
+}
+
+void Scene::RemoveFromSpatialIndex(SceneObject *object) {
+  if(object->_spatialDirty) {
+    std::erase(_spatialDirty,object);
+    object->_spatialDirty = false;
+  }
+
+  if(object->_bUnbounded) {
+    std::erase(_unbounded,object);
+    object->_bUnbounded = false;
+  }
+  
+  if(object->_spatialProxy != math::BoundsTree::NULL_NODE) {
+    _spatialIndex.Remove(object->_spatialProxy);
+    object->_spatialProxy = math::BoundsTree::NULL_NODE;
+  }
+}
+
+void Scene::UpdateSpatialIndex() {
+  for(const auto object : _spatialDirty) {
+    object->_spatialDirty = false;
+    const auto worldBounds = object->GetWorldBounds();
+    if(!worldBounds) {
+      if(object->_spatialProxy != math::BoundsTree::NULL_NODE) {
+        _spatialIndex.Remove(object->_spatialProxy);
+        object->_spatialProxy = math::BoundsTree::NULL_NODE;
+      }
+      if(!object->_bUnbounded) {
+        object->_bUnbounded = true;
+        _unbounded.push(object);
+      }
+      continue;
+    }
+
+    if(object->_bUnbounded) {
+      std::erase(_unbounded,object);
+      object->_bUnbounded = false;
+    }
+
+    const auto &bounds = *worldBounds;
+    if(object->_spatialProxy == math::BoundsTree::NULL_NODE) {
+      object->_spatialProxy = _spatialIndex.Insert(bounds,object);
+    } else {
+      _spatialIndex.Move(object->_spatialProxy,bounds,bounds.GetCenter() - object->_spatialBounds.GetCenter());
+    }
+    object->_spatialBounds = bounds;
+  }
+  _spatialDirty.clear();
+}
+
+void Scene::RebalanceSpatialIndex() {
+  if(++_ticksSinceSpatialCheck < SPATIAL_INDEX_CHECK_INTERVAL) {
+    return;
+  }
+  _ticksSinceSpatialCheck = 0;
+
+  // Incremental inserts degrade the tree over time, rebuild it once it gets noticeably worse than the last rebuild
+  if(const auto ratio = _spatialIndex.GetAreaRatio(); _spatialAreaRatio <= 0.0f || ratio > _spatialAreaRatio * SPATIAL_INDEX_REBUILD_THRESHOLD) {
+    _spatialIndex.Rebuild();
+    _spatialAreaRatio = _spatialIndex.GetAreaRatio();
+  }
+}
+
+const math::BoundsTree & Scene::GetSpatialIndex() const {
+  return _spatialIndex;
+}
+
+TransformStore &Scene::GetTransformStore() {
+  return _transformStore;
+}
+
+TickScheduler &Scene::GetTickScheduler() {
+  return _tickScheduler;
+}
+
+void Scene::Defer(std::function<void()> fn) {
+  _tickScheduler.Defer(std::move(fn));
+}
+
+void Scene::DestroySceneObject(const std::shared_ptr<SceneObject> &object) {
+  if(_tickScheduler.IsTicking()) {
+    // Objects later in the group must not tick it anymore, the wave may already be running on other threads
+    object->_bPendingRemoval.store(true, std::memory_order_release);
+    Defer([this,object] {
+      DestroySceneObject(object);
+    });
+    return;
+  }
+
+  if(_viewTarget == object) {
+    _viewTarget.reset();
+  }
+  _tickScheduler.Unregister(object.get());
+  RemoveFromSpatialIndex(object.get());
+  std::erase(_sceneObjects,object);
+}
+
+Array<std::weak_ptr<SceneObject>> Scene::QueryBounds(const math::Bounds &bounds) {
+  UpdateSpatialIndex();
+  Array<std::weak_ptr<SceneObject>> result;
+  _spatialIndex.Query(bounds,[&](const int32_t proxy) {
+    const auto object = static_cast<SceneObject *>(_spatialIndex.GetUserData(proxy));
+    if(object->_spatialBounds.Intersects(bounds)) {
+      result.push(utils::castStatic<SceneObject>(object->shared_from_this()));
+    }
+    return true;
+  });
+  return result;
+}
+
+Array<std::weak_ptr<SceneObject>> Scene::QuerySphere(const math::Sphere &sphere) {
+  UpdateSpatialIndex();
+  Array<std::weak_ptr<SceneObject>> result;
+  _spatialIndex.Query(sphere,[&](const int32_t proxy) {
+    const auto object = static_cast<SceneObject *>(_spatialIndex.GetUserData(proxy));
+    if(object->_spatialBounds.Intersects(sphere)) {
+      result.push(utils::castStatic<SceneObject>(object->shared_from_this()));
+    }
+    return true;
+  });
+  return result;
+}
+
+Array<std::weak_ptr<SceneObject>> Scene::QueryFrustum(const math::Frustum &frustum) {
+  UpdateSpatialIndex();
+  Array<std::weak_ptr<SceneObject>> result;
+  _spatialIndex.Query(frustum,[&](const int32_t proxy) {
+    const auto object = static_cast<SceneObject *>(_spatialIndex.GetUserData(proxy));
+    if(frustum.Intersects(object->_spatialBounds)) {
+      result.push(utils::castStatic<SceneObject>(object->shared_from_this()));
+    }
+    return true;
+  });
+  for(const auto object : _unbounded) {
+    result.push(utils::castStatic<SceneObject>(object->shared_from_this()));
+  }
+  return result;
+}
+
+std::optional<SceneRayHit> Scene::RayCast(const math::Ray &ray, const float maxDistance) {
+  UpdateSpatialIndex();
+  std::optional<SceneRayHit> result;
+  _spatialIndex.RayCast(ray,maxDistance,[&](const int32_t proxy,float,const float currentMax) {
+    const auto object = static_cast<SceneObject *>(_spatialIndex.GetUserData(proxy));
+    float distance;
+    if(!object->_spatialBounds.Intersects(ray,currentMax,distance)) {
+      return currentMax;
+    }
+    result = SceneRayHit{utils::castStatic<SceneObject>(object->shared_from_this()),distance};
+    return distance;
+  });
+  return result;
+}
+
+std::optional<physics::PhysicsHit> Scene::PhysicsRayCast(const math::Ray &ray, const float maxDistance) {
+  if(!_physics) {
+    return {};
+  }
+  return _physics->RayCast(ray,maxDistance);
+}
+
+Array<std::weak_ptr<SceneComponent>> Scene::PhysicsOverlapSphere(const glm::vec3 &center, const float radius) {
+  if(!_physics) {
+    return {};
+  }
+  return _physics->OverlapSphere(center,radius);
+}
+
+Array<std::weak_ptr<SceneComponent>> Scene::PhysicsOverlapBox(const math::Transform &transform, const glm::vec3 &halfExtents) {
+  if(!_physics) {
+    return {};
+  }
+  return _physics->OverlapBox(transform,halfExtents);
+}
+
 void Scene::Tick(float deltaTime) {
+  _tickScheduler.Tick(ETickGroup::PrePhysics,deltaTime);
   if(_physics) {
-    _physics->FixedUpdate(0.2f);
-  }
-  for(const auto &obj : _sceneObjects) {
-    obj->Tick(deltaTime);
+    _physics->FixedUpdate(deltaTime);
   }
+  _tickScheduler.Tick(ETickGroup::PostPhysics,deltaTime);
+  _transformStore.Update();
+  _tickScheduler.Tick(ETickGroup::Late,deltaTime);
+  UpdateSpatialIndex();
+  RebalanceSpatialIndex();
 }
 
 std::shared_ptr<physics::ScenePhysics> Scene::CreatePhysics() {
@@ -161,9 +353,18 @@ std::weak_ptr<SceneObject> Scene::GetViewTarget() const {
 }
 
 std::shared_ptr<SceneObject> Scene::InitSceneObject(const std::shared_ptr<SceneObject> &object) {
-  if (IsInitialized() || IsInitializing()) {
+  if (_tickScheduler.IsTicking()) {
+    // Objects ticking on other threads may be creating objects too
+    Defer([this,object] {
+      InitSceneObject(object);
+    });
+  } else if (IsInitialized() || IsInitializing()) {
       _sceneObjects.push(object);
       object->Init(this);
+      MarkSpatialDirty(object.get());
+      if(object->CanEverUpdate()) {
+        _tickScheduler.Register(object.get());
+      }
   } else {
     _objectsPendingInit.push(object);
   }
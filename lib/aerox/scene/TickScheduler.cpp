@@ -0,0 +1,194 @@
+#include "aerox/scene/TickScheduler.hpp"
+#include "aerox/async/parallel.hpp"
+#include "aerox/log.hpp"
+#include "aerox/scene/objects/SceneObject.hpp"
+#include <algorithm>
+#include <unordered_map>
+
+namespace aerox::scene {
+
+// Set while the current thread ticks a batch of thread safe objects
+static thread_local std::vector<SceneObject *> *batchSpatialDirty = nullptr;
+
+void TickScheduler::BuildWaves(Group &group) {
+  std::unordered_map<const SceneObject *, size_t> indices;
+  for (size_t i = 0; i < group.objects.size(); i++) {
+    indices.emplace(group.objects[i], i);
+  }
+
+  // Relax wave indices until every object sits after its prerequisites, any longer than the object count means there is a cycle
+  std::vector<size_t> waves(group.objects.size(), 0);
+  auto bChanged = true;
+  for (size_t pass = 0; bChanged && pass <= group.objects.size(); pass++) {
+    bChanged = false;
+    for (size_t i = 0; i < group.objects.size(); i++) {
+      for (const auto &prerequisite : group.objects[i]->GetTickPrerequisites()) {
+        // Prerequisites in other groups are already ordered by the groups themselves
+        const auto locked = prerequisite.lock();
+        const auto it = locked ? indices.find(locked.get()) : indices.end();
+        if (it != indices.end() && waves[i] <= waves[it->second]) {
+          waves[i] = waves[it->second] + 1;
+          bChanged = true;
+        }
+      }
+    }
+  }
+
+  if (bChanged) {
+    log::engine->Warn("Tick prerequisites contain a cycle, some objects will tick before their prerequisites");
+  }
+
+  const auto numWaves = group.objects.empty() ? 0 : *std::ranges::max_element(waves) + 1;
+  group.waves.assign(numWaves, {});
+  group.serialOffsets.assign(numWaves, 0);
+  for (size_t i = 0; i < group.objects.size(); i++) {
+    if (group.objects[i]->IsTickThreadSafe()) {
+      group.waves[waves[i]].push_back(group.objects[i]);
+    }
+  }
+  for (size_t wave = 0; wave < numWaves; wave++) {
+    group.serialOffsets[wave] = group.waves[wave].size();
+  }
+  for (size_t i = 0; i < group.objects.size(); i++) {
+    if (!group.objects[i]->IsTickThreadSafe()) {
+      group.waves[waves[i]].push_back(group.objects[i]);
+    }
+  }
+
+  group.bDirty = false;
+}
+
+void TickScheduler::Register(SceneObject *object) {
+  if (_bTicking) {
+    Defer([this, object] {
+      Register(object);
+    });
+    return;
+  }
+
+  auto &group = _groups[static_cast<size_t>(object->GetTickGroup())];
+  if (std::ranges::find(group.objects, object) == group.objects.end()) {
+    group.objects.push_back(object);
+    group.bDirty = true;
+  }
+}
+
+void TickScheduler::Unregister(SceneObject *object) {
+  if (_bTicking) {
+    Defer([this, object] {
+      Unregister(object);
+    });
+    return;
+  }
+
+  for (auto &group : _groups) {
+    if (std::erase(group.objects, object) > 0) {
+      group.bDirty = true;
+    }
+  }
+}
+
+void TickScheduler::MarkDirty(const SceneObject *object) {
+  if (_bTicking) {
+    Defer([this, object] {
+      MarkDirty(object);
+    });
+    return;
+  }
+
+  _groups[static_cast<size_t>(object->GetTickGroup())].bDirty = true;
+}
+
+void TickScheduler::Defer(std::function<void()> fn) {
+  if (!_bTicking) {
+    fn();
+    return;
+  }
+
+  std::lock_guard guard(_commandsMutex);
+  _commands.push_back(std::move(fn));
+}
+
+void TickScheduler::Tick(const ETickGroup group, const float deltaTime) {
+  auto &target = _groups[static_cast<size_t>(group)];
+  if (target.bDirty) {
+    BuildWaves(target);
+  }
+
+  _bTicking = true;
+  for (size_t wave = 0; wave < target.waves.size(); wave++) {
+    const auto &objects = target.waves[wave];
+    const auto serialOffset = target.serialOffsets[wave];
+    async::parallelFor(serialOffset, [&](const size_t begin, const size_t end) {
+      std::vector<SceneObject *> spatialDirty;
+      // A thread waiting on a nested job may pick up another batch while its own is in flight
+      const auto previous = batchSpatialDirty;
+      batchSpatialDirty = &spatialDirty;
+      for (auto i = begin; i < end; i++) {
+        if (!objects[i]->IsPendingRemoval()) {
+          objects[i]->Tick(deltaTime);
+        }
+      }
+      batchSpatialDirty = previous;
+
+      if (!spatialDirty.empty()) {
+        std::lock_guard guard(_waveMutex);
+        _waveSpatialDirty.insert(_waveSpatialDirty.end(), spatialDirty.begin(), spatialDirty.end());
+      }
+    }, 1);
+
+    // Back on one thread, merge before the serial objects run so their queries see this wave's movement
+    for (const auto object : _waveSpatialDirty) {
+      object->MarkBoundsDirty();
+    }
+    _waveSpatialDirty.clear();
+
+    for (auto i = serialOffset; i < objects.size(); i++) {
+      if (!objects[i]->IsPendingRemoval()) {
+        objects[i]->Tick(deltaTime);
+      }
+    }
+  }
+  _bTicking = false;
+
+  std::vector<std::function<void()>> commands;
+  {
+    std::lock_guard guard(_commandsMutex);
+    commands = std::move(_commands);
+    _commands.clear();
+  }
+
+  for (const auto &command : commands) {
+    command();
+  }
+}
+
+bool TickScheduler::IsTicking() const {
+  return _bTicking;
+}
+
+bool TickScheduler::DeferSpatialDirty(SceneObject *object) {
+  if (!batchSpatialDirty) {
+    return false;
+  }
+
+  // Objects usually move several components in a row
+  if (batchSpatialDirty->empty() || batchSpatialDirty->back() != object) {
+    batchSpatialDirty->push_back(object);
+  }
+  return true;
+}
+
+size_t TickScheduler::GetCount(const ETickGroup group) const {
+  return _groups[static_cast<size_t>(group)].objects.size();
+}
+
+void TickScheduler::Clear() {
+  for (auto &group : _groups) {
+    group = {};
+  }
+
+  std::lock_guard guard(_commandsMutex);
+  _commands.clear();
+}
+}
@@ -0,0 +1,219 @@
+#include "aerox/scene/TransformStore.hpp"
+#include "aerox/async/parallel.hpp"
+#include "aerox/math/simd.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace aerox::scene {
+
+void TransformStore::Sort() {
+  // Depth of every live id, resolved iteratively so deep hierarchies do not recurse
+  std::vector<uint32_t> depths(_idToIndex.size(), INVALID_ID);
+  uint32_t maxDepth = 0;
+  for (uint32_t id = 0; id < _idToIndex.size(); id++) {
+    if (_idToIndex[id] == INVALID_ID || depths[id] != INVALID_ID) {
+      continue;
+    }
+
+    _sortChain.clear();
+    auto current = id;
+    while (current != INVALID_ID && depths[current] == INVALID_ID) {
+      _sortChain.push_back(current);
+      current = _parentIds[current];
+    }
+
+    auto depth = current == INVALID_ID ? 0 : depths[current] + 1;
+    for (auto i = _sortChain.size(); i > 0; i--) {
+      depths[_sortChain[i - 1]] = depth++;
+    }
+    maxDepth = std::max(maxDepth, depth - 1);
+  }
+
+  _levelOffsets.assign(_count > 0 ? maxDepth + 2 : 1, 0);
+  for (const auto id : _ids) {
+    if (id != INVALID_ID) {
+      _levelOffsets[depths[id] + 1]++;
+    }
+  }
+  for (size_t i = 1; i < _levelOffsets.size(); i++) {
+    _levelOffsets[i] += _levelOffsets[i - 1];
+  }
+
+  std::vector<glm::mat4> local(_count);
+  std::vector<glm::mat4> world(_count);
+  std::vector<uint32_t> ids(_count);
+  std::vector<uint8_t> dirty(_count);
+  auto next = _levelOffsets;
+  for (size_t i = 0; i < _ids.size(); i++) {
+    const auto id = _ids[i];
+    if (id == INVALID_ID) {
+      continue;
+    }
+
+    const auto index = next[depths[id]]++;
+    local[index] = _local[i];
+    world[index] = _world[i];
+    ids[index] = id;
+    dirty[index] = _dirty[i];
+    _idToIndex[id] = index;
+  }
+
+  _local = std::move(local);
+  _world = std::move(world);
+  _ids = std::move(ids);
+  _dirty = std::move(dirty);
+
+  _parentIndices.resize(_count);
+  for (size_t i = 0; i < _count; i++) {
+    const auto parent = _parentIds[_ids[i]];
+    _parentIndices[i] = parent == INVALID_ID ? INVALID_ID : _idToIndex[parent];
+  }
+
+  _bOrderDirty = false;
+}
+
+uint32_t TransformStore::Add(const glm::mat4 &local) {
+  std::lock_guard guard(_mutex);
+  uint32_t id;
+  if (!_freeIds.empty()) {
+    id = _freeIds.back();
+    _freeIds.pop_back();
+  }
+  else {
+    id = static_cast<uint32_t>(_idToIndex.size());
+    _idToIndex.push_back(INVALID_ID);
+    _parentIds.push_back(INVALID_ID);
+  }
+
+  _idToIndex[id] = static_cast<uint32_t>(_local.size());
+  _parentIds[id] = INVALID_ID;
+  _local.push_back(local);
+  _world.push_back(local);
+  _ids.push_back(id);
+  _parentIndices.push_back(INVALID_ID);
+  _dirty.push_back(0);
+  _count++;
+  _bOrderDirty = true;
+  return id;
+}
+
+void TransformStore::Remove(const uint32_t id) {
+  std::lock_guard guard(_mutex);
+  // The entry is dropped from the arrays on the next sort
+  _ids[_idToIndex[id]] = INVALID_ID;
+  _idToIndex[id] = INVALID_ID;
+  _parentIds[id] = INVALID_ID;
+  _freeIds.push_back(id);
+  _count--;
+  _bOrderDirty = true;
+}
+
+void TransformStore::SetParent(const uint32_t id, const uint32_t parent) {
+  std::lock_guard guard(_mutex);
+  _parentIds[id] = parent;
+  _dirty[_idToIndex[id]] = 1;
+  _bOrderDirty = true;
+}
+
+uint32_t TransformStore::GetParent(const uint32_t id) const {
+  std::lock_guard guard(_mutex);
+  return _parentIds[id];
+}
+
+void TransformStore::SetLocal(const uint32_t id, const glm::mat4 &local) {
+  std::lock_guard guard(_mutex);
+  const auto index = _idToIndex[id];
+  _local[index] = local;
+  _dirty[index] = 1;
+}
+
+glm::mat4 TransformStore::GetLocal(const uint32_t id) const {
+  std::lock_guard guard(_mutex);
+  return _local[_idToIndex[id]];
+}
+
+void TransformStore::MarkDirty(const uint32_t id) {
+  std::lock_guard guard(_mutex);
+  _dirty[_idToIndex[id]] = 1;
+}
+
+glm::mat4 TransformStore::GetWorld(const uint32_t id) {
+  // Two objects ticking in parallel can walk up to the same dirty parent, one of them resolves it while the other waits
+  std::lock_guard guard(_mutex);
+  const auto index = _idToIndex[id];
+  if (!_dirty[index]) {
+    return _world[index];
+  }
+
+  // Per thread so concurrent callers never share the walk, kept around to avoid allocating every call
+  static thread_local std::vector<uint32_t> chain;
+  chain.clear();
+  auto current = id;
+  while (current != INVALID_ID && _dirty[_idToIndex[current]]) {
+    chain.push_back(current);
+    current = _parentIds[current];
+  }
+
+  const glm::mat4 *parentWorld = current == INVALID_ID ? nullptr : &_world[_idToIndex[current]];
+  for (auto i = chain.size(); i > 0; i--) {
+    const auto chainIndex = _idToIndex[chain[i - 1]];
+    _world[chainIndex] = parentWorld ? math::simd::multiply(*parentWorld, _local[chainIndex]) : _local[chainIndex];
+    _dirty[chainIndex] = 0;
+    parentWorld = &_world[chainIndex];
+  }
+
+  _updates += chain.size();
+  return _world[index];
+}
+
+void TransformStore::Update() {
+  if (_bOrderDirty) {
+    Sort();
+  }
+
+  std::atomic<uint64_t> updates = 0;
+  for (size_t level = 0; level + 1 < _levelOffsets.size(); level++) {
+    const auto levelStart = _levelOffsets[level];
+    const auto levelSize = _levelOffsets[level + 1] - levelStart;
+
+    // Parents were finished by the previous level so every entry in this one can be computed independently
+    async::parallelFor(levelSize, [&](const size_t begin, const size_t end) {
+      uint64_t batchUpdates = 0;
+      for (auto i = levelStart + begin; i < levelStart + end; i++) {
+        const auto parent = _parentIndices[i];
+        if (parent == INVALID_ID) {
+          if (_dirty[i]) {
+            _world[i] = _local[i];
+            batchUpdates++;
+          }
+        }
+        else if (_dirty[i] || _dirty[parent]) {
+          _world[i] = math::simd::multiply(_world[parent], _local[i]);
+          // Left set so this entry's children are recomputed in the next level
+          _dirty[i] = 1;
+          batchUpdates++;
+        }
+      }
+      updates.fetch_add(batchUpdates, std::memory_order_relaxed);
+    }, 1024);
+  }
+
+  std::fill(_dirty.begin(), _dirty.end(), 0);
+  _updates += updates.load(std::memory_order_relaxed);
+}
+
+size_t TransformStore::GetCount() const {
+  std::lock_guard guard(_mutex);
+  return _count;
+}
+
+uint64_t TransformStore::GetWorldUpdates() const {
+  std::lock_guard guard(_mutex);
+  return _updates;
+}
+
+void TransformStore::ResetWorldUpdates() {
+  std::lock_guard guard(_mutex);
+  _updates = 0;
+}
+}
@@ -1,4 +1,5 @@
 ﻿#include <aerox/scene/components/CameraComponent.hpp>
+#include "aerox/math/constants.hpp"
 #include "aerox/scene/Scene.hpp"
 #include "aerox/scene/objects/SceneObject.hpp"
 //#include <glm/gtx/transform.hpp>
@@ -7,8 +8,9 @@
 namespace aerox::scene {
 
 glm::mat4 CameraComponent::GetViewMatrix() const {
+  // Scale is ignored so the view is a rigid inverse
   const auto transform = GetWorldTransform();
-  return inverse(transform.GetLocationMatrix() * transform.GetRotationMatrix());
+  return math::Transform{transform.location, transform.rotation, math::VECTOR_UNIT}.InverseMatrix();
 }
 
 glm::mat4 CameraComponent::GetProjection(const float aspectRatio) const {
@@ -24,4 +26,8 @@ void CameraComponent::SetRelativeTransform(const math::Transform &val) {
   RenderedComponent::SetRelativeTransform(val);
   
 }
+
+std::optional<math::Bounds> CameraComponent::GetLocalBounds() const {
+  return math::Bounds::FromPoint({0.0f, 0.0f, 0.0f});
+}
 }
@@ -1,21 +1,58 @@
 ﻿#include <aerox/scene/components/LightComponent.hpp>
+#include "aerox/scene/objects/SceneObject.hpp"
+#include <algorithm>
+#include <cmath>
+
 namespace aerox::scene {
+void LightComponent::OnInit(SceneObject *owner) {
+  SceneComponent::OnInit(owner);
+  owner->GetScene()->RegisterLight(utils::castStatic<LightComponent>(shared_from_this()));
+}
+
+void LightComponent::MarkLightDirty() {
+  _lightVersion++;
+}
+
+void LightComponent::OnTransformChanged() {
+  SceneComponent::OnTransformChanged();
+  MarkLightDirty();
+}
+
 void LightComponent::SetIntensity(float intensity) {
   _intensity = intensity;
+  MarkLightDirty();
 }
 
 void LightComponent::SetRadius(float radius) {
   _radius = radius;
+  MarkLightDirty();
 }
 
 void LightComponent::SetColor(glm::vec4 color) {
   _color = color;
+  MarkLightDirty();
 }
 
 float LightComponent::GetIntensity() const {
   return _intensity;
 }
 
+float LightComponent::GetRadius() const {
+  return _radius;
+}
+
+float LightComponent::GetAttenuationRadius() const {
+  if (_radius > 0.0f) {
+    return _radius;
+  }
+  // Solves intensity / (distance^2 + 1) = cutoff, the falloff the lighting pass uses. Never 0, that would make it reach everywhere.
+  return std::sqrt(std::max(_intensity / LIGHT_CUTOFF_IRRADIANCE - 1.0f, 1.0f));
+}
+
+uint64_t LightComponent::GetLightVersion() const {
+  return _lightVersion;
+}
+
 glm::vec4 LightComponent::GetColor() const {
   return _color;
 }
@@ -3,5 +3,8 @@
 
 
 namespace aerox::scene {
-
+void RenderedComponent::OnInit(SceneObject *owner) {
+  SceneComponent::OnInit(owner);
+  owner->AddToRenderList(utils::castStatic<RenderedComponent>(shared_from_this()));
+}
 }
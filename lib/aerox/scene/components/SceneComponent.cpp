@@ -4,11 +4,11 @@
 namespace aerox::scene {
 
 math::Vec3<> SceneComponent::GetRelativeLocation() const {
-  return GetWorldTransform().location;
+  return GetRelativeTransform().location;
 }
 
 math::Quat SceneComponent::GetRelativeRotation() const {
-  return GetWorldTransform().rotation;
+  return GetRelativeTransform().rotation;
 }
 
 math::Vec3<> SceneComponent::GetRelativeScale() const {
@@ -27,13 +27,78 @@ math::Vec3<> SceneComponent::GetWorldScale() const {
   return GetWorldTransform().scale;
 }
 
+void SceneComponent::OnInit(SceneObject *owner) {
+  Component::OnInit(owner);
+  if(const auto scene = owner->GetScene()) {
+    _transformStore = &scene->GetTransformStore();
+    _transformId = _transformStore->Add(_relativeTransform.Matrix());
+    SyncTransformParent();
+
+    // Children attached before this component was initialized
+    for (const auto &child : _children) {
+      if (const auto childRef = child.lock(); childRef && childRef->_transformStore == _transformStore) {
+        childRef->SyncTransformParent();
+      }
+    }
+  }
+}
+
+void SceneComponent::OnDestroy() {
+  Component::OnDestroy();
+  for (const auto &child : _children) {
+    if (const auto childRef = child.lock(); childRef && childRef->_parent == this) {
+      childRef->_parent = nullptr;
+      childRef->SyncTransformParent();
+    }
+  }
+
+  if(_transformStore) {
+    _transformStore->Remove(_transformId);
+    _transformStore = nullptr;
+    _transformId = TransformStore::INVALID_ID;
+  }
+}
+
+bool SceneComponent::UsesTransformStore() const {
+  // Parents outside the store are resolved through the component instead
+  return _transformStore && (!_parent || _parent->_transformStore == _transformStore);
+}
+
+void SceneComponent::SyncTransformParent() {
+  if(!_transformStore) {
+    return;
+  }
+
+  _transformStore->SetParent(_transformId, _parent && _parent->_transformStore == _transformStore
+                                             ? _parent->_transformId
+                                             : TransformStore::INVALID_ID);
+}
+
+bool SceneComponent::HasUniformWorldScale() const {
+  for (auto component = this; component; component = component->GetParent()) {
+    if (!component->_relativeTransform.HasUniformScale()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 math::Transform SceneComponent::GetWorldTransform() const {
+  // A TRS product of the parent's world transform drops the shear a non-uniformly scaled parent gives a rotated child, decomposing
+  // the matrix keeps the transform in agreement with it
+  return _parent ? math::Transform(GetWorldMatrix()) : _relativeTransform;
+}
+
+glm::mat4 SceneComponent::GetWorldMatrix() const {
+  if(UsesTransformStore()) {
+    return _transformStore->GetWorld(_transformId);
+  }
+
   if(const auto parent = GetParent()) {
-    return GetRelativeTransform().RelativeTo(parent->GetWorldTransform());
+    return parent->GetWorldMatrix() * _relativeTransform.Matrix();
   }
 
-  return GetRelativeTransform();
-  //return GetRelativeTransform();
+  return _relativeTransform.Matrix();
 }
 
 void SceneComponent::SetRelativeLocation(const math::Vec3<> &val) {
@@ -62,15 +127,11 @@ void SceneComponent::SetWorldScale(const math::Vec3<> &val) {
 }
 
 void SceneComponent::SetWorldTransform(const math::Transform &val) {
-  // _relativeTransform = val;
-  if(GetParent()) {
-    const auto targetWorldMatrix = val.Matrix();
-    const auto thisWorldMatrix = GetWorldTransform().Matrix();
-
-    const auto thisToTarget = inverse(thisWorldMatrix) * targetWorldMatrix;
-    const auto thisToParent = GetRelativeTransform().Matrix();
-    
-    SetRelativeTransform(thisToTarget * inverse(thisToParent));
+  if(const auto parent = GetParent()) {
+    // Without shear in the parent the component math is exact and cheaper than going through the affine inverse
+    SetRelativeTransform(parent->HasUniformWorldScale()
+                           ? val.RelativeTo(parent->GetWorldTransform())
+                           : val.RelativeTo(parent->GetWorldMatrix()));
     return;
   }
 
@@ -91,13 +152,37 @@ math::Transform SceneComponent::GetRelativeTransform() const {
 
 void SceneComponent::SetRelativeTransform(const math::Transform &val) {
   _relativeTransform = val;
+  if(_transformStore) {
+    _transformStore->SetLocal(_transformId, _relativeTransform.Matrix());
+  }
+  OnTransformChanged();
+}
+
+void SceneComponent::OnTransformChanged() {
+  if(_transformStore) {
+    _transformStore->MarkDirty(_transformId);
+  }
+  
+  if (const auto owner = GetOwner()) {
+    owner->MarkBoundsDirty();
+  }
+
+  for (const auto &child : _children) {
+    if (const auto childRef = child.lock()) {
+      childRef->OnTransformChanged();
+    }
+  }
+}
+
+std::optional<math::Bounds> SceneComponent::GetLocalBounds() const {
+  return {};
 }
 
 void SceneComponent::SetRelativeTransform(
     const std::optional<math::Vec3<>> &location,
     const std::optional<math::Quat> &rotation,
     const std::optional<math::Vec3<>> &scale) {
-  auto existingTransform = GetWorldTransform();
+  auto existingTransform = GetRelativeTransform();
   SetRelativeTransform({location.value_or(existingTransform.location),rotation.value_or(existingTransform.rotation),scale.value_or(existingTransform.scale)});
   
 }
@@ -107,6 +192,18 @@ SceneComponent * SceneComponent::GetParent() const {
 }
 
 void SceneComponent::AttachTo(const std::weak_ptr<SceneComponent> &parent) {
+  const auto self = utils::castStatic<SceneComponent>(shared_from_this());
+  if (_parent) {
+    _parent->_children.Remove(self);
+  }
+  
   _parent = parent.lock().get();
+
+  if (_parent) {
+    _parent->_children.Add(self);
+  }
+
+  SyncTransformParent();
+  OnTransformChanged();
 }
 }
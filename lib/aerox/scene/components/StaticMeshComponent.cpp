@@ -18,6 +18,17 @@ void StaticMeshComponent::SetMesh(const std::shared_ptr<drawing::Mesh> &newMesh)
     }
   }
   _mesh = newMesh;
+  if (const auto owner = GetOwner()) {
+    owner->MarkBoundsDirty();
+  }
+}
+
+std::optional<math::Bounds> StaticMeshComponent::GetLocalBounds() const {
+  if (!_mesh) {
+    return {};
+  }
+
+  return _mesh->GetBounds();
 }
 
 void StaticMeshComponent::Draw(
@@ -26,12 +37,10 @@ void StaticMeshComponent::Draw(
   if (!_mesh || !_mesh->IsUploaded()) {
     return;
   }
-  const auto transform = GetWorldTransform();
-
   drawing::MeshVertexPushConstant pushConstants{};
 
   const auto meshGpuData = _mesh->GetGpuData().lock();
-  pushConstants.transformMatrix = transform.Matrix(); //glm::mat4{1.f};
+  pushConstants.transformMatrix = GetWorldMatrix();
   pushConstants.vertexBuffer = meshGpuData->vertexBufferAddress;
 
   const auto surfaces = _mesh->GetSurfaces();
@@ -51,9 +60,12 @@ void StaticMeshComponent::Draw(
     frameData->AddLit(
         [pushConstants,material,meshGpuData,count,startIndex](
         const drawing::SceneFrameData *frame) {
-          material->BindPipeline(frame->GetRaw());
-          material->BindSets(frame->GetRaw());
-          material->Push(frame->GetCmd(), "pVertex", pushConstants);
+          auto constants = pushConstants;
+          constants.material = material->GetBlockIndex();
+          constants.sceneGlobals = frame->GetSceneGlobals();
+          material->BindPipeline(frame);
+          material->BindSets(frame);
+          material->Push(frame->GetCmd(), "pVertex", constants);
 
           frame->GetCmd()->bindIndexBuffer(meshGpuData->indexBuffer->buffer, 0,
                                            vk::IndexType::eUint32);
@@ -13,6 +13,7 @@ std::shared_ptr<SceneComponent> DefaultCamera::CreateRootComponent() {
 
 void DefaultCamera::OnInit(Scene * scene) {
     SceneObject::OnInit(scene);
+  SetCanEverUpdate(true);
 
   const auto inputManager = GetInput().lock();
 
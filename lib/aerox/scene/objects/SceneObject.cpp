@@ -6,7 +6,6 @@
 
 namespace aerox::scene {
 
-
 std::shared_ptr<SceneComponent> SceneObject::CreateRootComponent() {
   return newObject<SceneComponent>();
 }
@@ -89,15 +88,54 @@ void SceneObject::SetWorldTransform(const math::Transform &val) {
   }
 }
 
+std::optional<math::Bounds> SceneObject::GetWorldBounds() const {
+  math::Bounds result;
+  for (const auto &component : _components) {
+    if (const auto sceneComponent = utils::cast<SceneComponent>(component)) {
+      if (const auto localBounds = sceneComponent->GetLocalBounds()) {
+        result = result.Union(localBounds->TransformBy(sceneComponent->GetWorldMatrix()));
+      } else if (utils::cast<RenderedComponent>(component)) {
+        return {};
+      }
+    }
+  }
+
+  if (!result.IsValid()) {
+    const auto location = GetWorldLocation();
+    return math::Bounds::FromPoint({location.x, location.y, location.z});
+  }
+
+  return result;
+}
+
+void SceneObject::MarkBoundsDirty() {
+  if (!IsInitialized() && !IsInitializing()) {
+    return;
+  }
+
+  if (const auto scene = GetScene()) {
+    scene->MarkSpatialDirty(this);
+  }
+}
+
 void SceneObject::OnInit(Scene *scene) {
   TOwnedBy::OnInit(scene);
   _rootComponent = CreateRootComponent();
+  // Listed before anything initializes so components can find the root from their OnInit, a rigid body root must be visible to the
+  // collision components that attach to it
+  _components.emplace_front(_rootComponent);
+  ClearComponentLookup();
   InitComponent(_rootComponent);
   AttachComponentsToRoot(_rootComponent);
-  for (const auto &component : _components) {
-    InitComponent(component);
+  for (auto it = std::next(_components.begin()); it != _components.end(); ++it) {
+    InitComponent(*it);
   }
-  _components.emplace_back(_rootComponent);
+}
+
+void SceneObject::ClearComponentLookup() {
+  // A new component can take the place of a cached miss, or of any entry when it is the root going in front
+  std::lock_guard lock(_componentLookupMutex);
+  _componentLookup.clear();
 }
 
 Engine *SceneObject::GetEngine() const {
@@ -116,6 +154,61 @@ void SceneObject::Tick(float deltaTime) {
 
 }
 
+void SceneObject::UpdateTickRegistration() {
+  if (!IsInitialized()) {
+    // The scene registers the object once it is initialized
+    return;
+  }
+
+  auto &scheduler = GetScene()->GetTickScheduler();
+  scheduler.Unregister(this);
+  if (_canEverUpdate) {
+    scheduler.Register(this);
+  }
+}
+
+void SceneObject::SetCanEverUpdate(const bool canEverUpdate) {
+  _canEverUpdate = canEverUpdate;
+  UpdateTickRegistration();
+}
+
+bool SceneObject::CanEverUpdate() const {
+  return _canEverUpdate;
+}
+
+void SceneObject::SetTickGroup(const ETickGroup group) {
+  _tickGroup = group;
+  UpdateTickRegistration();
+}
+
+ETickGroup SceneObject::GetTickGroup() const {
+  return _tickGroup;
+}
+
+void SceneObject::SetTickThreadSafe(const bool threadSafe) {
+  _bTickThreadSafe = threadSafe;
+  UpdateTickRegistration();
+}
+
+bool SceneObject::IsTickThreadSafe() const {
+  return _bTickThreadSafe;
+}
+
+void SceneObject::AddTickPrerequisite(const std::weak_ptr<SceneObject> &prerequisite) {
+  _tickPrerequisites.push_back(prerequisite);
+  if (IsInitialized()) {
+    GetScene()->GetTickScheduler().MarkDirty(this);
+  }
+}
+
+bool SceneObject::IsPendingRemoval() const {
+  return IsPendingDestroy() || _bPendingRemoval.load(std::memory_order_acquire);
+}
+
+const std::vector<std::weak_ptr<SceneObject>> &SceneObject::GetTickPrerequisites() const {
+  return _tickPrerequisites;
+}
+
 void SceneObject::AddToRenderList(const std::weak_ptr<RenderedComponent> &comp) {
   _renderedComponents.push_back(comp);
 }
@@ -136,22 +229,21 @@ void SceneObject::RemoveFromRenderList(const std::weak_ptr<RenderedComponent> &c
 
 void SceneObject::InitComponent(const std::shared_ptr<Component> &comp) {
   if (comp) {
+    // Components register themselves with the render list and scene in their own OnInit
     comp->Init(this);
-
-    if (const auto asRendered = utils::cast<RenderedComponent>(comp)) {
-      AddToRenderList(asRendered);
-    }
-    if (const auto asLight = utils::cast<LightComponent>(comp)) {
-      GetScene()->RegisterLight(asLight);
-    }
   }
 }
 
 void SceneObject::OnDestroy() {
   Object::OnDestroy();
+  if (const auto scene = GetScene()) {
+    scene->RemoveFromSpatialIndex(this);
+    scene->GetTickScheduler().Unregister(this);
+  }
   _renderedComponents.clear();
 
   _components.clear();
+  ClearComponentLookup();
 
   _rootComponent.reset();
 }
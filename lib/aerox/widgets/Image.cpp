@@ -11,21 +11,16 @@ namespace aerox::widgets {
 
 void Image::OnInit(WidgetSubsystem * ref) {
   GeometryWidget::OnInit(ref);
-  const auto drawer = Engine::Get()->GetDrawingSubsystem().lock();
 
   _imageMat = GetOwner()->CreateMaterialInstance(
   {drawing::Shader::FromSource(io::getRawShaderPath("2d/rect.vert")),
-   drawing::Shader::FromSource(io::getRawShaderPath("2d/image.frag"))});
-  _options = drawer->GetAllocator().lock()->CreateUniformCpuGpuBuffer<ImageGpuData>(false,"Image " + GetObjectInstanceId() + " options buffer");
-  _imageMat->SetBuffer("options",_options);
+   drawing::Shader::FromSource(io::getRawShaderPath("2d/image.frag"))},
+  {"Tint", "Texture"});
   UpdateOptionsBuffer();
 }
 
 void Image::SetTexture(const std::shared_ptr<drawing::Texture> &image) {
   _image = image;
-  if (_imageMat) {
-    _imageMat->SetTexture("ImageT", _image);
-  }
   UpdateOptionsBuffer();
   InvalidateCachedSize();
 }
@@ -42,19 +37,20 @@ void Image::Draw(WidgetFrameData *frameData,
     return;
   }
 
-  auto material = _imageMat;
-  const auto ogFrameData = frameData->GetRaw();
   WidgetPushConstants drawData{};
 
   drawData.clip = info.clip;
   drawData.extent = GetDrawRect();
+  drawData.material = _imageMat->GetBlockIndex();
+
+  frameData->AddDraw([material = _imageMat, drawData](const WidgetFrameData *frame) mutable {
+    bindMaterial(frame, material);
+    drawData.globals = frame->GetGlobals().address;
 
-  
-  bindMaterial(frameData, material);
-  
-  material->Push(frameData->GetCmd(), "pRect", drawData);
+    material->Push(frame->GetCmd(), "pRect", drawData);
 
-  frameData->DrawQuad();
+    frame->DrawQuad();
+  });
 }
 
 void Image::OnDestroy() {
@@ -63,8 +59,16 @@ void Image::OnDestroy() {
 }
 
 void Image::UpdateOptionsBuffer() {
-  const ImageGpuData imageData{_tint,static_cast<bool>(_image)};
-  _options->Write(imageData);
+  if (!_imageMat) {
+    return;
+  }
+
+  _imageMat->SetParam("Tint", static_cast<glm::vec4>(_tint));
+  if (_image) {
+    _imageMat->SetParam("Texture", _image);
+  } else {
+    _imageMat->SetParam("Texture", glm::vec4{0.0f});
+  }
 }
 
 void Image::SetTint(const Color &tint) {
@@ -42,12 +42,7 @@ void Text::OnInit(WidgetSubsystem *ref) {
   _material = GetOwner()->CreateMaterialInstance({
       drawing::Shader::FromSource(io::getRawShaderPath("2d/font.vert")),
       drawing::Shader::FromSource(io::getRawShaderPath("2d/font.frag"))
-  });
-
-  _gpuInfo = GetOwner()->GetOwner()->GetDrawingSubsystem().lock()->
-                         GetAllocator().lock()->CreateUniformCpuGpuBuffer<
-                           GpuTextOptions>(true);
-  _material->SetBuffer("options", _gpuInfo);
+  }, {"Color"});
 
   UpdateOptionsBuffer();
 }
@@ -93,14 +88,15 @@ void Text::Draw(WidgetFrameData *frameData, DrawInfo info) {
     return;
   }
 
-  bindMaterial(frameData, _material);
-
-  _material->SetTextureArray("AtlasT", _font->GetTextures());
-  _material->SetBuffer("FontChars", _font->GetPackedGlyphs().lock());
+  Array<drawing::FontPushConstants> glyphs;
 
   const auto startPosition = GetDrawRect().GetPoint();
   float xOffset = 0.0f;
 
+  // Glyph table and the material's params are read from the material buffer
+  const auto glyphsIndex = static_cast<float>(_font->GetGlyphsIndex());
+  const auto optionsIndex = static_cast<float>(_material->GetBlockIndex());
+
   auto baseline = startPosition.y + (_font->GetAscender() * _fontSize);
   std::string toDraw = _content;
   for (auto i = 0; i < toDraw.size(); i++) {
@@ -125,15 +121,26 @@ void Text::Draw(WidgetFrameData *frameData, DrawInfo info) {
     fontData.info.x = static_cast<float>(_font->GetGlyphIndex(toDraw.at(i)).
                                                 value());
     fontData.info.y = _fontSize;
+    fontData.info.z = glyphsIndex;
+    fontData.info.w = optionsIndex;
 
-    _material->Push(frameData->GetCmd(), "pFont", fontData);
-
-    frameData->DrawQuad();
+    glyphs.push(fontData);
 
     xOffset += scaledGlyph.hAdvance;
 
     //break;
   }
+
+  frameData->AddDraw([material = _material, font = _font, glyphs = std::move(glyphs)](const WidgetFrameData *frame) mutable {
+    bindMaterial(frame, material);
+
+    for (auto fontData : glyphs) {
+      fontData.globals = frame->GetGlobals().address;
+      material->Push(frame->GetCmd(), "pFont", fontData);
+
+      frame->DrawQuad();
+    }
+  });
 }
 
 void Text::SetColor(const Color &color) {
@@ -144,10 +151,14 @@ void Text::SetColor(const Color &color) {
 void Text::OnDestroy() {
   Widget::OnDestroy();
   _font.reset();
+  _material.reset();
 }
 
 void Text::UpdateOptionsBuffer() {
-  GpuTextOptions opts{_color};
-  _gpuInfo->Write(opts);
+  if (!_material) {
+    return;
+  }
+
+  _material->SetParam("Color", static_cast<glm::vec4>(_color));
 }
 }
@@ -1,6 +1,7 @@
 #include "aerox/widgets/Viewport.hpp"
 
 #include "aerox/Engine.hpp"
+#include "aerox/drawing/Texture.hpp"
 #include "aerox/drawing/WindowDrawer.hpp"
 #include "aerox/drawing/scene/SceneDrawer.hpp"
 #include "aerox/io/io.hpp"
@@ -11,22 +12,17 @@ namespace aerox::widgets {
 void Viewport::OnInit(WidgetSubsystem *ref) {
   Canvas::OnInit(ref);
 
-  constexpr auto samplerInfo = vk::SamplerCreateInfo().
-                               setMinFilter(vk::Filter::eLinear).setMagFilter(
-                                   vk::Filter::eLinear);
-  auto drawer = Engine::Get()->GetDrawingSubsystem().lock();
-  _sampler = drawer->GetVirtualDevice().createSampler(samplerInfo);
   _shader = GetOwner()->CreateMaterialInstance(
       {drawing::Shader::FromSource(io::getRawShaderPath("2d/rect.vert")),
-       drawing::Shader::FromSource(io::getRawShaderPath("2d/viewport.frag"))}
-      );
+       drawing::Shader::FromSource(io::getRawShaderPath("2d/viewport.frag"))},
+      {"Texture"});
 
   _scene = Engine::Get()->GetScenes().at(0);
   
   if (const auto scene = _scene.lock()) {
-    _shader->SetImage("TViewport",
-                      scene->GetDrawer().lock()->GetRenderTarget().lock(),
-                      _sampler);
+    _texture = drawing::Texture::FromAllocated(scene->GetDrawer().lock()->GetRenderTarget().lock(), vk::Filter::eLinear,
+                                               vk::SamplerAddressMode::eClampToEdge);
+    _shader->SetParam("Texture", _texture);
   }
 }
 
@@ -41,29 +37,31 @@ void Viewport::OnPaint(WidgetFrameData *frameData, const Rect &clip) {
   WidgetPushConstants drawData{};
   drawData.clip = clip;
   drawData.extent = rect;
+  drawData.material = _shader->GetBlockIndex();
   //drawData.transform = glm::rotate(glm::mat4{1.0f},45.0f,glm::vec3{0.0f,0.0,1.0f});
 
-  bindMaterial(frameData, _shader);
+  frameData->AddDraw([shader = _shader, drawData](const WidgetFrameData *frame) mutable {
+    bindMaterial(frame, shader);
+    drawData.globals = frame->GetGlobals().address;
 
-  _shader->Push(frameData->GetCmd(), "pRect", drawData);
+    shader->Push(frame->GetCmd(), "pRect", drawData);
 
-  frameData->DrawQuad();
+    frame->DrawQuad();
+  });
 }
 
 void Viewport::OnDestroy() {
   Canvas::OnDestroy();
   _shader.reset();
-  Engine::Get()->GetDrawingSubsystem().lock()->GetVirtualDevice().
-                 destroySampler(_sampler);
+  _texture.reset();
 }
 
 void Viewport::OnAddedToScreen() {
   Canvas::OnAddedToScreen();
   _rootResizeHandle = GetRoot().lock()->GetWindowDrawer().lock()->onResizeUi->BindFunction([this] {
-    if (const auto scene = Engine::Get()->GetScenes().at(0).lock()) {
-      _shader->SetImage("TViewport",
-                        scene->GetDrawer().lock()->GetRenderTarget().lock(),
-                        _sampler);
+    // The texture moves to a new bindless index, the material's param follows it
+    if (const auto scene = Engine::Get()->GetScenes().at(0).lock(); scene && _texture) {
+      _texture->SetGpuData(scene->GetDrawer().lock()->GetRenderTarget().lock());
     }
   });
 }
@@ -3,15 +3,12 @@
 #include "aerox/drawing/WindowDrawer.hpp"
 #include "aerox/widgets/Widget.hpp"
 #include "aerox/drawing/DrawingSubsystem.hpp"
+#include "aerox/drawing/barriers.hpp"
 
 #include <glm/ext/matrix_clip_space.hpp>
 
 namespace aerox::widgets {
 
-std::weak_ptr<drawing::AllocatedBuffer> WidgetRoot::GetGlobalBuffer() const {
-  return _uiGlobalBuffer;
-}
-
 void WidgetRoot::OnInit(WidgetSubsystem *subsystem,
                         const std::weak_ptr<window::Window> &window) {
   TOwnedBy::OnInit(
@@ -27,16 +24,14 @@ void WidgetRoot::OnInit(WidgetSubsystem *subsystem,
   if (const auto windowDrawer = drawer->GetWindowDrawer(_window).lock()) {
     _windowDrawer = windowDrawer;
 
-    AddCleanup(windowDrawer->onDrawUi->BindFunction(
-        [this](drawing::RawFrameData *rawFrame) {
-          Draw(rawFrame);
+    AddCleanup(windowDrawer->onCollectUi->BindFunction(
+        [this](drawing::WindowSnapshot *snapshot) {
+          snapshot->ui.push(Collect());
+          snapshot->output = _drawImage;
         }));
 
     _size = _window.lock()->GetPixelSize(); //engine->GetMainWindowSize();
 
-    _uiGlobalBuffer = drawer->GetAllocator().lock()->CreateUniformCpuGpuBuffer(
-        sizeof(UiGlobalBuffer), false);
-
     CreateDrawImage();
 
     AddCleanup(windowRef->onMouseDown->BindFunction([this](
@@ -96,12 +91,42 @@ void WidgetRoot::OnInit(WidgetSubsystem *subsystem,
   }
 }
 
-void WidgetRoot::Draw(drawing::RawFrameData *frame) {
-  if (!_widgets.empty()) {
-    drawing::DrawingSubsystem::TransitionImage(*frame->GetCmd(),
-                                               _drawImage->image,
-                                               vk::ImageLayout::eUndefined,
-                                               vk::ImageLayout::eColorAttachmentOptimal);
+drawing::recordFn WidgetRoot::Collect() {
+  auto collected = std::make_shared<WidgetFrameData>(nullptr, this);
+  const auto bHasWidgets = !_widgets.empty();
+
+  if (bHasWidgets) {
+    const Size2D size = {static_cast<float>(_size.width),
+                         static_cast<float>(_size.height)};
+
+    DrawInfo myInfo;
+    myInfo.parent = nullptr;
+    myInfo.clip.SetSize(size);
+
+    // Layout happens here on the game thread, widgets add draws that copy what they need
+    for (auto &widget : _widgets.clone()) {
+      if (widget) {
+        widget->UpdateDrawRect(Rect().SetSize(size));
+        widget->Draw(collected.get(), myInfo);
+      }
+    }
+  }
+
+  UiGlobalBuffer uiGb;
+  uiGb.viewport = glm::vec4{0, 0, _size.width, _size.height};
+  uiGb.time.x = Engine::Get()->GetEngineTimeSeconds();
+
+  return [self = utils::castStatic<WidgetRoot>(shared_from_this()), collected, uiGb, bHasWidgets](drawing::RawFrameData *frame) {
+    self->Record(frame, *collected, uiGb, bHasWidgets);
+  };
+}
+
+void WidgetRoot::Record(drawing::RawFrameData *frame, const WidgetFrameData &collected, const UiGlobalBuffer &uiGb, const bool bHasWidgets) {
+  if (bHasWidgets) {
+    // The window copied the last frame out of the image, the copy has to finish before it is cleared
+    drawing::ImageBarriers()
+        .Discard(_drawImage->image, drawing::EImageUsage::TransferSrc, drawing::EImageUsage::ColorAttachmentWrite)
+        .Record(*frame->GetCmd());
     const vk::Extent2D drawExtent = frame->GetWindowDrawer()->
                                            GetSwapchainExtent();
     vk::ClearValue colorClear;
@@ -120,39 +145,21 @@ void WidgetRoot::Draw(drawing::RawFrameData *frame) {
 
     cmd->beginRendering(renderingInfo);
 
-    UiGlobalBuffer uiGb;
-    uiGb.viewport = glm::vec4{0, 0, _size.width, _size.height};
-    uiGb.time.x = Engine::Get()->GetEngineTimeSeconds();
-
-    _uiGlobalBuffer->Write(uiGb);
+    // One buffer shared across frames would be rewritten while the previous frame still reads it
+    const WidgetFrameData wFrameData(frame, this, frame->GetUploads()->Upload(uiGb));
 
-    const Size2D size = {static_cast<float>(_size.width),
-                         static_cast<float>(_size.height)};
-
-    DrawInfo myInfo;
-    myInfo.parent = nullptr;
-    myInfo.clip.SetSize(size);
-
-    WidgetFrameData wFrameData(frame, this);
-
-    for (auto &widget : _widgets.clone()) {
-      if (widget) {
-        widget->UpdateDrawRect(Rect().SetSize(size));
-        widget->Draw(&wFrameData, myInfo);
-      }
+    for (const auto &draw : collected.draws) {
+      draw(&wFrameData);
     }
 
     cmd->endRendering();
-    drawing::DrawingSubsystem::TransitionImage(*frame->GetCmd(),
-                                               _drawImage->image,
-                                               vk::ImageLayout::eColorAttachmentOptimal,
-                                               vk::ImageLayout::eTransferSrcOptimal);
+    drawing::transitionImage(*frame->GetCmd(), _drawImage->image, drawing::EImageUsage::ColorAttachmentWrite,
+                             drawing::EImageUsage::TransferSrc);
 
   } else {
-    drawing::DrawingSubsystem::TransitionImage(*frame->GetCmd(),
-                                               _drawImage->image,
-                                               vk::ImageLayout::eUndefined,
-                                               vk::ImageLayout::eTransferSrcOptimal);
+    drawing::ImageBarriers()
+        .Discard(_drawImage->image, drawing::EImageUsage::TransferSrc, drawing::EImageUsage::TransferSrc)
+        .Record(*frame->GetCmd());
 
   }
 }
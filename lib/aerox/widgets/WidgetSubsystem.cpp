@@ -28,6 +28,7 @@ void WidgetSubsystem::OnInit(Engine *outer) {
 }
 
 void WidgetSubsystem::OnDestroy() {
+  Engine::Get()->GetDrawingSubsystem().lock()->WaitForRenderThread();
   Engine::Get()->GetDrawingSubsystem().lock()->WaitDeviceIdle();
   _roots.clear();
 
@@ -38,13 +39,19 @@ String WidgetSubsystem::GetName() const {
   return "widgets";
 }
 
-void WidgetSubsystem::Draw(
-    drawing::RawFrameData *frameData) {
+drawing::recordFn WidgetSubsystem::Collect() {
+  Array<drawing::recordFn> records;
   for (auto &val : _rootsArr) {
     if (const auto reserved = _roots[val]) {
-      reserved->Draw(frameData);
+      records.push(reserved->Collect());
     }
   }
+
+  return [records](drawing::RawFrameData *frameData) {
+    for (const auto &record : records) {
+      record(frameData);
+    }
+  };
 }
 
 void WidgetSubsystem::InitWidget(const std::shared_ptr<Widget> &widget) const {
@@ -82,12 +89,16 @@ void WidgetSubsystem::DestroyRoot(const std::weak_ptr<window::Window> &window) {
 }
 
 std::shared_ptr<drawing::MaterialInstance> WidgetSubsystem::CreateMaterialInstance(
-    const Array<std::shared_ptr<drawing::Shader>> &shaders) {
-  return drawing::MaterialBuilder().AddShaders(shaders).
-                                    SetType(drawing::EMaterialType::UI).
-                                    AddAttachmentFormats(
-                                        {vk::Format::eR16G16B16A16Sfloat}).
-                                    Create();
+    const Array<std::shared_ptr<drawing::Shader>> &shaders, const Array<std::string> &params) {
+  drawing::MaterialBuilder builder;
+  builder.AddShaders(shaders).
+          SetType(drawing::EMaterialType::UI).
+          AddAttachmentFormats(
+              {vk::Format::eR16G16B16A16Sfloat});
+  for (const auto &param : params) {
+    builder.AddParam(param);
+  }
+  return builder.Create();
 }
 
 void WidgetSubsystem::Tick(float deltaTime) {
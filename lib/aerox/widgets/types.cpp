@@ -2,14 +2,23 @@
 
 namespace aerox::widgets {
 
-WidgetFrameData::WidgetFrameData(drawing::RawFrameData *frame, WidgetRoot *root) : SimpleFrameData(frame) {
+WidgetFrameData::WidgetFrameData(drawing::RawFrameData *frame, WidgetRoot *root, const drawing::FrameUpload &globals) : SimpleFrameData(frame) {
   _root = root;
+  _globals = globals;
 }
 
 WidgetRoot * WidgetFrameData::GetRoot() const {
   return _root;
 }
 
+const drawing::FrameUpload &WidgetFrameData::GetGlobals() const {
+  return _globals;
+}
+
+void WidgetFrameData::AddDraw(const widgetDrawFn &drawFn) {
+  draws.push(drawFn);
+}
+
 Point2D::Point2D() {
   x = 0;
   y = 0;
@@ -1,6 +1,8 @@
 #version 450
 
 #extension GL_GOOGLE_include_directive : require
+#extension GL_EXT_nonuniform_qualifier : require
+#extension GL_EXT_buffer_reference : require
 #include "font.glsl"
 
 layout (location = 0) in vec2 iUV;
@@ -10,19 +12,17 @@ float median(float r, float g, float b) {
     return max(min(r, g), min(max(r, g), b));
 }
 
-layout(set = 1, binding = 2) uniform options{   
-	vec4 color;
-} opts;
-
 void main() 
 {
     vec4 bgColor = vec4(0.0);
-    vec4 fgColor = opts.color;
+    // Text color and the font's glyph table live in the material buffer
+    vec4 fgColor = materials.data[int(pFont.info.w)];
 
-    FontChar char = font.chars[int(pFont.info.x)];
+    FontChar char = FontChar(materials.data[int(pFont.info.z) + int(pFont.info.x)]);
+    // Bindless index of the glyph's atlas
     int atlasIdx = int(char.info.x);
-    vec3 msdf = texture(AtlasT[atlasIdx],iUV).rgb;
-    ivec2 sz = textureSize(AtlasT[atlasIdx], 0).xy;
+    vec3 msdf = texture(Textures[atlasIdx],iUV).rgb;
+    ivec2 sz = textureSize(Textures[atlasIdx], 0).xy;
     float dx = dFdx(iUV.x) * sz.x; 
     float dy = dFdy(iUV.y) * sz.y;
     float toPixels = 12.0 * inversesqrt(dx * dx + dy * dy);
@@ -6,15 +6,13 @@ struct FontChar {
 	vec4 info;
 };
 
-layout(set = 1, binding = 0) uniform sampler2D AtlasT[256];
-layout(set = 1, binding = 1) uniform  FontChars{   
-	FontChar chars[256];
-    int numChars;
-} font;
+#include "ui.glsl"
+#include "../bindless.glsl"
 
 
 layout( push_constant ) uniform constants
 {
     vec4 extent;
 	vec4 info;
+    UiGlobalBuffer globals;
 } pFont;
\ No newline at end of file
@@ -1,8 +1,8 @@
 #version 450
 #extension GL_GOOGLE_include_directive : require
+#extension GL_EXT_nonuniform_qualifier : require
 #extension GL_EXT_buffer_reference : require
 
-#include "./ui.glsl"
 #include "./font.glsl"
 
 layout(location = 0) out vec2 oUV;
@@ -10,6 +10,8 @@ layout(location = 0) out vec2 oUV;
 
 void main() 
 {
+    ui = pFont.globals;
+
     vec2 screenRes = ui.viewport.zw;
     
 	// Transform vertices based on input extent
@@ -2,31 +2,34 @@
 
 #extension GL_GOOGLE_include_directive : require
 #extension GL_EXT_buffer_reference : require
+#extension GL_EXT_nonuniform_qualifier : require
 
 #include "ui.glsl"
 #include "rect.glsl"
+#include "../bindless.glsl"
 
-layout(set = 1, binding = 0) uniform sampler2D ImageT;
 layout (location = 0) in vec2 iUV;
 layout (location = 0) out vec4 oColor;
 
-layout(set = 1, binding = 1) uniform options{   
-	vec4 tint; // the image tint
-	int bHasTexture; // check if we have a texture
-    float borderRadius;
-} opts;
+// Params of the image material, Tint then Texture
+#define TINT 0
+#define TEXTURE 1
 
 void main() {
+    ui = pRect.globals;
+
     if(shouldDiscard(ui.viewport,pRect.clip,gl_FragCoord.xy)){
         discard;
     }
 
     vec4 pxColor = vec4(1.0);
 
-    if(opts.bHasTexture == 1){
-        pxColor = texture(ImageT,iUV);
+    // x is the bindless index, y is 1 when a texture is set
+    vec4 image = materials.data[pRect.material + TEXTURE];
+    if(image.y > 0.0){
+        pxColor = texture(Textures[int(image.x)],iUV);
     }
 
 	//vec2 uv = vec2(mapRangeUnClamped(iUV.x,0.0,1.0,0.5,1.0),mapRangeUnClamped(iUV.y,0.0,1.0,0.5,1.0));
-	oColor = opts.tint * pxColor;
+	oColor = materials.data[pRect.material + TINT] * pxColor;
 }
\ No newline at end of file
@@ -26,6 +26,8 @@ vec3 palette( float t ) {
 
 //https://www.shadertoy.com/view/mtyGWy
 void main() {
+    ui = pRect.globals;
+
 
     if(shouldDiscard(ui.viewport,pRect.clip,gl_FragCoord.xy)){
         discard;
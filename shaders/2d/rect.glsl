@@ -6,4 +6,7 @@ layout( push_constant ) uniform constants
     vec4 clip;
 	vec4 extent;
     mat4 transform;
+    // First slot of the material's params in materials.data
+    uint material;
+    UiGlobalBuffer globals;
 } pRect;
@@ -13,6 +13,8 @@ layout(location = 0) out vec2 oUV;
 
 void main() 
 {
+    ui = pRect.globals;
+
     vec2 screenRes = ui.viewport.zw;
     vec4 extent = pRect.extent;
     vec2 normPt1 = normalizePoint(ui.viewport,extent.xy);
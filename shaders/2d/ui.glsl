@@ -2,10 +2,13 @@
 // layout(location = 1) in vec3 iColor;
 // layout(location = 2) in vec3 iNormal;
 // layout(location = 3) in vec2 iUV;
-layout(set = 0, binding = 0) uniform  UiGlobalBuffer{   
+// Uploaded once per frame, draws push its address and assign it to ui at the start of main
+layout(buffer_reference, std430) readonly buffer UiGlobalBuffer{
 	vec4 viewport;
 	vec4 time;
-} ui;
+};
+
+UiGlobalBuffer ui;
 
 float mapRangeUnClamped(float value, float fromMin, float fromMax, float toMin, float toMax) {
 
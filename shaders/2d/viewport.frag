@@ -2,19 +2,23 @@
 
 #extension GL_GOOGLE_include_directive : require
 #extension GL_EXT_buffer_reference : require
+#extension GL_EXT_nonuniform_qualifier : require
 
 #include "ui.glsl"
 #include "rect.glsl"
+#include "../bindless.glsl"
 
-layout(set = 1, binding = 0) uniform sampler2D TViewport;
 layout (location = 0) in vec2 iUV;
 layout (location = 0) out vec4 oColor;
 
 
 void main() {
+    ui = pRect.globals;
+
     if(shouldDiscard(ui.viewport,pRect.clip,gl_FragCoord.xy)){
         discard;
     }
 	//vec2 uv = vec2(mapRangeUnClamped(iUV.x,0.0,1.0,0.5,1.0),mapRangeUnClamped(iUV.y,0.0,1.0,0.5,1.0));
-	oColor = vec4(texture(TViewport,iUV).xyz,1.0);
+	// The scene's render target, its bindless index is the material's only param
+	oColor = vec4(texture(Textures[int(materials.data[pRect.material].x)],iUV).xyz,1.0);
 }
\ No newline at end of file
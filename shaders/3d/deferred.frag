@@ -1,17 +1,17 @@
 #version 450
 
 #extension GL_GOOGLE_include_directive : require
+#extension GL_EXT_buffer_reference : require
 #define RECIPROCAL_PI 0.3183098861837907
 #define RECIPROCAL_2PI 0.15915494309189535
 
 #include "scene.glsl"
+#include "gbuffer.glsl"
 
-layout(set = 1,binding = 0) uniform sampler2D TColor;
-layout(set = 1,binding = 1) uniform sampler2D TLocation;
-layout(set = 1,binding = 2) uniform sampler2D TNormal;
-layout(set = 1,binding = 3) uniform sampler2D TRoughMetallic;
-layout(set = 1,binding = 4) uniform sampler2D TSpecular;
-layout(set = 1,binding = 5) uniform sampler2D TEmissive;
+layout( push_constant ) uniform constants
+{
+  SceneGlobalBuffer scene;
+} pScene;
 
 layout(location = 0) in vec2 iUV;
 layout(location = 0) out vec4 oColor;
@@ -54,6 +54,14 @@ vec3 calcLightRadiance(vec3 sceneLocation,vec3 color,Light light,float NoV, vec3
   vec3 lightDirection = sceneLocation - light.location.xyz;//mix(iSceneLocation - light.location.xyz,light.direction.xyz,light.direction.w);
   vec3 lightDir = normalize(-lightDirection);
   float irradiPerp = light.color.w;
+  float radius = light.location.w;
+  if(radius > 0.0){
+    // Inverse square falloff, windowed so the light reaches zero at its radius
+    float distanceSquared = dot(lightDirection,lightDirection);
+    float distanceRatio = sqrt(distanceSquared) / radius;
+    float window = clamp(1.0 - pow(distanceRatio,4.0),0.0,1.0);
+    irradiPerp *= window * window / (distanceSquared + 1.0);
+  }
   float irradiance = max(dot(lightDir, normal), 0.0) * irradiPerp;
 
   if(irradiance > 0.0){
@@ -87,24 +95,53 @@ vec3 calcLightRadiance(vec3 sceneLocation,vec3 color,Light light,float NoV, vec3
   return vec3(0.0);
 }
 
+uint getClusterIndex(vec3 sceneLocation){
+  vec3 viewLocation = (scene.viewMatrix * vec4(sceneLocation,1.0)).xyz;
+  float depth = max(dot(viewLocation,scene.clusterForward.xyz),scene.clusterDepth.x);
+  uint slice = uint(clamp(log(depth) * scene.clusterDepth.z + scene.clusterDepth.w,0.0,float(scene.clusterGrid.z - 1)));
+  uvec2 tile = min(uvec2(iUV * vec2(scene.clusterGrid.xy)),scene.clusterGrid.xy - 1);
+  return tile.x + tile.y * scene.clusterGrid.x + slice * scene.clusterGrid.x * scene.clusterGrid.y;
+}
+
 // Brffd Microfacet
 void main(){
+    scene = pScene.scene;
+
+    float depth = texture(TDepth,iUV).r;
+    // Nothing was drawn here
+    if(depth >= 1.0){
+      oColor = vec4(0.0);
+      return;
+    }
 
-    vec3 sceneLocation = texture(TLocation,iUV).xyz;
-    vec3 color = texture(TColor,iUV).xyz;
-    vec3 normal = texture(TNormal,iUV).xyz;
-    vec2 roughMetalic = texture(TRoughMetallic,iUV).xy;
-    vec3 specular = texture(TSpecular,iUV).xyz;
-    vec3 emissive = texture(TEmissive,iUV).xyz;
+    vec3 sceneLocation = reconstructLocation(iUV,depth,scene.inverseViewProjection);
+    vec3 color = texture(TAlbedo,iUV).xyz;
+    vec3 normal = decodeNormal(texture(TNormal,iUV).xy);
+    GBufferMaterial material = decodeMaterial(texture(TMaterial,iUV));
+    vec2 roughMetalic = vec2(material.roughness,material.metallic);
+    vec3 emissive = color * material.emissive;
     
     vec3 viewDir = normalize(scene.cameraLocation.xyz - sceneLocation);
     float NoV = clamp(dot(normal,viewDir),0.0,1.0);
     vec3 radiance = emissive;
-    int numLights = int(scene.numLights.x);
+    uint numClusters = scene.clusterGrid.x * scene.clusterGrid.y * scene.clusterGrid.z;
+    
+    // Lights without a radius are in the list after the last cluster
+    uint globalOffset = scene.clusters.data[numClusters * 2];
+    uint numGlobal = scene.clusters.data[numClusters * 2 + 1];
+    for(uint i = 0; i < numGlobal; ++i)
+    {
+        Light light = scene.lightBuffer.lights[scene.clusters.data[globalOffset + i]];
+        radiance += calcLightRadiance(sceneLocation,color,light,NoV,normal,viewDir,roughMetalic.r,roughMetalic.g);
+    }
 
-    for(int i=0; i < numLights; ++i)
+    uint cluster = getClusterIndex(sceneLocation);
+    uint clusterOffset = scene.clusters.data[cluster * 2];
+    uint numClusterLights = scene.clusters.data[cluster * 2 + 1];
+    for(uint i = 0; i < numClusterLights; ++i)
     {
-        radiance += calcLightRadiance(sceneLocation,color,scene.lights[i],NoV,normal,viewDir,roughMetalic.r,roughMetalic.g);
+        Light light = scene.lightBuffer.lights[scene.clusters.data[clusterOffset + i]];
+        radiance += calcLightRadiance(sceneLocation,color,light,NoV,normal,viewDir,roughMetalic.r,roughMetalic.g);
     }
 
     oColor = vec4(radiance,1.0);
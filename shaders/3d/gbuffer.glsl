@@ -0,0 +1,40 @@
+// Formats, outputs and samplers come from the layout the engine generates, define GBUFFER_OUTPUTS before including to write the G-buffer
+#include "gbuffer_layout.glsl"
+
+vec2 octWrap(vec2 v){
+  return (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0,v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+// Unit vector to [-1,1] on the octahedron folded onto a square
+vec2 encodeNormal(vec3 n){
+  n /= abs(n.x) + abs(n.y) + abs(n.z);
+  return n.z >= 0.0 ? n.xy : octWrap(n.xy);
+}
+
+vec3 decodeNormal(vec2 e){
+  vec3 n = vec3(e,1.0 - abs(e.x) - abs(e.y));
+  float t = clamp(-n.z,0.0,1.0);
+  n.xy += vec2(n.x >= 0.0 ? -t : t,n.y >= 0.0 ? -t : t);
+  return normalize(n);
+}
+
+struct GBufferMaterial {
+  float roughness;
+  float metallic;
+  float specular;
+  float emissive;
+};
+
+vec4 encodeMaterial(float roughness,float metallic,float specular,float emissive){
+  return vec4(roughness,metallic,specular,clamp(emissive / GBUFFER_EMISSIVE_RANGE,0.0,1.0));
+}
+
+GBufferMaterial decodeMaterial(vec4 e){
+  return GBufferMaterial(e.r,e.g,e.b,e.a * GBUFFER_EMISSIVE_RANGE);
+}
+
+// World location of a pixel from its depth
+vec3 reconstructLocation(vec2 uv,float depth,mat4 inverseViewProjection){
+  vec4 location = inverseViewProjection * vec4(uv * 2.0 - 1.0,depth,1.0);
+  return location.xyz / location.w;
+}
@@ -0,0 +1,21 @@
+// Shared by every mesh stage, include scene.glsl first
+
+struct Vertex {
+	vec4 location;
+	vec4 normal;
+	vec4 uv;
+}; 
+
+layout(buffer_reference, std430) readonly buffer VertexBuffer{ 
+	Vertex vertices[];
+};
+
+//push constants block
+layout( push_constant ) uniform constants
+{
+	mat4 transformMatrix;
+	// First slot of the material's params in materials.data
+	uint material;
+	VertexBuffer vertexBuffer;
+	SceneGlobalBuffer scene;
+} pVertex;
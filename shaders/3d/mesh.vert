@@ -3,30 +3,16 @@
 #extension GL_EXT_buffer_reference : require
 
 #include "./scene.glsl"
+#include "./mesh.glsl"
 
 layout (location = 0) out vec3 oSceneNormal;
 layout (location = 1) out vec2 oUV;
 layout (location = 2) out vec3 oSceneLocation;
 
-struct Vertex {
-	vec4 location;
-	vec4 normal;
-	vec4 uv;
-}; 
-
-layout(buffer_reference, std430) readonly buffer VertexBuffer{ 
-	Vertex vertices[];
-};
-
-//push constants block
-layout( push_constant ) uniform constants
-{
-	mat4 transformMatrix;
-	VertexBuffer vertexBuffer;
-} pVertex;
-
 void main() 
 {
+	scene = pVertex.scene;
+
 	Vertex v = pVertex.vertexBuffer.vertices[gl_VertexIndex];
 	
 	vec4 location = vec4(v.location.xyz, 1.0f);
@@ -2,28 +2,37 @@
 
 #extension GL_GOOGLE_include_directive : require
 #extension GL_EXT_buffer_reference : require
+#extension GL_EXT_nonuniform_qualifier : require
 
 #include "normal.glsl"
 #include "scene.glsl"
+#include "mesh.glsl"
 #include "deferred.glsl"
+#include "../bindless.glsl"
 
+// Slots of the params SceneDeferredDrawer declares, each holds the texture's bindless index in x
+#define COLOR_T 0
+#define NORMAL_T 1
+#define ROUGHNESS_T 2
+#define METALLIC_T 3
+#define SPECULAR_T 4
+#define EMISSIVE_T 5
 
-layout(set = 1, binding = 0) uniform sampler2D ColorT;
-layout(set = 1, binding = 1) uniform sampler2D NormalT;
-layout(set = 1, binding = 2) uniform sampler2D RoughnessT;
-layout(set = 1, binding = 3) uniform sampler2D MetallicT;
-layout(set = 1, binding = 4) uniform sampler2D SpecularT;
-layout(set = 1, binding = 5) uniform sampler2D EmissiveT;
+int textureParam(uint slot){
+	return int(materials.data[pVertex.material + slot].x);
+}
 
 void main() 
 {
+	scene = pVertex.scene;
+
     vec3 viewDir = normalize(scene.cameraLocation.xyz - iSceneLocation);
 
-	vec3 normal = applyNormalMap(NormalT,normalize(iSceneNormal),viewDir,iUV);
+	vec3 normal = applyNormalMap(Textures[textureParam(NORMAL_T)],normalize(iSceneNormal),viewDir,iUV);
 
-	vec3 color = texture(ColorT,iUV).xyz;
+	vec3 color = texture(Textures[textureParam(COLOR_T)],iUV).xyz;
 
-	vec3 roughness = texture(RoughnessT,iUV).xyz;
+	vec3 roughness = texture(Textures[textureParam(ROUGHNESS_T)],iUV).xyz;
 
-	setOutput(color,normal,roughness.r,1.0,vec3(0.0),vec3(0.0));
-}
\ No newline at end of file
+	setOutput(color,normal,roughness.r,1.0,0.0,0.0);
+}
@@ -9,12 +9,29 @@ struct Light {
   vec4 color;
 };
 
-layout(set = 0, binding = 0) uniform  SceneGlobalBuffer {   
+layout(buffer_reference, std430) readonly buffer LightBuffer {
+  Light lights[];
+};
+
+// [offset,count] for every cluster, one more pair for global lights then the light indices
+layout(buffer_reference, std430) readonly buffer ClusterBuffer {
+  uint data[];
+};
+
+// Uploaded once per frame, draws push its address and assign it to scene at the start of main
+layout(buffer_reference, std430) readonly buffer SceneGlobalBuffer {
 	mat4 viewMatrix;
 	mat4 projectionMatrix;
 	vec4 ambientColor;
 	vec4 lightDirection;
 	vec4 cameraLocation;
   vec4 numLights;
-  Light lights[1024];
-} scene;
+  uvec4 clusterGrid;
+  vec4 clusterDepth;
+  vec4 clusterForward;
+  ClusterBuffer clusters;
+  LightBuffer lightBuffer;
+  mat4 inverseViewProjection;
+};
+
+SceneGlobalBuffer scene;
@@ -0,0 +1,7 @@
+// Every uploaded texture, indexed with Texture::GetBindlessIndex. Needs GL_EXT_nonuniform_qualifier.
+layout(set = 3, binding = 0) uniform sampler2D Textures[];
+
+// Parameters of every material, indexed with MaterialBlock::GetIndex
+layout(set = 3, binding = 1) readonly buffer MaterialData {
+    vec4 data[];
+} materials;
@@ -11,6 +11,7 @@ void LightArray::Tick(float deltaTime) {
 
 void LightArray::OnInit(scene::Scene * scene) {
     SceneObject::OnInit(scene);
+    SetCanEverUpdate(true);
     constexpr auto distance = 5000.0f;
 
     if(const auto pointLight = GetScene()->CreateSceneObject<scene::PointLight>().lock()) {
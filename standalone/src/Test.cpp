@@ -46,6 +46,7 @@ void PrettyShader::OnPaint(widgets::WidgetFrameData *frameData,
     //drawData.transform = glm::rotate(glm::mat4{1.0f},45.0f,glm::vec3{0.0f,0.0,1.0f});
 
     widgets::bindMaterial(frameData, _material);
+    drawData.globals = frameData->GetGlobals().address;
 
     _material->Push(frameData->GetCmd(), "pRect", drawData);
 
@@ -0,0 +1,78 @@
+#include "bench.hpp"
+#include <aerox/math/BoundsTree.hpp>
+#include <random>
+
+using namespace aerox::math;
+
+namespace {
+constexpr size_t MOVING_OBJECTS = 100000;
+
+struct MovingScene {
+  std::mt19937 rng{1};
+  BoundsTree tree{0.2f};
+  std::vector<Bounds> bounds;
+  std::vector<glm::vec3> velocities;
+  std::vector<int32_t> proxies;
+
+  MovingScene() {
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> size(0.1f, 3.0f);
+    std::uniform_real_distribution<float> speed(-0.1f, 0.1f);
+    for (size_t i = 0; i < MOVING_OBJECTS; i++) {
+      const glm::vec3 center(position(rng), position(rng), position(rng));
+      const auto extent = glm::vec3(size(rng));
+      bounds.emplace_back(center - extent, center + extent);
+      velocities.emplace_back(speed(rng), speed(rng), speed(rng));
+      proxies.push_back(tree.Insert(bounds.back(), reinterpret_cast<void *>(i)));
+    }
+  }
+
+  void Step() {
+    for (size_t i = 0; i < bounds.size(); i++) {
+      bounds[i] = Bounds(bounds[i].min + velocities[i], bounds[i].max + velocities[i]);
+      tree.Move(proxies[i], bounds[i], velocities[i]);
+    }
+  }
+};
+}
+
+BENCHMARK(BoundsTreeInsert100k) {
+  state.Measure(5, [] {
+    MovingScene scene;
+    aerox::bench::doNotOptimize(scene.tree.GetHeight());
+  });
+}
+
+BENCHMARK(BoundsTreeMove100k) {
+  MovingScene scene;
+  state.Measure(50, [&] {
+    scene.Step();
+  });
+}
+
+BENCHMARK(BoundsTreeQuery100k) {
+  MovingScene scene;
+  std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+  state.Measure(50, [&] {
+    // Roughly what a frame of culling and overlap queries does
+    size_t hits = 0;
+    for (int i = 0; i < 1000; i++) {
+      const glm::vec3 center(position(scene.rng), position(scene.rng), position(scene.rng));
+      scene.tree.Query(Bounds(center - glm::vec3(20.0f), center + glm::vec3(20.0f)), [&](int32_t) {
+        hits++;
+        return true;
+      });
+    }
+    aerox::bench::doNotOptimize(hits);
+  });
+}
+
+BENCHMARK(BoundsTreeRebuild100k) {
+  MovingScene scene;
+  for (int i = 0; i < 100; i++) {
+    scene.Step();
+  }
+  state.Measure(5, [&] {
+    scene.tree.Rebuild();
+  });
+}
@@ -0,0 +1,67 @@
+#include "bench.hpp"
+#include <aerox/scene/EntityStore.hpp>
+#include <aerox/scene/components/SceneComponent.hpp>
+#include <list>
+#include <memory>
+
+using namespace aerox;
+using namespace aerox::scene;
+
+namespace {
+constexpr size_t NUM_ENTITIES = 100000;
+constexpr float DELTA_TIME = 0.016f;
+
+struct Velocity {
+  math::Vec3<> value;
+};
+}
+
+BENCHMARK(EntityStoreMove100k) {
+  EntityStore store;
+  for (size_t i = 0; i < NUM_ENTITIES; i++) {
+    const auto entity = store.Create();
+    store.Add(entity, math::Transform{});
+    store.Add(entity, Velocity{{1.0f, 2.0f, 3.0f}});
+  }
+  store.Sync();
+
+  state.Measure(100, [&] {
+    store.EachChunk<math::Transform, const Velocity>([](auto, const std::span<math::Transform> transforms,
+                                                        const std::span<const Velocity> velocities) {
+      for (size_t i = 0; i < transforms.size(); i++) {
+        transforms[i].location = transforms[i].location + velocities[i].value * DELTA_TIME;
+      }
+    });
+  });
+}
+
+// The same move through the engine's scene components, held in a list and updated through their virtual transform interface. The
+// components are not initialized so they stay out of any transform store
+BENCHMARK(SceneComponentMove100k) {
+  std::list<std::shared_ptr<SceneComponent>> components;
+  std::vector<math::Vec3<>> velocities;
+  for (size_t i = 0; i < NUM_ENTITIES; i++) {
+    components.push_back(newObject<SceneComponent>());
+    velocities.emplace_back(1.0f, 2.0f, 3.0f);
+  }
+
+  state.Measure(100, [&] {
+    auto velocity = velocities.begin();
+    for (const auto &component : components) {
+      component->SetRelativeLocation(component->GetRelativeLocation() + *velocity++ * DELTA_TIME);
+    }
+  });
+}
+
+BENCHMARK(EntityStoreCreate100k) {
+  state.Measure(10, [] {
+    EntityStore store;
+    for (size_t i = 0; i < NUM_ENTITIES; i++) {
+      const auto entity = store.Create();
+      store.Add(entity, math::Transform{});
+      store.Add(entity, Velocity{});
+    }
+    store.Sync();
+    aerox::bench::doNotOptimize(store.GetCount());
+  });
+}
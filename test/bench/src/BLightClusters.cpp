@@ -0,0 +1,38 @@
+#include "bench.hpp"
+#include <aerox/drawing/scene/LightClusters.hpp>
+#include <random>
+
+using namespace aerox;
+using namespace aerox::drawing;
+
+BENCHMARK(LightClustersAssign10k) {
+  const auto projection = glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+  LightClusters clusters;
+  clusters.Build(projection, 0.1f, 1000.0f);
+
+  std::mt19937 rng(2);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  const auto forward = clusters.GetForward();
+  Array<math::Sphere> lights;
+  for (int i = 0; i < 10000; i++) {
+    const auto depth = unit(rng) * 300.0f;
+    const glm::vec3 offset((unit(rng) - 0.5f) * 2.0f * depth, (unit(rng) - 0.5f) * depth, 0.0f);
+    lights.push(math::Sphere(forward * depth + offset, unit(rng) * 4.0f + 0.1f));
+  }
+
+  // Runs inline here, the engine spreads the slices over the async subsystem
+  state.Measure(20, [&] {
+    clusters.Assign(lights);
+    aerox::bench::doNotOptimize(clusters.GetData().size());
+  });
+}
+
+BENCHMARK(LightClustersBuild) {
+  LightClusters clusters;
+  auto fov = 70.0f;
+  state.Measure(20, [&] {
+    // Alternate the fov so Build does not skip an unchanged projection
+    fov = fov == 70.0f ? 71.0f : 70.0f;
+    clusters.Build(glm::perspective(glm::radians(fov), 16.0f / 9.0f, 0.1f, 1000.0f), 0.1f, 1000.0f);
+  });
+}
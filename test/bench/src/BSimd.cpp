@@ -0,0 +1,123 @@
+#include "bench.hpp"
+#include <aerox/math/simd.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+using namespace aerox::math;
+
+namespace {
+constexpr size_t COUNT = 100000;
+
+struct Inputs {
+  std::vector<glm::mat4> matrices;
+  std::vector<glm::vec3> locations;
+  std::vector<glm::quat> rotations;
+  std::vector<glm::vec3> scales;
+  std::vector<glm::vec3> points;
+
+  Inputs() {
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<float> value(-2.0f, 2.0f);
+    for (size_t i = 0; i < COUNT; i++) {
+      locations.emplace_back(value(rng), value(rng), value(rng));
+      rotations.push_back(glm::normalize(glm::quat{value(rng), value(rng), value(rng), value(rng)}));
+      scales.emplace_back(1.0f + std::abs(value(rng)), 1.0f + std::abs(value(rng)), 1.0f + std::abs(value(rng)));
+      matrices.push_back(simd::composeTrs(locations.back(), rotations.back(), scales.back()));
+      points.emplace_back(value(rng), value(rng), value(rng));
+    }
+  }
+};
+
+Inputs &getInputs() {
+  static Inputs inputs;
+  return inputs;
+}
+}
+
+BENCHMARK(MatrixProductGlm100k) {
+  auto &inputs = getInputs();
+  std::vector<glm::mat4> out(COUNT);
+  state.Measure(20, [&] {
+    for (size_t i = 0; i + 1 < COUNT; i++) {
+      out[i] = inputs.matrices[i] * inputs.matrices[i + 1];
+    }
+    aerox::bench::doNotOptimize(out);
+  });
+}
+
+BENCHMARK(MatrixProductSimd100k) {
+  auto &inputs = getInputs();
+  std::vector<glm::mat4> out(COUNT);
+  state.Measure(20, [&] {
+    for (size_t i = 0; i + 1 < COUNT; i++) {
+      out[i] = simd::multiply(inputs.matrices[i], inputs.matrices[i + 1]);
+    }
+    aerox::bench::doNotOptimize(out);
+  });
+}
+
+BENCHMARK(ComposeTrsGlm100k) {
+  auto &inputs = getInputs();
+  std::vector<glm::mat4> out(COUNT);
+  state.Measure(20, [&] {
+    for (size_t i = 0; i < COUNT; i++) {
+      out[i] = glm::translate(glm::mat4(1.0f), inputs.locations[i]) * glm::mat4_cast(inputs.rotations[i]) *
+               glm::scale(glm::mat4(1.0f), inputs.scales[i]);
+    }
+    aerox::bench::doNotOptimize(out);
+  });
+}
+
+BENCHMARK(ComposeTrsSimd100k) {
+  auto &inputs = getInputs();
+  std::vector<glm::mat4> out(COUNT);
+  state.Measure(20, [&] {
+    for (size_t i = 0; i < COUNT; i++) {
+      out[i] = simd::composeTrs(inputs.locations[i], inputs.rotations[i], inputs.scales[i]);
+    }
+    aerox::bench::doNotOptimize(out);
+  });
+}
+
+BENCHMARK(InverseGlm100k) {
+  auto &inputs = getInputs();
+  std::vector<glm::mat4> out(COUNT);
+  state.Measure(20, [&] {
+    for (size_t i = 0; i < COUNT; i++) {
+      out[i] = glm::inverse(inputs.matrices[i]);
+    }
+    aerox::bench::doNotOptimize(out);
+  });
+}
+
+BENCHMARK(InverseAffineSimd100k) {
+  auto &inputs = getInputs();
+  std::vector<glm::mat4> out(COUNT);
+  state.Measure(20, [&] {
+    for (size_t i = 0; i < COUNT; i++) {
+      out[i] = simd::inverseAffine(inputs.matrices[i]);
+    }
+    aerox::bench::doNotOptimize(out);
+  });
+}
+
+BENCHMARK(TransformPointsGlm100k) {
+  auto &inputs = getInputs();
+  std::vector<glm::vec3> out(COUNT);
+  const auto &matrix = inputs.matrices.front();
+  state.Measure(20, [&] {
+    for (size_t i = 0; i < COUNT; i++) {
+      out[i] = glm::vec3(matrix * glm::vec4(inputs.points[i], 1.0f));
+    }
+    aerox::bench::doNotOptimize(out);
+  });
+}
+
+BENCHMARK(TransformPointsSimd100k) {
+  auto &inputs = getInputs();
+  std::vector<glm::vec3> out(COUNT);
+  state.Measure(20, [&] {
+    simd::transformPoints(inputs.matrices.front(), inputs.points.data(), out.data(), COUNT);
+    aerox::bench::doNotOptimize(out);
+  });
+}
@@ -0,0 +1,92 @@
+#include "bench.hpp"
+#include <aerox/math/Transform.hpp>
+#include <random>
+
+using namespace aerox::math;
+
+namespace {
+constexpr size_t COUNT = 100000;
+
+std::vector<Transform> makeTransforms(const bool bUniform) {
+  std::mt19937 rng(6);
+  std::uniform_real_distribution<float> value(-5.0f, 5.0f);
+  std::uniform_real_distribution<float> size(0.5f, 2.0f);
+
+  std::vector<Transform> transforms;
+  for (size_t i = 0; i < COUNT; i++) {
+    const auto axis = glm::normalize(glm::vec3(value(rng), value(rng), value(rng)));
+    const auto scale = bUniform ? Vec3<>(size(rng)) : Vec3<>(size(rng), size(rng), size(rng));
+    transforms.emplace_back(Vec3<>(value(rng), value(rng), value(rng)), Quat(value(rng) * 30.0f, Vec3<>(axis.x, axis.y, axis.z)), scale);
+  }
+  return transforms;
+}
+}
+
+BENCHMARK(TransformInverseUniform100k) {
+  const auto transforms = makeTransforms(true);
+  std::vector<Transform> out(COUNT);
+  state.Measure(20, [&] {
+    for (size_t i = 0; i < COUNT; i++) {
+      out[i] = transforms[i].Inverse();
+    }
+    aerox::bench::doNotOptimize(out);
+  });
+}
+
+BENCHMARK(TransformInverseNonUniform100k) {
+  const auto transforms = makeTransforms(false);
+  std::vector<Transform> out(COUNT);
+  state.Measure(20, [&] {
+    for (size_t i = 0; i < COUNT; i++) {
+      out[i] = transforms[i].Inverse();
+    }
+    aerox::bench::doNotOptimize(out);
+  });
+}
+
+BENCHMARK(TransformInverseGlm100k) {
+  const auto transforms = makeTransforms(false);
+  std::vector<Transform> out(COUNT);
+  state.Measure(20, [&] {
+    for (size_t i = 0; i < COUNT; i++) {
+      out[i] = Transform(glm::inverse(transforms[i].Matrix()));
+    }
+    aerox::bench::doNotOptimize(out);
+  });
+}
+
+BENCHMARK(TransformRelativeToUniform100k) {
+  const auto parents = makeTransforms(true);
+  const auto children = makeTransforms(false);
+  std::vector<Transform> out(COUNT);
+  state.Measure(20, [&] {
+    for (size_t i = 0; i < COUNT; i++) {
+      out[i] = children[i].RelativeTo(parents[i]);
+    }
+    aerox::bench::doNotOptimize(out);
+  });
+}
+
+BENCHMARK(TransformRelativeToNonUniform100k) {
+  const auto parents = makeTransforms(false);
+  const auto children = makeTransforms(false);
+  std::vector<Transform> out(COUNT);
+  state.Measure(20, [&] {
+    for (size_t i = 0; i < COUNT; i++) {
+      out[i] = children[i].RelativeTo(parents[i]);
+    }
+    aerox::bench::doNotOptimize(out);
+  });
+}
+
+BENCHMARK(TransformRelativeToGlm100k) {
+  const auto parents = makeTransforms(false);
+  const auto children = makeTransforms(false);
+  std::vector<Transform> out(COUNT);
+  state.Measure(20, [&] {
+    for (size_t i = 0; i < COUNT; i++) {
+      out[i] = Transform(glm::inverse(parents[i].Matrix()) * children[i].Matrix());
+    }
+    aerox::bench::doNotOptimize(out);
+  });
+}
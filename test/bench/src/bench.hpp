@@ -0,0 +1,61 @@
+#pragma once
+#include <chrono>
+#include <vector>
+
+namespace aerox::bench {
+
+/**
+ * \brief Times repeated runs of a benchmark body, setup done before Measure is not timed
+ */
+class BenchState {
+  const char *_name;
+  std::vector<double> _samples;
+
+public:
+  explicit BenchState(const char *name);
+
+  template <typename T>
+  void Measure(const int iterations, T &&body) {
+    // One untimed warm up run so caches and allocations settle
+    body();
+    for (int i = 0; i < iterations; i++) {
+      const auto start = std::chrono::steady_clock::now();
+      body();
+      const auto end = std::chrono::steady_clock::now();
+      _samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+  }
+
+  /**
+   * \brief Prints the min, median and mean of the samples taken so far
+   */
+  void Report() const;
+};
+
+using BenchFn = void (*)(BenchState &state);
+
+struct BenchCase {
+  const char *name;
+  BenchFn fn;
+};
+
+std::vector<BenchCase> &getBenchmarks();
+
+struct BenchRegistrar {
+  BenchRegistrar(const char *name, BenchFn fn);
+};
+
+/**
+ * \brief Keeps the optimizer from discarding a result
+ */
+template <typename T>
+void doNotOptimize(const T &value) {
+  static volatile const void *sink;
+  sink = &value;
+}
+}
+
+#define BENCHMARK(name)                                                                                                \
+  static void name(::aerox::bench::BenchState &state);                                                                 \
+  static ::aerox::bench::BenchRegistrar name##Registrar{#name, name};                                                   \
+  static void name(::aerox::bench::BenchState &state)
@@ -0,0 +1,51 @@
+#include "bench.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+
+namespace aerox::bench {
+BenchState::BenchState(const char *name) {
+  _name = name;
+}
+
+void BenchState::Report() const {
+  if (_samples.empty()) {
+    std::printf("%-40s no samples\n", _name);
+    return;
+  }
+
+  auto sorted = _samples;
+  std::sort(sorted.begin(), sorted.end());
+  const auto mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+  std::printf("%-40s min %9.3f ms  median %9.3f ms  mean %9.3f ms  (%zu runs)\n", _name, sorted.front(),
+              sorted[sorted.size() / 2], mean, sorted.size());
+}
+
+std::vector<BenchCase> &getBenchmarks() {
+  static std::vector<BenchCase> benchmarks;
+  return benchmarks;
+}
+
+BenchRegistrar::BenchRegistrar(const char *name, const BenchFn fn) {
+  getBenchmarks().push_back({name, fn});
+}
+}
+
+// Usage: aeroxBench [filter], build in Release for meaningful numbers
+int main(const int argc, char **argv) {
+  using namespace aerox::bench;
+
+  const char *filter = argc > 1 ? argv[1] : nullptr;
+  for (const auto &benchmark : getBenchmarks()) {
+    if (filter && !std::strstr(benchmark.name, filter)) {
+      continue;
+    }
+
+    BenchState state(benchmark.name);
+    benchmark.fn(state);
+    state.Report();
+  }
+
+  return 0;
+}
@@ -0,0 +1,61 @@
+#include "test.hpp"
+#include <aerox/assets/AssetSubsystem.hpp>
+#include <aerox/assets/LiveAsset.hpp>
+
+using namespace aerox;
+
+namespace {
+class CachedAsset : public assets::LiveAsset {
+public:
+  void WriteTo(Buffer &store) override {
+  }
+
+  void ReadFrom(Buffer &store) override {
+  }
+};
+}
+
+TEST(AssetCacheLetsGoOfTheLeastRecentlyUsedAsset) {
+  const auto cache = newObject<assets::AssetSubsystem>();
+
+  std::vector<std::weak_ptr<assets::LiveAsset>> retained;
+  for (uint32_t i = 0; i < assets::NUM_RETAINED_ASSETS; i++) {
+    const auto asset = std::make_shared<CachedAsset>();
+    cache->Retain(asset);
+    retained.push_back(asset);
+  }
+
+  // Using the first asset again makes the second one the oldest
+  cache->Retain(retained.front().lock());
+  cache->Retain(std::make_shared<CachedAsset>());
+
+  CHECK_EQ(cache->GetNumRetained(), size_t{assets::NUM_RETAINED_ASSETS});
+  CHECK(!retained.front().expired());
+  CHECK(retained[1].expired());
+  for (size_t i = 2; i < retained.size(); i++) {
+    CHECK(!retained[i].expired());
+  }
+}
+
+TEST(AssetCacheReleasesOnlyAssetsNothingElseUses) {
+  const auto cache = newObject<assets::AssetSubsystem>();
+
+  const std::shared_ptr<assets::LiveAsset> used = std::make_shared<CachedAsset>();
+  std::weak_ptr<assets::LiveAsset> unused;
+  {
+    const auto asset = std::make_shared<CachedAsset>();
+    unused = asset;
+    cache->Retain(asset);
+  }
+  cache->Retain(used);
+
+  // What memory pressure does
+  CHECK_EQ(cache->ReleaseRetained(), size_t{1});
+  CHECK(unused.expired());
+  CHECK_EQ(cache->GetNumRetained(), size_t{1});
+
+  // What shutdown does
+  CHECK_EQ(cache->ReleaseRetained(false), size_t{1});
+  CHECK_EQ(cache->GetNumRetained(), size_t{0});
+  CHECK_EQ(used.use_count(), long{1});
+}
@@ -0,0 +1,25 @@
+#include "test.hpp"
+#include <aerox/assets/AssetMeta.hpp>
+#include <aerox/containers/Buffer.hpp>
+
+using namespace aerox;
+
+TEST(AssetMetaRoundTripsThroughABuffer) {
+  assets::AssetMeta written;
+  written.version = assets::ASSET_VERSION_INITIAL;
+  written.type = "mesh";
+  written.id = "meshes/crate";
+  written.tags = {"props", "static"};
+
+  MemoryBuffer buffer;
+  written.WriteTo(buffer);
+  CHECK(buffer.size() > 0);
+
+  assets::AssetMeta read;
+  read.ReadFrom(buffer);
+  CHECK_EQ(read.version, written.version);
+  CHECK_EQ(read.type, written.type);
+  CHECK_EQ(read.id, written.id);
+  CHECK(read.tags == written.tags);
+  CHECK_EQ(buffer.size(), size_t{0});
+}
@@ -0,0 +1,120 @@
+#include "test.hpp"
+#include <aerox/drawing/barriers.hpp>
+
+using namespace aerox::drawing;
+
+namespace {
+constexpr uint64_t IMAGE = 1;
+
+void barrier(BarrierValidator &validator, const EImageUsage from, const EImageUsage to, const bool bDiscard = false) {
+  validator.Barrier(IMAGE, makeImageBarrier({}, from, to, vk::ImageAspectFlagBits::eColor, {}, bDiscard));
+}
+
+// Drawn to as a color attachment, the usual start of every test
+BarrierValidator drawn() {
+  BarrierValidator validator;
+  barrier(validator, EImageUsage::Undefined, EImageUsage::ColorAttachmentWrite);
+  validator.Access(IMAGE, EImageUsage::ColorAttachmentWrite);
+  return validator;
+}
+}
+
+TEST(BarrierValidatorAcceptsSynchronizedUse) {
+  auto validator = drawn();
+  barrier(validator, EImageUsage::ColorAttachmentWrite, EImageUsage::FragmentSampled);
+  validator.Access(IMAGE, EImageUsage::FragmentSampled);
+  barrier(validator, EImageUsage::FragmentSampled, EImageUsage::TransferSrc);
+  validator.Access(IMAGE, EImageUsage::TransferSrc);
+  barrier(validator, EImageUsage::TransferSrc, EImageUsage::Present);
+  validator.Access(IMAGE, EImageUsage::Present);
+
+  CHECK(validator.GetHazards().empty());
+}
+
+TEST(BarrierValidatorReportsUseInWrongLayout) {
+  BarrierValidator validator;
+  validator.Access(IMAGE, EImageUsage::ColorAttachmentWrite);
+  CHECK_EQ(validator.GetHazards().size(), size_t{1});
+}
+
+TEST(BarrierValidatorReportsWriteAfterWrite) {
+  auto validator = drawn();
+  validator.Access(IMAGE, EImageUsage::ColorAttachmentWrite);
+  CHECK(!validator.GetHazards().empty());
+}
+
+TEST(BarrierValidatorReportsWriteThatIsNotMadeAvailable) {
+  auto validator = drawn();
+
+  // Waits on the right stage but never flushes the attachment write
+  auto unflushed = makeImageBarrier({}, EImageUsage::ColorAttachmentWrite, EImageUsage::FragmentSampled);
+  unflushed.setSrcAccessMask({});
+  validator.Barrier(IMAGE, unflushed);
+  CHECK(!validator.GetHazards().empty());
+}
+
+TEST(BarrierValidatorReportsWriteAfterRead) {
+  auto validator = drawn();
+  barrier(validator, EImageUsage::ColorAttachmentWrite, EImageUsage::FragmentSampled);
+  validator.Access(IMAGE, EImageUsage::FragmentSampled);
+  CHECK(validator.GetHazards().empty());
+
+  // Discarding skips the layout but still has to wait for the sampling to finish, this waits on nothing
+  barrier(validator, EImageUsage::Undefined, EImageUsage::ColorAttachmentWrite, true);
+  CHECK(!validator.GetHazards().empty());
+}
+
+TEST(BarrierValidatorReportsWrongOldLayout) {
+  auto validator = drawn();
+  // Claims the image was a transfer destination
+  auto wrong = makeImageBarrier({}, EImageUsage::ColorAttachmentWrite, EImageUsage::FragmentSampled);
+  wrong.setOldLayout(vk::ImageLayout::eTransferDstOptimal);
+  validator.Barrier(IMAGE, wrong);
+  CHECK(!validator.GetHazards().empty());
+}
+
+TEST(BarrierValidatorFollowsBarrierChains) {
+  auto validator = drawn();
+  barrier(validator, EImageUsage::ColorAttachmentWrite, EImageUsage::FragmentSampled);
+  validator.Access(IMAGE, EImageUsage::FragmentSampled);
+
+  // Same layout, the write reaches compute by chaining through the fragment stage the first barrier made it visible to
+  barrier(validator, EImageUsage::FragmentSampled, EImageUsage::ComputeSampled);
+  validator.Access(IMAGE, EImageUsage::ComputeSampled);
+  CHECK(validator.GetHazards().empty());
+}
+
+TEST(BarrierValidatorReportsReadInStageTheWriteIsNotVisibleTo) {
+  auto validator = drawn();
+  barrier(validator, EImageUsage::ColorAttachmentWrite, EImageUsage::FragmentSampled);
+
+  // Same layout as fragment sampling, but the barrier only made the write visible to fragment shaders
+  validator.Access(IMAGE, EImageUsage::ComputeSampled);
+  CHECK(!validator.GetHazards().empty());
+}
+
+TEST(BarrierValidatorStartsFromAssumedUsage) {
+  BarrierValidator imported;
+  imported.Assume(IMAGE, EImageUsage::TransferSrc);
+  barrier(imported, EImageUsage::TransferSrc, EImageUsage::ColorAttachmentWrite);
+  imported.Access(IMAGE, EImageUsage::ColorAttachmentWrite);
+  CHECK(imported.GetHazards().empty());
+
+  // A copy into the image from before is still in flight
+  BarrierValidator written;
+  written.Assume(IMAGE, EImageUsage::TransferDst);
+  written.Access(IMAGE, EImageUsage::TransferDst);
+  CHECK(!written.GetHazards().empty());
+}
+
+TEST(BarrierValidatorTracksImagesSeparately) {
+  auto validator = drawn();
+  constexpr uint64_t other = 2;
+  validator.Barrier(other, makeImageBarrier({}, EImageUsage::Undefined, EImageUsage::TransferDst));
+  validator.Access(other, EImageUsage::TransferDst);
+  CHECK(validator.GetHazards().empty());
+
+  // Only the first image was drawn to
+  validator.Access(other, EImageUsage::TransferDst);
+  CHECK_EQ(validator.GetHazards().size(), size_t{1});
+}
@@ -0,0 +1,177 @@
+#include "test.hpp"
+#include <aerox/math/BoundsTree.hpp>
+#include <random>
+#include <set>
+
+using namespace aerox::math;
+
+namespace {
+/**
+ * \brief Keeps the exact bounds of every proxy so tree queries can be compared against a linear scan
+ */
+struct BruteForceScene {
+  std::mt19937 rng{1};
+  std::uniform_real_distribution<float> position{-100.0f, 100.0f};
+  std::uniform_real_distribution<float> size{0.1f, 3.0f};
+
+  BoundsTree tree{0.2f};
+  std::vector<Bounds> bounds;
+  std::vector<int32_t> proxies;
+  std::vector<bool> alive;
+
+  Bounds RandomBounds() {
+    const glm::vec3 center(position(rng), position(rng), position(rng));
+    const auto extent = glm::vec3(size(rng));
+    return Bounds(center - extent, center + extent);
+  }
+
+  void Add(const int count) {
+    for (int i = 0; i < count; i++) {
+      const auto index = bounds.size();
+      bounds.push_back(RandomBounds());
+      proxies.push_back(tree.Insert(bounds.back(), reinterpret_cast<void *>(index)));
+      alive.push_back(true);
+    }
+  }
+
+  size_t IndexOf(const int32_t proxy) const {
+    return reinterpret_cast<size_t>(tree.GetUserData(proxy));
+  }
+
+  // The tree reports proxies by their fat bounds, narrow them down the same way a caller would
+  template <typename T>
+  std::set<size_t> Query(const T &shape) const {
+    std::set<size_t> result;
+    tree.Query(shape, [&](const int32_t proxy) {
+      const auto index = IndexOf(proxy);
+      if (bounds[index].Intersects(shape)) {
+        result.insert(index);
+      }
+      return true;
+    });
+    return result;
+  }
+
+  template <typename T>
+  std::set<size_t> Scan(const T &shape) const {
+    std::set<size_t> result;
+    for (size_t i = 0; i < bounds.size(); i++) {
+      if (alive[i] && bounds[i].Intersects(shape)) {
+        result.insert(i);
+      }
+    }
+    return result;
+  }
+
+  void CheckQueries(const int count) {
+    for (int q = 0; q < count; q++) {
+      const auto box = RandomBounds().Expand(10.0f);
+      CHECK(Query(box) == Scan(box));
+
+      const Sphere sphere(glm::vec3(position(rng), position(rng), position(rng)), 15.0f);
+      CHECK(Query(sphere) == Scan(sphere));
+
+      const Ray ray(glm::vec3(position(rng), position(rng), position(rng)),
+                    glm::vec3(position(rng), position(rng), position(rng)));
+      constexpr float maxDistance = 500.0f;
+
+      auto closest = maxDistance;
+      bool bHit = false;
+      tree.RayCast(ray, maxDistance, [&](const int32_t proxy, float, const float currentMax) {
+        float distance;
+        if (bounds[IndexOf(proxy)].Intersects(ray, currentMax, distance) && distance < closest) {
+          closest = distance;
+          bHit = true;
+          return distance;
+        }
+        return currentMax;
+      });
+
+      auto expectedClosest = maxDistance;
+      bool bExpectedHit = false;
+      for (size_t i = 0; i < bounds.size(); i++) {
+        float distance;
+        if (alive[i] && bounds[i].Intersects(ray, maxDistance, distance) && distance < expectedClosest) {
+          expectedClosest = distance;
+          bExpectedHit = true;
+        }
+      }
+
+      CHECK_EQ(bHit, bExpectedHit);
+      if (bHit) {
+        CHECK_NEAR(closest, expectedClosest, 1e-4);
+      }
+    }
+  }
+};
+}
+
+TEST(BoundsTreeMatchesBruteForceAfterInsert) {
+  BruteForceScene scene;
+  scene.Add(5000);
+  CHECK_EQ(scene.tree.GetProxyCount(), size_t{5000});
+  scene.CheckQueries(50);
+}
+
+TEST(BoundsTreeMatchesBruteForceAfterMoves) {
+  BruteForceScene scene;
+  scene.Add(5000);
+
+  std::uniform_real_distribution<float> jitter(-0.001f, 0.001f);
+  int reinserts = 0;
+  for (int frame = 0; frame < 20; frame++) {
+    for (size_t i = 0; i < scene.bounds.size(); i++) {
+      const glm::vec3 offset(0.05f + jitter(scene.rng), jitter(scene.rng), jitter(scene.rng));
+      scene.bounds[i] = Bounds(scene.bounds[i].min + offset, scene.bounds[i].max + offset);
+      reinserts += scene.tree.Move(scene.proxies[i], scene.bounds[i], offset) ? 1 : 0;
+
+      // The fat bounds must always contain the real bounds or queries would miss the proxy
+      CHECK(scene.tree.GetFatBounds(scene.proxies[i]).Contains(scene.bounds[i]));
+    }
+  }
+
+  // Small steady motion should mostly stay inside the predicted fat bounds
+  CHECK(reinserts < static_cast<int>(scene.bounds.size()) * 20 / 2);
+  scene.CheckQueries(50);
+}
+
+TEST(BoundsTreeMatchesBruteForceAfterRemoveAndRebuild) {
+  BruteForceScene scene;
+  scene.Add(5000);
+
+  for (size_t i = 0; i < scene.bounds.size(); i += 3) {
+    scene.tree.Remove(scene.proxies[i]);
+    scene.alive[i] = false;
+  }
+  scene.CheckQueries(25);
+
+  scene.tree.Rebuild();
+  scene.CheckQueries(25);
+
+  for (size_t i = 0; i < scene.bounds.size(); i += 3) {
+    scene.proxies[i] = scene.tree.Insert(scene.bounds[i], reinterpret_cast<void *>(i));
+    scene.alive[i] = true;
+  }
+  CHECK_EQ(scene.tree.GetProxyCount(), scene.bounds.size());
+  scene.CheckQueries(25);
+}
+
+TEST(BoundsTreeStopsQueryWhenCallbackReturnsFalse) {
+  BruteForceScene scene;
+  scene.Add(1000);
+
+  int visited = 0;
+  scene.tree.Query(Bounds(glm::vec3(-200.0f), glm::vec3(200.0f)), [&](int32_t) {
+    visited++;
+    return false;
+  });
+  CHECK_EQ(visited, 1);
+}
+
+TEST(BoundsTreeStaysBalanced) {
+  BruteForceScene scene;
+  scene.Add(10000);
+
+  // A balanced tree over 10k leaves is around 14 levels deep, a degenerate one would be thousands
+  CHECK(scene.tree.GetHeight() < 40);
+}
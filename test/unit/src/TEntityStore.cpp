@@ -0,0 +1,153 @@
+#include "test.hpp"
+#include <aerox/scene/EntityStore.hpp>
+#include <string>
+
+using namespace aerox::scene;
+
+namespace {
+struct Position {
+  float x = 0.0f;
+};
+
+struct Velocity {
+  float x = 0.0f;
+};
+
+struct Name {
+  std::string value;
+};
+
+// Counts live instances so moves between archetypes can be checked for leaks
+int liveTracked = 0;
+
+struct Tracked {
+  int value;
+
+  explicit Tracked(const int inValue) : value(inValue) {
+    liveTracked++;
+  }
+
+  Tracked(Tracked &&other) noexcept : value(other.value) {
+    liveTracked++;
+  }
+
+  ~Tracked() {
+    liveTracked--;
+  }
+};
+
+constexpr int NUM_ENTITIES = 5000;
+}
+
+TEST(EntityStoreAppliesChangesOnSync) {
+  EntityStore store;
+  const auto entity = store.Create();
+  store.Add(entity, Position{1.0f});
+  CHECK(store.Get<Position>(entity) == nullptr);
+
+  store.Sync();
+  CHECK(store.IsAlive(entity));
+  CHECK_EQ(store.Get<Position>(entity)->x, 1.0f);
+
+  store.Destroy(entity);
+  CHECK(store.IsAlive(entity));
+  store.Sync();
+  CHECK(!store.IsAlive(entity));
+}
+
+TEST(EntityStoreRejectsStaleIds) {
+  EntityStore store;
+  const auto first = store.Create();
+  store.Sync();
+  store.Destroy(first);
+  store.Sync();
+
+  // The index is reused with a new generation
+  const auto second = store.Create();
+  store.Add(second, Position{2.0f});
+  store.Sync();
+  CHECK_EQ(first.index, second.index);
+  CHECK(!store.IsAlive(first));
+  CHECK(store.Get<Position>(first) == nullptr);
+  CHECK_EQ(store.Get<Position>(second)->x, 2.0f);
+}
+
+TEST(EntityStoreKeepsComponentsThroughArchetypeMoves) {
+  {
+    EntityStore store;
+    std::vector<EntityId> entities;
+    for (auto i = 0; i < NUM_ENTITIES; i++) {
+      const auto entity = store.Create();
+      entities.push_back(entity);
+      store.Add(entity, Position{static_cast<float>(i)});
+      if (i % 2) {
+        store.Add(entity, Velocity{1.0f});
+      }
+      if (i % 3 == 0) {
+        store.Add(entity, Name{std::to_string(i)});
+      }
+      store.Add(entity, Tracked{i});
+    }
+    store.Sync();
+    CHECK_EQ(store.GetCount(), static_cast<size_t>(NUM_ENTITIES));
+    CHECK_EQ(liveTracked, NUM_ENTITIES);
+
+    for (auto i = 0; i < NUM_ENTITIES; i += 7) {
+      store.Destroy(entities[i]);
+    }
+    for (auto i = 1; i < NUM_ENTITIES; i += 5) {
+      store.Remove<Velocity>(entities[i]);
+    }
+    for (auto i = 2; i < NUM_ENTITIES; i += 11) {
+      store.Add(entities[i], Velocity{2.0f});
+    }
+    store.Sync();
+
+    for (auto i = 0; i < NUM_ENTITIES; i++) {
+      const auto bDead = i % 7 == 0;
+      CHECK_EQ(store.IsAlive(entities[i]), !bDead);
+      if (bDead) {
+        continue;
+      }
+
+      CHECK_EQ(store.Get<Position>(entities[i])->x, static_cast<float>(i));
+      CHECK_EQ(store.Get<Tracked>(entities[i])->value, i);
+      if (i % 3 == 0) {
+        CHECK_EQ(store.Get<Name>(entities[i])->value, std::to_string(i));
+      }
+
+      const auto bHasVelocity = (i % 2 == 1 && (i - 1) % 5 != 0) || (i >= 2 && (i - 2) % 11 == 0);
+      CHECK_EQ(store.Has<Velocity>(entities[i]), bHasVelocity);
+    }
+  }
+
+  // Destroying the store destroys every component it still held
+  CHECK_EQ(liveTracked, 0);
+}
+
+TEST(EntityStoreIteratesMatchingEntities) {
+  EntityStore store;
+  for (auto i = 0; i < NUM_ENTITIES; i++) {
+    const auto entity = store.Create();
+    store.Add(entity, Position{0.0f});
+    if (i % 4 == 0) {
+      store.Add(entity, Velocity{static_cast<float>(i)});
+    }
+  }
+  store.Sync();
+
+  size_t visited = 0;
+  store.Each<Position, const Velocity>([&](const EntityId entity, Position &position, const Velocity &velocity) {
+    CHECK(store.Has<Velocity>(entity));
+    position.x += velocity.x;
+    visited++;
+  });
+  CHECK_EQ(visited, static_cast<size_t>(NUM_ENTITIES / 4));
+
+  // Parallel iteration runs inline without the async subsystem, it must still see every chunk once
+  size_t chunkRows = 0;
+  store.ParallelEachChunk<Position>([&](const std::span<const EntityId> entities, std::span<Position>) {
+    chunkRows += entities.size();
+  });
+  CHECK_EQ(chunkRows, static_cast<size_t>(NUM_ENTITIES));
+}
@@ -0,0 +1,146 @@
+#include "test.hpp"
+#include <aerox/Engine.hpp>
+#include <aerox/drawing/DrawingSubsystem.hpp>
+#include <aerox/drawing/Mesh.hpp>
+#include <aerox/drawing/OffscreenDrawer.hpp>
+#include <aerox/io/io.hpp>
+#include <aerox/scene/Scene.hpp>
+#include <aerox/scene/components/StaticMeshComponent.hpp>
+#include <aerox/scene/objects/PointLight.hpp>
+#include <aerox/scene/objects/SceneObject.hpp>
+#include <array>
+
+using namespace aerox;
+
+namespace {
+constexpr vk::Extent2D EXTENT{64, 48};
+constexpr float STEP_SECONDS = 1.0f / 60.0f;
+constexpr int NUM_STEPS = 8;
+// Counter clockwise seen from outside the box
+constexpr std::array<glm::vec2, 4> FACE_CORNERS{glm::vec2{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}};
+
+/**
+ * \brief A box around the origin, every face has its own vertices so it gets a flat normal
+ */
+std::shared_ptr<drawing::Mesh> makeBox(const float halfExtent) {
+  Array<drawing::Vertex> vertices;
+  Array<uint32_t> indices;
+  for (auto axis = 0; axis < 3; axis++) {
+    for (const auto side : {-1.0f, 1.0f}) {
+      glm::vec3 normal{0.0f}, u{0.0f}, v{0.0f};
+      normal[axis] = side;
+      u[(axis + 1) % 3] = 1.0f;
+      v[(axis + 2) % 3] = side;
+
+      const auto first = static_cast<uint32_t>(vertices.size());
+      for (const auto &corner : FACE_CORNERS) {
+        const auto location = (normal + u * corner.x + v * corner.y) * halfExtent;
+        vertices.push({glm::vec4(location, 1.0f), glm::vec4(normal, 0.0f), glm::vec4((corner + 1.0f) / 2.0f, 0.0f, 0.0f)});
+      }
+      for (const auto corner : {0u, 1u, 2u, 0u, 2u, 3u}) {
+        indices.push(first + corner);
+      }
+    }
+  }
+
+  const auto mesh = newObject<drawing::Mesh>();
+  mesh->SetVertices(vertices);
+  mesh->SetIndices(indices);
+  mesh->SetSurfaces({drawing::MeshSurface{0, static_cast<uint32_t>(indices.size())}});
+  return mesh;
+}
+
+/**
+ * \brief Starts the engine headless with a lit box in front of the scene's default camera, stops it again even if a check fails
+ */
+struct HeadlessEngine {
+  HeadlessEngine() {
+    io::setRawShadersPath(AEROX_SHADERS_DIR);
+    const auto engine = Engine::Get();
+    engine->SetHeadless(true);
+    engine->SetMainWindowSize(EXTENT);
+    const auto weakScene = engine->CreateScene<scene::Scene>();
+    engine->Start();
+
+    // The default camera sits at z -10 looking down +z
+    const auto scene = weakScene.lock();
+    const auto box = scene->CreateSceneObject<scene::SceneObject>().lock();
+    const auto boxMesh = box->AddComponent<scene::StaticMeshComponent>().lock();
+    boxMesh->AttachTo(box->GetRootComponent());
+    // No material, the scene drawer's default checkerboard is used. The mesh is uploaded here, before the first step.
+    boxMesh->SetMesh(makeBox(1.0f));
+
+    const auto light = scene->CreateSceneObject<scene::PointLight>().lock();
+    light->SetWorldLocation({0.0f, 0.0f, -5.0f});
+    light->SetIntensity(100.0f);
+  }
+
+  ~HeadlessEngine() {
+    Engine::Get()->Stop();
+  }
+
+  drawing::FrameCapture Step() const {
+    Engine::Get()->Step(STEP_SECONDS);
+    return Engine::Get()->GetDrawingSubsystem().lock()->GetOffscreenDrawer().lock()->ReadFrame();
+  }
+};
+
+const uint8_t *pixelAt(const drawing::FrameCapture &capture, const uint32_t x, const uint32_t y) {
+  return capture.pixels.data() + (static_cast<size_t>(y) * capture.extent.width + x) * 4;
+}
+
+bool hasTiming(const drawing::FrameCapture &capture, const std::string &name) {
+  for (const auto &timing : capture.timings) {
+    if (timing.name == name) {
+      return timing.milliseconds >= 0.0;
+    }
+  }
+  return false;
+}
+}
+
+GPU_TEST(HeadlessStepsDrawAndReadBackFrames) {
+  const HeadlessEngine engine;
+  CHECK(Engine::Get()->IsHeadless());
+
+  std::vector<drawing::FrameCapture> captures;
+  for (int i = 0; i < NUM_STEPS; i++) {
+    captures.push_back(engine.Step());
+  }
+
+  for (size_t i = 0; i < captures.size(); i++) {
+    const auto &capture = captures[i];
+    CHECK_EQ(capture.extent.width, EXTENT.width);
+    CHECK_EQ(capture.extent.height, EXTENT.height);
+    CHECK_EQ(capture.pixels.size(), static_cast<size_t>(EXTENT.width) * EXTENT.height * 4);
+
+    // Each step draws exactly one frame and it has finished by the time the step returns
+    if (i > 0) {
+      CHECK_EQ(capture.frame, captures[i - 1].frame + 1);
+    }
+
+    // Timestamps are supported on the graphics queue of lavapipe and the desktop drivers
+    CHECK(hasTiming(capture, "Scene Base"));
+    CHECK(hasTiming(capture, "Scene Lighting"));
+    CHECK(hasTiming(capture, "Readback"));
+  }
+
+  // The lighting pass writes transparent black where nothing was drawn and opaque colour where the box is
+  const auto &first = captures.front();
+  CHECK_EQ(pixelAt(first, 0, 0)[3], uint8_t{0});
+  CHECK_EQ(pixelAt(first, EXTENT.width - 1, EXTENT.height - 1)[3], uint8_t{0});
+  CHECK_EQ(pixelAt(first, EXTENT.width / 2, EXTENT.height / 2)[3], uint8_t{255});
+
+  // The checkerboard has dark squares, somewhere on the box the light must show
+  bool bLit = false;
+  for (size_t i = 0; i < first.pixels.size(); i += 4) {
+    bLit = bLit || first.pixels[i] > 0 || first.pixels[i + 1] > 0 || first.pixels[i + 2] > 0;
+  }
+  CHECK(bLit);
+
+  // Nothing in the scene moves. Uploads and light data are written for whichever frame in flight draws, so every step gives the
+  // same pixels from the first one on.
+  for (size_t i = 1; i < captures.size(); i++) {
+    CHECK(captures[i].pixels == first.pixels);
+  }
+}
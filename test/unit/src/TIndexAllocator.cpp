@@ -0,0 +1,62 @@
+#include "test.hpp"
+#include <aerox/drawing/BindlessTextures.hpp>
+
+using namespace aerox::drawing;
+
+TEST(IndexAllocatorHandsOutIndicesUpToCapacity) {
+  IndexAllocator indices(4);
+  for (uint32_t i = 0; i < 4; i++) {
+    CHECK_EQ(indices.Allocate(), i);
+  }
+  CHECK_EQ(indices.Allocate(), INVALID_BINDLESS_INDEX);
+  CHECK_EQ(indices.GetNumAllocated(), 4u);
+}
+
+TEST(IndexAllocatorReusesFreedIndicesFirst) {
+  IndexAllocator indices(8);
+  for (int i = 0; i < 5; i++) {
+    indices.Allocate();
+  }
+
+  indices.Free(1);
+  indices.Free(3);
+  CHECK_EQ(indices.GetNumAllocated(), 3u);
+
+  // Most recently freed first, new indices only once the free list is empty
+  CHECK_EQ(indices.Allocate(), 3u);
+  CHECK_EQ(indices.Allocate(), 1u);
+  CHECK_EQ(indices.Allocate(), 5u);
+  CHECK_EQ(indices.GetNumAllocated(), 6u);
+}
+
+TEST(IndexAllocatorReusesFreedIndicesWhenFull) {
+  IndexAllocator indices(2);
+  indices.Allocate();
+  indices.Allocate();
+  CHECK_EQ(indices.Allocate(), INVALID_BINDLESS_INDEX);
+
+  indices.Free(0);
+  CHECK_EQ(indices.Allocate(), 0u);
+  CHECK_EQ(indices.Allocate(), INVALID_BINDLESS_INDEX);
+}
+
+TEST(IndexAllocatorRejectsIndicesThatWereNeverAllocated) {
+  IndexAllocator indices(8);
+  indices.Allocate();
+  CHECK_THROWS(indices.Free(1));
+  CHECK_THROWS(indices.Free(INVALID_BINDLESS_INDEX));
+  CHECK_EQ(indices.GetNumAllocated(), 1u);
+}
+
+TEST(IndexAllocatorRejectsDoubleFree) {
+  IndexAllocator indices(8);
+  indices.Allocate();
+  const auto index = indices.Allocate();
+  indices.Free(index);
+  CHECK_THROWS(indices.Free(index));
+  CHECK_EQ(indices.GetNumAllocated(), 1u);
+
+  // Allocated again, so it can be freed again
+  CHECK_EQ(indices.Allocate(), index);
+  indices.Free(index);
+}
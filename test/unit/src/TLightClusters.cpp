@@ -0,0 +1,138 @@
+#include "test.hpp"
+#include <aerox/drawing/scene/LightClusters.hpp>
+#include <algorithm>
+#include <random>
+
+using namespace aerox;
+using namespace aerox::drawing;
+
+namespace {
+constexpr float NEAR_CLIP = 0.1f;
+constexpr float FAR_CLIP = 1000.0f;
+
+glm::mat4 makeProjection() {
+  return glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, NEAR_CLIP, FAR_CLIP);
+}
+
+Array<math::Sphere> makeLights(std::mt19937 &rng, const glm::vec3 &forward, const size_t count) {
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  const auto right = glm::normalize(glm::cross(forward, glm::vec3(0.0f, 1.0f, 0.0f)));
+  const auto up = glm::cross(right, forward);
+
+  Array<math::Sphere> lights;
+  for (size_t i = 0; i < count; i++) {
+    const auto depth = unit(rng) * 300.0f;
+    const auto center = forward * depth + right * ((unit(rng) - 0.5f) * 2.0f * depth) + up * ((unit(rng) - 0.5f) * depth);
+    lights.push(math::Sphere(center, 0.5f + unit(rng) * 4.0f));
+  }
+  return lights;
+}
+}
+
+// Every view space point lit by a light must find that light in the cluster the shader would look it up in
+TEST(LightClustersContainEveryLightThatReachesAPoint) {
+  const auto projection = makeProjection();
+  LightClusters clusters;
+  clusters.Build(projection, NEAR_CLIP, FAR_CLIP);
+
+  std::mt19937 rng(2);
+  const auto lights = makeLights(rng, clusters.GetForward(), 2000);
+  clusters.Assign(lights);
+
+  const auto inverseProjection = glm::inverse(projection);
+  const auto gridSize = clusters.GetGridSize();
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+  int checked = 0;
+  for (int sample = 0; sample < 20000; sample++) {
+    const auto ndcX = unit(rng) * 2.0f - 1.0f;
+    const auto ndcY = unit(rng) * 2.0f - 1.0f;
+    const auto unProjected = inverseProjection * glm::vec4(ndcX, ndcY, 0.0f, 1.0f);
+    auto direction = glm::vec3(unProjected) / unProjected.w;
+    direction = direction / glm::dot(direction, clusters.GetForward());
+
+    const auto depth = NEAR_CLIP * std::pow(FAR_CLIP / NEAR_CLIP, unit(rng));
+    const auto point = direction * depth;
+
+    const auto x = std::min(static_cast<uint32_t>((ndcX * 0.5f + 0.5f) * static_cast<float>(gridSize.x)), gridSize.x - 1);
+    const auto y = std::min(static_cast<uint32_t>((ndcY * 0.5f + 0.5f) * static_cast<float>(gridSize.y)), gridSize.y - 1);
+    const auto z = clusters.GetSlice(glm::dot(point, clusters.GetForward()));
+    const auto listed = clusters.GetLights(clusters.GetClusterIndex(x, y, z));
+
+    // Full clusters drop lights by design
+    if (listed.size() >= MAX_LIGHTS_PER_CLUSTER) {
+      continue;
+    }
+
+    for (uint32_t i = 0; i < lights.size(); i++) {
+      const auto offset = point - lights[i].center;
+      if (glm::dot(offset, offset) <= lights[i].radius * lights[i].radius) {
+        checked++;
+        CHECK(std::find(listed.begin(), listed.end(), i) != listed.end());
+      }
+    }
+  }
+
+  // Make sure the samples actually exercised the lists
+  CHECK(checked > 100);
+}
+
+TEST(LightClustersOnlyListLightsTouchingTheCluster) {
+  LightClusters clusters;
+  clusters.Build(makeProjection(), NEAR_CLIP, FAR_CLIP);
+
+  std::mt19937 rng(3);
+  const auto lights = makeLights(rng, clusters.GetForward(), 2000);
+  clusters.Assign(lights);
+
+  for (uint32_t cluster = 0; cluster < clusters.GetNumClusters(); cluster++) {
+    for (const auto light : clusters.GetLights(cluster)) {
+      CHECK(light < lights.size());
+      CHECK(clusters.GetClusterBounds(cluster).Intersects(lights[light]));
+    }
+  }
+}
+
+TEST(LightClustersPutUnboundedLightsInTheGlobalList) {
+  LightClusters clusters;
+  clusters.Build(makeProjection(), NEAR_CLIP, FAR_CLIP);
+
+  const auto forward = clusters.GetForward();
+  Array<math::Sphere> lights;
+  lights.push(math::Sphere(forward * 10.0f, 2.0f));
+  lights.push(math::Sphere(glm::vec3(0.0f), 0.0f));
+  // Behind the camera and past the far plane
+  lights.push(math::Sphere(forward * -50.0f, 2.0f));
+  lights.push(math::Sphere(forward * (FAR_CLIP + 50.0f), 2.0f));
+  clusters.Assign(lights, {7, 11, 13, 17});
+
+  const auto global = clusters.GetGlobalLights();
+  CHECK_EQ(global.size(), size_t{1});
+  CHECK_EQ(global[0], 11u);
+
+  bool bFoundBounded = false;
+  for (uint32_t cluster = 0; cluster < clusters.GetNumClusters(); cluster++) {
+    for (const auto id : clusters.GetLights(cluster)) {
+      // Ids replace indices in the lists and culled lights never show up
+      CHECK(id == 7u);
+      bFoundBounded = true;
+    }
+  }
+  CHECK(bFoundBounded);
+}
+
+TEST(LightClustersCapFullClusters) {
+  LightClusters clusters;
+  clusters.Build(makeProjection(), NEAR_CLIP, FAR_CLIP);
+
+  Array<math::Sphere> lights;
+  for (uint32_t i = 0; i < MAX_LIGHTS_PER_CLUSTER * 2; i++) {
+    lights.push(math::Sphere(clusters.GetForward() * 20.0f, 1.0f));
+  }
+  clusters.Assign(lights);
+
+  uint32_t largest = 0;
+  for (uint32_t cluster = 0; cluster < clusters.GetNumClusters(); cluster++) {
+    largest = std::max(largest, static_cast<uint32_t>(clusters.GetLights(cluster).size()));
+  }
+  CHECK_EQ(largest, MAX_LIGHTS_PER_CLUSTER);
+}
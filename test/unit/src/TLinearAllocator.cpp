@@ -0,0 +1,54 @@
+#include "test.hpp"
+#include <aerox/drawing/FrameUploadBuffer.hpp>
+
+using namespace aerox::drawing;
+
+namespace {
+uint64_t allocate(LinearAllocator &allocator, const uint64_t size, const uint64_t alignment) {
+  const auto offset = allocator.Allocate(size, alignment);
+  CHECK(offset.has_value());
+  return *offset;
+}
+}
+
+TEST(LinearAllocatorAlignsOffsets) {
+  LinearAllocator allocator(1024);
+  CHECK_EQ(allocate(allocator, 3, 1), uint64_t{0});
+  CHECK_EQ(allocate(allocator, 8, 16), uint64_t{16});
+  CHECK_EQ(allocate(allocator, 1, 256), uint64_t{256});
+  CHECK_EQ(allocator.GetUsed(), uint64_t{257});
+
+  // Already aligned, nothing is skipped
+  CHECK_EQ(allocate(allocator, 4, 1), uint64_t{257});
+}
+
+TEST(LinearAllocatorFailsWithoutMovingWhenFull) {
+  LinearAllocator allocator(64);
+  CHECK(allocator.Allocate(40, 16).has_value());
+
+  // Fits the remaining space but not once aligned
+  CHECK(!allocator.Allocate(20, 32).has_value());
+  CHECK_EQ(allocator.GetUsed(), uint64_t{40});
+
+  CHECK_EQ(allocate(allocator, 24, 8), uint64_t{40});
+  CHECK_EQ(allocator.GetUsed(), allocator.GetCapacity());
+  CHECK(!allocator.Allocate(1, 1).has_value());
+
+  // Big enough to wrap the offset around if the size were added first
+  CHECK(!allocator.Allocate(UINT64_MAX, 1).has_value());
+}
+
+TEST(LinearAllocatorResetStartsOver) {
+  LinearAllocator allocator(64);
+  allocator.Allocate(64, 1);
+  allocator.Reset();
+  CHECK_EQ(allocator.GetUsed(), uint64_t{0});
+  CHECK_EQ(allocate(allocator, 64, 64), uint64_t{0});
+}
+
+TEST(LinearAllocatorRejectsAlignmentThatIsNotAPowerOfTwo) {
+  LinearAllocator allocator(1024);
+  CHECK_THROWS(allocator.Allocate(4, 0));
+  CHECK_THROWS(allocator.Allocate(4, 24));
+  CHECK_EQ(allocator.GetUsed(), uint64_t{0});
+}
@@ -0,0 +1,109 @@
+#include "test.hpp"
+#include <aerox/Engine.hpp>
+#include <aerox/async/AsyncSubsystem.hpp>
+#include <aerox/async/parallel.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace aerox;
+using namespace aerox::async;
+
+namespace {
+void checkPartition(const size_t count, const size_t maxBatches, const size_t minBatchSize) {
+  const auto batches = partition(count, maxBatches, minBatchSize);
+  if (count == 0) {
+    CHECK(batches.empty());
+    return;
+  }
+
+  CHECK(!batches.empty());
+  CHECK(batches.size() <= std::max(maxBatches, size_t{1}));
+
+  // Contiguous and covering [0,count) exactly
+  size_t next = 0;
+  for (size_t i = 0; i < batches.size(); i++) {
+    const auto [begin, end] = batches[i];
+    CHECK_EQ(begin, next);
+    CHECK(end > begin);
+    if (i + 1 < batches.size()) {
+      CHECK(end - begin >= std::max(minBatchSize, size_t{1}));
+    }
+    next = end;
+  }
+  CHECK_EQ(next, count);
+
+  CHECK(partition(count, maxBatches, minBatchSize) == batches);
+}
+}
+
+TEST(PartitionCoversRangeInOrder) {
+  for (size_t count = 0; count < 300; count += 7) {
+    for (size_t maxBatches = 0; maxBatches < 12; maxBatches++) {
+      for (const size_t minBatchSize : {0, 1, 5, 64}) {
+        checkPartition(count, maxBatches, minBatchSize);
+      }
+    }
+  }
+}
+
+TEST(PartitionKeepsSmallCountsInOneBatch) {
+  const auto batches = partition(40, 8, 64);
+  CHECK_EQ(batches.size(), size_t{1});
+  CHECK(batches.front() == std::make_pair(size_t{0}, size_t{40}));
+}
+
+TEST(PartitionUsesEveryWorkerForLargeCounts) {
+  CHECK_EQ(partition(10000, 8, 64).size(), size_t{8});
+}
+
+TEST(ParallelForVisitsEveryItemOnce) {
+  const auto runner = newObject<AsyncSubsystem>();
+  runner->Init(Engine::Get());
+
+  std::vector<std::atomic<int>> visits(5000);
+  std::atomic<size_t> numBatches = 0;
+  std::atomic<size_t> otherThreadBatches = 0;
+  const auto caller = std::this_thread::get_id();
+  parallelFor(runner, visits.size(), [&](const size_t begin, const size_t end) {
+    numBatches.fetch_add(1);
+    if (std::this_thread::get_id() != caller) {
+      otherThreadBatches.fetch_add(1);
+    }
+    else if (begin == 0 && runner->GetNumThreads() > 0) {
+      // Holds the first batch until a pool thread picked up another one, bounded so a broken pool fails instead of hanging
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+      while (otherThreadBatches.load() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+      }
+    }
+
+    for (auto i = begin; i < end; i++) {
+      visits[i].fetch_add(1, std::memory_order_relaxed);
+    }
+  }, 16);
+
+  for (const auto &visit : visits) {
+    CHECK_EQ(visit.load(), 1);
+  }
+
+  CHECK_EQ(numBatches.load(), partition(visits.size(), runner->GetNumThreads() + 1, 16).size());
+  if (runner->GetNumThreads() > 0) {
+    CHECK(otherThreadBatches.load() > 0);
+  }
+}
+
+TEST(ParallelForRunsInlineWithoutARunningPool) {
+  const auto caller = std::this_thread::get_id();
+  std::atomic<size_t> numBatches = 0;
+  bool bOnCaller = true;
+  parallelFor(std::shared_ptr<AsyncSubsystem>{}, 5000, [&](const size_t begin, const size_t end) {
+    numBatches.fetch_add(1);
+    bOnCaller = bOnCaller && std::this_thread::get_id() == caller && begin == 0 && end == 5000;
+  }, 16);
+
+  CHECK_EQ(numBatches.load(), size_t{1});
+  CHECK(bOnCaller);
+}
@@ -0,0 +1,54 @@
+#include "test.hpp"
+#include <aerox/containers/TRecycledList.hpp>
+
+using namespace aerox;
+
+TEST(RecycledListCreatesOnlyWhenAllInUse) {
+  TRecycledList<int> list;
+  int created = 0;
+  const auto create = [&] {
+    return created++;
+  };
+
+  CHECK_EQ(list.Acquire(create), 0);
+  CHECK_EQ(list.Acquire(create), 1);
+  CHECK_EQ(list.Acquire(create), 2);
+  CHECK_EQ(created, 3);
+  CHECK_EQ(list.GetNumUsed(), 3u);
+}
+
+TEST(RecycledListHandsOutKeptItemsInOrderAfterReset) {
+  TRecycledList<int> list;
+  int created = 0;
+  const auto create = [&] {
+    return created++;
+  };
+
+  for (int i = 0; i < 4; i++) {
+    list.Acquire(create);
+  }
+  CHECK(list.Reset());
+  CHECK_EQ(list.GetNumUsed(), 0u);
+
+  // Same items as the first frame, nothing new until the kept ones run out
+  CHECK_EQ(list.Acquire(create), 0);
+  CHECK_EQ(list.Acquire(create), 1);
+  CHECK_EQ(created, 4);
+
+  for (int i = 0; i < 3; i++) {
+    list.Acquire(create);
+  }
+  CHECK_EQ(created, 5);
+  CHECK_EQ(list.GetItems().size(), size_t{5});
+}
+
+TEST(RecycledListResetReportsUnusedLists) {
+  TRecycledList<int> list;
+  CHECK(!list.Reset());
+
+  list.Acquire([] {
+    return 7;
+  });
+  CHECK(list.Reset());
+  CHECK(!list.Reset());
+}
@@ -0,0 +1,222 @@
+#include "test.hpp"
+#include <aerox/drawing/RenderGraph.hpp>
+
+using namespace aerox;
+using namespace aerox::drawing;
+
+namespace {
+constexpr vk::Extent2D EXTENT{64, 64};
+constexpr vk::DeviceSize COLOR_SIZE = 8192;
+constexpr vk::DeviceSize DEPTH_SIZE = 4096;
+
+// Stands in for the device, depth images are smaller so the packer has different sizes to place
+vk::MemoryRequirements fakeRequirements(const RenderGraphImage &image, vk::ImageUsageFlags) {
+  vk::MemoryRequirements requirements;
+  requirements.size = image.format == vk::Format::eD32Sfloat ? DEPTH_SIZE : COLOR_SIZE;
+  requirements.alignment = 256;
+  requirements.memoryTypeBits = 0b11;
+  return requirements;
+}
+
+graphImageId createColor(RenderGraph &graph, const String &name) {
+  return graph.CreateImage(name, vk::Format::eR16G16B16A16Sfloat, EXTENT);
+}
+
+graphImageId importResult(RenderGraph &graph) {
+  RenderGraphImport import;
+  import.before = EImageUsage::TransferSrc;
+  import.after = EImageUsage::TransferSrc;
+  import.bDiscard = true;
+  return graph.ImportImage("result", nullptr, import);
+}
+
+bool survived(const CompiledRenderGraph &compiled, const uint32_t pass) {
+  for (const auto &compiledPass : compiled.passes) {
+    if (compiledPass.pass == pass) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool memoryOverlaps(const CompiledRenderGraphImage &a, const CompiledRenderGraphImage &b) {
+  return a.offset < b.offset + b.requirements.size && b.offset < a.offset + a.requirements.size;
+}
+}
+
+TEST(RenderGraphCullsPassesNothingNeeds) {
+  RenderGraph graph;
+  const auto gbuffer = createColor(graph, "gbuffer");
+  const auto debug = createColor(graph, "debug");
+  const auto lit = createColor(graph, "lit");
+  const auto result = importResult(graph);
+
+  graph.AddPass("gbuffer", {}).Write(gbuffer, EImageUsage::ColorAttachmentWrite);
+  // Writes an image no later pass reads
+  graph.AddPass("debug", {}).Read(gbuffer, EImageUsage::FragmentSampled).Write(debug, EImageUsage::ColorAttachmentWrite);
+  graph.AddPass("light", {}).Read(gbuffer, EImageUsage::FragmentSampled).Write(lit, EImageUsage::ColorAttachmentWrite);
+  graph.AddPass("post", {}).Read(lit, EImageUsage::FragmentSampled).Write(result, EImageUsage::ColorAttachmentWrite);
+
+  const auto compiled = graph.Compile(fakeRequirements);
+  CHECK_EQ(compiled.numCulled, 1u);
+  CHECK_EQ(compiled.passes.size(), size_t{3});
+  CHECK(survived(compiled, 0));
+  CHECK(!survived(compiled, 1));
+  CHECK(survived(compiled, 2));
+  CHECK(survived(compiled, 3));
+  CHECK(!compiled.images[debug].bUsed);
+}
+
+TEST(RenderGraphCullsWritesThatAreOverwrittenBeforeBeingRead) {
+  RenderGraph graph;
+  const auto color = createColor(graph, "color");
+  const auto result = importResult(graph);
+
+  graph.AddPass("first", {}).Write(color, EImageUsage::ColorAttachmentWrite);
+  // Writes without reading, so nothing from the first pass is needed
+  graph.AddPass("second", {}).Write(color, EImageUsage::ColorAttachmentWrite);
+  graph.AddPass("copy", {}).Read(color, EImageUsage::TransferSrc).Write(result, EImageUsage::TransferDst);
+
+  const auto compiled = graph.Compile(fakeRequirements);
+  CHECK_EQ(compiled.numCulled, 1u);
+  CHECK(!survived(compiled, 0));
+  CHECK(survived(compiled, 1));
+}
+
+TEST(RenderGraphKeepsPassesWritingImportedImages) {
+  RenderGraph graph;
+  const auto result = importResult(graph);
+  graph.AddPass("clear", {}).Write(result, EImageUsage::TransferDst);
+
+  const auto compiled = graph.Compile(fakeRequirements);
+  CHECK_EQ(compiled.numCulled, 0u);
+  CHECK_EQ(compiled.passes.size(), size_t{1});
+}
+
+TEST(RenderGraphThrowsOnReadBeforeWrite) {
+  RenderGraph graph;
+  const auto color = createColor(graph, "color");
+  const auto result = importResult(graph);
+  graph.AddPass("read", {}).Read(color, EImageUsage::FragmentSampled).Write(result, EImageUsage::ColorAttachmentWrite);
+
+  CHECK_THROWS(graph.Compile(fakeRequirements));
+}
+
+TEST(RenderGraphBarriersPassValidation) {
+  RenderGraph graph;
+  const auto albedo = createColor(graph, "albedo");
+  const auto normal = createColor(graph, "normal");
+  const auto depth = graph.CreateImage("depth", vk::Format::eD32Sfloat, EXTENT, vk::ImageAspectFlagBits::eDepth);
+  const auto lit = createColor(graph, "lit");
+  const auto bloom = createColor(graph, "bloom");
+  const auto result = importResult(graph);
+
+  graph.AddPass("gbuffer", {})
+       .Write(albedo, EImageUsage::ColorAttachmentWrite)
+       .Write(normal, EImageUsage::ColorAttachmentWrite)
+       .Write(depth, EImageUsage::DepthAttachmentWrite);
+  graph.AddPass("light", {})
+       .Read(albedo, EImageUsage::FragmentSampled)
+       .Read(normal, EImageUsage::FragmentSampled)
+       .Read(depth, EImageUsage::DepthAttachmentRead)
+       .Write(lit, EImageUsage::ColorAttachmentWrite);
+  graph.AddPass("bloom", {}).Read(lit, EImageUsage::ComputeSampled).Write(bloom, EImageUsage::ColorAttachmentWrite);
+  graph.AddPass("composite", {})
+       .Read(lit, EImageUsage::FragmentSampled)
+       .Read(bloom, EImageUsage::FragmentSampled)
+       .Write(result, EImageUsage::ColorAttachmentWrite);
+
+  const auto compiled = graph.Compile(fakeRequirements);
+  CHECK_EQ(compiled.numCulled, 0u);
+  CHECK(graph.Validate(compiled).empty());
+
+  // Every pass after the first needs at least one barrier for what it reads
+  for (size_t i = 1; i < compiled.passes.size(); i++) {
+    CHECK(!compiled.passes[i].barriers.empty());
+  }
+
+  // The result is left as imported
+  CHECK_EQ(compiled.finalBarriers.size(), size_t{1});
+  CHECK_EQ(compiled.finalBarriers.front().image, result);
+}
+
+TEST(RenderGraphValidationCatchesMissingBarriers) {
+  RenderGraph graph;
+  const auto color = createColor(graph, "color");
+  const auto result = importResult(graph);
+  graph.AddPass("draw", {}).Write(color, EImageUsage::ColorAttachmentWrite);
+  graph.AddPass("copy", {}).Read(color, EImageUsage::TransferSrc).Write(result, EImageUsage::TransferDst);
+
+  auto compiled = graph.Compile(fakeRequirements);
+  CHECK(graph.Validate(compiled).empty());
+
+  // Without the copy's barriers it reads the color before the draw is visible and writes the result in the wrong layout
+  compiled.passes[1].barriers.clear();
+  CHECK(!graph.Validate(compiled).empty());
+}
+
+TEST(RenderGraphAliasesImagesWithDisjointLifetimes) {
+  RenderGraph graph;
+  const auto a = createColor(graph, "a");
+  const auto b = createColor(graph, "b");
+  const auto c = createColor(graph, "c");
+  const auto d = createColor(graph, "d");
+  const auto result = importResult(graph);
+
+  // a lives in passes 0-1, b in 1-2, c in 2-3, d in 3-4
+  graph.AddPass("0", {}).Write(a, EImageUsage::ColorAttachmentWrite);
+  graph.AddPass("1", {}).Read(a, EImageUsage::FragmentSampled).Write(b, EImageUsage::ColorAttachmentWrite);
+  graph.AddPass("2", {}).Read(b, EImageUsage::FragmentSampled).Write(c, EImageUsage::ColorAttachmentWrite);
+  graph.AddPass("3", {}).Read(c, EImageUsage::FragmentSampled).Write(d, EImageUsage::ColorAttachmentWrite);
+  graph.AddPass("4", {}).Read(d, EImageUsage::FragmentSampled).Write(result, EImageUsage::ColorAttachmentWrite);
+
+  const auto compiled = graph.Compile(fakeRequirements);
+  const auto &images = compiled.images;
+
+  // Neighbours overlap in one pass and must not share memory
+  CHECK(!memoryOverlaps(images[a], images[b]));
+  CHECK(!memoryOverlaps(images[b], images[c]));
+  CHECK(!memoryOverlaps(images[c], images[d]));
+
+  // Images two apart never live at the same time and reuse the same memory
+  CHECK_EQ(images[a].offset, images[c].offset);
+  CHECK_EQ(images[b].offset, images[d].offset);
+  CHECK_EQ(compiled.heapSize, 2 * COLOR_SIZE);
+  CHECK_EQ(compiled.heapMemoryTypes, 0b11u);
+
+  // Sharing memory means the barrier into c has to wait on what a last did
+  CHECK(graph.Validate(compiled).empty());
+}
+
+TEST(RenderGraphKeepsOverlappingLifetimesApart) {
+  RenderGraph graph;
+  Array<graphImageId> targets;
+  for (int i = 0; i < 4; i++) {
+    targets.push(createColor(graph, "target"));
+  }
+  const auto depth = graph.CreateImage("depth", vk::Format::eD32Sfloat, EXTENT, vk::ImageAspectFlagBits::eDepth);
+  const auto result = importResult(graph);
+
+  auto &write = graph.AddPass("write", {});
+  for (const auto target : targets) {
+    write.Write(target, EImageUsage::ColorAttachmentWrite);
+  }
+  write.Write(depth, EImageUsage::DepthAttachmentWrite);
+
+  auto &read = graph.AddPass("read", {});
+  for (const auto target : targets) {
+    read.Read(target, EImageUsage::FragmentSampled);
+  }
+  read.Read(depth, EImageUsage::DepthAttachmentRead).Write(result, EImageUsage::ColorAttachmentWrite);
+
+  const auto compiled = graph.Compile(fakeRequirements);
+  auto all = targets;
+  all.push(depth);
+  for (size_t i = 0; i < all.size(); i++) {
+    for (size_t j = i + 1; j < all.size(); j++) {
+      CHECK(!memoryOverlaps(compiled.images[all[i]], compiled.images[all[j]]));
+    }
+    CHECK_EQ(compiled.images[all[i]].offset % 256, vk::DeviceSize{0});
+  }
+  CHECK_EQ(compiled.heapSize, 4 * COLOR_SIZE + DEPTH_SIZE);
+}
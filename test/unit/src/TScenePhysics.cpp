@@ -0,0 +1,138 @@
+#include "test.hpp"
+#include <aerox/Engine.hpp>
+#include <aerox/async/AsyncSubsystem.hpp>
+#include <aerox/physics/rp3/RP3DScenePhysics.hpp>
+#include <aerox/scene/components/SceneComponent.hpp>
+#include <random>
+
+using namespace aerox;
+
+namespace {
+constexpr int NUM_BOXES = 3;
+constexpr int NUM_FRAMES = 240;
+constexpr float BOX_HALF_EXTENT = 0.5f;
+
+/**
+ * \brief The engine's physics stepping on a test owned job pool, every step records where the boxes ended up so two runs can be
+ * compared step by step
+ */
+class RecordingPhysics : public physics::RP3DScenePhysics {
+  std::shared_ptr<async::AsyncSubsystem> _runner;
+
+protected:
+  std::shared_ptr<async::AsyncSubsystem> GetStepRunner() const override {
+    return _runner;
+  }
+
+public:
+  // Only touched by steps
+  std::vector<rp3d::RigidBody *> boxBodies;
+  std::vector<glm::vec3> stepLocations;
+
+  explicit RecordingPhysics(std::shared_ptr<async::AsyncSubsystem> runner) : _runner(std::move(runner)) {
+  }
+
+  void InternalFixedUpdate(const float deltaTime) override {
+    RP3DScenePhysics::InternalFixedUpdate(deltaTime);
+    for (const auto body : boxBodies) {
+      const auto &position = body->getTransform().getPosition();
+      stepLocations.emplace_back(position.x, position.y, position.z);
+    }
+  }
+};
+
+struct Replay {
+  std::vector<glm::vec3> stepLocations;
+  size_t contacts = 0;
+};
+
+/**
+ * \brief Drops a few boxes on a static ground box, nudging one of them every half second through commands
+ */
+Replay replay(const std::shared_ptr<async::AsyncSubsystem> &runner, const bool bAsync) {
+  auto &common = physics::RP3DScenePhysics::physicsCommon;
+  const auto groundShape = common.createBoxShape({10.0f, 0.5f, 10.0f});
+  const auto boxShape = common.createBoxShape({BOX_HALF_EXTENT, BOX_HALF_EXTENT, BOX_HALF_EXTENT});
+
+  Replay result;
+  {
+    const auto simulation = newObject<RecordingPhysics>(runner);
+    simulation->Init(nullptr);
+    simulation->SetAsync(bAsync);
+    const auto contactsHandle = simulation->onContacts->BindFunction([&result](const std::vector<physics::ContactEvent> &events) {
+      result.contacts += events.size();
+    });
+
+    // Top face at y 0
+    const auto ground = newObject<scene::SceneComponent>();
+    ground->SetRelativeLocation({0.0f, -0.5f, 0.0f});
+    simulation->AddCollider(simulation->CreateBody(ground, rp3d::BodyType::STATIC), groundShape, {}, ground.get());
+
+    std::vector<std::shared_ptr<scene::SceneComponent>> boxes;
+    for (auto i = 0; i < NUM_BOXES; i++) {
+      const auto box = newObject<scene::SceneComponent>();
+      box->SetRelativeTransform({{static_cast<float>(i) * 2.0f - 2.0f, 1.0f + static_cast<float>(i), 0.0f},
+                                 math::Quat(20.0f * static_cast<float>(i), math::Vec3<>(0.0f, 0.0f, 1.0f)), math::Vec3<>(1.0f)});
+      const auto body = simulation->CreateBody(box, rp3d::BodyType::DYNAMIC);
+      simulation->AddCollider(body, boxShape, {}, box.get());
+      simulation->boxBodies.push_back(body);
+      boxes.push_back(box);
+    }
+
+    std::mt19937 rng{7};
+    std::uniform_real_distribution<float> frameTime(0.002f, 0.05f);
+    for (auto frame = 0; frame < NUM_FRAMES; frame++) {
+      if (frame % 20 == 0) {
+        simulation->PushCommand([body = simulation->boxBodies[frame / 20 % NUM_BOXES]] {
+          body->applyWorldForceAtCenterOfMass({20.0f, 0.0f, 0.0f});
+        });
+      }
+      simulation->FixedUpdate(frameTime(rng));
+    }
+
+    // Exchanges the last frame's steps, the scene side then follows the simulation
+    simulation->FlushCommands();
+    simulation->SyncFromPhysics(1.0f);
+    for (auto i = 0; i < NUM_BOXES; i++) {
+      const auto location = boxes[i]->GetWorldLocation();
+      const auto &stepped = simulation->stepLocations[simulation->stepLocations.size() - NUM_BOXES + i];
+      CHECK_NEAR(location.x, stepped.x, 1e-4);
+      CHECK_NEAR(location.y, stepped.y, 1e-4);
+      CHECK_NEAR(location.z, stepped.z, 1e-4);
+    }
+
+    contactsHandle->UnBind();
+    result.stepLocations = simulation->stepLocations;
+  }
+
+  common.destroyBoxShape(boxShape);
+  common.destroyBoxShape(groundShape);
+  return result;
+}
+}
+
+TEST(ScenePhysicsBoxesComeToRestOnTheGround) {
+  const auto runner = newObject<async::AsyncSubsystem>();
+  runner->Init(Engine::Get());
+
+  const auto result = replay(runner, false);
+  CHECK(result.contacts > 0);
+  CHECK_EQ(result.stepLocations.size() % NUM_BOXES, size_t{0});
+  for (auto i = 0; i < NUM_BOXES; i++) {
+    // Settled flat on the ground
+    CHECK_NEAR(result.stepLocations[result.stepLocations.size() - NUM_BOXES + i].y, BOX_HALF_EXTENT, 0.05);
+  }
+}
+
+TEST(ScenePhysicsAsyncStepsReplayInlineSteps) {
+  const auto runner = newObject<async::AsyncSubsystem>();
+  runner->Init(Engine::Get());
+
+  const auto inlineSteps = replay(runner, false).stepLocations;
+  CHECK(!inlineSteps.empty());
+
+  // Scheduling differs run to run, the steps must not
+  for (auto run = 0; run < 3; run++) {
+    CHECK(replay(runner, true).stepLocations == inlineSteps);
+  }
+}
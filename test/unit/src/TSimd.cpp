@@ -0,0 +1,147 @@
+#include "test.hpp"
+#include <aerox/math/simd.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <cstring>
+#include <random>
+
+using namespace aerox::math;
+
+namespace {
+constexpr int ITERATIONS = 10000;
+
+struct RandomValues {
+  std::mt19937 rng{3};
+  std::uniform_real_distribution<float> value{-2.0f, 2.0f};
+
+  glm::mat4 Matrix() {
+    glm::mat4 result;
+    for (auto column = 0; column < 4; column++) {
+      for (auto row = 0; row < 4; row++) {
+        result[column][row] = value(rng);
+      }
+    }
+    return result;
+  }
+
+  glm::vec3 Vector() {
+    return {value(rng), value(rng), value(rng)};
+  }
+
+  glm::quat Quat() {
+    return {value(rng), value(rng), value(rng), value(rng)};
+  }
+
+  glm::quat Rotation() {
+    return glm::normalize(Quat());
+  }
+
+  glm::vec3 Scale() {
+    return {0.5f + std::abs(value(rng)), 0.5f + std::abs(value(rng)), 0.5f + std::abs(value(rng))};
+  }
+};
+
+// Compares values rather than bytes for results where glm adds zero terms, +0 and -0 are the same value
+bool equal(const glm::mat4 &a, const glm::mat4 &b) {
+  for (auto column = 0; column < 4; column++) {
+    for (auto row = 0; row < 4; row++) {
+      if (a[column][row] != b[column][row]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+TEST(SimdMatrixProductMatchesGlmBitForBit) {
+  RandomValues values;
+  for (auto i = 0; i < ITERATIONS; i++) {
+    const auto a = values.Matrix();
+    const auto b = values.Matrix();
+    const auto simdResult = simd::multiply(a, b);
+    const auto glmResult = a * b;
+    CHECK(std::memcmp(&simdResult, &glmResult, sizeof(glm::mat4)) == 0);
+  }
+}
+
+TEST(SimdQuatProductMatchesGlmBitForBit) {
+  RandomValues values;
+  for (auto i = 0; i < ITERATIONS; i++) {
+    const auto a = values.Quat();
+    const auto b = values.Quat();
+    const auto simdResult = simd::multiply(a, b);
+    const auto glmResult = a * b;
+    CHECK(std::memcmp(&simdResult, &glmResult, sizeof(glm::quat)) == 0);
+  }
+}
+
+TEST(SimdComposeMatchesGlm) {
+  RandomValues values;
+  for (auto i = 0; i < ITERATIONS; i++) {
+    const auto location = values.Vector();
+    const auto rotation = values.Rotation();
+    const auto scale = values.Scale();
+    const auto expected = glm::translate(glm::mat4(1.0f), location) * glm::mat4_cast(rotation) * glm::scale(glm::mat4(1.0f), scale);
+    CHECK(equal(simd::composeTrs(location, rotation, scale), expected));
+  }
+}
+
+TEST(SimdRotateMatchesGlm) {
+  RandomValues values;
+  for (auto i = 0; i < ITERATIONS; i++) {
+    const auto rotation = values.Rotation();
+    const auto vector = values.Vector();
+    CHECK(simd::rotate(rotation, vector) == rotation * vector);
+  }
+}
+
+TEST(SimdSlerpMatchesGlm) {
+  RandomValues values;
+  std::uniform_real_distribution<float> alpha(0.0f, 1.0f);
+  for (auto i = 0; i < ITERATIONS; i++) {
+    const auto a = values.Rotation();
+    // Every few iterations take the nearly equal branch
+    const auto b = i % 8 == 0 ? a : values.Rotation();
+    const auto t = alpha(values.rng);
+    const auto simdResult = simd::slerp(a, b, t);
+    const auto glmResult = glm::slerp(a, b, t);
+    CHECK(simdResult.x == glmResult.x && simdResult.y == glmResult.y && simdResult.z == glmResult.z && simdResult.w == glmResult.w);
+  }
+}
+
+TEST(SimdTransformPointsMatchesGlm) {
+  RandomValues values;
+  glm::vec3 points[17];
+  glm::vec3 out[17];
+  for (auto i = 0; i < ITERATIONS / 16; i++) {
+    const auto matrix = simd::composeTrs(values.Vector(), values.Rotation(), values.Scale());
+    for (auto &point : points) {
+      point = values.Vector();
+    }
+
+    simd::transformPoints(matrix, points, out, 17);
+    for (auto p = 0; p < 17; p++) {
+      CHECK(out[p] == glm::vec3(matrix * glm::vec4(points[p], 1.0f)));
+    }
+
+    // In place
+    simd::transformPoints(matrix, points, points, 17);
+    for (auto p = 0; p < 17; p++) {
+      CHECK(points[p] == out[p]);
+    }
+  }
+}
+
+TEST(SimdAffineInverseMatchesGlm) {
+  RandomValues values;
+  for (auto i = 0; i < ITERATIONS; i++) {
+    const auto matrix = simd::composeTrs(values.Vector() * 10.0f, values.Rotation(), values.Scale());
+    const auto simdResult = simd::inverseAffine(matrix);
+    const auto glmResult = glm::inverse(matrix);
+    for (auto column = 0; column < 4; column++) {
+      for (auto row = 0; row < 4; row++) {
+        CHECK_NEAR(simdResult[column][row], glmResult[column][row], 1e-4);
+      }
+    }
+  }
+}
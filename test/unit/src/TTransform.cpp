@@ -0,0 +1,143 @@
+#include "test.hpp"
+#include <aerox/math/Transform.hpp>
+#include <random>
+
+using namespace aerox::math;
+
+namespace {
+constexpr int ITERATIONS = 2000;
+constexpr double TOLERANCE = 1e-4;
+
+struct RandomTransforms {
+  std::mt19937 rng{5};
+  std::uniform_real_distribution<float> value{-5.0f, 5.0f};
+  std::uniform_real_distribution<float> angle{-180.0f, 180.0f};
+  std::uniform_real_distribution<float> size{0.5f, 2.0f};
+
+  Vec3<> Location() {
+    return {value(rng), value(rng), value(rng)};
+  }
+
+  Quat Rotation() {
+    const auto axis = glm::normalize(glm::vec3(value(rng), value(rng), value(rng)));
+    return Quat(angle(rng), Vec3<>(axis.x, axis.y, axis.z));
+  }
+
+  Transform Uniform() {
+    return {Location(), Rotation(), Vec3<>(size(rng))};
+  }
+
+  Transform NonUniform() {
+    return {Location(), Rotation(), Vec3<>(size(rng), size(rng) * 2.0f, size(rng) * 0.5f)};
+  }
+};
+
+void checkMatrix(const glm::mat4 &a, const glm::mat4 &b) {
+  for (auto column = 0; column < 4; column++) {
+    for (auto row = 0; row < 4; row++) {
+      CHECK_NEAR(a[column][row], b[column][row], TOLERANCE);
+    }
+  }
+}
+
+glm::mat4 product(const Transform &a, const Transform &b) {
+  return a.Matrix() * b.Matrix();
+}
+}
+
+TEST(TransformDecomposesItsMatrix) {
+  RandomTransforms random;
+  for (auto i = 0; i < ITERATIONS; i++) {
+    const auto transform = random.NonUniform();
+    checkMatrix(Transform(transform.Matrix()).Matrix(), transform.Matrix());
+  }
+
+  // Mirrored on one axis
+  const Transform mirrored{{1.0f, 2.0f, 3.0f}, Quat(30.0f, Vec3<>(0.0f, 1.0f, 0.0f)), {-1.0f, 2.0f, 1.0f}};
+  checkMatrix(Transform(mirrored.Matrix()).Matrix(), mirrored.Matrix());
+}
+
+TEST(TransformUniformInverseMatchesMatrixInverse) {
+  RandomTransforms random;
+  for (auto i = 0; i < ITERATIONS; i++) {
+    const auto transform = random.Uniform();
+    CHECK(transform.HasUniformScale());
+    checkMatrix(transform.Inverse().Matrix(), glm::inverse(transform.Matrix()));
+  }
+}
+
+TEST(TransformInverseMatrixIsExactForAnyScale) {
+  RandomTransforms random;
+  for (auto i = 0; i < ITERATIONS; i++) {
+    const auto transform = random.NonUniform();
+    CHECK(!transform.HasUniformScale());
+    checkMatrix(transform.InverseMatrix(), glm::inverse(transform.Matrix()));
+  }
+}
+
+TEST(TransformNonUniformInverseIsExactWhenRepresentable) {
+  RandomTransforms random;
+  for (auto i = 0; i < ITERATIONS; i++) {
+    // A quarter turn keeps the scaled axes on the world axes so the inverse is a plain transform again
+    const Transform transform{random.Location(), Quat(90.0f, Vec3<>(0.0f, 0.0f, 1.0f)), Vec3<>(1.0f, 2.0f, 0.5f)};
+    checkMatrix(transform.Inverse().Matrix(), glm::inverse(transform.Matrix()));
+  }
+}
+
+TEST(TransformRelativeToUniformParentRoundTrips) {
+  RandomTransforms random;
+  for (auto i = 0; i < ITERATIONS; i++) {
+    const auto parent = random.Uniform();
+    const auto world = random.NonUniform();
+    checkMatrix(product(parent, world.RelativeTo(parent)), world.Matrix());
+  }
+}
+
+TEST(TransformRelativeToNonUniformParentRoundTrips) {
+  RandomTransforms random;
+  for (auto i = 0; i < ITERATIONS; i++) {
+    // The child is turned a quarter around z relative to its non-uniformly scaled parent, the component math swaps the wrong scale
+    // axes here while the affine path is exact
+    const auto parent = random.NonUniform();
+    const Transform child{random.Location(), Quat(90.0f, Vec3<>(0.0f, 0.0f, 1.0f)), Vec3<>(random.size(random.rng))};
+    const auto world = Transform(product(parent, child));
+
+    const auto relative = world.RelativeTo(parent);
+    checkMatrix(product(parent, relative), world.Matrix());
+    checkMatrix(relative.Matrix(), child.Matrix());
+  }
+}
+
+TEST(TransformRelativeToShearedMatrixKeepsLocation) {
+  RandomTransforms random;
+  for (auto i = 0; i < ITERATIONS; i++) {
+    // A rotated child of a non-uniformly scaled parent has shear no Transform can hold
+    const auto sheared = product(random.NonUniform(), random.Uniform());
+    const auto world = random.Uniform();
+
+    const auto relative = world.RelativeTo(sheared);
+    const auto location = sheared * glm::vec4(relative.location.x, relative.location.y, relative.location.z, 1.0f);
+    CHECK_NEAR(location.x, world.location.x, TOLERANCE);
+    CHECK_NEAR(location.y, world.location.y, TOLERANCE);
+    CHECK_NEAR(location.z, world.location.z, TOLERANCE);
+  }
+}
+
+TEST(TransformProductWithUniformParentMatchesMatrixProduct) {
+  RandomTransforms random;
+  for (auto i = 0; i < ITERATIONS; i++) {
+    const auto parent = random.Uniform();
+    const auto child = random.NonUniform();
+    checkMatrix((parent * child).Matrix(), product(parent, child));
+  }
+}
+
+TEST(TransformProductWithNonUniformParentMatchesMatrixProduct) {
+  RandomTransforms random;
+  for (auto i = 0; i < ITERATIONS; i++) {
+    // A quarter turn keeps the product free of shear, the component math would scale the child along the wrong axes here
+    const auto parent = random.NonUniform();
+    const Transform child{random.Location(), Quat(90.0f, Vec3<>(0.0f, 0.0f, 1.0f)), Vec3<>(random.size(random.rng))};
+    checkMatrix((parent * child).Matrix(), product(parent, child));
+  }
+}
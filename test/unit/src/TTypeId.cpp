@@ -0,0 +1,19 @@
+#include "test.hpp"
+#include <aerox/TypeId.hpp>
+
+using namespace aerox;
+
+namespace {
+struct First {};
+struct Second {};
+}
+
+// Computed at compile time, the hash of the name does not depend on which library instantiates it
+static_assert(typeIdOf<First>() != typeIdOf<Second>());
+static_assert(typeIdOf<const First &>() == typeIdOf<First>());
+
+TEST(TypeIdHashesTheTypeName) {
+  CHECK(typeSignature<First>().find("First") != std::string_view::npos);
+  CHECK_EQ(typeIdOf<First>(), hashString(typeSignature<First>()));
+  CHECK(typeIdOf<int>() != typeIdOf<unsigned int>());
+}
@@ -0,0 +1,57 @@
+#include "test.hpp"
+#include <cstring>
+#include <exception>
+#include <iostream>
+
+namespace aerox::test {
+std::vector<TestCase> &getTests() {
+  static std::vector<TestCase> tests;
+  return tests;
+}
+
+TestRegistrar::TestRegistrar(const char *name, const TestFn fn, const bool gpu) {
+  getTests().push_back({name, fn, gpu});
+}
+
+void fail(const char *file, const int line, const std::string &message) {
+  throw TestFailure{std::string(file) + ":" + std::to_string(line) + ": " + message};
+}
+}
+
+// Usage: aeroxTests [--gpu] [filter], runs the cpu tests by default and only the gpu tests with --gpu
+int main(const int argc, char **argv) {
+  using namespace aerox::test;
+
+  bool bGpu = false;
+  const char *filter = nullptr;
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--gpu") == 0) {
+      bGpu = true;
+    } else {
+      filter = argv[i];
+    }
+  }
+
+  int ran = 0;
+  int failed = 0;
+  for (const auto &test : getTests()) {
+    if (test.gpu != bGpu || (filter && !std::strstr(test.name, filter))) {
+      continue;
+    }
+
+    ran++;
+    try {
+      test.fn();
+      std::cout << "[ PASS ] " << test.name << std::endl;
+    } catch (const TestFailure &failure) {
+      failed++;
+      std::cout << "[ FAIL ] " << test.name << "\n  " << failure.message << std::endl;
+    } catch (const std::exception &e) {
+      failed++;
+      std::cout << "[ FAIL ] " << test.name << "\n  unexpected exception: " << e.what() << std::endl;
+    }
+  }
+
+  std::cout << ran - failed << "/" << ran << " tests passed" << std::endl;
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace aerox::test {
+
+using TestFn = void (*)();
+
+struct TestCase {
+  const char *name;
+  TestFn fn;
+  // Needs a vulkan device, only run with --gpu
+  bool gpu;
+};
+
+/**
+ * \brief Thrown by a failed check, caught by the runner
+ */
+struct TestFailure {
+  std::string message;
+};
+
+std::vector<TestCase> &getTests();
+
+struct TestRegistrar {
+  TestRegistrar(const char *name, TestFn fn, bool gpu);
+};
+
+[[noreturn]] void fail(const char *file, int line, const std::string &message);
+
+template <typename A, typename B>
+void checkEqual(const A &a, const B &b, const char *expression, const char *file, const int line) {
+  if (!(a == b)) {
+    std::stringstream stream;
+    stream << expression << " (" << a << " != " << b << ")";
+    fail(file, line, stream.str());
+  }
+}
+
+inline void checkNear(const double a, const double b, const double epsilon, const char *expression, const char *file,
+                      const int line) {
+  if (!(std::abs(a - b) <= epsilon)) {
+    std::stringstream stream;
+    stream << expression << " (" << a << " vs " << b << ", epsilon " << epsilon << ")";
+    fail(file, line, stream.str());
+  }
+}
+}
+
+#define AEROX_TEST_IMPL(name, gpu)                                                                                       \
+  static void name();                                                                                                  \
+  static ::aerox::test::TestRegistrar name##Registrar{#name, name, gpu};                                                 \
+  static void name()
+
+#define TEST(name) AEROX_TEST_IMPL(name, false)
+
+#define GPU_TEST(name) AEROX_TEST_IMPL(name, true)
+
+#define CHECK(expression)                                                                                              \
+  do {                                                                                                                 \
+    if (!(expression)) ::aerox::test::fail(__FILE__, __LINE__, #expression);                                           \
+  } while (false)
+
+#define CHECK_EQ(a, b) ::aerox::test::checkEqual((a), (b), #a " == " #b, __FILE__, __LINE__)
+
+#define CHECK_NEAR(a, b, epsilon) ::aerox::test::checkNear((a), (b), (epsilon), #a " ~= " #b, __FILE__, __LINE__)
+
+#define CHECK_THROWS(expression)                                                                                       \
+  do {                                                                                                                 \
+    bool bThrew = false;                                                                                               \
+    try {                                                                                                              \
+      expression;                                                                                                      \
+    } catch (...) {                                                                                                    \
+      bThrew = true;                                                                                                   \
+    }                                                                                                                  \
+    if (!bThrew) ::aerox::test::fail(__FILE__, __LINE__, "expected " #expression " to throw");                         \
+  } while (false)